@@ -14,6 +14,7 @@ CFLAGS			?=
 CXXFLAGS		?=
 CPPFLAGS		?=
 LDFLAGS			?=
+LIBS			?=
 SYSTEM_CFLAGS	?=
 SYSTEM_CXXFLAGS	?=
 SYSTEM_CPPFLAGS	?=
@@ -57,7 +58,7 @@ endif
 CFLAGS			+= -std=c99   $(OPT_FLAGS) $(WARNING_FLAGS) $(SYSTEM_CFLAGS)
 CXXFLAGS		+= -std=c++2b $(OPT_FLAGS) $(WARNING_FLAGS) $(WARNING_CXXFLAGS) $(SYSTEM_CXXFLAGS)
 CPPFLAGS    	+= -I../include -isystem ../lib/range-v3/include $(BOOST_INCLUDE) $(SYSTEM_CPPFLAGS) $(IQUOTE)
-LDFLAGS			+= $(SYSTEM_LDFLAGS) -lz
+LDFLAGS			+= $(SYSTEM_LDFLAGS) -lz $(LIBS)
 
 %.cov.o: %.cc
 	$(CXX) -c --coverage $(CXXFLAGS) $(CPPFLAGS) -o $@ $<
@@ -1,3 +1,5 @@
 #define LIBBIO_ENABLE_BAM_PARSER 1
+#define LIBBIO_ENABLE_BGZF_COMPRESSOR 1
 #define LIBBIO_ENABLE_BGZF_DECOMPRESSOR 1
+#define LIBBIO_ENABLE_HIGHWAY 0
 #define LIBBIO_ENABLE_MEMORY_LOGGER_SUPPORT 1
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_ARENA_HH
+#define LIBBIO_ARENA_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/assert.hh>
+#include <libbio/buffer.hh>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio {
+
+	// Bump allocator for objects that share a lifetime. Destructors are not called; all memory
+	// is released at once with release(), which keeps the blocks for reuse.
+	class arena
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_BLOCK_SIZE{64 * 1024};
+
+	protected:
+		typedef std::unique_ptr <std::byte, detail::malloc_deleter <std::byte>>	block_ptr;
+
+		struct block
+		{
+			block_ptr	data;
+			std::size_t	size{};
+		};
+
+		typedef std::vector <block>	block_vector;
+
+	protected:
+		block_vector	m_blocks;
+		std::size_t		m_block_size{DEFAULT_BLOCK_SIZE};
+		std::size_t		m_block_idx{};		// Current block.
+		std::size_t		m_offset{};			// Offset in the current block.
+		std::size_t		m_bytes_used{};
+
+	public:
+		arena() = default;
+
+		explicit arena(std::size_t const block_size):
+			m_block_size(block_size)
+		{
+			libbio_assert_lt(0, block_size);
+		}
+
+		arena(arena const &) = delete;
+		arena(arena &&) = default;
+		arena &operator=(arena const &) = delete;
+		arena &operator=(arena &&) & = default;
+
+		inline void *allocate(std::size_t const size, std::size_t const alignment = alignof(std::max_align_t));
+
+		template <typename t_type>
+		t_type *allocate_array(std::size_t const count) { return static_cast <t_type *>(allocate(count * sizeof(t_type), alignof(t_type))); }
+
+		inline std::string_view copy(std::string_view const sv);
+
+		// Invalidate all allocations but keep the blocks.
+		void release() { m_block_idx = 0; m_offset = 0; m_bytes_used = 0; }
+
+		// Invalidate all allocations and free the blocks.
+		void clear() { m_blocks.clear(); release(); }
+
+		std::size_t bytes_used() const { return m_bytes_used; }
+		std::size_t block_count() const { return m_blocks.size(); }
+		inline std::size_t capacity() const;
+
+	protected:
+		void *allocate_slow(std::size_t const size, std::size_t const alignment);
+	};
+
+
+	// Allocator for standard containers. deallocate() is a no-op, so the memory is reclaimed only
+	// when the arena is released.
+	template <typename t_type>
+	struct arena_allocator
+	{
+		template <typename>
+		friend struct arena_allocator;
+
+		typedef t_type		value_type;
+		typedef value_type	*pointer;
+		typedef std::size_t	size_type;
+
+	protected:
+		arena	*m_arena{};
+
+	public:
+		explicit arena_allocator(arena &arena_): m_arena(&arena_) {}
+
+		template <typename t_other_type>
+		arena_allocator(arena_allocator <t_other_type> const &other): m_arena(other.m_arena) {}
+
+		pointer allocate(size_type const size) { return m_arena->template allocate_array <t_type>(size); }
+		void deallocate(pointer, size_type) {}
+
+		template <typename t_other_type>
+		bool operator==(arena_allocator <t_other_type> const &other) const { return m_arena == other.m_arena; }
+	};
+
+
+	void *arena::allocate(std::size_t const size, std::size_t const alignment)
+	{
+		libbio_assert_eq(0, alignment & (alignment - 1));
+		if (m_block_idx < m_blocks.size())
+		{
+			auto &blk(m_blocks[m_block_idx]);
+			auto const start(reinterpret_cast <std::uintptr_t>(blk.data.get()));
+			auto const aligned_offset(((start + m_offset + alignment - 1) & ~(alignment - 1)) - start);
+			if (aligned_offset + size <= blk.size)
+			{
+				m_offset = aligned_offset + size;
+				m_bytes_used += size;
+				return blk.data.get() + aligned_offset;
+			}
+		}
+
+		return allocate_slow(size, alignment);
+	}
+
+
+	std::string_view arena::copy(std::string_view const sv)
+	{
+		if (sv.empty())
+			return {};
+
+		auto *dst(allocate_array <char>(sv.size()));
+		std::memcpy(dst, sv.data(), sv.size());
+		return {dst, sv.size()};
+	}
+
+
+	std::size_t arena::capacity() const
+	{
+		std::size_t retval{};
+		for (auto const &blk : m_blocks)
+			retval += blk.size;
+		return retval;
+	}
+}
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_ARROW_ARRAY_BUILDER_HH
+#define LIBBIO_ARROW_ARRAY_BUILDER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/arrow/record_batch.hh>
+#include <libbio/assert.hh>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace libbio::arrow {
+
+	// Bit-packed booleans in LSB order, used for validity bitmaps and for Bool values.
+	class bitmap_builder
+	{
+	protected:
+		std::vector <std::uint8_t>	m_bytes;
+		std::size_t					m_size{};
+		std::size_t					m_unset_count{};
+
+	public:
+		inline void push_back(bool const value);
+
+		std::size_t size() const { return m_size; }
+		std::size_t unset_count() const { return m_unset_count; }
+		std::span <std::uint8_t const> bytes() const { return m_bytes; }
+		void clear() { m_bytes.clear(); m_size = 0; m_unset_count = 0; }
+	};
+
+
+	// Base class for the column builders. output() adds the field nodes and the buffers
+	// of the column and its children to a record batch in depth-first order.
+	class array_builder
+	{
+	protected:
+		bitmap_builder	m_validity;
+
+	public:
+		virtual ~array_builder() {}
+
+		std::size_t length() const { return m_validity.size(); }
+		std::size_t null_count() const { return m_validity.unset_count(); }
+
+		virtual void append_null() = 0;
+		virtual void describe(field &dst) const = 0;	// Set the type and the children.
+		virtual void output(record_batch &dst) const = 0;
+		virtual void clear() = 0;
+
+	protected:
+		inline void output_validity(record_batch &dst) const;
+	};
+
+
+	// Integer and floating point values.
+	template <typename t_value>
+	class primitive_builder final : public array_builder
+	{
+		static_assert(std::is_arithmetic_v <t_value>);
+
+	protected:
+		std::vector <t_value>	m_values;
+
+	public:
+		void append(t_value const val) { m_values.push_back(val); m_validity.push_back(true); }
+		void append_null() override { m_values.emplace_back(); m_validity.push_back(false); }
+		inline void describe(field &dst) const override;
+		void output(record_batch &dst) const override { output_validity(dst); dst.add_buffer(std::span(m_values)); }
+		void clear() override { m_values.clear(); m_validity.clear(); }
+	};
+
+
+	class boolean_builder final : public array_builder
+	{
+	protected:
+		bitmap_builder	m_values;
+
+	public:
+		void append(bool const val) { m_values.push_back(val); m_validity.push_back(true); }
+		void append_null() override { m_values.push_back(false); m_validity.push_back(false); }
+		void describe(field &dst) const override { dst.type = type_id::BOOL; }
+		void output(record_batch &dst) const override { output_validity(dst); dst.add_buffer(m_values.bytes()); }
+		void clear() override { m_values.clear(); m_validity.clear(); }
+	};
+
+
+	class utf8_builder final : public array_builder
+	{
+	protected:
+		std::vector <std::int32_t>	m_offsets{0};
+		std::string					m_data;
+
+	public:
+		void append(std::string_view const sv) { m_data += sv; finish_item(true); }
+		void append_null() override { finish_item(false); }
+
+		// Add characters to the current value and finish it with finish_item().
+		std::string &data() { return m_data; }
+		inline void finish_item(bool const is_valid);
+
+		void describe(field &dst) const override { dst.type = type_id::UTF8; }
+		inline void output(record_batch &dst) const override;
+		void clear() override { m_offsets.resize(1); m_data.clear(); m_validity.clear(); }
+	};
+
+
+	// Variable-length lists; add the values to child() and call finish_item().
+	template <typename t_child>
+	class list_builder final : public array_builder
+	{
+	protected:
+		std::vector <std::int32_t>	m_offsets{0};
+		t_child						m_child;
+
+	public:
+		t_child &child() { return m_child; }
+		void finish_item() { push_offset(); m_validity.push_back(true); }
+		void append_null() override { push_offset(); m_validity.push_back(false); }
+		inline void describe(field &dst) const override;
+		inline void output(record_batch &dst) const override;
+		void clear() override { m_offsets.resize(1); m_child.clear(); m_validity.clear(); }
+
+	protected:
+		inline void push_offset();
+	};
+
+
+	// Lists of list_size values; add the values to child() and call finish_item().
+	template <typename t_child>
+	class fixed_size_list_builder final : public array_builder
+	{
+	protected:
+		t_child			m_child;
+		std::int32_t	m_list_size{};
+
+	public:
+		explicit fixed_size_list_builder(std::int32_t const list_size):
+			m_list_size(list_size)
+		{
+		}
+
+		t_child &child() { return m_child; }
+		std::int32_t list_size() const { return m_list_size; }
+		void finish_item() { m_validity.push_back(true); libbio_assert_eq(m_child.length(), m_list_size * length()); }
+		inline void append_null() override;
+		inline void describe(field &dst) const override;
+		inline void output(record_batch &dst) const override;
+		void clear() override { m_child.clear(); m_validity.clear(); }
+	};
+
+
+	void bitmap_builder::push_back(bool const value)
+	{
+		if (0 == m_size % 8)
+			m_bytes.push_back(0);
+
+		if (value)
+			m_bytes.back() |= std::uint8_t(1) << (m_size % 8);
+		else
+			++m_unset_count;
+
+		++m_size;
+	}
+
+
+	void array_builder::output_validity(record_batch &dst) const
+	{
+		// The validity bitmap may be omitted if there are no nulls.
+		dst.add_node(length(), null_count());
+		if (null_count())
+			dst.add_buffer(m_validity.bytes());
+		else
+			dst.add_buffer(std::span <std::byte const>{});
+	}
+
+
+	template <typename t_value>
+	void primitive_builder <t_value>::describe(field &dst) const
+	{
+		if constexpr (std::is_floating_point_v <t_value>)
+		{
+			static_assert(4 == sizeof(t_value) || 8 == sizeof(t_value));
+			dst.type = type_id::FLOATING_POINT;
+			dst.precision = (4 == sizeof(t_value) ? float_precision::SINGLE : float_precision::DOUBLE);
+		}
+		else
+		{
+			dst.type = type_id::INT;
+			dst.bit_width = 8 * sizeof(t_value);
+			dst.is_signed = std::is_signed_v <t_value>;
+		}
+	}
+
+
+	void utf8_builder::finish_item(bool const is_valid)
+	{
+		// The offsets are 32-bit in the Utf8 type; the batch needs to be written before they overflow.
+		libbio_always_assert_lte(m_data.size(), INT32_MAX, "Too many characters in a UTF-8 column");
+		m_offsets.push_back(m_data.size());
+		m_validity.push_back(is_valid);
+	}
+
+
+	void utf8_builder::output(record_batch &dst) const
+	{
+		output_validity(dst);
+		dst.add_buffer(std::span(m_offsets));
+		dst.add_buffer(std::span(m_data));
+	}
+
+
+	template <typename t_child>
+	void list_builder <t_child>::push_offset()
+	{
+		libbio_always_assert_lte(m_child.length(), INT32_MAX, "Too many values in a list column");
+		m_offsets.push_back(m_child.length());
+	}
+
+
+	template <typename t_child>
+	void list_builder <t_child>::describe(field &dst) const
+	{
+		dst.type = type_id::LIST;
+		auto &child(dst.children.emplace_back());
+		child.name = "item";
+		m_child.describe(child);
+	}
+
+
+	template <typename t_child>
+	void list_builder <t_child>::output(record_batch &dst) const
+	{
+		output_validity(dst);
+		dst.add_buffer(std::span(m_offsets));
+		m_child.output(dst);
+	}
+
+
+	template <typename t_child>
+	void fixed_size_list_builder <t_child>::append_null()
+	{
+		for (std::int32_t i{}; i < m_list_size; ++i)
+			m_child.append_null();
+		m_validity.push_back(false);
+	}
+
+
+	template <typename t_child>
+	void fixed_size_list_builder <t_child>::describe(field &dst) const
+	{
+		dst.type = type_id::FIXED_SIZE_LIST;
+		dst.list_size = m_list_size;
+		auto &child(dst.children.emplace_back());
+		child.name = "item";
+		m_child.describe(child);
+	}
+
+
+	template <typename t_child>
+	void fixed_size_list_builder <t_child>::output(record_batch &dst) const
+	{
+		output_validity(dst);
+		m_child.output(dst);
+	}
+}
+
+#endif
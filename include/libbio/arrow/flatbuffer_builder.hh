@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_ARROW_FLATBUFFER_BUILDER_HH
+#define LIBBIO_ARROW_FLATBUFFER_BUILDER_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace libbio::arrow {
+
+	// Minimal FlatBuffers encoder for writing the Arrow IPC metadata without a dependency on the FlatBuffers
+	// library. As in the reference implementation, the buffer is filled from the end, so that the objects
+	// referred to by an offset have already been written when the offset is added. Positions are stored as
+	// distances from the end of the buffer. Identical vtables are written only once.
+	class flatbuffer_builder
+	{
+	public:
+		typedef std::uint32_t	offset_type;
+		typedef std::span <std::byte const>	byte_span;
+
+	protected:
+		typedef std::pair <std::uint16_t, offset_type>	field_position;	// Field identifier, position.
+
+	protected:
+		std::vector <std::byte>			m_buffer;		// The contents are in the last m_size bytes.
+		std::vector <field_position>	m_fields;		// Fields of the current table.
+		std::vector <offset_type>		m_vtables;		// Positions of the vtables written so far.
+		std::size_t						m_size{};
+		std::size_t						m_min_alignment{1};
+		offset_type						m_table_start{};
+
+	public:
+		// Contents of the finished buffer.
+		byte_span data() const { return {m_buffer.data() + m_buffer.size() - m_size, m_size}; }
+		std::size_t size() const { return m_size; }
+		void clear() { m_size = 0; m_min_alignment = 1; m_fields.clear(); m_vtables.clear(); }
+
+		// Prepend a scalar without alignment. Used for vector contents.
+		template <typename t_type>
+		void push(t_type const val);
+
+		// Add padding s.t. the buffer is aligned after prepending length bytes.
+		inline void pre_align(std::size_t const length, std::size_t const alignment);
+		void align(std::size_t const alignment) { pre_align(0, alignment); }
+
+		offset_type create_string(std::string_view const sv);
+		offset_type create_offset_vector(std::span <offset_type const> const offsets);
+
+		// Vectors of scalars and structs; push the elements in reverse order between the calls.
+		void start_vector(std::size_t const count, std::size_t const element_size, std::size_t const alignment);
+		offset_type end_vector(std::size_t const count);
+
+		void start_table();
+		offset_type end_table();
+
+		template <typename t_type>
+		void add_field(std::uint16_t const field_id, t_type const val);
+		void add_offset_field(std::uint16_t const field_id, offset_type const offset);
+
+		// Add the root table offset.
+		void finish(offset_type const root);
+
+	protected:
+		std::byte *make_space(std::size_t const length);
+		std::byte *at(offset_type const pos) { return m_buffer.data() + m_buffer.size() - pos; }
+		offset_type refer_to(offset_type const offset);
+		offset_type deduplicate_vtable(std::uint16_t const vtable_size);
+	};
+
+
+	template <typename t_type>
+	void store_le(std::byte *dst, t_type const val)
+	{
+		static_assert(std::is_trivially_copyable_v <t_type>);
+		auto const bytes(std::bit_cast <std::array <std::byte, sizeof(t_type)>>(val));
+		if constexpr (std::endian::little == std::endian::native)
+			std::copy(bytes.begin(), bytes.end(), dst);
+		else
+			std::reverse_copy(bytes.begin(), bytes.end(), dst);
+	}
+
+
+	template <typename t_type>
+	void flatbuffer_builder::push(t_type const val)
+	{
+		store_le(make_space(sizeof(t_type)), val);
+	}
+
+
+	void flatbuffer_builder::pre_align(std::size_t const length, std::size_t const alignment)
+	{
+		libbio_assert(std::has_single_bit(alignment));
+		m_min_alignment = std::max(m_min_alignment, alignment);
+		auto const padding((~(m_size + length) + 1) & (alignment - 1));
+		std::fill_n(make_space(padding), padding, std::byte{});
+	}
+
+
+	template <typename t_type>
+	void flatbuffer_builder::add_field(std::uint16_t const field_id, t_type const val)
+	{
+		align(sizeof(t_type));
+		push(val);
+		m_fields.emplace_back(field_id, m_size);
+	}
+}
+
+#endif
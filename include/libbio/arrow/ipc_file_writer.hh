@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_ARROW_IPC_FILE_WRITER_HH
+#define LIBBIO_ARROW_IPC_FILE_WRITER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/arrow/flatbuffer_builder.hh>
+#include <libbio/arrow/record_batch.hh>
+#include <ostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace libbio::arrow {
+
+	// Writes the Arrow IPC file format (Arrow columnar format, version 1.0, metadata version V5):
+	// the schema, the dictionary and record batch messages and the footer.
+	// Dictionary batches may be written after the record batches that use them.
+	class ipc_file_writer
+	{
+	public:
+		typedef std::vector <std::pair <std::string, std::string>>	key_value_vector;
+
+	protected:
+		struct block
+		{
+			std::int64_t	offset{};
+			std::int32_t	metadata_length{};
+			std::int64_t	body_length{};
+		};
+
+		typedef std::vector <block>	block_vector;
+
+	protected:
+		std::ostream		*m_stream{};
+		field_vector		m_schema;
+		key_value_vector	m_schema_metadata;
+		block_vector		m_dictionary_blocks;
+		block_vector		m_record_batch_blocks;
+		flatbuffer_builder	m_builder;
+		std::uint64_t		m_offset{};
+
+	public:
+		ipc_file_writer() = default;
+
+		explicit ipc_file_writer(std::ostream &stream):
+			m_stream(&stream)
+		{
+		}
+
+		void set_stream(std::ostream &stream) { m_stream = &stream; }
+
+		// Write the magic string and the schema with optional custom metadata.
+		void write_schema(field_vector schema, key_value_vector metadata = {});
+		void write_dictionary_batch(std::int64_t const id, record_batch const &batch);
+		void write_record_batch(record_batch const &batch);
+
+		// Write the end-of-stream marker and the footer.
+		void finish();
+
+		std::uint64_t bytes_written() const { return m_offset; }
+
+	protected:
+		void write(std::span <std::byte const> const bytes);
+		block write_message(std::span <std::byte const> const body);
+	};
+}
+
+#endif
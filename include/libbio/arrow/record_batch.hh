@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_ARROW_RECORD_BATCH_HH
+#define LIBBIO_ARROW_RECORD_BATCH_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace libbio::arrow {
+
+	// Subset of the Arrow types, values from Schema.fbs.
+	enum class type_id : std::uint8_t
+	{
+		INT				= 2,
+		FLOATING_POINT	= 3,
+		UTF8			= 5,
+		BOOL			= 6,
+		LIST			= 12,
+		FIXED_SIZE_LIST	= 16
+	};
+
+
+	enum class float_precision : std::int16_t
+	{
+		HALF	= 0,
+		SINGLE	= 1,
+		DOUBLE	= 2
+	};
+
+
+	// Field of a schema.
+	struct field
+	{
+		std::string				name;
+		std::vector <field>		children;
+		type_id					type{};
+		std::int32_t			bit_width{};			// INT
+		bool					is_signed{};			// INT
+		float_precision			precision{};			// FLOATING_POINT
+		std::int32_t			list_size{};			// FIXED_SIZE_LIST
+		std::int64_t			dictionary_id{-1};		// If non-negative, the values are dictionary indices of type Int32.
+		bool					nullable{true};
+	};
+
+	typedef std::vector <field>	field_vector;
+
+
+	struct field_node
+	{
+		std::int64_t	length{};
+		std::int64_t	null_count{};
+	};
+
+
+	struct buffer_ref
+	{
+		std::int64_t	offset{};
+		std::int64_t	length{};
+	};
+
+
+	// The field nodes and the buffers of one record batch in depth-first order, and the message body.
+	class record_batch
+	{
+	public:
+		constexpr static inline std::size_t const BUFFER_ALIGNMENT{8};
+
+	protected:
+		std::vector <field_node>	m_nodes;
+		std::vector <buffer_ref>	m_buffers;
+		std::vector <std::byte>		m_body;
+		std::int64_t				m_length{};
+
+	public:
+		std::int64_t length() const { return m_length; }
+		std::vector <field_node> const &nodes() const { return m_nodes; }
+		std::vector <buffer_ref> const &buffers() const { return m_buffers; }
+		std::vector <std::byte> const &body() const { return m_body; }
+
+		void set_length(std::int64_t const length) { m_length = length; }
+		void add_node(std::int64_t const length, std::int64_t const null_count) { m_nodes.emplace_back(length, null_count); }
+		inline void add_buffer(std::span <std::byte const> const bytes);
+
+		template <typename t_type>
+		void add_buffer(std::span <t_type const> const values) { add_buffer(std::as_bytes(values)); }
+
+		void clear() { m_nodes.clear(); m_buffers.clear(); m_body.clear(); m_length = 0; }
+	};
+
+
+	void record_batch::add_buffer(std::span <std::byte const> const bytes)
+	{
+		// Pad each buffer to the alignment.
+		auto const offset(m_body.size());
+		m_buffers.emplace_back(offset, bytes.size());
+		m_body.insert(m_body.end(), bytes.begin(), bytes.end());
+		m_body.resize(m_body.size() + ((~m_body.size() + 1) & (BUFFER_ALIGNMENT - 1)));
+	}
+}
+
+#endif
@@ -40,6 +40,7 @@ namespace libbio::bam::fields::detail {
 		static inline decltype(auto) start_array(sam::optional_field &of, sam::tag_type const tag_id) { return of.start_array <t_type>(tag_id); }
 
 		static inline std::string &start_string(sam::optional_field &of, sam::tag_type const tag_id) { return of.start_string(tag_id); }
+		static inline void finish(sam::optional_field &of) { of.rebuild_tag_index(); }
 	};
 
 
@@ -84,6 +85,10 @@ namespace libbio::bam::fields {
 	{
 		template <binary_parsing::endian t_order>
 		void read_value(binary_parsing::range &rr, std::vector <sam::cigar_run> &dst) const;
+
+		// Calculates the alignment geometry in the same pass.
+		template <binary_parsing::endian t_order>
+		void read_value(binary_parsing::range &rr, std::vector <sam::cigar_run> &dst, sam::alignment_geometry &geometry) const;
 	};
 
 
@@ -118,6 +123,16 @@ namespace libbio::bam::fields {
 	template <binary_parsing::endian t_order>
 	void cigar <t_mem>::read_value(binary_parsing::range &rr, std::vector <sam::cigar_run> &dst) const
 	{
+		sam::alignment_geometry geometry;
+		read_value <t_order>(rr, dst, geometry);
+	}
+
+
+	template <binary_parsing::data_member t_mem>
+	template <binary_parsing::endian t_order>
+	void cigar <t_mem>::read_value(binary_parsing::range &rr, std::vector <sam::cigar_run> &dst, sam::alignment_geometry &geometry) const
+	{
+		geometry.clear();
 		for (auto &run : dst)
 		{
 			std::uint32_t rep{};
@@ -131,6 +146,7 @@ namespace libbio::bam::fields {
 
 			run.assign(sam::cigar_run::count_type{count});
 			run.assign(sam::cigar_operation(op)); // The order of the operations are the same as in the BAM format, i.e. MIDNSHP=X.
+			geometry.update(run);
 		}
 	}
 
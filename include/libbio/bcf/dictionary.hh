@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BCF_DICTIONARY_HH
+#define LIBBIO_BCF_DICTIONARY_HH
+
+#include <cstddef>
+#include <libbio/vcf/metadata.hh>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio::bcf {
+
+	// The string and contig dictionaries, BCF 2.2 § 6.2.1. The indices are taken from the IDX fields
+	// of the header records if present, otherwise from the order of the records with PASS first.
+	// The identifiers refer to the keys of the metadata maps.
+	class dictionary
+	{
+	public:
+		typedef std::vector <std::string_view>	string_vector;
+
+	protected:
+		string_vector	m_strings;
+		string_vector	m_contigs;
+
+	public:
+		void build(vcf::metadata const &meta);
+
+		string_vector const &strings() const { return m_strings; }
+		string_vector const &contigs() const { return m_contigs; }
+
+		// Empty if the index is not in use.
+		std::string_view string(std::size_t const idx) const { return idx < m_strings.size() ? m_strings[idx] : std::string_view{}; }
+		std::string_view contig(std::size_t const idx) const { return idx < m_contigs.size() ? m_contigs[idx] : std::string_view{}; }
+	};
+}
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BCF_TYPED_VALUE_HH
+#define LIBBIO_BCF_TYPED_VALUE_HH
+
+#include <bit>
+#include <boost/endian.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>							// memcpy
+#include <libbio/binary_parsing/endian.hh>
+#include <libbio/binary_parsing/range.hh>
+#include <libbio/binary_parsing/read_value.hh>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace libbio::bcf {
+
+	// Value types of typed values, BCF 2.2 § 6.3.3.
+	enum class value_type : std::uint8_t
+	{
+		MISSING	= 0,
+		INT8	= 1,
+		INT16	= 2,
+		INT32	= 3,
+		FLOAT	= 5,
+		CHAR	= 7
+	};
+
+
+	// Special values for denoting a missing value and the end of a vector.
+	constexpr inline std::int32_t const INT8_MISSING{INT8_MIN};
+	constexpr inline std::int32_t const INT8_END_OF_VECTOR{INT8_MIN + 1};
+	constexpr inline std::int32_t const INT16_MISSING{INT16_MIN};
+	constexpr inline std::int32_t const INT16_END_OF_VECTOR{INT16_MIN + 1};
+	constexpr inline std::int32_t const INT32_MISSING{INT32_MIN};
+	constexpr inline std::int32_t const INT32_END_OF_VECTOR{INT32_MIN + 1};
+	constexpr inline std::uint32_t const FLOAT_MISSING_BITS{0x7F800001};
+	constexpr inline std::uint32_t const FLOAT_END_OF_VECTOR_BITS{0x7F800002};
+
+	// Count that denotes that the actual count follows as a typed integer.
+	constexpr inline std::uint8_t const OVERFLOW_COUNT{15};
+
+
+	constexpr inline std::size_t value_size(value_type const vt)
+	{
+		switch (vt)
+		{
+			case value_type::MISSING:	return 0;
+			case value_type::INT8:		return 1;
+			case value_type::INT16:		return 2;
+			case value_type::INT32:		return 4;
+			case value_type::FLOAT:		return 4;
+			case value_type::CHAR:		return 1;
+		}
+
+		throw std::runtime_error("Unexpected BCF value type");
+	}
+
+
+	constexpr inline bool is_integer(value_type const vt)
+	{
+		return value_type::INT8 == vt || value_type::INT16 == vt || value_type::INT32 == vt;
+	}
+
+
+	// Non-owning view of a typed value or of one sample’s values in a genotype field.
+	struct typed_value
+	{
+		std::byte const	*data{};
+		std::uint32_t	count{};			// Number of values.
+		value_type		type{};
+
+		std::size_t byte_size() const { return count * value_size(type); }
+
+		// Value of one sample when count values are stored for each sample.
+		typed_value sample(std::size_t const idx) const { return {data + idx * byte_size(), count, type}; }
+
+		inline std::int32_t raw_integer_at(std::size_t const idx) const;	// Includes the special values.
+		inline std::uint32_t raw_float_bits_at(std::size_t const idx) const;
+		inline bool is_missing_at(std::size_t const idx) const;
+		inline bool is_end_of_vector_at(std::size_t const idx) const;
+		inline std::int32_t integer_at(std::size_t const idx) const;
+		inline float float_at(std::size_t const idx) const;
+		inline std::string_view string() const;							// Trailing NUL characters removed.
+
+		// Number of values before the end-of-vector marker.
+		inline std::uint32_t value_count() const;
+
+		// Check whether the whole value has been marked missing, i.e. it is equivalent to “.” in VCF.
+		inline bool is_missing() const;
+	};
+
+
+	// Read a type descriptor byte and the count that may follow it.
+	inline typed_value take_type_descriptor(binary_parsing::range &rr);
+
+	// Read a type descriptor and the values.
+	inline typed_value take_typed_value(binary_parsing::range &rr);
+
+	// Read a typed value that is expected to contain exactly one integer, e.g. an INFO key.
+	inline std::int32_t take_typed_integer(binary_parsing::range &rr);
+
+
+	std::int32_t typed_value::raw_integer_at(std::size_t const idx) const
+	{
+		auto const *ptr(data + idx * value_size(type));
+		switch (type)
+		{
+			case value_type::INT8:
+				return std::int8_t(*ptr);
+
+			case value_type::INT16:
+			{
+				std::int16_t retval{};
+				std::memcpy(&retval, ptr, sizeof(retval));
+				return boost::endian::little_to_native(retval);
+			}
+
+			case value_type::INT32:
+			{
+				std::int32_t retval{};
+				std::memcpy(&retval, ptr, sizeof(retval));
+				return boost::endian::little_to_native(retval);
+			}
+
+			default:
+				throw std::runtime_error("Expected an integer type");
+		}
+	}
+
+
+	std::uint32_t typed_value::raw_float_bits_at(std::size_t const idx) const
+	{
+		if (value_type::FLOAT != type)
+			throw std::runtime_error("Expected a floating point type");
+
+		std::uint32_t retval{};
+		std::memcpy(&retval, data + idx * sizeof(retval), sizeof(retval));
+		return boost::endian::little_to_native(retval);
+	}
+
+
+	bool typed_value::is_missing_at(std::size_t const idx) const
+	{
+		switch (type)
+		{
+			case value_type::MISSING:	return true;
+			case value_type::INT8:		return INT8_MISSING == raw_integer_at(idx);
+			case value_type::INT16:		return INT16_MISSING == raw_integer_at(idx);
+			case value_type::INT32:		return INT32_MISSING == raw_integer_at(idx);
+			case value_type::FLOAT:		return FLOAT_MISSING_BITS == raw_float_bits_at(idx);
+			case value_type::CHAR:		return false;
+		}
+
+		return false;
+	}
+
+
+	bool typed_value::is_end_of_vector_at(std::size_t const idx) const
+	{
+		switch (type)
+		{
+			case value_type::MISSING:	return false;
+			case value_type::INT8:		return INT8_END_OF_VECTOR == raw_integer_at(idx);
+			case value_type::INT16:		return INT16_END_OF_VECTOR == raw_integer_at(idx);
+			case value_type::INT32:		return INT32_END_OF_VECTOR == raw_integer_at(idx);
+			case value_type::FLOAT:		return FLOAT_END_OF_VECTOR_BITS == raw_float_bits_at(idx);
+			case value_type::CHAR:		return false;
+		}
+
+		return false;
+	}
+
+
+	std::int32_t typed_value::integer_at(std::size_t const idx) const
+	{
+		if (value_type::FLOAT == type)
+			return float_at(idx);
+		return raw_integer_at(idx);
+	}
+
+
+	float typed_value::float_at(std::size_t const idx) const
+	{
+		if (is_integer(type))
+			return raw_integer_at(idx);
+		return std::bit_cast <float>(raw_float_bits_at(idx));
+	}
+
+
+	std::string_view typed_value::string() const
+	{
+		if (value_type::CHAR != type)
+			throw std::runtime_error("Expected a character type");
+
+		std::string_view retval(reinterpret_cast <char const *>(data), count);
+		auto const pos(retval.find_last_not_of('\0'));
+		if (std::string_view::npos == pos)
+			return {};
+		return retval.substr(0, 1 + pos);
+	}
+
+
+	std::uint32_t typed_value::value_count() const
+	{
+		if (value_type::CHAR == type)
+			return count;
+
+		std::uint32_t retval{};
+		while (retval < count && !is_end_of_vector_at(retval))
+			++retval;
+		return retval;
+	}
+
+
+	bool typed_value::is_missing() const
+	{
+		if (0 == count || value_type::MISSING == type)
+			return true;
+
+		if (value_type::CHAR == type)
+		{
+			auto const sv(string());
+			return sv.empty() || "." == sv;
+		}
+
+		return is_missing_at(0) && 1 == value_count();
+	}
+
+
+	typed_value take_type_descriptor(binary_parsing::range &rr)
+	{
+		typed_value retval;
+		auto const descriptor(binary_parsing::take <std::uint8_t, binary_parsing::endian::little>(rr));
+		retval.type = static_cast <value_type>(descriptor & 0xF);
+		retval.count = descriptor >> 4;
+		value_size(retval.type); // Check the type.
+
+		if (OVERFLOW_COUNT == retval.count)
+		{
+			auto const count(take_typed_integer(rr));
+			if (count < 0)
+				throw std::runtime_error("Unexpected negative count in BCF typed value");
+			retval.count = count;
+		}
+
+		return retval;
+	}
+
+
+	typed_value take_typed_value(binary_parsing::range &rr)
+	{
+		auto retval(take_type_descriptor(rr));
+		retval.data = rr.it;
+		rr.seek(retval.byte_size());
+		return retval;
+	}
+
+
+	std::int32_t take_typed_integer(binary_parsing::range &rr)
+	{
+		auto const val(take_typed_value(rr));
+		if (! (is_integer(val.type) && 1 == val.count))
+			throw std::runtime_error("Expected a single integer in BCF typed value");
+		return val.raw_integer_at(0);
+	}
+}
+
+#endif
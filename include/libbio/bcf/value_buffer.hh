@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BCF_VALUE_BUFFER_HH
+#define LIBBIO_BCF_VALUE_BUFFER_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/vcf/variant/sample.hh>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace libbio::bcf {
+
+	typedef std::vector <std::byte>	byte_vector;
+
+
+	// Append a type descriptor and the overflow count if needed, BCF 2.2 § 6.3.3.
+	void append_type_descriptor(byte_vector &dst, value_type const vt, std::size_t const count);
+
+	// Append a typed value that consists of one integer with the smallest possible type.
+	void append_typed_integer(byte_vector &dst, std::int32_t const val);
+
+	// Append a character vector. An empty string is encoded as a missing value.
+	void append_typed_string(byte_vector &dst, std::string_view const sv);
+
+	template <std::size_t t_size> struct unsigned_for_size {};
+	template <> struct unsigned_for_size <1> { typedef std::uint8_t type; };
+	template <> struct unsigned_for_size <2> { typedef std::uint16_t type; };
+	template <> struct unsigned_for_size <4> { typedef std::uint32_t type; };
+	template <> struct unsigned_for_size <8> { typedef std::uint64_t type; };
+
+	template <typename t_type>
+	void store_le(std::byte *dst, t_type const val)
+	{
+		auto uval(std::bit_cast <typename unsigned_for_size <sizeof(t_type)>::type>(val));
+		for (std::size_t i{}; i < sizeof(t_type); ++i)
+		{
+			dst[i] = std::byte(uval & 0xff);
+			uval >>= 8;
+		}
+	}
+
+	template <typename t_type>
+	void append_le(byte_vector &dst, t_type const val)
+	{
+		auto const pos(dst.size());
+		dst.resize(pos + sizeof(t_type));
+		store_le(dst.data() + pos, val);
+	}
+
+
+	// Collects the values of one INFO field or of one genotype field in every sample
+	// and encodes them as a typed value with the smallest integer type that fits the values.
+	// The items, i.e. samples, are padded to the same length.
+	class value_buffer
+	{
+	protected:
+		std::vector <std::int32_t>		m_integers;				// INT32_MISSING denotes a missing value.
+		std::vector <std::uint32_t>		m_float_bits;
+		std::string						m_characters;
+		std::vector <std::size_t>		m_item_starts;			// Indices of the first values of the items.
+		std::vector <std::size_t>		m_item_value_counts;
+		value_type						m_type{value_type::MISSING};
+
+	public:
+		// Start collecting the values of the given type, INT32 for any integer type.
+		inline void reset(value_type const vt);
+
+		// Start the next sample.
+		inline void begin_item();
+
+		void add_integer(std::int32_t const val) { libbio_assert_eq(value_type::INT32, m_type); m_integers.push_back(val); count_value(); }
+		void add_float(float const val) { libbio_assert_eq(value_type::FLOAT, m_type); m_float_bits.push_back(std::bit_cast <std::uint32_t>(val)); count_value(); }
+		inline void add_missing();
+		inline void add_string(std::string_view const sv);		// Values in string vectors are separated by commas.
+
+		// Overloads for the value access classes.
+		void add_value(std::int32_t const val) { add_integer(val); }
+		void add_value(float const val) { add_float(val); }
+		void add_value(std::uint8_t const) { /* FLAG, no value. */ }
+		void add_value(std::string_view const sv) { add_string(sv); }
+		void add_value(std::string const &str) { add_string(str); }
+		inline void add_value(vcf::sample_genotype const gt);
+
+		value_type type() const { return m_type; }
+		std::size_t item_count() const { return m_item_starts.size(); }
+
+		// The collected values of all items.
+		std::vector <std::int32_t> const &integers() const { return m_integers; }
+		std::vector <std::uint32_t> const &float_bits() const { return m_float_bits; }
+		std::string const &characters() const { return m_characters; }
+
+		// Append the type descriptor and the values.
+		void output(byte_vector &dst) const;
+
+	protected:
+		void count_value() { libbio_assert(!m_item_value_counts.empty()); ++m_item_value_counts.back(); }
+		std::size_t item_end(std::size_t const idx) const;
+		std::size_t max_item_value_count() const { return m_item_value_counts.empty() ? 0 : *std::max_element(m_item_value_counts.begin(), m_item_value_counts.end()); }
+	};
+
+
+	void value_buffer::reset(value_type const vt)
+	{
+		libbio_assert(value_type::INT8 != vt && value_type::INT16 != vt);
+		m_integers.clear();
+		m_float_bits.clear();
+		m_characters.clear();
+		m_item_starts.clear();
+		m_item_value_counts.clear();
+		m_type = vt;
+	}
+
+
+	void value_buffer::begin_item()
+	{
+		switch (m_type)
+		{
+			case value_type::INT32:
+				m_item_starts.push_back(m_integers.size());
+				break;
+			case value_type::FLOAT:
+				m_item_starts.push_back(m_float_bits.size());
+				break;
+			case value_type::CHAR:
+				m_item_starts.push_back(m_characters.size());
+				break;
+			default:
+				m_item_starts.push_back(0);
+				break;
+		}
+
+		m_item_value_counts.push_back(0);
+	}
+
+
+	void value_buffer::add_missing()
+	{
+		switch (m_type)
+		{
+			case value_type::INT32:
+				m_integers.push_back(INT32_MISSING);
+				break;
+			case value_type::FLOAT:
+				m_float_bits.push_back(FLOAT_MISSING_BITS);
+				break;
+			case value_type::CHAR:
+				m_characters.push_back('.');
+				break;
+			default:
+				break;
+		}
+
+		count_value();
+	}
+
+
+	void value_buffer::add_string(std::string_view const sv)
+	{
+		libbio_assert_eq(value_type::CHAR, m_type);
+		if (m_item_value_counts.back())
+			m_characters.push_back(',');
+		m_characters += sv;
+		count_value();
+	}
+
+
+	void value_buffer::add_value(vcf::sample_genotype const gt)
+	{
+		// BCF 2.2 § 6.3.3. Zero denotes a missing allele.
+		if (vcf::sample_genotype::NULL_ALLELE == gt.alt)
+			add_integer(gt.is_phased);
+		else
+			add_integer(((1 + gt.alt) << 1) | gt.is_phased);
+	}
+}
+
+#endif
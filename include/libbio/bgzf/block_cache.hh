@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BGZF_BLOCK_CACHE_HH
+#define LIBBIO_BGZF_BLOCK_CACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/bgzf/deflate_decompressor.hh>
+#include <libbio/bgzf/gzi_index.hh>
+#include <span>
+#include <vector>
+
+
+namespace libbio::bgzf {
+
+	// Decompresses BGZF blocks on demand and keeps the most recently used ones.
+	// Not thread-safe; the returned spans are valid until the next call to block_containing().
+	class block_cache
+	{
+	public:
+		struct cached_block
+		{
+			std::vector <std::byte>	data;
+			std::uint64_t			compressed_offset{UINT64_MAX};
+			std::uint64_t			uncompressed_offset{};
+			std::uint64_t			last_used{};
+		};
+
+	protected:
+		std::span <std::byte const>			m_compressed_data;
+		gzi_index const						*m_index{};
+		detail::deflate_decompressor		m_decompressor;
+		std::vector <cached_block>			m_blocks;
+		std::uint64_t						m_time{};
+		std::uint64_t						m_hits{};
+		std::uint64_t						m_misses{};
+
+	protected:
+		void decompress(gzi_index::entry const &entry, cached_block &dst);
+
+	public:
+		block_cache() = default;
+		block_cache(std::span <std::byte const> compressed_data, gzi_index const &index, std::size_t const capacity = 4);
+
+		// Return the cached block that contains the given uncompressed offset.
+		cached_block const &block_containing(std::uint64_t const uncompressed_offset);
+
+		std::uint64_t hits() const { return m_hits; }
+		std::uint64_t misses() const { return m_misses; }
+	};
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BGZF_DEFLATE_COMPRESSOR_HH
+#define LIBBIO_BGZF_DEFLATE_COMPRESSOR_HH
+
+#include <cstddef>
+#include <libdeflate.h>
+#include <span>
+
+
+namespace libbio::bgzf::detail {
+
+	struct deflate_compressor
+	{
+		struct libdeflate_compressor	*compressor{};
+
+		~deflate_compressor() { libdeflate_free_compressor(compressor); }
+		void prepare(int const compression_level) { compressor = libdeflate_alloc_compressor(compression_level); }
+
+		// Compress in to a BGZF block including the header and the footer. Returns the written part of out.
+		std::span <std::byte> compress_block(std::span <std::byte const> in, std::span <std::byte> out);
+	};
+}
+
+#endif
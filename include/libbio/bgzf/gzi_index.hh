@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BGZF_GZI_INDEX_HH
+#define LIBBIO_BGZF_GZI_INDEX_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+
+namespace libbio::bgzf {
+
+	// Maps the uncompressed offsets to the BGZF blocks as in bgzip’s .gzi files.
+	class gzi_index
+	{
+	public:
+		struct entry
+		{
+			std::uint64_t	compressed_offset{};
+			std::uint64_t	uncompressed_offset{};
+		};
+
+		typedef std::vector <entry>	entry_vector;
+
+	protected:
+		entry_vector	m_entries{entry{}};	// Including the first block unlike the file.
+
+	public:
+		// Index the blocks of a BGZF file.
+		void build(std::span <std::byte const> compressed_data);
+
+		// Read or write the little-endian .gzi format.
+		void read(std::istream &is);
+		void write(std::ostream &os) const;
+
+		entry_vector const &entries() const { return m_entries; }
+		void clear() { m_entries.assign(1, entry{}); }
+
+		// Block that contains the given uncompressed offset.
+		entry const &find(std::uint64_t const uncompressed_offset) const;
+	};
+}
+
+#endif
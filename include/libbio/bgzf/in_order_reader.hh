@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BGZF_IN_ORDER_READER_HH
+#define LIBBIO_BGZF_IN_ORDER_READER_HH
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/streaming_reader.hh>
+#include <libbio/dispatch/group.hh>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/file_handle.hh>
+#include <mutex>
+#include <semaphore>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace libbio::bgzf {
+
+	// Reads a BGZF-compressed file sequentially. The blocks are decompressed in parallel with streaming_reader,
+	// which is run in a separate thread after input has been requested for the first time.
+	// The decompressed blocks are returned in order; the number of blocks that have been
+	// decompressed but not yet consumed is limited by a semaphore.
+	class in_order_reader final : public reading_handle, public streaming_reader_delegate
+	{
+	public:
+		typedef streaming_reader::output_buffer_type		buffer_type;
+		typedef std::span <std::byte const>					byte_span;
+
+	private:
+		typedef std::counting_semaphore <UINT16_MAX>		semaphore_type;
+
+		struct block
+		{
+			std::size_t	index{};
+			buffer_type	data;
+
+			block(std::size_t const index_, buffer_type &&data_):
+				index(index_),
+				data(std::move(data_))
+			{
+			}
+
+			constexpr bool operator>(block const &other) const { return index > other.index; }
+		};
+
+		typedef std::vector <block>							block_vector;
+		typedef std::vector <buffer_type>					buffer_vector;
+
+	private:
+		dispatch::group					m_group;
+		semaphore_type					m_semaphore;
+		streaming_reader				m_bgzf_reader;
+		std::thread						m_thread;
+		dispatch::parallel_queue		*m_queue{};
+
+		std::mutex						m_mutex;							// Protects the variables below.
+		std::condition_variable			m_cv;
+		block_vector					m_pending_blocks;					// Min-heap by block index.
+		buffer_vector					m_free_buffers;
+		std::exception_ptr				m_exception;
+		bool							m_did_finish{};
+		bool							m_is_stopping{};
+
+		// Accessed only from the consumer’s thread.
+		buffer_type						m_current_block;
+		std::size_t						m_current_block_offset{};			// For read().
+		std::size_t						m_next_block_index{};
+		bool							m_holds_block{};
+		bool							m_has_started{};
+
+	public:
+		constexpr static inline std::size_t const DEFAULT_MAX_PENDING_BLOCKS{256};
+
+		explicit in_order_reader(
+			reading_handle &handle,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			std::size_t const max_pending_blocks = DEFAULT_MAX_PENDING_BLOCKS,
+			dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			m_semaphore(std::min <std::size_t>(max_pending_blocks, semaphore_type::max())),
+			m_bgzf_reader(handle, task_count, m_group, &m_semaphore, *this),
+			m_queue(&queue)
+		{
+			libbio_always_assert_lt(0, max_pending_blocks);
+		}
+
+		~in_order_reader();
+
+		// Set block to the next decompressed block or return false on EOF.
+		// The block is valid until the next call.
+		bool next_block(byte_span &block);
+
+		using reading_handle::read;
+
+		// Copy the decompressed data.
+		std::size_t read(std::size_t const len, std::byte *dst) override;
+		std::size_t io_op_blocksize() const override { return streaming_reader::block_size; }
+
+		void stop();
+
+		void streaming_reader_did_decompress_block(
+			streaming_reader &reader,
+			std::size_t block_index,
+			buffer_type &buffer
+		) override;
+
+	private:
+		void start();
+		void release_current_block();
+	};
+}
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef LIBBIO_BGZF_STREAMING_READER_HH
 #define LIBBIO_BGZF_STREAMING_READER_HH
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <libbio/assert.hh>
@@ -100,10 +101,11 @@ namespace libbio::bgzf {
 		offset_vector									m_released_offsets;
 		offset_vector									m_offset_buffer;
 		semaphore_type									*m_semaphore{};
-		file_handle										*m_handle{};
+		reading_handle									*m_handle{};
 		dispatch::group									*m_group{};
 		streaming_reader_delegate						*m_delegate{};
 		std::mutex										m_released_offsets_mutex{};
+		std::atomic_bool								m_should_stop{};
 
 	private:
 		static std::size_t page_count_for_buffer(std::size_t task_count) { return bits::gte_power_of_2_((task_count * block_size / circular_buffer::page_size()) ?: 1); }
@@ -111,7 +113,7 @@ namespace libbio::bgzf {
 
 	public:
 		streaming_reader(
-			file_handle &handle,
+			reading_handle &handle,
 			std::size_t const task_count,							// (Likely) need to be less than the maximum number of threads to avoid deadlocks.
 			std::size_t const buffer_count,
 			dispatch::group &group,
@@ -136,7 +138,7 @@ namespace libbio::bgzf {
 		}
 
 		streaming_reader(
-			file_handle &handle,
+			reading_handle &handle,
 			std::size_t const task_count,
 			dispatch::group &group,
 			semaphore_type *semaphore,								// Optional
@@ -147,7 +149,7 @@ namespace libbio::bgzf {
 		}
 
 		streaming_reader(
-			file_handle &handle,
+			reading_handle &handle,
 			dispatch::group &group,
 			semaphore_type *semaphore,								// Optional
 			streaming_reader_delegate &delegate
@@ -159,6 +161,11 @@ namespace libbio::bgzf {
 		void run(dispatch::queue &queue = dispatch::parallel_queue::shared_queue());
 		void read_first_block(dispatch::queue &queue = dispatch::parallel_queue::shared_queue());
 		void return_output_buffer(output_buffer_type &buffer);
+
+		// Make run() return after starting the current decompression task. The tasks that have already been
+		// started will be completed and passed to the delegate.
+		void stop() { m_should_stop.store(true, std::memory_order_release); }
+		bool is_stopped() const { return m_should_stop.load(std::memory_order_acquire); }
 	};
 }
 
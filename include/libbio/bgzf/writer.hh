@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_BGZF_WRITER_HH
+#define LIBBIO_BGZF_WRITER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <libbio/bgzf/deflate_compressor.hh>
+#include <libbio/bounded_mpmc_queue.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/file_handle.hh>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>								// std::thread::hardware_concurrency()
+#include <vector>
+
+
+namespace libbio::bgzf {
+
+	class writer;
+}
+
+
+namespace libbio::bgzf::detail {
+
+	struct writer_compression_task
+	{
+		typedef std::vector <std::byte>	buffer_type;
+
+		deflate_compressor				compressor;
+		buffer_type						input;
+		buffer_type						output;
+		std::span <std::byte const>		compressed_block;
+		bgzf::writer					*bgzf_writer{};
+		std::size_t						block_index{};
+
+		void prepare(int const compression_level);
+		void run();
+		void operator()() { run(); }
+	};
+}
+
+
+namespace libbio::bgzf {
+
+	/*
+	 * Write BGZF blocks.
+	 *
+	 * The input is collected into blocks, which are compressed in worker threads. The compressed
+	 * blocks are written to the output in order by one worker thread at a time without holding
+	 * the mutex, so that the other workers need not wait for the I/O. The number
+	 * of blocks in flight is limited by the number of tasks; write() blocks when all of them are in use.
+	 */
+	class writer
+	{
+		typedef detail::writer_compression_task			compression_task;
+		typedef bounded_mpmc_queue <compression_task>	task_queue_type;
+		typedef std::vector <compression_task *>		task_ptr_vector;
+
+		friend compression_task;
+
+	public:
+		constexpr static std::size_t const max_input_size{0xff00};		// As in HTSlib.
+		constexpr static std::size_t const max_block_size{0x10000};
+		constexpr static int const default_compression_level{6};
+
+	private:
+		task_queue_type									m_task_queue;
+		dispatch::group									m_group;
+		file_handle										*m_handle{};
+		dispatch::queue									*m_queue{};
+		compression_task								*m_current_task{};
+		std::size_t										m_next_block_index{};
+		task_ptr_vector									m_ready_tasks;			// Only accessed by the writing thread.
+
+		std::mutex										m_mutex;				// Protects the variables below.
+		task_ptr_vector									m_finished_tasks;		// Min-heap by block index.
+		std::size_t										m_next_written_block_index{};
+		std::exception_ptr								m_exception;
+		bool											m_is_writing{};
+
+	private:
+		void compression_task_did_finish(compression_task &task, std::exception_ptr exc);
+		void write_block(std::span <std::byte const> block);
+		void rethrow_exception_if_needed();
+
+	public:
+		writer(
+			file_handle &handle,
+			std::size_t const task_count,					// (Likely) need to be less than the maximum number of threads to avoid deadlocks.
+			int const compression_level = default_compression_level,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		);
+
+		explicit writer(file_handle &handle):
+			writer(handle, std::thread::hardware_concurrency() ?: 1)
+		{
+		}
+
+		~writer();
+
+		void write(std::span <std::byte const> data);
+		void write(std::string_view const sv) { write(std::as_bytes(std::span{sv.data(), sv.size()})); }
+
+		// Start a new block, e.g. to make a virtual offset point to the beginning of a block.
+		void flush_block();
+
+		// Write the remaining data and the EOF marker block.
+		void finish();
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_DECOMPRESSING_READING_HANDLE_HH
+#define LIBBIO_DECOMPRESSING_READING_HANDLE_HH
+
+#include <array>
+#include <cstddef>
+#include <libbio/assert.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/gzip_read_handle.hh>
+#include <memory>
+#include <span>
+#include <string>
+
+
+namespace libbio::bgzf {
+	class in_order_reader;
+}
+
+
+namespace libbio {
+
+	// Returns the bytes that were read for detecting the file type before the rest of the input.
+	// Used instead of pread() s.t. pipes and the standard input can be read, too.
+	class prefix_reading_handle final : public reading_handle
+	{
+	public:
+		constexpr static inline std::size_t const PREFIX_SIZE{16};
+
+	private:
+		std::array <std::byte, PREFIX_SIZE>	m_prefix{};
+		reading_handle						*m_handle{}; // Not owned.
+		std::size_t							m_prefix_size{};
+		std::size_t							m_prefix_pos{};
+
+	public:
+		// Read at most PREFIX_SIZE bytes from handle and return them.
+		std::span <std::byte const> read_prefix(reading_handle &handle);
+
+		using reading_handle::read;
+
+		std::size_t read(std::size_t const len, std::byte *dst) override;
+		std::size_t io_op_blocksize() const override { libbio_assert(m_handle); return m_handle->io_op_blocksize(); }
+	};
+
+
+	// Reads a file that may be gzip or BGZF compressed. The compression is detected from the beginning of the file.
+	// BGZF blocks are decompressed in parallel with bgzf::in_order_reader.
+	class decompressing_reading_handle final : public reading_handle
+	{
+	public:
+		enum class compression_type
+		{
+			none,
+			gzip,
+			bgzf
+		};
+
+		// bgzf::in_order_reader is incomplete here, which avoids depending on libdeflate.
+		struct bgzf_reader_deleter
+		{
+			void operator()(bgzf::in_order_reader *reader) const;
+		};
+
+		typedef std::unique_ptr <bgzf::in_order_reader, bgzf_reader_deleter>	bgzf_reader_ptr;
+
+	private:
+		file_handle				m_handle;
+		prefix_reading_handle	m_prefix_handle;	// Reads from m_handle.
+		gzip_reading_handle		m_gzip_handle;
+		bgzf_reader_ptr			m_bgzf_reader;		// Destroyed before m_handle.
+		reading_handle			*m_reading_handle{};
+		compression_type		m_compression{compression_type::none};
+		bool					m_has_prepared_gzip_handle{};
+
+	private:
+		void prepare_gzip_handle();
+
+	public:
+		decompressing_reading_handle() = default;
+
+		explicit decompressing_reading_handle(std::string const &path)
+		{
+			open(path);
+		}
+
+		decompressing_reading_handle(decompressing_reading_handle const &) = delete;
+		decompressing_reading_handle &operator=(decompressing_reading_handle const &) = delete;
+
+		using reading_handle::read;
+
+		void open(std::string const &path); // throws
+		void open(file_handle &&handle);
+		compression_type compression() const { return m_compression; }
+
+		std::size_t read(std::size_t const len, std::byte *dst) override { libbio_assert(m_reading_handle); return m_reading_handle->read(len, dst); }
+		std::size_t io_op_blocksize() const override { libbio_assert(m_reading_handle); return m_reading_handle->io_op_blocksize(); }
+	};
+}
+
+#endif
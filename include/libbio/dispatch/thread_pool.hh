@@ -46,7 +46,8 @@ namespace libbio::dispatch {
 		std::condition_variable			m_cv{};										// For pausing the workers.
 		std::condition_variable			m_stop_cv{};								// For stopping the thread pool.
 		std::shared_mutex				m_queue_mutex{};							// Protects m_queues
-		std::mutex						m_mutex{};									// Protects m_waiting_tasks, m_current_workers, m_idle_workers, m_should_continue.
+		std::mutex						m_mutex{};									// Protects m_waiting_tasks, m_current_workers, m_idle_workers, m_has_unclaimed_tasks, m_should_continue.
+		bool							m_has_unclaimed_tasks{};					// Set when a task was added while all the workers were busy.
 		bool							m_should_continue{true};
 
 	private:
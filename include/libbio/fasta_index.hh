@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_FASTA_INDEX_HH
+#define LIBBIO_FASTA_INDEX_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <libbio/utility/compare_strings_transparent.hh>
+#include <libbio/utility/string_hash.hh>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace libbio {
+
+	// One line of a samtools faidx-compatible (.fai) index.
+	struct fasta_index_entry
+	{
+		std::string		name;
+		std::uint64_t	length{};		// Number of bases.
+		std::uint64_t	offset{};		// Byte offset of the first base.
+		std::uint32_t	line_bases{};	// Number of bases per line.
+		std::uint32_t	line_width{};	// Number of bytes per line including the newline.
+
+		// Byte offset of the given 0-based position.
+		std::uint64_t position_offset(std::uint64_t const pos) const { return offset + pos / line_bases * line_width + pos % line_bases; }
+	};
+
+
+	// Checks the line lengths of one sequence as in samtools faidx: all lines except the last one need
+	// to have the same length, and the last one may not be longer. Empty lines are allowed only at the end.
+	class fasta_line_length_checker
+	{
+	protected:
+		bool	m_has_short_line{};
+
+	public:
+		void reset() { m_has_short_line = false; }
+
+		// Sets the entry’s line lengths from the first non-empty line. Returns false if the line breaks the rule.
+		bool add_line(fasta_index_entry &entry, std::uint64_t const bases, std::uint64_t const width);
+	};
+
+
+	class fasta_index;
+
+
+	// Builds a fasta_index from FASTA text that is passed in arbitrary chunks, e.g. decompressed blocks.
+	// Every sequence needs a name, so text before the first header is an error.
+	class fasta_index_builder
+	{
+	protected:
+		fasta_index			*m_index{};
+		fasta_index_entry			m_entry;
+		std::string					m_partial_line;		// Incomplete line from the previous chunk.
+		fasta_line_length_checker	m_line_lengths;
+		std::uint64_t				m_line_offset{};	// Offset of the next line.
+		bool						m_in_sequence{};
+
+	protected:
+		void add_line(std::string_view line, std::uint32_t const width);
+
+	public:
+		explicit fasta_index_builder(fasta_index &index);
+
+		void add(std::string_view chunk);
+		void finish();
+	};
+
+
+	class fasta_index
+	{
+		friend fasta_index_builder;
+
+	public:
+		typedef std::vector <fasta_index_entry>	entry_vector;
+
+	protected:
+		typedef std::unordered_map <
+			std::string,
+			std::size_t,
+			libbio::string_hash_transparent,
+			libbio::string_equal_to_transparent
+		>										index_map;
+
+	protected:
+		entry_vector	m_entries;			// In file order.
+		index_map		m_entry_indices;	// By name.
+
+	protected:
+		void add_entry(fasta_index_entry &&entry);
+
+	public:
+		// Index the contents of a FASTA file. All lines of a sequence except the last one need to have
+		// the same length. Throws std::runtime_error otherwise.
+		void build(std::string_view const content);
+
+		// Read or write the tab-separated .fai format.
+		void read(std::istream &is);
+		void write(std::ostream &os) const;
+
+		entry_vector const &entries() const { return m_entries; }
+		std::size_t size() const { return m_entries.size(); }
+		bool empty() const { return m_entries.empty(); }
+		void clear() { m_entries.clear(); m_entry_indices.clear(); }
+
+		// Returns nullptr if not found.
+		fasta_index_entry const *find(std::string_view const name) const;
+	};
+}
+
+#endif
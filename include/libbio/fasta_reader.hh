@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <libbio/fasta_index.hh>
 #include <libbio/file_handle.hh>
 #include <libbio/sequence_reader.hh>
 #include <libbio/utility/variable_guard.hh>
@@ -23,6 +24,8 @@ namespace libbio {
 	class fasta_reader_base;
 
 
+	// If fasta_reader_base::strips_newlines() is set, handle_sequence_chunk() is called with has_newline = false
+	// for each contiguous part of the sequence in the read buffer, instead of once per line.
 	struct fasta_reader_delegate
 	{
 		virtual ~fasta_reader_delegate() {}
@@ -65,6 +68,21 @@ namespace libbio {
 			}
 		};
 
+		// State for parsing with the newline characters removed.
+		struct newline_stripping_state
+		{
+			fasta_index_entry			index_entry;
+			std::vector <char>			sequence_buffer;
+			fasta_line_length_checker	line_lengths;
+			std::uint64_t				buffer_offset{};		// File offset of m_buffer[0].
+			std::size_t					buffer_position{};		// Next unhandled character in m_buffer.
+			std::uint64_t				line_length{};			// Length of the current line so far.
+			char						previous_character{};
+			bool						at_line_start{true};
+			bool						in_sequence{};
+			bool						has_uniform_line_lengths{true};
+		};
+
 		// Try to save a bit of memory, as well as memory accesses.
 		union string_view_placeholder
 		{
@@ -85,17 +103,36 @@ namespace libbio {
 		std::vector <string_view_placeholder>	m_extra_fields;
 		std::vector <char>						m_buffer;
 		fsm										m_fsm;
+		newline_stripping_state					m_newline_stripping_state;
 		fasta_reader_delegate					*m_delegate{};
+		bool									m_strips_newlines{};
 
 	protected:
 		virtual void report_unexpected_character(int current_state) const = 0;
 		virtual void report_unexpected_eof(int current_state) const = 0;
 
+		parsing_status parse_stripping_newlines_(handle_type &handle, std::size_t blocksize);
+		parsing_status handle_header_line(char const *line_start, char const *line_end);
+		char const *handle_sequence_lines(char const *start, char const *end);
+		void update_line_lengths(std::uint64_t const bases, std::uint64_t const width);
+		void finish_sequence_lines();
+
 	public:
 		virtual ~fasta_reader_base() {}
 
 		void set_delegate(fasta_reader_delegate &delegate) { m_delegate = &delegate; }
 
+		// Pass the sequences to the delegate in buffer-sized chunks without the newline characters. The sequence
+		// characters are not validated in this mode. Needs to be set before prepare() or parse().
+		void set_strips_newlines(bool const value) { m_strips_newlines = value; }
+		bool strips_newlines() const { return m_strips_newlines; }
+
+		// The faidx entry of the current sequence, valid in handle_sequence_end() when stripping newlines.
+		// The line lengths are valid for faidx if has_uniform_line_lengths() returns true.
+		// Unlike fasta_index_builder, the reader accepts a sequence without a header; its entry has an empty name.
+		fasta_index_entry const &index_entry() const { return m_newline_stripping_state.index_entry; }
+		bool has_uniform_line_lengths() const { return m_newline_stripping_state.has_uniform_line_lengths; }
+
 		parsing_status parse(handle_type &handle, std::size_t blocksize) final;
 		parsing_status parse(handle_type &handle, fasta_reader_delegate &delegate, std::size_t blocksize) { variable_guard gg{m_delegate, delegate}; return parse(handle, blocksize);; }
 		parsing_status parse(handle_type &handle, fasta_reader_delegate &delegate) { return parse(handle, delegate, handle.io_op_blocksize()); }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_FASTQ_QC_HH
+#define LIBBIO_FASTQ_QC_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/accumulator/mean.hh>
+#include <libbio/accumulator/sum.hh>
+#include <libbio/assert.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio {
+
+	// FastQC-style statistics of FASTQ records. The counts are updated one record at a time; partial statistics,
+	// e.g. ones collected in different threads, may be combined with pairwise_update() as with the accumulators.
+	// The sequence and the quality strings are scanned with Highway if LIBBIO_ENABLE_HIGHWAY is set.
+	class fastq_qc_statistics
+	{
+	public:
+		typedef std::vector <std::uint64_t>		count_vector;
+		typedef std::span <std::uint64_t const>	count_span;
+
+		constexpr static inline std::uint8_t const DEFAULT_QUALITY_OFFSET{33};
+		constexpr static inline std::size_t const QUALITY_VALUE_COUNT{94};	// From ! to ~ with the default offset.
+		constexpr static inline std::size_t const GC_PERCENTAGE_COUNT{101};
+
+	protected:
+		count_vector						m_position_quality_counts;	// QUALITY_VALUE_COUNT values for each position.
+		count_vector						m_position_n_counts;
+		count_vector						m_length_counts;
+		count_vector						m_mean_quality_counts{count_vector(QUALITY_VALUE_COUNT, 0)};	// Truncated.
+		count_vector						m_gc_percentage_counts{count_vector(GC_PERCENTAGE_COUNT, 0)};	// Rounded.
+		accumulators::mean <double>			m_mean_quality;
+		accumulators::sum <std::uint64_t>	m_base_count;
+		accumulators::sum <std::uint64_t>	m_gc_count;
+		accumulators::sum <std::uint64_t>	m_n_count;
+		std::uint64_t						m_read_count{};
+		std::uint8_t						m_quality_offset{DEFAULT_QUALITY_OFFSET};
+
+	protected:
+		void reserve_positions(std::size_t const length);
+
+	public:
+		fastq_qc_statistics() = default;
+
+		explicit fastq_qc_statistics(std::uint8_t const quality_offset):
+			m_quality_offset(quality_offset)
+		{
+		}
+
+		// Throws std::runtime_error without changing the statistics if the lengths do not match or the quality string has characters out of range.
+		void update(std::string_view const sequence, std::string_view const quality);
+		void update(fastq_record_view const &rec) { update(rec.sequence, rec.quality); }
+		void pairwise_update(fastq_qc_statistics const &other);
+
+		std::uint8_t quality_offset() const { return m_quality_offset; }
+		std::uint64_t read_count() const { return m_read_count; }
+		std::uint64_t base_count() const { return m_base_count.value(); }
+		std::uint64_t gc_count() const { return m_gc_count.value(); }
+		std::uint64_t n_count() const { return m_n_count.value(); }
+		double mean_quality() const { return m_mean_quality.value(); } // Mean of the per-read means.
+		std::size_t max_length() const { return m_position_n_counts.size(); }
+
+		// Indexed by the quality value (without the offset), the length or the percentage.
+		inline count_span position_quality_counts(std::size_t const pos) const;
+		count_span position_n_counts() const { return m_position_n_counts; }
+		count_span length_counts() const { return m_length_counts; }
+		count_span mean_quality_counts() const { return m_mean_quality_counts; }
+		count_span gc_percentage_counts() const { return m_gc_percentage_counts; }
+	};
+
+
+	// Collect the statistics with parallel_fastq_reader::parse_unordered(). The worker threads update
+	// a pool of partial statistics, which are combined at the end.
+	fastq_qc_statistics collect_fastq_qc_statistics(
+		parallel_fastq_reader &reader,
+		std::uint8_t const quality_offset = fastq_qc_statistics::DEFAULT_QUALITY_OFFSET,
+		dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue()
+	);
+
+
+	auto fastq_qc_statistics::position_quality_counts(std::size_t const pos) const -> count_span
+	{
+		libbio_assert_lt(pos, max_length());
+		return count_span(m_position_quality_counts.data() + pos * QUALITY_VALUE_COUNT, QUALITY_VALUE_COUNT);
+	}
+}
+
+#endif
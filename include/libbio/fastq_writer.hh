@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_FASTQ_WRITER_HH
+#define LIBBIO_FASTQ_WRITER_HH
+
+#include <cstddef>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/writer.hh>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <libbio/sequence_batch_reader.hh>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace libbio {
+
+	// Writes a BGZF-compressed FASTQ file, which can be read with gzip. The records are formatted
+	// in the caller’s thread into a buffer that is passed to bgzf::writer in large chunks, and the
+	// blocks are compressed in parallel.
+	class fastq_writer
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_BUFFER_SIZE{16 * bgzf::writer::max_input_size};
+
+	protected:
+		bgzf::writer		m_writer;
+		std::vector <char>	m_buffer;
+		std::size_t			m_buffer_size{DEFAULT_BUFFER_SIZE};
+
+	protected:
+		inline void append(std::string_view const sv);
+
+	public:
+		explicit fastq_writer(
+			file_handle &handle,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			int const compression_level = bgzf::writer::default_compression_level,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			m_writer(handle, task_count, compression_level, queue)
+		{
+			m_buffer.reserve(m_buffer_size);
+		}
+
+		void set_buffer_size(std::size_t const size) { libbio_always_assert_lt(0, size); m_buffer_size = size; }
+
+		// The identifier should not include the @. Throws std::runtime_error if the lengths of
+		// the sequence and the quality string do not match.
+		inline void write(std::string_view const identifier, std::string_view const sequence, std::string_view const quality);
+		void write(fastq_record_view const &rec) { write(rec.identifier, rec.sequence, rec.quality); }
+		inline void write(std::span <fastq_record_view const> const records);
+		inline void write(sequence_record_batch const &batch);
+
+		// Pass the buffered records to the compressor.
+		inline void flush();
+
+		// Write the remaining data and the EOF marker block.
+		void finish() { flush(); m_writer.finish(); }
+	};
+
+
+	void fastq_writer::append(std::string_view const sv)
+	{
+		m_buffer.insert(m_buffer.end(), sv.begin(), sv.end());
+	}
+
+
+	void fastq_writer::write(std::string_view const identifier, std::string_view const sequence, std::string_view const quality)
+	{
+		if (sequence.size() != quality.size())
+			throw std::runtime_error("Sequence and quality lengths do not match");
+
+		m_buffer.push_back('@');
+		append(identifier);
+		m_buffer.push_back('\n');
+		append(sequence);
+		append("\n+\n");
+		append(quality);
+		m_buffer.push_back('\n');
+
+		if (m_buffer_size <= m_buffer.size())
+			flush();
+	}
+
+
+	void fastq_writer::write(std::span <fastq_record_view const> const records)
+	{
+		for (auto const &rec : records)
+			write(rec);
+	}
+
+
+	void fastq_writer::write(sequence_record_batch const &batch)
+	{
+		for (std::size_t i{}; i < batch.size(); ++i)
+			write(batch.identifier(i), batch.sequence(i), batch.quality(i));
+	}
+
+
+	void fastq_writer::flush()
+	{
+		m_writer.write(std::string_view{m_buffer.data(), m_buffer.size()});
+		m_buffer.clear();
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_HASH_COUNTER_HH
+#define LIBBIO_HASH_COUNTER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/dispatch.hh>
+#include <mutex>
+#include <span>
+#include <vector>
+
+
+namespace libbio {
+
+	struct hash_count
+	{
+		std::uint64_t	hash{};
+		std::uint64_t	count{};
+
+		constexpr bool operator==(hash_count const &) const = default;
+	};
+
+
+	// Counts hash values, e.g. from kmer_extractor or minimizer_extractor, in parallel. The values are
+	// radix-partitioned by their most significant bits, and the partitions are sorted independently.
+	// add() may be called from multiple threads; hash_buffer may be used to collect the values in each thread.
+	class hash_counter
+	{
+		friend class hash_buffer;
+
+	public:
+		typedef std::vector <std::uint64_t>	hash_vector;
+		typedef std::vector <std::size_t>	offset_vector;
+		typedef std::vector <hash_count>	count_vector;
+
+		constexpr static inline std::uint8_t const DEFAULT_PARTITION_BITS{8};
+
+	protected:
+		struct partition
+		{
+			std::mutex	mutex;
+			hash_vector	hashes;
+		};
+
+	protected:
+		std::vector <partition>	m_partitions;
+		std::uint8_t			m_hash_bits{};
+		std::uint8_t			m_partition_bits{};
+
+	protected:
+		std::size_t partition_index(std::uint64_t const hash) const { return (hash >> (m_hash_bits - m_partition_bits)) & (m_partitions.size() - 1); }
+		void add(std::span <std::uint64_t const> const hashes, hash_vector &buffer, offset_vector &offsets);
+
+	public:
+		// The hashes are assumed to be less than 2^hash_bits, e.g. 2k bits for k-mers.
+		explicit hash_counter(std::uint8_t const hash_bits = 64, std::uint8_t const partition_bits = DEFAULT_PARTITION_BITS):
+			m_partitions(std::size_t(1) << partition_bits),
+			m_hash_bits(hash_bits),
+			m_partition_bits(partition_bits)
+		{
+			libbio_always_assert_lte(hash_bits, 64);
+			libbio_always_assert_lt(0, partition_bits);
+			libbio_always_assert_lte(partition_bits, hash_bits);
+			libbio_always_assert_lte(partition_bits, 24);
+		}
+
+		void add(std::span <std::uint64_t const> const hashes) { hash_vector buffer; offset_vector offsets; add(hashes, buffer, offsets); }
+
+		// Count the added hashes in parallel and return the counts sorted by the hash value. The added hashes are removed.
+		count_vector count(dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue());
+	};
+
+
+	// Per-thread buffer for hash_counter.
+	class hash_buffer
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_CAPACITY{1024 * 1024};
+
+	protected:
+		hash_counter				*m_counter{};
+		hash_counter::hash_vector	m_hashes;
+		hash_counter::hash_vector	m_partitioned_hashes;
+		hash_counter::offset_vector	m_offsets;
+		std::size_t					m_capacity{};
+
+	public:
+		explicit hash_buffer(hash_counter &counter, std::size_t const capacity = DEFAULT_CAPACITY):
+			m_counter(&counter),
+			m_capacity(capacity)
+		{
+			libbio_always_assert_lt(0, capacity);
+			m_hashes.reserve(capacity);
+		}
+
+		void push_back(std::uint64_t const hash) { m_hashes.push_back(hash); if (m_capacity == m_hashes.size()) flush(); }
+
+		// Needs to be called before counting.
+		void flush() { m_counter->add(m_hashes, m_partitioned_hashes, m_offsets); m_hashes.clear(); }
+	};
+}
+
+#endif
@@ -50,6 +50,7 @@ namespace libbio {
 			constexpr bool is_handling_remaining() const { return false; }
 			HWY_ATTR auto set(value_type val) const { return hwy_apply::set(val); }
 			HWY_ATTR auto load(value_type const *src) const { return hwy::HWY_NAMESPACE::Load(dd, src + ii); }
+			HWY_ATTR auto load_u(value_type const *src) const { return hwy::HWY_NAMESPACE::LoadU(dd, src + ii); }
 			HWY_ATTR void store(vector_type const vec, value_type *dst) const { hwy_apply::store_(vec, dst + ii); }
 			HWY_ATTR void store_(vector_type const vec, value_type *dst) const { hwy_apply::store_(vec, dst); }
 			HWY_ATTR void store_unaligned(vector_type const vec, value_type *dst) const { hwy_apply::store_unaligned_(vec, dst + ii); }
@@ -73,9 +74,10 @@ namespace libbio {
 			constexpr bool is_handling_remaining() const { return true; }
 			HWY_ATTR auto set(value_type val) const { return hwy_apply::set(val); }
 			HWY_ATTR auto load(value_type const *src) const { return hwy::HWY_NAMESPACE::LoadN(dd, src + ii, remaining); }
+			HWY_ATTR auto load_u(value_type const *src) const { return hwy::HWY_NAMESPACE::LoadN(dd, src + ii, remaining); } // LoadN does not require alignment.
 			HWY_ATTR void store(vector_type const vec, value_type *dst) const { hwy::HWY_NAMESPACE::StoreN(vec, dd, dst + ii, remaining); }
 			HWY_ATTR void store_(vector_type const vec, value_type *dst) const { hwy::HWY_NAMESPACE::StoreN(vec, dd, dst, remaining); }
-			HWY_ATTR void store_unaligned(vector_type const vec, value_type *dst) const { hwy::HWY_NAMESPACE::StoreN(vec, dd + ii, dst, remaining); }
+			HWY_ATTR void store_unaligned(vector_type const vec, value_type *dst) const { hwy::HWY_NAMESPACE::StoreN(vec, dd, dst + ii, remaining); }
 			HWY_ATTR void store_unaligned_(vector_type const vec, value_type *dst) const { hwy::HWY_NAMESPACE::StoreN(vec, dd, dst, remaining); }
 		};
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_INDEXED_FASTA_HH
+#define LIBBIO_INDEXED_FASTA_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <libbio/bgzf/gzi_index.hh>
+#include <libbio/fasta_index.hh>
+#include <libbio/mmap_file_handle.hh>
+#include <memory>
+#include <string>
+#include <string_view>
+
+
+namespace libbio::bgzf {
+	class block_cache;
+}
+
+
+namespace libbio {
+
+	// Random access to the sequences of a memory-mapped FASTA file with a .fai index.
+	// Fetching a subsequence takes one memory copy per line of the range.
+	// BGZF-compressed files (bgzip) are read with a .gzi index by decompressing only the blocks
+	// that contain the requested range. The most recently used blocks are cached, which makes
+	// the compressed case not thread-safe even though the member functions are const.
+	class indexed_fasta
+	{
+	public:
+		// bgzf::block_cache is incomplete here.
+		struct block_cache_deleter
+		{
+			void operator()(bgzf::block_cache *cache) const;
+		};
+
+		typedef std::unique_ptr <bgzf::block_cache, block_cache_deleter>	block_cache_ptr;
+
+	protected:
+		mmap_file_handle <char>	m_handle;
+		fasta_index				m_index;
+		bgzf::gzi_index			m_gzi_index;
+		block_cache_ptr			m_block_cache;	// Non-null iff. the file is compressed.
+
+	protected:
+		inline void check_range(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t &end) const;
+		bool prepare_compressed(std::string const &path);
+		void build_index();
+		void check_index() const;
+		std::uint64_t uncompressed_size() const;
+		void copy_compressed(std::uint64_t offset, std::uint64_t count, std::string &dst) const;
+
+	public:
+		// Use path.fai (and path.gzi for bgzipped files) if it exists, otherwise build the index.
+		void open(std::string const &path);
+		void open(std::string const &path, fasta_index &&index);
+		void close();
+
+		bool is_compressed() const { return bool(m_block_cache); }
+		bgzf::gzi_index const &gzi_index() const { return m_gzi_index; }
+		bgzf::block_cache const *block_cache() const { return m_block_cache.get(); }
+
+		fasta_index const &index() const { return m_index; }
+		fasta_index_entry const *find(std::string_view const name) const { return m_index.find(name); }
+
+		// Copy the bases in the half-open 0-based range [begin, end) without the newlines to dst.
+		// The range is clamped to the length of the sequence. Return false if the sequence is not found.
+		bool subsequence(std::string_view const name, std::uint64_t const begin, std::uint64_t const end, std::string &dst) const;
+		void subsequence(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t end, std::string &dst) const;
+
+		// Return a view to the mapped file if the range does not span multiple lines, otherwise an empty view.
+		// In the compressed case, the range also needs to be contained in one BGZF block and the view is
+		// valid until the next call.
+		std::string_view subsequence_view(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t end) const;
+	};
+
+
+	void indexed_fasta::check_range(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t &end) const
+	{
+		end = std::min(end, entry.length);
+		if (end < begin)
+			end = begin;
+	}
+}
+
+#endif
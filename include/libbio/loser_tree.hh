@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_LOSER_TREE_HH
+#define LIBBIO_LOSER_TREE_HH
+
+#include <cstddef>
+#include <functional>
+#include <libbio/assert.hh>
+#include <utility>
+#include <vector>
+
+
+namespace libbio {
+
+	// Tree of losers for k-way merging (Knuth, TAOCP Vol. 3, § 5.4.1). The internal nodes store the source
+	// that lost the comparison at the node, so replacing the key of the winner takes ⌈log₂ k⌉ comparisons
+	// along one path. Ties are broken by the source index, which makes the merge stable.
+	template <typename t_key, typename t_cmp = std::less <t_key>>
+	class loser_tree
+	{
+	public:
+		typedef t_key		key_type;
+		typedef t_cmp		key_compare;
+
+	protected:
+		std::vector <key_type>		m_keys;			// By source.
+		std::vector <bool>			m_is_exhausted;	// By source.
+		std::vector <std::size_t>	m_losers;		// m_losers[0] is the winner, leaf of source i is k + i.
+		key_compare					m_cmp;
+
+	public:
+		loser_tree() = default;
+
+		explicit loser_tree(std::size_t const source_count, key_compare cmp = key_compare()):
+			m_keys(source_count),
+			m_is_exhausted(source_count, true),
+			m_losers(source_count, 0),
+			m_cmp(std::move(cmp))
+		{
+		}
+
+		std::size_t source_count() const { return m_keys.size(); }
+
+		// Set the initial keys, then call build().
+		void set_key(std::size_t const source, key_type key) { m_keys[source] = std::move(key); m_is_exhausted[source] = false; }
+		void build();
+
+		bool empty() const { return m_keys.empty() || m_is_exhausted[winner()]; }
+		std::size_t winner() const { libbio_assert(!m_losers.empty()); return m_losers[0]; }
+		key_type const &winner_key() const { libbio_assert(!empty()); return m_keys[winner()]; }
+
+		// Replace the key of the winner or mark its source exhausted and determine the new winner.
+		void replace_winner(key_type key) { set_key(winner(), std::move(key)); replay(winner()); }
+		void remove_winner() { m_is_exhausted[winner()] = true; replay(winner()); }
+
+	protected:
+		inline bool beats(std::size_t const lhs, std::size_t const rhs) const;
+		inline void replay(std::size_t source);
+	};
+
+
+	template <typename t_key, typename t_cmp>
+	bool loser_tree <t_key, t_cmp>::beats(std::size_t const lhs, std::size_t const rhs) const
+	{
+		if (m_is_exhausted[lhs])
+			return false;
+		if (m_is_exhausted[rhs])
+			return true;
+		if (m_cmp(m_keys[lhs], m_keys[rhs]))
+			return true;
+		if (m_cmp(m_keys[rhs], m_keys[lhs]))
+			return false;
+		return lhs < rhs;
+	}
+
+
+	template <typename t_key, typename t_cmp>
+	void loser_tree <t_key, t_cmp>::build()
+	{
+		// Determine the winners of the subtrees bottom-up and store the losers.
+		auto const count(m_keys.size());
+		if (!count)
+			return;
+
+		std::vector <std::size_t> winners(2 * count);
+		for (std::size_t i{}; i < count; ++i)
+			winners[count + i] = i;
+
+		for (std::size_t node(count - 1); 0 < node; --node)
+		{
+			auto const lhs(winners[2 * node]);
+			auto const rhs(winners[2 * node + 1]);
+			if (beats(lhs, rhs))
+			{
+				winners[node] = lhs;
+				m_losers[node] = rhs;
+			}
+			else
+			{
+				winners[node] = rhs;
+				m_losers[node] = lhs;
+			}
+		}
+
+		m_losers[0] = (1 == count ? 0 : winners[1]);
+	}
+
+
+	template <typename t_key, typename t_cmp>
+	void loser_tree <t_key, t_cmp>::replay(std::size_t source)
+	{
+		// Compare with the stored losers on the path from the leaf to the root.
+		for (auto node((m_keys.size() + source) / 2); 0 < node; node /= 2)
+		{
+			if (beats(m_losers[node], source))
+				std::swap(m_losers[node], source);
+		}
+
+		m_losers[0] = source;
+	}
+}
+
+#endif
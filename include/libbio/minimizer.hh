@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_MINIMIZER_HH
+#define LIBBIO_MINIMIZER_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio::detail {
+
+	constexpr inline std::uint8_t const DNA_CODE_INVALID{0xff};
+
+	// A, C, G, T to 0, 1, 2, 3 in either case.
+	constexpr inline auto const DNA_CODES([]{
+		std::array <std::uint8_t, 256> retval{};
+		std::fill(retval.begin(), retval.end(), DNA_CODE_INVALID);
+		constexpr std::array const bases{'A', 'C', 'G', 'T'};
+		for (std::uint8_t i{}; i < 4; ++i)
+		{
+			retval[bases[i]] = i;
+			retval[bases[i] | 0x20] = i;
+		}
+		return retval;
+	}());
+}
+
+
+namespace libbio {
+
+	// Invertible hash for values in [0, mask]; from minimap2 (Li H., Bioinformatics 2018).
+	constexpr inline std::uint64_t kmer_hash(std::uint64_t key, std::uint64_t const mask)
+	{
+		key = (~key + (key << 21)) & mask;
+		key = key ^ key >> 24;
+		key = ((key + (key << 3)) + (key << 8)) & mask;
+		key = key ^ key >> 14;
+		key = ((key + (key << 2)) + (key << 4)) & mask;
+		key = key ^ key >> 28;
+		key = (key + (key << 31)) & mask;
+		return key;
+	}
+
+
+	// Rolling two-bit encoding of canonical k-mers, i.e. the smaller of the k-mer and its reverse complement.
+	// The sequence may be passed in chunks, e.g. lines from fasta_reader_delegate::handle_sequence_chunk();
+	// k-mers with characters other than A, C, G and T are skipped.
+	class kmer_extractor
+	{
+	protected:
+		std::uint64_t	m_mask{};
+		std::uint64_t	m_forward{};
+		std::uint64_t	m_reverse{};
+		std::uint64_t	m_position{};		// Number of characters since reset().
+		std::uint8_t	m_k{};
+		std::uint8_t	m_length{};			// Length of the current run of bases, up to k.
+
+	public:
+		constexpr static inline std::uint8_t const MAX_K{32};
+
+		kmer_extractor() = default;
+
+		explicit kmer_extractor(std::uint8_t const k):
+			m_mask(k == MAX_K ? UINT64_MAX : (std::uint64_t(1) << (2 * k)) - 1),
+			m_k(k)
+		{
+			libbio_always_assert_lt(0, k);
+			libbio_always_assert_lte(k, MAX_K);
+		}
+
+		std::uint8_t k() const { return m_k; }
+		std::uint64_t mask() const { return m_mask; }
+		void reset() { m_forward = 0; m_reverse = 0; m_position = 0; m_length = 0; }
+
+		// Call fn(position, kmer) for each k-mer that ends in the chunk.
+		template <typename t_fn>
+		inline void update(std::string_view const chunk, t_fn &&fn);
+
+		template <typename t_fn>
+		void extract(std::string_view const seq, t_fn &&fn) { reset(); update(seq, fn); }
+	};
+
+
+	// (w, k)-minimizers, i.e. the k-mers with the smallest hash value in each window of w consecutive k-mers.
+	// The leftmost one is chosen in case of ties, and each minimizer is reported once. The window minima are
+	// maintained in a monotone deque stored as power-of-two ring buffers of hashes and positions.
+	class minimizer_extractor
+	{
+	protected:
+		kmer_extractor				m_kmers;
+		std::vector <std::uint64_t>	m_hashes;
+		std::vector <std::uint64_t>	m_positions;
+		std::uint64_t				m_ring_mask{};
+		std::uint64_t				m_head{};
+		std::uint64_t				m_tail{};
+		std::uint64_t				m_run_start{};				// Position of the first k-mer in the current run.
+		std::uint64_t				m_previous_position{};
+		std::uint64_t				m_last_reported_position{};
+		std::uint32_t				m_w{};
+		bool						m_has_kmers{};
+		bool						m_has_reported{};
+
+	public:
+		minimizer_extractor() = default;
+
+		minimizer_extractor(std::uint32_t const w, std::uint8_t const k):
+			m_kmers(k),
+			m_hashes(std::bit_ceil(w), 0),
+			m_positions(std::bit_ceil(w), 0),
+			m_ring_mask(std::bit_ceil(w) - 1),
+			m_w(w)
+		{
+			libbio_always_assert_lt(0, w);
+		}
+
+		std::uint32_t w() const { return m_w; }
+		std::uint8_t k() const { return m_kmers.k(); }
+		void reset() { m_kmers.reset(); m_head = 0; m_tail = 0; m_has_kmers = false; m_has_reported = false; }
+
+		// Call fn(position, hash) for each new minimizer. The hash can be inverted to get the canonical k-mer.
+		template <typename t_fn>
+		inline void update(std::string_view const chunk, t_fn &&fn);
+
+		template <typename t_fn>
+		void extract(std::string_view const seq, t_fn &&fn) { reset(); update(seq, fn); }
+	};
+
+
+	template <typename t_fn>
+	void kmer_extractor::update(std::string_view const chunk, t_fn &&fn)
+	{
+		auto const shift(2 * (m_k - 1));
+		for (auto const cc : chunk)
+		{
+			auto const code(detail::DNA_CODES[std::uint8_t(cc)]);
+			if (detail::DNA_CODE_INVALID == code)
+			{
+				m_forward = 0;
+				m_reverse = 0;
+				m_length = 0;
+			}
+			else
+			{
+				m_forward = ((m_forward << 2) | code) & m_mask;
+				m_reverse = (m_reverse >> 2) | (std::uint64_t(3 - code) << shift);
+				if (m_length < m_k)
+					++m_length;
+				if (m_length == m_k)
+					fn(m_position + 1 - m_k, std::min(m_forward, m_reverse));
+			}
+
+			++m_position;
+		}
+	}
+
+
+	template <typename t_fn>
+	void minimizer_extractor::update(std::string_view const chunk, t_fn &&fn)
+	{
+		m_kmers.update(chunk, [this, &fn](std::uint64_t const pos, std::uint64_t const kmer){
+			auto const hash(kmer_hash(kmer, m_kmers.mask()));
+
+			// Start a new run after a character that is not a base.
+			if (!m_has_kmers || pos != m_previous_position + 1)
+			{
+				m_head = m_tail;
+				m_run_start = pos;
+				m_has_kmers = true;
+			}
+			m_previous_position = pos;
+
+			// Remove the expired positions from the front and the larger hashes from the back.
+			// The deque then has space for the new k-mer.
+			while (m_head != m_tail && m_positions[m_head & m_ring_mask] + m_w <= pos)
+				++m_head;
+			while (m_head != m_tail && hash < m_hashes[(m_tail - 1) & m_ring_mask])
+				--m_tail;
+
+			libbio_assert_lt(m_tail - m_head, m_hashes.size());
+			m_hashes[m_tail & m_ring_mask] = hash;
+			m_positions[m_tail & m_ring_mask] = pos;
+			++m_tail;
+
+			// Report once the first window is complete.
+			if (m_run_start + m_w - 1 <= pos)
+			{
+				auto const min_pos(m_positions[m_head & m_ring_mask]);
+				if (!m_has_reported || min_pos != m_last_reported_position)
+				{
+					fn(min_pos, m_hashes[m_head & m_ring_mask]);
+					m_last_reported_position = min_pos;
+					m_has_reported = true;
+				}
+			}
+		});
+	}
+}
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_PACKED_SEQUENCE_STORE_HH
+#define LIBBIO_PACKED_SEQUENCE_STORE_HH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/int_vector.hh>
+#include <libbio/mmap_file_handle.hh>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace libbio {
+
+	// The positions are global, i.e. they include the contig’s base_offset.
+	struct packed_sequence_contig
+	{
+		std::uint64_t	base_offset{};
+		std::uint64_t	length{};
+		std::uint64_t	ambiguity_run_begin{};
+		std::uint64_t	ambiguity_run_end{};
+		std::uint64_t	mask_run_begin{};
+		std::uint64_t	mask_run_end{};
+		std::uint64_t	name_offset{};
+		std::uint64_t	name_length{};
+	};
+
+
+	// Run of N or some other character that cannot be represented with two bits.
+	struct packed_sequence_ambiguity_run
+	{
+		std::uint64_t			position{};
+		std::uint32_t			length{};
+		char					character{};	// Upper case.
+		std::array <char, 3>	padding{};		// Explicit s.t. write_mappable() does not write indeterminate bytes.
+	};
+
+
+	// Run of lower case (soft-masked) characters.
+	struct packed_sequence_mask_run
+	{
+		std::uint64_t	position{};
+		std::uint64_t	length{};
+	};
+
+	// The records are written as is by write_mappable(), so they may not have implicit padding.
+	static_assert(std::is_trivially_copyable_v <packed_sequence_contig>);
+	static_assert(std::is_trivially_copyable_v <packed_sequence_ambiguity_run>);
+	static_assert(std::is_trivially_copyable_v <packed_sequence_mask_run>);
+	static_assert(std::has_unique_object_representations_v <packed_sequence_contig>);
+	static_assert(std::has_unique_object_representations_v <packed_sequence_ambiguity_run>);
+	static_assert(std::has_unique_object_representations_v <packed_sequence_mask_run>);
+
+
+	// Read-only access to packed sequences that are stored either in a packed_sequence_store or in a memory-mapped file.
+	class packed_sequence_view
+	{
+	public:
+		typedef std::span <std::uint64_t const>					word_span;
+		typedef std::span <packed_sequence_contig const>			contig_span;
+		typedef std::span <packed_sequence_ambiguity_run const>	ambiguity_run_span;
+		typedef std::span <packed_sequence_mask_run const>		mask_run_span;
+
+	protected:
+		word_span				m_words;
+		contig_span				m_contigs;
+		ambiguity_run_span		m_ambiguity_runs;
+		mask_run_span			m_mask_runs;
+		std::string_view		m_names;
+
+	protected:
+		void decode(std::uint64_t pos, std::uint64_t const count, char *dst) const;
+
+	public:
+		packed_sequence_view() = default;
+
+		packed_sequence_view(
+			word_span const words,
+			contig_span const contigs,
+			ambiguity_run_span const ambiguity_runs,
+			mask_run_span const mask_runs,
+			std::string_view const names
+		):
+			m_words(words),
+			m_contigs(contigs),
+			m_ambiguity_runs(ambiguity_runs),
+			m_mask_runs(mask_runs),
+			m_names(names)
+		{
+		}
+
+		// Check the layout written by packed_sequence_store::write_mappable().
+		// Throws std::runtime_error if the buffer is not valid.
+		static packed_sequence_view from_mappable(std::span <std::byte const> const buffer);
+
+		std::size_t contig_count() const { return m_contigs.size(); }
+		contig_span contigs() const { return m_contigs; }
+		packed_sequence_contig const &contig(std::size_t const idx) const { return m_contigs[idx]; }
+		std::string_view name(packed_sequence_contig const &contig) const { return m_names.substr(contig.name_offset, contig.name_length); }
+		std::string_view name(std::size_t const idx) const { return name(m_contigs[idx]); }
+		packed_sequence_contig const *find(std::string_view const name) const;
+
+		// Copy the characters in [start, end) of the contig to dst, which needs to have space for end - start characters.
+		void extract(packed_sequence_contig const &contig, std::uint64_t const start, std::uint64_t const end, char *dst, bool const soft_masked = true) const;
+		inline void extract(packed_sequence_contig const &contig, std::uint64_t const start, std::uint64_t const end, std::string &dst, bool const soft_masked = true) const;
+
+		// Compare the contig at pos to ref ignoring case, e.g. to validate VCF REF columns.
+		bool compare(packed_sequence_contig const &contig, std::uint64_t const pos, std::string_view const ref) const;
+	};
+
+
+	// Stores DNA sequences with two bits per base. Other characters, e.g. N and IUPAC codes, are stored as runs
+	// s.t. the corresponding bases are zero in the packed vector, and so are the runs of lower case characters.
+	// The store may be serialized with cereal (see packed_sequence_store/cereal_serialization.hh) or written in a
+	// format that can be memory-mapped with mapped_packed_sequence_store, e.g. for sharing one reference
+	// between processes.
+	class packed_sequence_store
+	{
+		template <typename t_archive>
+		friend void serialize(t_archive &, packed_sequence_store &, std::uint32_t const);
+
+	public:
+		constexpr static inline std::uint32_t const SERIALIZATION_VERSION{1};	// cereal class version.
+
+		typedef int_vector <2>										base_vector;
+		typedef std::vector <packed_sequence_contig>				contig_vector;
+		typedef std::vector <packed_sequence_ambiguity_run>		ambiguity_run_vector;
+		typedef std::vector <packed_sequence_mask_run>			mask_run_vector;
+
+	protected:
+		base_vector				m_bases;
+		contig_vector			m_contigs;
+		ambiguity_run_vector	m_ambiguity_runs;
+		mask_run_vector			m_mask_runs;
+		std::string				m_names;
+
+	public:
+		// Read the sequences with fasta_reader. Throws on parse errors.
+		void load_fasta(reading_handle &handle);
+
+		void add_contig(std::string_view const name);
+		void append_sequence(std::string_view const seq); // Append to the last contig.
+		void clear();
+
+		base_vector const &bases() const { return m_bases; }
+		std::size_t contig_count() const { return m_contigs.size(); }
+		inline packed_sequence_view view() const;
+
+		// Native byte order; from_mappable() checks that the byte order and the format version match.
+		void write_mappable(std::ostream &stream) const;
+	};
+
+
+	// Owns a memory-mapped file written with packed_sequence_store::write_mappable().
+	class mapped_packed_sequence_store
+	{
+	protected:
+		mmap_file_handle <std::byte>	m_handle;
+		packed_sequence_view			m_view;
+
+	public:
+		void open(std::string const &path) { m_handle.open(path); m_view = packed_sequence_view::from_mappable(m_handle.to_span()); }
+		packed_sequence_view const &view() const { return m_view; }
+	};
+
+
+	void packed_sequence_view::extract(
+		packed_sequence_contig const &contig,
+		std::uint64_t const start,
+		std::uint64_t const end,
+		std::string &dst,
+		bool const soft_masked
+	) const
+	{
+		libbio_assert_lte(start, end);
+		dst.resize(end - start);
+		extract(contig, start, end, dst.data(), soft_masked);
+	}
+
+
+	packed_sequence_view packed_sequence_store::view() const
+	{
+		return packed_sequence_view(
+			{std::to_address(m_bases.word_cbegin()), m_bases.word_size()},
+			m_contigs,
+			m_ambiguity_runs,
+			m_mask_runs,
+			m_names
+		);
+	}
+}
+
+#endif
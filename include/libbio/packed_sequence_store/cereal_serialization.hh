@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_PACKED_SEQUENCE_STORE_CEREAL_SERIALIZATION_HH
+#define LIBBIO_PACKED_SEQUENCE_STORE_CEREAL_SERIALIZATION_HH
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <cstdint>
+#include <libbio/int_vector/cereal_serialization.hh>
+#include <libbio/packed_sequence_store.hh>
+#include <stdexcept>
+
+
+namespace libbio {
+
+	template <typename t_archive>
+	inline void serialize(t_archive &archive, packed_sequence_contig &contig)
+	{
+		archive(
+			contig.base_offset,
+			contig.length,
+			contig.ambiguity_run_begin,
+			contig.ambiguity_run_end,
+			contig.mask_run_begin,
+			contig.mask_run_end,
+			contig.name_offset,
+			contig.name_length
+		);
+	}
+
+
+	template <typename t_archive>
+	inline void serialize(t_archive &archive, packed_sequence_ambiguity_run &run)
+	{
+		archive(run.position, run.length, run.character);
+	}
+
+
+	template <typename t_archive>
+	inline void serialize(t_archive &archive, packed_sequence_mask_run &run)
+	{
+		archive(run.position, run.length);
+	}
+
+
+	template <typename t_archive>
+	inline void serialize(t_archive &archive, packed_sequence_store &store, std::uint32_t const version)
+	{
+		// Loading an archive written with a different layout would not fail otherwise.
+		if (packed_sequence_store::SERIALIZATION_VERSION != version)
+			throw std::runtime_error("Unexpected packed_sequence_store serialization version");
+
+		archive(store.m_bases, store.m_contigs, store.m_ambiguity_runs, store.m_mask_runs, store.m_names);
+	}
+}
+
+
+CEREAL_CLASS_VERSION(libbio::packed_sequence_store, libbio::packed_sequence_store::SERIALIZATION_VERSION);
+
+#endif
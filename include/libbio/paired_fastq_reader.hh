@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_PAIRED_FASTQ_READER_HH
+#define LIBBIO_PAIRED_FASTQ_READER_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <libbio/assert.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace libbio {
+
+	// Records parsed from one input. The views point to text.
+	struct fastq_text_batch
+	{
+		std::vector <char>					text;
+		std::vector <fastq_record_view>		records;
+
+		void clear() { text.clear(); records.clear(); }
+	};
+
+
+	struct paired_fastq_batch
+	{
+		fastq_text_batch	first;
+		fastq_text_batch	second;
+		std::uint64_t		first_record_index{};
+
+		std::size_t size() const { return first.records.size(); }
+		bool empty() const { return first.records.empty(); }
+	};
+}
+
+
+namespace libbio::detail {
+
+	// Reads and parses batches of records from one input in a separate thread.
+	class fastq_batch_producer
+	{
+	protected:
+		reading_handle					*m_handle{};
+		std::size_t						m_batch_size{};
+		std::size_t						m_max_pending_batches{};
+		std::thread						m_thread;
+
+		std::mutex						m_mutex;			// Protects the variables below.
+		std::condition_variable			m_cv;
+		std::deque <fastq_text_batch>	m_pending_batches;
+		std::vector <fastq_text_batch>	m_free_batches;
+		std::exception_ptr				m_exception;
+		bool							m_did_finish{};
+		bool							m_is_stopping{};
+
+	protected:
+		void run();
+		fastq_text_batch make_batch();
+		bool add_batch(fastq_text_batch &&batch);
+
+	public:
+		fastq_batch_producer(reading_handle &handle, std::size_t const batch_size, std::size_t const max_pending_batches):
+			m_handle(&handle),
+			m_batch_size(batch_size),
+			m_max_pending_batches(max_pending_batches)
+		{
+		}
+
+		~fastq_batch_producer() { stop(); }
+
+		void start();
+		void stop();
+
+		// Replace the contents of dst with the next batch or return false on EOF. The previous contents are reused.
+		bool next_batch(fastq_text_batch &dst);
+	};
+}
+
+
+namespace libbio {
+
+	// Reads the records of paired-end FASTQ inputs, e.g. R1 and R2 files, in lockstep. Each input is read and
+	// parsed in a separate thread and the batches are pipelined s.t. the consumer may process one batch while
+	// the following ones are being read; compressed inputs may be read with decompressing_reading_handle, which
+	// decompresses BGZF blocks in parallel. The records need to consist of four lines each. The identifiers
+	// of the mates are required to match up to the first whitespace character and an optional /1 or /2 suffix.
+	class paired_fastq_reader
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_BATCH_SIZE{4096};
+		constexpr static inline std::size_t const DEFAULT_MAX_PENDING_BATCHES{4};
+
+	protected:
+		detail::fastq_batch_producer	m_first;
+		detail::fastq_batch_producer	m_second;
+		std::uint64_t					m_record_index{};
+		bool							m_has_started{};
+		bool							m_validates_identifiers{true};
+
+	public:
+		paired_fastq_reader(
+			reading_handle &first,
+			reading_handle &second,
+			std::size_t const batch_size = DEFAULT_BATCH_SIZE,
+			std::size_t const max_pending_batches = DEFAULT_MAX_PENDING_BATCHES
+		):
+			m_first(first, batch_size, max_pending_batches),
+			m_second(second, batch_size, max_pending_batches)
+		{
+			libbio_always_assert_lt(0, batch_size);
+			libbio_always_assert_lt(0, max_pending_batches);
+		}
+
+		bool validates_identifiers() const { return m_validates_identifiers; }
+		void set_validates_identifiers(bool const should_validate) { m_validates_identifiers = should_validate; }
+
+		// Replace the contents of batch with the next pairs or return false on EOF. Throws std::runtime_error if
+		// the inputs have different numbers of records or the identifiers do not match.
+		bool next_batch(paired_fastq_batch &batch);
+
+		static bool identifiers_match(std::string_view lhs, std::string_view rhs);
+	};
+}
+
+#endif
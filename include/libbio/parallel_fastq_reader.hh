@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_PARALLEL_FASTQ_READER_HH
+#define LIBBIO_PARALLEL_FASTQ_READER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/dispatch.hh>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace libbio {
+
+	// Views to one record of a FASTQ buffer.
+	struct fastq_record_view
+	{
+		std::string_view	identifier;	// Without the @.
+		std::string_view	sequence;
+		std::string_view	quality;
+	};
+
+
+	struct fastq_record_batch
+	{
+		std::vector <fastq_record_view>	records;
+		std::size_t						chunk_index{};
+		std::uint64_t					first_record_index{};	// Set only when delivering in order.
+	};
+
+
+	// Thrown if the input is not valid. The line number is one-based.
+	class fastq_parse_error : public std::runtime_error
+	{
+	protected:
+		std::string	m_reason;
+		std::size_t	m_lineno{};
+
+	public:
+		fastq_parse_error(std::string reason, std::size_t const lineno):
+			std::runtime_error(reason + " at line " + std::to_string(lineno)),
+			m_reason(std::move(reason)),
+			m_lineno(lineno)
+		{
+		}
+
+		std::string const &reason() const { return m_reason; }
+		std::size_t lineno() const { return m_lineno; }
+	};
+
+
+	// Parses a FASTQ buffer, e.g. the contents of a memory-mapped file, in chunks on a parallel queue.
+	// The chunks are split at record boundaries that are verified by checking the following lines
+	// b.c. @ may also begin a quality line. The records need to consist of exactly four lines each,
+	// i.e. the sequence and the quality strings may not be wrapped. Errors are reported by throwing
+	// fastq_parse_error. The record views point to the buffer, which needs to outlive the batches.
+	class parallel_fastq_reader
+	{
+	public:
+		typedef std::function <bool(fastq_record_batch const &)>	batch_callback_fn;
+		typedef std::vector <std::string_view>						chunk_vector;
+
+		constexpr static inline std::size_t const DEFAULT_CHUNK_SIZE{16 * 1024 * 1024};
+
+	protected:
+		std::string_view	m_content;
+		std::size_t			m_chunk_size{DEFAULT_CHUNK_SIZE};
+		std::size_t			m_max_pending_chunks{2 * (std::thread::hardware_concurrency() ?: 1)};
+
+	public:
+		parallel_fastq_reader() = default;
+
+		explicit parallel_fastq_reader(std::string_view const content):
+			m_content(content)
+		{
+		}
+
+		std::string_view content() const { return m_content; }
+		void set_content(std::string_view const content) { m_content = content; }
+
+		std::size_t chunk_size() const { return m_chunk_size; }
+		void set_chunk_size(std::size_t const size) { libbio_always_assert_lt(0, size); m_chunk_size = size; }
+		std::size_t max_pending_chunks() const { return m_max_pending_chunks; }
+		void set_max_pending_chunks(std::size_t const count) { libbio_always_assert_lt(0, count); m_max_pending_chunks = count; }
+
+		// Return the offset of the first record that begins at or after pos, or the size of the buffer.
+		static std::size_t find_record_start(std::string_view const content, std::size_t pos);
+
+		// Append at most max_count complete records from the beginning of the buffer to dst and return the number of
+		// bytes consumed. An incomplete record at the end is left unparsed unless is_last is set.
+		// Throws fastq_parse_error if the buffer is not valid; the line number is relative to the buffer.
+		static std::size_t parse_records(std::string_view buffer, bool const is_last, std::size_t const max_count, std::vector <fastq_record_view> &dst);
+
+		// Parse the records of one chunk. Throws fastq_parse_error if the chunk is not valid; the line number is relative to the chunk.
+		static void parse_chunk(std::string_view const chunk, std::vector <fastq_record_view> &dst) { dst.clear(); parse_records(chunk, true, SIZE_MAX, dst); }
+
+		chunk_vector make_chunks() const;
+
+		// Calls the callback from the worker threads in arbitrary order.
+		// The line numbers in the errors are counted from the beginning of the content.
+		void parse_unordered(batch_callback_fn const &callback, dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue());
+
+		// Calls the callback serially in buffer order from a worker thread.
+		// The line numbers in the errors are counted from the beginning of the content.
+		void parse_ordered(batch_callback_fn const &callback, dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue());
+
+	protected:
+		// Parse a chunk of m_content and make the line number in an error relative to the beginning of m_content.
+		void parse_content_chunk(std::string_view const chunk, std::vector <fastq_record_view> &dst) const;
+	};
+}
+
+#endif
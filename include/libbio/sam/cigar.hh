@@ -100,6 +100,85 @@ namespace libbio::sam {
 
 
 	inline std::ostream &operator<<(std::ostream &os, cigar_run const &run) { os << run.count() << run.operation(); return os; }
+
+
+	// Lengths and counts determined from the CIGAR operations. Filled by the SAM and BAM parsers
+	// while the CIGAR is being read, so that the consumers do not need to traverse it again.
+	struct alignment_geometry
+	{
+		typedef cigar_run::count_type	count_type;
+
+		count_type	reference_length{};				// Consumed by M, D, N, =, X.
+		count_type	query_length{};					// Consumed by M, I, S, =, X.
+		count_type	leading_soft_clip_length{};
+		count_type	trailing_soft_clip_length{};
+		count_type	leading_hard_clip_length{};
+		count_type	trailing_hard_clip_length{};
+		count_type	insertion_count{};				// Number of I operations.
+		count_type	inserted_bases{};
+		count_type	deletion_count{};				// Number of D operations.
+		count_type	deleted_bases{};
+
+		constexpr count_type aligned_query_length() const { return query_length - leading_soft_clip_length - trailing_soft_clip_length; }
+		constexpr bool is_before_aligned_part() const { return 0 == reference_length && query_length == leading_soft_clip_length; }
+
+		constexpr void clear() { *this = alignment_geometry{}; }
+		constexpr inline void update(cigar_run const run);
+
+		template <typename t_range>
+		constexpr void assign(t_range const &runs) { clear(); for (auto const run : runs) update(run); }
+
+		constexpr bool operator==(alignment_geometry const &) const = default;
+	};
+
+
+	constexpr void alignment_geometry::update(cigar_run const run)
+	{
+		auto const count(run.count());
+		switch (run.operation())
+		{
+			case cigar_operation::alignment_match:
+			case cigar_operation::sequence_match:
+			case cigar_operation::sequence_mismatch:
+				reference_length += count;
+				query_length += count;
+				break;
+
+			case cigar_operation::insertion:
+				query_length += count;
+				++insertion_count;
+				inserted_bases += count;
+				break;
+
+			case cigar_operation::deletion:
+				reference_length += count;
+				++deletion_count;
+				deleted_bases += count;
+				break;
+
+			case cigar_operation::skipped_region:
+				reference_length += count;
+				break;
+
+			case cigar_operation::soft_clipping:
+				if (is_before_aligned_part())
+					leading_soft_clip_length += count;
+				else
+					trailing_soft_clip_length += count;
+				query_length += count;
+				break;
+
+			case cigar_operation::hard_clipping:
+				if (0 == reference_length && 0 == query_length)
+					leading_hard_clip_length += count;
+				else
+					trailing_hard_clip_length += count;
+				break;
+
+			case cigar_operation::padding:
+				break;
+		}
+	}
 }
 
 #endif
@@ -22,9 +22,16 @@ namespace libbio::sam::fields {
 		typedef std::vector <cigar_run>	cigar_vector;
 		typedef cigar_run::count_type	cigar_count_type;
 
+		// The geometry is calculated in the same pass.
+		struct cigar_value
+		{
+			cigar_vector		runs;
+			alignment_geometry	geometry;
+		};
+
 
 		template <bool t_should_copy>
-		using value_type = cigar_vector;
+		using value_type = cigar_value;
 
 
 		template <typename t_range>
@@ -45,14 +52,15 @@ namespace libbio::sam::fields {
 		}
 
 
-		constexpr void clear_value(cigar_vector &dst) const
+		constexpr void clear_value(cigar_value &dst) const
 		{
-			dst.clear();
+			dst.runs.clear();
+			dst.geometry.clear();
 		}
 
 
 		template <typename t_delimiter, parsing::field_position t_field_position, typename t_range>
-		constexpr parsing::parsing_result parse(t_range &range, cigar_vector &dst) const
+		constexpr parsing::parsing_result parse(t_range &range, cigar_value &dst) const
 		{
 			if constexpr (any(parsing::field_position::initial_ & t_field_position))
 			{
@@ -107,7 +115,9 @@ namespace libbio::sam::fields {
 				}
 
 			continue_parsing_2:
-				dst.emplace_back(parse_one(range));
+				auto const run(parse_one(range));
+				dst.runs.emplace_back(run);
+				dst.geometry.update(run);
 			}
 
 			if constexpr (t_field_position == parsing::field_position::final_)
@@ -17,6 +17,7 @@
 #include <libbio/generic_parser.hh>
 #include <libbio/sam/input_range.hh>
 #include <libbio/sam/tag.hh>
+#include <libbio/sam/tag_index.hh>
 #include <libbio/tuple.hh>
 #include <libbio/type_traits.hh>
 #include <limits>
@@ -180,7 +181,7 @@ namespace libbio::sam {
 			// For alignment purposes all are std::uint16_t.
 			// Since the tags are sorted by tag_id, the rank (unfortunately) needs to be stored, too
 			// (i.e. calculating the rank with std::distance is not possible).
-			// FIXME: since there are typically very few tags, linear search could be utilised instead.
+			// Lookups by tag_id are done with m_tag_index.
 			tag_type		tag_id{};
 			tag_type		type_index{};
 			tag_count_type	rank{};
@@ -251,8 +252,9 @@ namespace libbio::sam {
 		using find_rank_return_type_t = if_const_t <t_optional_field, tag_rank_vector::const_iterator, tag_rank_vector::iterator>;
 
 	private:
-		tag_rank_vector		m_tag_ranks;	// Rank of the tag among its value type.
-		value_tuple_type	m_values;
+		tag_rank_vector				m_tag_ranks;	// Rank of the tag among its value type.
+		value_tuple_type			m_values;
+		detail::tag_index			m_tag_index;	// Positions in m_tag_ranks by tag_id, rebuilt after m_tag_ranks has been modified.
 
 	private:
 		template <typename t_type>
@@ -271,11 +273,18 @@ namespace libbio::sam {
 		template <typename t_type, typename t_value>
 		inline void add_array_value(t_value const);
 
-		void update_tag_order() { std::sort(m_tag_ranks.begin(), m_tag_ranks.end()); }
+		// Called by the parsers after adding the values of a record.
+		void rebuild_tag_index() { m_tag_index.rebuild(m_tag_ranks, [](tag_rank const &tr){ return tr.tag_id; }); }
+		void update_tag_order() { std::sort(m_tag_ranks.begin(), m_tag_ranks.end()); rebuild_tag_index(); }
+
+		detail::tag_index const &tag_index() const { return m_tag_index; }
 
 		template <typename t_type, typename t_optional_field>
 		constexpr static inline auto find_rank(t_optional_field &&of, tag_type const tag) -> find_rank_return_type_t <t_optional_field>;
 
+		template <typename t_tuple, typename t_optional_field, std::size_t ... t_idxs>
+		constexpr static inline t_tuple do_get_all(t_optional_field &&of, std::array <tag_type, sizeof...(t_idxs)> const &tags, std::index_sequence <t_idxs...>);
+
 		template <typename t_type, typename t_optional_field>
 		constexpr static inline get_value_return_type_t <t_type> do_get(t_optional_field &&of, tag_rank_vector::const_iterator it, tag_type const tag);
 
@@ -300,13 +309,28 @@ namespace libbio::sam {
 		}
 
 		constexpr bool empty() const { return m_tag_ranks.empty(); }
-		constexpr void clear() { m_tag_ranks.clear(); tuples::for_each(m_values, []<typename t_idx>(auto &element){ element.clear(); }); }
+		constexpr void clear() { m_tag_ranks.clear(); m_tag_index.clear(); tuples::for_each(m_values, []<typename t_idx>(auto &element){ element.clear(); }); }
 
 		template <typename t_type> constexpr get_value_return_type_t <t_type> get(tag_type const tag) { return do_get <t_type>(*this, tag); }
 		template <typename t_type> constexpr get_value_return_type_t <t_type const> get(tag_type const tag) const { return do_get <t_type const>(*this, tag); }
 		template <tag_type t_tag>  constexpr get_value_return_type_t <tag_value_t <t_tag>> get() { return get <tag_value_t <t_tag>>(t_tag); }
 		template <tag_type t_tag>  constexpr get_value_return_type_t <tag_value_t <t_tag> const> get() const { return get <tag_value_t <t_tag>>(t_tag); }
 
+		// Resolve a fixed set of tags at once, e.g. get_all <std::int32_t, std::string>({"NM"_tag, "MD"_tag}).
+		template <typename ... t_types>
+		constexpr std::tuple <get_value_return_type_t <t_types>...> get_all(std::array <tag_type, sizeof...(t_types)> const &tags);
+
+		template <typename ... t_types>
+		constexpr std::tuple <get_value_return_type_t <t_types const>...> get_all(std::array <tag_type, sizeof...(t_types)> const &tags) const;
+
+		template <tag_type ... t_tags>
+		constexpr auto get_all() { return get_all <tag_value_t <t_tags>...>({t_tags...}); }
+
+		template <tag_type ... t_tags>
+		constexpr auto get_all() const { return get_all <tag_value_t <t_tags>...>({t_tags...}); }
+
+		bool contains(tag_type const tag) const { return detail::tag_index::NOT_FOUND != tag_index().find(tag); }
+
 		// Get or insert (even on type mismatch).
 		template <typename t_type> t_type &obtain(tag_type const tag);
 		template <tag_type t_tag> tag_value_t <t_tag> &obtain() { return obtain <tag_value_t <t_tag>>(t_tag); }
@@ -340,6 +364,7 @@ namespace libbio::sam {
 		constexpr auto const idx{tuples::first_index_of_v <value_tuple_type, t_container_type>};
 		auto &dst(std::get <t_container_type>(m_values));
 		m_tag_ranks.emplace_back(tag_id, idx, dst.size(), m_tag_ranks.size()); // Precondition used here for the last parameter.
+		m_tag_index.invalidate();
 		return dst;
 	}
 
@@ -377,10 +402,10 @@ namespace libbio::sam {
 	template <typename t_type, typename t_optional_field>
 	constexpr auto optional_field::find_rank(t_optional_field &&of, tag_type const tag) -> find_rank_return_type_t <t_optional_field>
 	{
-		auto const begin(of.m_tag_ranks.begin());
-		auto const end(of.m_tag_ranks.end());
-		auto const it(std::lower_bound(begin, end, tag, tag_rank_cmp{}));
-		return it;
+		auto const pos(of.tag_index().find(tag));
+		if (detail::tag_index::NOT_FOUND == pos)
+			return of.m_tag_ranks.end();
+		return of.m_tag_ranks.begin() + pos;
 	}
 
 
@@ -397,6 +422,29 @@ namespace libbio::sam {
 	}
 
 
+	template <typename t_tuple, typename t_optional_field, std::size_t ... t_idxs>
+	constexpr auto optional_field::do_get_all(t_optional_field &&of, std::array <tag_type, sizeof...(t_idxs)> const &tags, std::index_sequence <t_idxs...>) -> t_tuple
+	{
+		return t_tuple{do_get <typename std::tuple_element_t <t_idxs, t_tuple>::value_type::type>(of, std::get <t_idxs>(tags))...};
+	}
+
+
+	template <typename ... t_types>
+	constexpr auto optional_field::get_all(std::array <tag_type, sizeof...(t_types)> const &tags) -> std::tuple <get_value_return_type_t <t_types>...>
+	{
+		typedef std::tuple <get_value_return_type_t <t_types>...> return_type;
+		return do_get_all <return_type>(*this, tags, std::index_sequence_for <t_types...>{});
+	}
+
+
+	template <typename ... t_types>
+	constexpr auto optional_field::get_all(std::array <tag_type, sizeof...(t_types)> const &tags) const -> std::tuple <get_value_return_type_t <t_types const>...>
+	{
+		typedef std::tuple <get_value_return_type_t <t_types const>...> return_type;
+		return do_get_all <return_type>(*this, tags, std::index_sequence_for <t_types...>{});
+	}
+
+
 	template <typename t_type, typename t_optional_field>
 	constexpr auto optional_field::do_get(t_optional_field &&of, tag_type const tag) -> get_value_return_type_t <t_type>
 	{
@@ -416,9 +464,12 @@ namespace libbio::sam {
 		auto const end(m_tag_ranks.cend());
 		auto &dst(std::get <idx>(m_values));
 
-		if (end == it || it->tag_id != tag)
+		if (end == it)
 		{
-			m_tag_ranks.emplace(it, tag, idx, dst.size());
+			// Maintain the order by tag_id.
+			auto const it_(std::lower_bound(m_tag_ranks.begin(), m_tag_ranks.end(), tag, tag_rank_cmp{}));
+			m_tag_ranks.emplace(it_, tag, idx, dst.size());
+			rebuild_tag_index();
 			return dst.emplace_back();
 		}
 
@@ -528,6 +579,7 @@ namespace libbio::sam {
 		// Erase the removed ranks.
 		callback(tag_rank_vector::const_iterator(rank_it_), m_tag_ranks.cend());
 		m_tag_ranks.erase(rank_it_, rank_end);
+		rebuild_tag_index();
 
 		// Assign new ranks to the remaining tags.
 		{
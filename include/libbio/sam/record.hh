@@ -35,6 +35,7 @@ namespace libbio::sam {
 
 		std::string				qname;	// Empty for missing.
 		std::vector <cigar_run>	cigar;
+		alignment_geometry		geometry;	// Calculated from cigar by the parsers.
 		sequence_type			seq;
 		qual_type				qual;
 		optional_field			optional_fields;
@@ -53,6 +54,12 @@ namespace libbio::sam {
 
 		constexpr bool is_primary() const { return 0 == std::to_underlying(flag & (flag::secondary_alignment | flag::supplementary_alignment)); } // SAMv1 § 1.4
 		constexpr mapping_quality_type normalised_mapping_quality() const { return mapq - MAPQ_MIN; }
+
+		// Half-open, i.e. one past the last aligned reference position.
+		constexpr position_type reference_end() const { return pos + position_type(geometry.reference_length); }
+
+		// For records whose CIGAR has been modified after parsing.
+		void update_geometry() { geometry.assign(cigar); }
 	};
 
 
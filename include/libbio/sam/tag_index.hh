@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_SAM_TAG_INDEX_HH
+#define LIBBIO_SAM_TAG_INDEX_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <libbio/assert.hh>
+#include <libbio/sam/tag.hh>
+#include <limits>
+#include <vector>
+
+
+namespace libbio::sam::detail {
+
+	// Small open-addressing hash table from tags to positions in a sequence of tag ranks.
+	// Valid tags never have zero as the first character (SAMv1 § 1.5), so zero denotes an empty slot.
+	class tag_index
+	{
+	public:
+		typedef std::uint16_t	position_type;
+		constexpr static inline position_type const NOT_FOUND{std::numeric_limits <position_type>::max()};
+
+	private:
+		struct slot
+		{
+			tag_type		tag_id{};
+			position_type	position{NOT_FOUND};
+		};
+
+		typedef std::vector <slot>	slot_vector;
+
+		constexpr static inline std::size_t const MIN_SLOT_COUNT{32};	// Enough for typical records with no rehashing.
+
+	private:
+		slot_vector		m_slots;
+		std::size_t		m_mask{};
+		bool			m_is_valid{};
+
+	private:
+		constexpr std::size_t home_slot(tag_type const tag_id) const
+		{
+			// Fibonacci hashing; the table size is a power of two.
+			std::uint32_t const hh(std::uint32_t(tag_id) * UINT32_C(2654435769));
+			return (hh >> 16U) & m_mask;
+		}
+
+	public:
+		constexpr bool is_valid() const { return m_is_valid; }
+		constexpr void invalidate() { m_is_valid = false; }
+		constexpr inline void clear();
+
+		template <typename t_range, typename t_tag_fn>
+		void rebuild(t_range const &range, t_tag_fn &&tag_fn);
+
+		inline position_type find(tag_type const tag_id) const;
+	};
+
+
+	template <typename t_range, typename t_tag_fn>
+	void tag_index::rebuild(t_range const &range, t_tag_fn &&tag_fn)
+	{
+		// Keep the load factor at most 1/2.
+		auto const count(std::size(range));
+		libbio_always_assert_lt(count, NOT_FOUND);
+		auto const slot_count(std::max(MIN_SLOT_COUNT, std::bit_ceil(2 * count)));
+		m_slots.clear();
+		m_slots.resize(slot_count);
+		m_mask = slot_count - 1;
+
+		position_type pos{};
+		for (auto const &item : range)
+		{
+			auto const tag_id(tag_fn(item));
+			auto idx(home_slot(tag_id));
+			while (true)
+			{
+				auto &ss(m_slots[idx]);
+				if (0 == ss.tag_id)
+				{
+					ss.tag_id = tag_id;
+					ss.position = pos;
+					break;
+				}
+
+				// In case of duplicate tags, the first one is retained.
+				if (tag_id == ss.tag_id)
+					break;
+
+				idx = (idx + 1) & m_mask;
+			}
+
+			++pos;
+		}
+
+		m_is_valid = true;
+	}
+
+
+	constexpr void tag_index::clear()
+	{
+		// Retain the slots for the next record.
+		if (m_slots.empty())
+		{
+			m_slots.resize(MIN_SLOT_COUNT);
+			m_mask = MIN_SLOT_COUNT - 1;
+		}
+		else
+		{
+			std::fill(m_slots.begin(), m_slots.end(), slot{});
+		}
+
+		m_is_valid = true;
+	}
+
+
+	auto tag_index::find(tag_type const tag_id) const -> position_type
+	{
+		// The index of a default-constructed optional_field has no slots.
+		libbio_assert(m_is_valid || m_slots.empty());
+		if (0 == tag_id || m_slots.empty())
+			return NOT_FOUND;
+
+		auto idx(home_slot(tag_id));
+		while (true)
+		{
+			auto const &ss(m_slots[idx]);
+			if (tag_id == ss.tag_id)
+				return ss.position;
+			if (0 == ss.tag_id)
+				return NOT_FOUND;
+			idx = (idx + 1) & m_mask;
+		}
+	}
+}
+
+#endif
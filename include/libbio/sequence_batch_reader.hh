@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_SEQUENCE_BATCH_READER_HH
+#define LIBBIO_SEQUENCE_BATCH_READER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio {
+
+	// Records stored in contiguous buffers. The offset vectors have one more element than there are records.
+	// The quality strings are empty for FASTA input. Reusing the batch avoids reallocating the buffers.
+	struct sequence_record_batch
+	{
+		typedef std::vector <std::size_t>	offset_vector;
+
+		std::string		identifiers;
+		std::string		sequences;
+		std::string		qualities;
+		offset_vector	identifier_offsets{0};
+		offset_vector	sequence_offsets{0};
+		offset_vector	quality_offsets{0};
+
+		std::size_t size() const { return identifier_offsets.size() - 1; }
+		bool empty() const { return 1 == identifier_offsets.size(); }
+		inline void clear();
+
+		std::string_view identifier(std::size_t const idx) const { return substring(identifiers, identifier_offsets, idx); }
+		std::string_view sequence(std::size_t const idx) const { return substring(sequences, sequence_offsets, idx); }
+		std::string_view quality(std::size_t const idx) const { return substring(qualities, quality_offsets, idx); }
+
+		// For adding records.
+		inline void finish_record();
+
+	private:
+		static std::string_view substring(std::string const &buffer, offset_vector const &offsets, std::size_t const idx)
+		{
+			libbio_assert_lt(idx + 1, offsets.size());
+			return std::string_view(buffer.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+		}
+	};
+
+
+	// Reads blocks from a reading_handle to a buffer the unread part of which is preserved between the calls.
+	class sequence_batch_reader_base
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_MAX_RECORDS{4096};
+		constexpr static inline std::size_t const DEFAULT_MAX_SEQUENCE_LENGTH{16 * 1024 * 1024};
+
+	protected:
+		reading_handle		*m_handle{};
+		std::vector <char>	m_buffer;
+		std::size_t			m_blocksize{};
+		std::size_t			m_pos{};
+		std::uint64_t		m_record_count{};
+		bool				m_is_eof{};
+
+	protected:
+		std::string_view unread() const { return std::string_view(m_buffer.data() + m_pos, m_buffer.size() - m_pos); }
+		bool fill(); // Return false on EOF.
+		bool skip_empty_lines(); // Return false on EOF.
+
+	public:
+		// Reads blocks of the handle’s preferred size by default.
+		explicit sequence_batch_reader_base(reading_handle &handle, std::size_t const blocksize = 0):
+			m_handle(&handle),
+			m_blocksize(blocksize ?: (handle.io_op_blocksize() ?: 65536))
+		{
+		}
+
+		std::uint64_t record_count() const { return m_record_count; }
+	};
+
+
+	// Pull-style alternative to fasta_reader. Each sequence is copied to the batch without the newlines.
+	// The records are not split between batches, so a batch may exceed max_sequence_length by one record.
+	// Throws std::runtime_error on invalid input.
+	class fasta_batch_reader final : public sequence_batch_reader_base
+	{
+	protected:
+		bool read_record(sequence_record_batch &batch);
+
+	public:
+		using sequence_batch_reader_base::sequence_batch_reader_base;
+
+		// Replace the contents of batch with the next records or return false on EOF.
+		bool read_batch(
+			sequence_record_batch &batch,
+			std::size_t const max_records = DEFAULT_MAX_RECORDS,
+			std::size_t const max_sequence_length = DEFAULT_MAX_SEQUENCE_LENGTH
+		);
+	};
+
+
+	// Pull-style alternative to fastq_reader for records that consist of four lines each.
+	// Throws std::runtime_error on invalid input.
+	class fastq_batch_reader final : public sequence_batch_reader_base
+	{
+	protected:
+		std::vector <fastq_record_view>	m_records;
+
+	public:
+		using sequence_batch_reader_base::sequence_batch_reader_base;
+
+		// Replace the contents of batch with the next records or return false on EOF.
+		bool read_batch(
+			sequence_record_batch &batch,
+			std::size_t const max_records = DEFAULT_MAX_RECORDS,
+			std::size_t const max_sequence_length = DEFAULT_MAX_SEQUENCE_LENGTH
+		);
+	};
+
+
+	void sequence_record_batch::clear()
+	{
+		identifiers.clear();
+		sequences.clear();
+		qualities.clear();
+		identifier_offsets.assign(1, 0);
+		sequence_offsets.assign(1, 0);
+		quality_offsets.assign(1, 0);
+	}
+
+
+	void sequence_record_batch::finish_record()
+	{
+		identifier_offsets.push_back(identifiers.size());
+		sequence_offsets.push_back(sequences.size());
+		quality_offsets.push_back(qualities.size());
+	}
+}
+
+#endif
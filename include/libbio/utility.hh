@@ -13,8 +13,10 @@
 #include <libbio/utility/is_lte.hh>							// IWYU pragma: export
 #include <libbio/utility/make_const.hh>						// IWYU pragma: export
 #include <libbio/utility/misc.hh>							// IWYU pragma: export
+#include <libbio/utility/output_integer.hh>					// IWYU pragma: export
 #include <libbio/utility/smallest_unsigned_lockfree.hh>		// IWYU pragma: export
 #include <libbio/utility/string_hash.hh>					// IWYU pragma: export
+#include <libbio/utility/strip_newlines.hh>				// IWYU pragma: export
 #include <libbio/utility/variable_guard.hh>					// IWYU pragma: export
 
 #endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_UTILITY_OUTPUT_INTEGER_HH
+#define LIBBIO_UTILITY_OUTPUT_INTEGER_HH
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <ostream>
+
+
+namespace libbio {
+
+	// Write an integer with std::to_chars, which avoids the locale-dependent formatting of operator<<.
+	template <std::integral t_integer>
+	void output_integer(std::ostream &os, t_integer const value)
+	{
+		std::array <char, 2 + std::numeric_limits <t_integer>::digits10> buffer;
+		auto const res(std::to_chars(buffer.data(), buffer.data() + buffer.size(), value));
+		os.write(buffer.data(), res.ptr - buffer.data());
+	}
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_UTILITY_STRIP_NEWLINES_HH
+#define LIBBIO_UTILITY_STRIP_NEWLINES_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+namespace libbio {
+
+	// Copy src to dst without the '\n' and '\r' characters and return the number of characters copied.
+	// dst needs to have space for src.size() characters. Uses Highway if LIBBIO_ENABLE_HIGHWAY is set.
+	std::size_t strip_newlines(std::string_view const src, char *dst);
+
+	inline void append_without_newlines(std::string_view const src, std::string &dst)
+	{
+		auto const size(dst.size());
+		dst.resize(size + src.size());
+		dst.resize(size + strip_newlines(src, dst.data() + size));
+	}
+}
+
+#endif
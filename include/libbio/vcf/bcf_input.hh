@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_BCF_INPUT_HH
+#define LIBBIO_VCF_BCF_INPUT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/bcf/dictionary.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/vcf/metadata.hh>
+#include <libbio/vcf/subfield/info_field_base_decl.hh>
+#include <libbio/vcf/vcf_input.hh>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Base class for BCF inputs. The header text is passed to the reader’s VCF header parser,
+	// after which the records are parsed with reader::parse_bcf(). Subclasses provide the
+	// uncompressed contents of the file in consecutive chunks.
+	class bcf_input_base : public input_base
+	{
+		friend class reader;
+
+	public:
+		typedef std::span <std::byte const>	byte_span;
+
+	protected:
+		struct format_entry
+		{
+			std::int32_t					key{};
+			bcf::typed_value				values;		// n_sample × count values.
+		};
+
+		typedef std::vector <format_entry>	format_entry_vector;
+
+	protected:
+		bcf::dictionary							m_dictionary;
+		std::string								m_header_text;
+		std::vector <std::byte>					m_spill_buffer;			// For data that spans multiple chunks.
+		byte_span								m_chunk;				// Unread part of the current chunk.
+		std::size_t								m_offset{};				// Offset of the next unread byte in the uncompressed data.
+
+		// State for reader::parse_bcf(); the look-up tables are indexed by the string dictionary indices.
+		std::vector <info_field_base *>			m_info_fields_by_key;
+		std::vector <metadata_filter const *>	m_filters_by_key;
+		format_entry_vector						m_format_entries;
+		std::string								m_format_buffer;
+		std::int32_t							m_pass_key{};
+		bool									m_has_served_header{};
+		bool									m_has_lookup_tables{};
+
+	public:
+		bcf::dictionary const &dictionary() const { return m_dictionary; }
+		std::string const &header_text() const { return m_header_text; }
+
+	protected:
+		// Set chunk to the next range of uncompressed data or return false on EOF.
+		// The previous chunk may be released.
+		virtual bool next_chunk(byte_span &chunk) = 0;
+
+		char const *buffer_start() const override { return m_header_text.data(); }
+		void fill_buffer(reader &vcf_reader) override;
+		bcf_input_base *as_bcf_input() override { return this; }
+
+		// Returned range is valid until the next call to take().
+		byte_span take(std::size_t const size);
+		bool has_remaining_input();
+		bool take_record(byte_span &shared, byte_span &indiv);
+		void read_header_text();
+		void prepare_for_parsing(reader &vcf_reader);
+		std::size_t offset() const { return m_offset; }
+	};
+
+
+	// Uncompressed BCF in memory, e.g. a memory-mapped output of “bcftools view -Ou”.
+	class bcf_buffer_input final : public bcf_input_base
+	{
+	protected:
+		byte_span	m_buffer;
+		bool		m_has_served_buffer{};
+
+	public:
+		bcf_buffer_input() = default;
+
+		explicit bcf_buffer_input(byte_span const buffer):
+			m_buffer(buffer)
+		{
+		}
+
+	protected:
+		bool next_chunk(byte_span &chunk) override;
+	};
+}
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_BCF_VARIANT_PRINTER_HH
+#define LIBBIO_VCF_BCF_VARIANT_PRINTER_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/bcf/dictionary.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/bcf/value_buffer.hh>
+#include <libbio/vcf/constants.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/variant_end_pos.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Output variants as BCF records, BCF 2.2 § 6.3. The typed INFO and FORMAT values are encoded
+	// directly from the subfield buffers. The string and contig dictionaries are built from the reader’s
+	// metadata in the same way as when reading BCF, and output_header() writes the header records
+	// in the matching order.
+	class bcf_variant_printer
+	{
+	public:
+		typedef bcf::byte_vector									byte_vector;
+
+	protected:
+		typedef std::map <std::string_view, std::int32_t, std::less <>>	key_map;
+
+		struct info_field_entry
+		{
+			info_field_base const	*field{};
+			std::int32_t			key{};
+		};
+
+		typedef std::vector <info_field_entry>						info_field_entry_vector;
+		typedef std::vector <genotype_field_base const *>			genotype_field_ptr_vector;
+
+	protected:
+		bcf::dictionary						m_dictionary;
+		key_map								m_string_keys;
+		key_map								m_contig_keys;
+		info_field_entry_vector				m_info_fields;
+		info_field_end const				*m_end_field{};
+		reader const						*m_reader{};
+		std::int32_t						m_pass_key{};
+
+		// Buffers.
+		bcf::value_buffer					m_values;
+		byte_vector							m_shared;
+		byte_vector							m_indiv;
+		std::string							m_id_buffer;
+		genotype_field_ptr_vector			m_genotype_fields;
+
+	public:
+		// Build the dictionaries from the reader’s metadata.
+		void prepare(reader const &vcf_reader);
+
+		// Output the magic string and the header text.
+		void output_header(byte_vector &dst) const;
+
+		// Append one record to dst.
+		template <typename t_string, typename t_format_access>
+		void output_variant(byte_vector &dst, formatted_variant <t_string, t_format_access> const &var);
+
+		bcf::dictionary const &dictionary() const { return m_dictionary; }
+
+	protected:
+		std::int32_t string_key(std::string_view const id) const;
+		std::int32_t contig_key(std::string_view const id) const;
+		void reset_values(genotype_field_base const &field);
+
+		template <typename t_variant>
+		void output_shared(t_variant const &var);
+
+		template <typename t_variant>
+		void output_indiv(t_variant const &var);
+	};
+
+
+	template <typename t_string, typename t_format_access>
+	void bcf_variant_printer::output_variant(byte_vector &dst, formatted_variant <t_string, t_format_access> const &var)
+	{
+		libbio_assert(m_reader);
+		m_shared.clear();
+		m_indiv.clear();
+
+		output_shared(var);
+		output_indiv(var);
+
+		bcf::append_le(dst, std::uint32_t(m_shared.size()));
+		bcf::append_le(dst, std::uint32_t(m_indiv.size()));
+		dst.insert(dst.end(), m_shared.begin(), m_shared.end());
+		dst.insert(dst.end(), m_indiv.begin(), m_indiv.end());
+	}
+
+
+	template <typename t_variant>
+	void bcf_variant_printer::output_shared(t_variant const &var)
+	{
+		// CHROM, POS, rlen, QUAL
+		auto const zero_based_pos(var.zero_based_pos());
+		auto const end_pos(m_end_field ? variant_end_pos(var, *m_end_field) : zero_based_pos + var.ref().size());
+		bcf::append_le(m_shared, contig_key(var.chrom_id()));
+		bcf::append_le(m_shared, std::int32_t(zero_based_pos));
+		bcf::append_le(m_shared, std::int32_t(end_pos - zero_based_pos));
+		if (abstract_variant::UNKNOWN_QUALITY == var.qual())
+			bcf::append_le(m_shared, bcf::FLOAT_MISSING_BITS);
+		else
+			bcf::append_le(m_shared, float(var.qual()));
+
+		// n_info and n_allele; n_info is updated below.
+		auto const n_info_pos(m_shared.size());
+		bcf::append_le(m_shared, std::uint32_t((1 + var.alts().size()) << 16));
+
+		// n_sample and n_fmt.
+		std::size_t n_fmt{};
+		for (auto const &[id, field_ptr] : var.get_format().fields_by_identifier())
+		{
+			if (metadata_value_type::NOT_PROCESSED != field_ptr->metadata_value_type())
+				++n_fmt;
+		}
+		if (var.samples().empty())
+			n_fmt = 0;
+		bcf::append_le(m_shared, std::uint32_t((n_fmt << 24) | var.samples().size()));
+
+		// ID
+		m_id_buffer.clear();
+		for (auto const &id : var.id())
+		{
+			if ("." == id)
+				continue;
+
+			if (!m_id_buffer.empty())
+				m_id_buffer += ';';
+			m_id_buffer += id;
+		}
+		bcf::append_typed_string(m_shared, m_id_buffer);
+
+		// REF and ALT
+		bcf::append_typed_string(m_shared, var.ref());
+		for (auto const &alt : var.alts())
+			bcf::append_typed_string(m_shared, alt.alt);
+
+		// FILTER
+		{
+			auto const &filters(var.filters());
+			m_values.reset(bcf::value_type::INT32);
+			m_values.begin_item();
+			if (filters.empty())
+				m_values.add_integer(m_pass_key);
+			else
+			{
+				for (auto const *filter : filters)
+					m_values.add_integer(string_key(filter->get_id()));
+			}
+			m_values.output(m_shared);
+		}
+
+		// INFO
+		std::uint32_t n_info{};
+		for (auto const &entry : m_info_fields)
+		{
+			auto const &field(*entry.field);
+			if (!field.has_value(var))
+				continue;
+
+			++n_info;
+			bcf::append_typed_integer(m_shared, entry.key);
+			switch (field.metadata_value_type())
+			{
+				case metadata_value_type::FLAG:
+					bcf::append_type_descriptor(m_shared, bcf::value_type::MISSING, 0);
+					continue;
+				case metadata_value_type::INTEGER:
+					m_values.reset(bcf::value_type::INT32);
+					break;
+				case metadata_value_type::FLOAT:
+					m_values.reset(bcf::value_type::FLOAT);
+					break;
+				default:
+					m_values.reset(bcf::value_type::CHAR);
+					break;
+			}
+
+			m_values.begin_item();
+			field.output_bcf_value(m_values, var);
+			m_values.output(m_shared);
+		}
+
+		bcf::store_le(m_shared.data() + n_info_pos, std::uint32_t(((1 + var.alts().size()) << 16) | n_info));
+	}
+
+
+	template <typename t_variant>
+	void bcf_variant_printer::output_indiv(t_variant const &var)
+	{
+		auto const &samples(var.samples());
+		if (samples.empty())
+			return;
+
+		// Use the order of the fields in the FORMAT column.
+		m_genotype_fields.clear();
+		for (auto const &[id, field_ptr] : var.get_format().fields_by_identifier())
+		{
+			if (metadata_value_type::NOT_PROCESSED != field_ptr->metadata_value_type())
+				m_genotype_fields.push_back(field_ptr.get());
+		}
+
+		std::sort(m_genotype_fields.begin(), m_genotype_fields.end(), [](auto const *lhs, auto const *rhs){
+			return lhs->get_index() < rhs->get_index();
+		});
+
+		for (auto const *field_ptr : m_genotype_fields)
+		{
+			auto const &field(*field_ptr);
+			auto const *meta(field.get_metadata());
+			libbio_assert(meta);
+
+			reset_values(field);
+			for (auto const &sample : samples)
+			{
+				m_values.begin_item();
+				if (field.has_value(sample))
+					field.output_bcf_value(m_values, sample);
+			}
+
+			bcf::append_typed_integer(m_indiv, string_key(meta->get_id()));
+			m_values.output(m_indiv);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_BGZF_BCF_INPUT_HH
+#define LIBBIO_VCF_BGZF_BCF_INPUT_HH
+
+#include <cstddef>
+#include <libbio/bgzf/in_order_reader.hh>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/vcf/bcf_input.hh>
+#include <thread>
+#include <utility>
+
+
+namespace libbio::vcf {
+
+	// Reads a BGZF-compressed BCF file. The blocks are decompressed in parallel and passed to the reader
+	// in order by bgzf::in_order_reader.
+	class bgzf_bcf_input final : public bcf_input_base
+	{
+	private:
+		file_handle						m_handle;
+		bgzf::in_order_reader			m_bgzf_reader;	// Destroyed before the handle.
+
+	public:
+		constexpr static inline std::size_t const DEFAULT_MAX_PENDING_BLOCKS{bgzf::in_order_reader::DEFAULT_MAX_PENDING_BLOCKS};
+
+		explicit bgzf_bcf_input(
+			file_handle &&handle,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			std::size_t const max_pending_blocks = DEFAULT_MAX_PENDING_BLOCKS,
+			dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			m_handle(std::move(handle)),
+			m_bgzf_reader(m_handle, task_count, max_pending_blocks, queue)
+		{
+		}
+
+		file_handle &handle() { return m_handle; }
+		file_handle const &handle() const { return m_handle; }
+
+	protected:
+		bool next_chunk(byte_span &chunk) override { return m_bgzf_reader.next_block(chunk); }
+	};
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_BGZF_BCF_WRITER_HH
+#define LIBBIO_VCF_BGZF_BCF_WRITER_HH
+
+#include <cstddef>
+#include <libbio/bgzf/writer.hh>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/file_handle.hh>
+#include <libbio/vcf/bcf_variant_printer.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <span>
+#include <thread>
+
+
+namespace libbio::vcf {
+
+	// Writes a BGZF-compressed BCF file. The records are encoded with bcf_variant_printer
+	// in the caller’s thread and the blocks are compressed in parallel with bgzf::writer.
+	class bgzf_bcf_writer
+	{
+	public:
+		typedef bcf_variant_printer::byte_vector	byte_vector;
+
+	protected:
+		bgzf::writer			m_writer;
+		bcf_variant_printer		m_printer;
+		byte_vector				m_buffer;
+
+	public:
+		explicit bgzf_bcf_writer(
+			file_handle &handle,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			int const compression_level = bgzf::writer::default_compression_level,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			m_writer(handle, task_count, compression_level, queue)
+		{
+		}
+
+		bcf_variant_printer &printer() { return m_printer; }
+		bcf_variant_printer const &printer() const { return m_printer; }
+
+		// Build the dictionaries and write the header to its own BGZF block(s).
+		inline void output_header(reader const &vcf_reader);
+
+		template <typename t_string, typename t_format_access>
+		inline void output_variant(formatted_variant <t_string, t_format_access> const &var);
+
+		// Write the remaining data and the EOF marker block.
+		void finish() { m_writer.finish(); }
+	};
+
+
+	void bgzf_bcf_writer::output_header(reader const &vcf_reader)
+	{
+		m_printer.prepare(vcf_reader);
+		m_buffer.clear();
+		m_printer.output_header(m_buffer);
+		m_writer.write(std::span{m_buffer.data(), m_buffer.size()});
+		m_writer.flush_block();
+	}
+
+
+	template <typename t_string, typename t_format_access>
+	void bgzf_bcf_writer::output_variant(formatted_variant <t_string, t_format_access> const &var)
+	{
+		m_buffer.clear();
+		m_printer.output_variant(m_buffer, var);
+		m_writer.write(std::span{m_buffer.data(), m_buffer.size()});
+	}
+}
+
+#endif
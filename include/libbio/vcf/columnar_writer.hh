@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_COLUMNAR_WRITER_HH
+#define LIBBIO_VCF_COLUMNAR_WRITER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <libbio/arrow/array_builder.hh>
+#include <libbio/arrow/ipc_file_writer.hh>
+#include <libbio/arrow/record_batch.hh>
+#include <libbio/assert.hh>
+#include <libbio/bcf/value_buffer.hh>
+#include <libbio/utility/string_hash.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/variant_format.hh>
+#include <libbio/vcf/vcf_reader_decl.hh>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Converts variants to an Arrow IPC file, which may be memory-mapped by the analysis tools.
+	// CHROM is dictionary-encoded, ID and FILTER are stored as strings and lists of strings, REF and ALT
+	// as UTF-8 with offsets and each processed INFO field in the headers gets a typed column named INFO/<ID>.
+	// GT is stored as fixed-size lists of sample_count × ploidy allele numbers, i.e. one row-major
+	// haplotype matrix per record batch, and the phasing in a similar list of booleans. The sample
+	// names are stored in the schema metadata.
+	class columnar_writer
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_BATCH_SIZE{65536};
+
+	protected:
+		enum class info_column_type : std::uint8_t
+		{
+			FLAG,
+			INTEGER,
+			INTEGER_LIST,
+			FLOAT,
+			FLOAT_LIST,
+			STRING
+		};
+
+		struct info_column
+		{
+			info_field_base const					*field{};
+			std::unique_ptr <arrow::array_builder>	builder;
+			info_column_type						type{};
+		};
+
+		typedef std::vector <info_column>			info_column_vector;
+
+		typedef std::unordered_map <
+			std::string,
+			std::int32_t,
+			libbio::string_hash_transparent,
+			libbio::string_equal_to_transparent
+		>											chromosome_map;
+
+		typedef arrow::list_builder <arrow::utf8_builder>								string_list_builder;
+		typedef arrow::fixed_size_list_builder <arrow::primitive_builder <std::uint16_t>>	allele_builder;
+		typedef arrow::fixed_size_list_builder <arrow::boolean_builder>					phasing_builder;
+
+	protected:
+		arrow::ipc_file_writer						m_writer;
+		arrow::record_batch							m_batch;
+		bcf::value_buffer							m_values;
+		chromosome_map								m_chromosome_indices;
+		arrow::utf8_builder							m_chromosome_names;		// Dictionary.
+
+		arrow::primitive_builder <std::int32_t>		m_chrom;
+		arrow::primitive_builder <std::uint64_t>	m_pos;
+		arrow::utf8_builder							m_id;
+		arrow::utf8_builder							m_ref;
+		string_list_builder							m_alt;
+		arrow::primitive_builder <double>			m_qual;
+		string_list_builder							m_filter;
+		info_column_vector							m_info_columns;
+		std::unique_ptr <allele_builder>			m_gt_alleles;
+		std::unique_ptr <phasing_builder>			m_gt_phased;
+
+		variant_format const						*m_format{};
+		genotype_field_gt const						*m_gt_field{};
+		std::size_t									m_batch_size{};
+		std::size_t									m_sample_count{};
+		std::uint16_t								m_ploidy{};
+
+	public:
+		explicit columnar_writer(std::ostream &stream, std::uint16_t const ploidy = 2, std::size_t const batch_size = DEFAULT_BATCH_SIZE):
+			m_writer(stream),
+			m_batch_size(batch_size),
+			m_ploidy(ploidy)
+		{
+			libbio_always_assert_lt(0, batch_size);
+			libbio_always_assert_lt(0, ploidy);
+		}
+
+		// Build the schema from the reader’s metadata and write it.
+		void prepare(reader const &vcf_reader);
+
+		template <typename t_string, typename t_format_access>
+		void add_variant(formatted_variant <t_string, t_format_access> const &var);
+
+		// Write the remaining records, the CHROM dictionary and the footer.
+		void finish();
+
+		std::uint64_t bytes_written() const { return m_writer.bytes_written(); }
+
+	protected:
+		std::int32_t chromosome_index(std::string_view const chrom_id);
+		void add_info_value(info_column &column, bool const has_value);
+		void update_format(variant_format const &format);
+		void add_genotype(std::vector <sample_genotype> const *gt);
+		void write_batch();
+
+		template <typename t_fn>
+		void visit_columns(t_fn &&fn);
+	};
+
+
+	template <typename t_string, typename t_format_access>
+	void columnar_writer::add_variant(formatted_variant <t_string, t_format_access> const &var)
+	{
+		m_chrom.append(chromosome_index(var.chrom_id()));
+		m_pos.append(var.pos());
+
+		// ID; missing if there are no identifiers.
+		{
+			auto &data(m_id.data());
+			bool is_first{true};
+			for (auto const &id : var.id())
+			{
+				if ("." == id)
+					continue;
+
+				if (!is_first)
+					data += ';';
+				data += id;
+				is_first = false;
+			}
+			m_id.finish_item(!is_first);
+		}
+
+		m_ref.append(var.ref());
+
+		for (auto const &alt : var.alts())
+			m_alt.child().append(alt.alt);
+		m_alt.finish_item();
+
+		if (abstract_variant::UNKNOWN_QUALITY == var.qual())
+			m_qual.append_null();
+		else
+			m_qual.append(var.qual());
+
+		// FILTER, output as PASS if empty as in variant_printer.
+		if (var.filters().empty())
+			m_filter.child().append("PASS");
+		for (auto const *filter : var.filters())
+			m_filter.child().append(filter->get_id());
+		m_filter.finish_item();
+
+		// INFO
+		for (auto &column : m_info_columns)
+		{
+			auto const &field(*column.field);
+			auto const has_value(field.has_value(var));
+			if (has_value && info_column_type::FLAG != column.type)
+			{
+				m_values.reset(info_column_type::STRING == column.type ? bcf::value_type::CHAR : (
+					info_column_type::FLOAT == column.type || info_column_type::FLOAT_LIST == column.type ?
+					bcf::value_type::FLOAT :
+					bcf::value_type::INT32
+				));
+				m_values.begin_item();
+				field.output_bcf_value(m_values, var);
+			}
+
+			add_info_value(column, has_value);
+		}
+
+		// GT
+		if (m_gt_alleles)
+		{
+			update_format(var.get_format());
+			auto const &samples(var.samples());
+			libbio_always_assert_eq(m_sample_count, samples.size(), "Unexpected number of samples");
+			for (auto const &sample : samples)
+				add_genotype(m_gt_field && m_gt_field->has_value(sample) ? &(*m_gt_field)(sample) : nullptr);
+
+			m_gt_alleles->finish_item();
+			m_gt_phased->finish_item();
+		}
+
+		if (m_batch_size <= m_pos.length())
+			write_batch();
+	}
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_CONTIG_TABLE_HH
+#define LIBBIO_VCF_CONTIG_TABLE_HH
+
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/utility/compare_strings_transparent.hh>
+#include <libbio/utility/string_hash.hh>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	class metadata;
+	class shared_contig_table;
+
+
+	// Maps the CHROM values to dense integer identifiers. The contigs in the ##contig header lines get
+	// the identifiers 0, 1, … in header order, and the contigs not listed in the header are added in order
+	// of appearance. Hence the identifiers of the undeclared contigs are specific to one reader unless
+	// the readers share them with shared_contig_table.
+	class contig_table
+	{
+		friend shared_contig_table;
+
+	public:
+		typedef std::uint32_t	contig_index_type;
+
+		constexpr static inline contig_index_type const INVALID_INDEX{std::numeric_limits <contig_index_type>::max()};
+
+	protected:
+		typedef std::unordered_map <
+			std::string,
+			contig_index_type,
+			libbio::string_hash_transparent,
+			libbio::string_equal_to_transparent
+		>										index_map;
+
+	protected:
+		std::vector <std::string>	m_names;				// By index.
+		index_map					m_indices;				// By name.
+		shared_contig_table			*m_shared_contigs{};	// Not owned.
+		contig_index_type			m_prev_index{INVALID_INDEX};	// Consecutive records usually have the same CHROM.
+
+	protected:
+		inline contig_index_type add(std::string_view const name);
+		contig_index_type find_or_add_shared(std::string_view const name);
+
+	public:
+		// Assign the indices from the ##contig lines. The shared table is retained.
+		void reset(class metadata const &meta);
+
+		// Take the indices of the undeclared contigs from the given table, which needs to have been reset
+		// from the same header.
+		void set_shared_contigs(shared_contig_table &contigs) { m_shared_contigs = &contigs; }
+
+		contig_index_type size() const { return m_names.size(); }
+		std::string const &name(contig_index_type const idx) const { libbio_assert_lt(idx, m_names.size()); return m_names[idx]; }
+		std::vector <std::string> const &names() const { return m_names; }
+
+		// Returns INVALID_INDEX if not found.
+		inline contig_index_type find(std::string_view const name) const;
+		inline contig_index_type find_or_add(std::string_view const name);
+	};
+
+
+	auto contig_table::find(std::string_view const name) const -> contig_index_type
+	{
+		auto const it(m_indices.find(name));
+		return m_indices.end() == it ? INVALID_INDEX : it->second;
+	}
+
+
+	// Shares the indices of the contigs not listed in the header between the readers of one file,
+	// e.g. the chunk readers of parallel_reader. A reader locks the table only when it encounters
+	// a contig that it has not seen before.
+	class shared_contig_table
+	{
+		friend contig_table;
+
+	protected:
+		contig_table	m_contigs;
+		std::mutex		m_mutex;
+
+	public:
+		void reset(contig_table const &contigs);
+
+		// Not thread-safe.
+		contig_table const &contigs() const { return m_contigs; }
+	};
+
+
+	auto contig_table::add(std::string_view const name) -> contig_index_type
+	{
+		libbio_always_assert_lt(m_names.size(), INVALID_INDEX);
+		contig_index_type const retval(m_names.size());
+		m_indices.emplace(name, retval);
+		m_names.emplace_back(name);
+		return retval;
+	}
+
+
+	auto contig_table::find_or_add(std::string_view const name) -> contig_index_type
+	{
+		if (INVALID_INDEX != m_prev_index && m_names[m_prev_index] == name)
+			return m_prev_index;
+
+		auto const it(m_indices.find(name));
+		if (m_indices.end() != it)
+			m_prev_index = it->second;
+		else if (m_shared_contigs)
+			m_prev_index = find_or_add_shared(name);
+		else
+			m_prev_index = add(name);
+
+		return m_prev_index;
+	}
+}
+
+#endif
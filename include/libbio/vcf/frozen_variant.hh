@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_FROZEN_VARIANT_HH
+#define LIBBIO_VCF_FROZEN_VARIANT_HH
+
+#include <cstddef>
+#include <cstring>
+#include <libbio/arena.hh>
+#include <libbio/assert.hh>
+#include <libbio/vcf/contig_table.hh>
+#include <libbio/vcf/metadata.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/variant_format.hh>
+#include <libbio/vcf/variant_printer.hh>
+#include <libbio/vcf/vcf_reader_decl.hh>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Genotype values of a frozen_variant. The values are accessed with the genotype fields’ operator().
+	class frozen_variant_sample
+	{
+		friend class frozen_variant_buffer;
+		friend class genotype_field_base;
+
+	protected:
+		std::byte const			*m_sample_data{};
+		std::span <bool const>	m_assigned_genotype_fields{};
+
+	public:
+		std::span <bool const> assigned_genotype_fields() const { return m_assigned_genotype_fields; }
+	};
+
+
+	// Read-only copy of a variant that is stored in an arena. The INFO and genotype values are
+	// stored in their typed form; strings and vectors are replaced with views to the arena
+	// (see detail::frozen_value). The values are accessed with the fields’ operator().
+	// The copy is valid until the arena is released.
+	class frozen_variant
+	{
+		friend class frozen_variant_buffer;
+		friend class info_field_base;
+
+	public:
+		typedef metadata_filter const			*filter_ptr;
+		typedef std::string_view				string_type;
+		typedef variant_alt <string_type>		variant_alt_type;
+		typedef frozen_variant_sample			sample_type;
+
+	protected:
+		struct record
+		{
+			class reader const						*reader{};
+			variant_format const					*format{};		// Retained by frozen_variant_buffer.
+			std::byte const							*info{};
+			std::string_view						chrom_id{};
+			std::string_view						ref{};
+			std::span <std::string_view const>		id{};
+			std::span <variant_alt_type const>		alts{};
+			std::span <sample_type const>			samples{};
+			std::span <filter_ptr const>			filters{};
+			std::span <bool const>					assigned_info_fields{};
+			double									qual{abstract_variant::UNKNOWN_QUALITY};
+			std::size_t								pos{};
+			std::size_t								variant_index{};
+			std::size_t								lineno{};
+			contig_table::contig_index_type			contig_index{contig_table::INVALID_INDEX};
+		};
+
+	protected:
+		record const	*m_record{};
+
+	protected:
+		explicit frozen_variant(record const *rec): m_record(rec) {}
+
+	public:
+		frozen_variant() = default;
+
+		bool empty() const { return !m_record; }
+		class reader const *reader() const { return m_record ? m_record->reader : nullptr; }
+		variant_format const &get_format() const { return *m_record->format; }
+		std::string_view chrom_id() const { return m_record->chrom_id; }
+		std::string_view ref() const { return m_record->ref; }
+		std::span <std::string_view const> id() const { return m_record->id; }
+		std::span <variant_alt_type const> alts() const { return m_record->alts; }
+		std::span <sample_type const> samples() const { return m_record->samples; }
+		std::span <filter_ptr const> filters() const { return m_record->filters; }
+		std::span <bool const> assigned_info_fields() const { return m_record->assigned_info_fields; }
+		double qual() const { return m_record->qual; }
+		std::size_t pos() const { return m_record->pos; }
+		std::size_t zero_based_pos() const { libbio_always_assert_neq(0, m_record->pos, "Unexpected position"); return m_record->pos - 1; }
+		std::size_t variant_index() const { return m_record->variant_index; }
+		std::size_t lineno() const { return m_record->lineno; }
+		contig_table::contig_index_type contig_index() const { return m_record->contig_index; }
+
+		inline void output_vcf(std::ostream &os) const;
+	};
+
+
+	// Makes frozen copies of variants. The INFO and sample buffers are copied field by field, so copying
+	// a variant takes no allocations other than from the arena once the arena has grown to fit the records.
+	// release() invalidates all of the copies at once.
+	class frozen_variant_buffer
+	{
+	protected:
+		typedef frozen_variant::record	record;
+
+	protected:
+		libbio::arena						m_arena;
+		std::vector <variant_format_ptr>	m_formats;	// Keeps the formats of the copies available.
+
+	public:
+		frozen_variant_buffer() = default;
+
+		explicit frozen_variant_buffer(std::size_t const block_size):
+			m_arena(block_size)
+		{
+		}
+
+		template <typename t_string, typename t_format_access>
+		frozen_variant freeze(formatted_variant <t_string, t_format_access> const &var);
+
+		void release() { m_arena.release(); m_formats.clear(); }
+		void clear() { m_arena.clear(); m_formats.clear(); }
+		libbio::arena const &memory() const { return m_arena; }
+
+	protected:
+		record *copy_common(abstract_variant const &var, variant_format_ptr const &format);
+		std::span <bool const> copy_flags(std::vector <bool> const &flags);
+		std::byte *allocate_buffer(aligned_buffer <std::byte, buffer_base::zero_tag> const &src);
+	};
+
+
+	template <typename t_string, typename t_format_access>
+	frozen_variant frozen_variant_buffer::freeze(formatted_variant <t_string, t_format_access> const &var)
+	{
+		if (!var.reader())
+			return {};
+
+		auto &format(var.get_format());
+		auto *rec(copy_common(var, var.get_format_ptr()));
+
+		// CHROM, REF, ID, ALT.
+		rec->chrom_id = m_arena.copy(var.chrom_id());
+		rec->ref = m_arena.copy(var.ref());
+
+		{
+			auto const &id(var.id());
+			auto *dst(m_arena.allocate_array <std::string_view>(id.size()));
+			for (std::size_t idx{}; idx < id.size(); ++idx)
+				new (dst + idx) std::string_view(m_arena.copy(id[idx]));
+			rec->id = std::span(dst, id.size());
+		}
+
+		{
+			typedef frozen_variant::variant_alt_type alt_type;
+			auto const &alts(var.alts());
+			auto *dst(m_arena.allocate_array <alt_type>(alts.size()));
+			for (std::size_t idx{}; idx < alts.size(); ++idx)
+			{
+				auto *alt(new (dst + idx) alt_type{});
+				alt->alt_sv_type = alts[idx].alt_sv_type;
+				alt->alt = m_arena.copy(alts[idx].alt);
+			}
+			rec->alts = std::span(dst, alts.size());
+		}
+
+		// INFO.
+		if (auto *info = allocate_buffer(var.m_info))
+		{
+			auto const *src(var.m_info.get());
+			for (auto const *field_ptr : var.reader()->info_fields_in_headers())
+			{
+				if (field_ptr->has_value(var))
+					field_ptr->freeze_ds(var, src, info, m_arena);
+			}
+			rec->info = info;
+		}
+
+		// Samples.
+		auto const &samples(var.samples());
+		auto *dst_samples(m_arena.allocate_array <frozen_variant_sample>(samples.size()));
+		for (std::size_t idx{}; idx < samples.size(); ++idx)
+		{
+			auto const &sample(samples[idx]);
+			auto *dst(new (dst_samples + idx) frozen_variant_sample{});
+			dst->m_assigned_genotype_fields = copy_flags(sample.m_assigned_genotype_fields);
+			if (auto *sample_data = allocate_buffer(sample.m_sample_data))
+			{
+				auto const *src(sample.m_sample_data.get());
+				for (auto const &[key, field_ptr] : format.fields_by_identifier())
+				{
+					if (field_ptr->has_value(sample))
+						field_ptr->freeze_ds(sample, src, sample_data, m_arena);
+				}
+				dst->m_sample_data = sample_data;
+			}
+		}
+		rec->samples = std::span(dst_samples, samples.size());
+
+		return frozen_variant(rec);
+	}
+
+
+	void frozen_variant::output_vcf(std::ostream &os) const
+	{
+		variant_printer <frozen_variant> printer;
+		printer.output_variant(os, *this);
+	}
+
+
+	std::byte const *info_field_base::buffer_start(frozen_variant const &ct) const
+	{
+		return ct.m_record->info;
+	}
+
+
+	bool info_field_base::has_value(frozen_variant const &var) const
+	{
+		libbio_assert(m_metadata);
+		return var.assigned_info_fields()[m_metadata->get_index()];
+	}
+
+
+	bool info_field_base::output_vcf_value(std::ostream &stream, frozen_variant const &var, char const *sep) const
+	{
+		if (!has_value(var))
+			return false;
+
+		stream << sep << m_metadata->get_id();
+		if (metadata_value_type::FLAG != metadata_value_type())
+		{
+			stream << '=';
+			output_frozen_vcf_value(stream, buffer_start(var));
+		}
+		return true;
+	}
+
+
+	std::byte const *genotype_field_base::buffer_start(frozen_variant_sample const &vs) const
+	{
+		return vs.m_sample_data;
+	}
+
+
+	bool genotype_field_base::has_value(frozen_variant_sample const &sample) const
+	{
+		libbio_assert_neq(m_index, INVALID_INDEX);
+		return sample.m_assigned_genotype_fields[m_index];
+	}
+
+
+	void genotype_field_base::output_vcf_value(std::ostream &stream, frozen_variant_sample const &sample) const
+	{
+		if (has_value(sample))
+			output_frozen_vcf_value(stream, buffer_start(sample));
+		else
+			stream << '.';
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_GENOTYPE_MATRIX_HH
+#define LIBBIO_VCF_GENOTYPE_MATRIX_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/int_matrix.hh>
+#include <libbio/int_vector.hh>
+#include <libbio/matrix/indexing.hh>
+#include <libbio/vcf/parallel_reader.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/variant_format.hh>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Allele numbers of one variant with more than two alleles. The width of the values is determined by
+	// the largest allele number of the variant.
+	struct multiallelic_column
+	{
+		std::size_t		variant_idx{};
+		int_vector <0>	alleles;	// One value per haplotype.
+	};
+
+
+	// Genotypes of a set of variants as column-major matrices. Each column stores the haplotypes of one variant,
+	// i.e. row sample_idx * ploidy + chr_copy_idx. The allele numbers of biallelic variants are stored in a bit
+	// matrix; the remaining variants are stored separately with a width that fits their largest allele number.
+	// Missing alleles are stored as zero.
+	struct genotype_matrix
+	{
+		bit_matrix							alleles;				// Zero in the columns of multiallelic variants.
+		bit_matrix							phased;					// Value of sample_genotype::is_phased.
+		bit_matrix							missing;				// Set for missing and null alleles and for haplotypes beyond the sample’s ploidy.
+		std::vector <multiallelic_column>	multiallelic_columns;	// Sorted by variant_idx.
+		std::uint16_t						ploidy{};
+
+		std::size_t haplotype_count() const { return alleles.number_of_rows(); }
+		std::size_t variant_count() const { return alleles.number_of_columns(); }
+		std::size_t idx(std::size_t const variant_idx, std::size_t const haplotype_idx) const { return libbio::detail::matrix_index(haplotype_idx, variant_idx, haplotype_count()); }
+		inline multiallelic_column const *find_multiallelic_column(std::size_t const variant_idx) const;
+		inline std::uint16_t allele(std::size_t const variant_idx, std::size_t const haplotype_idx) const;
+		bool is_phased(std::size_t const variant_idx, std::size_t const haplotype_idx) const { return phased.values()[idx(variant_idx, haplotype_idx)]; }
+		bool is_missing(std::size_t const variant_idx, std::size_t const haplotype_idx) const { return missing.values()[idx(variant_idx, haplotype_idx)]; }
+	};
+
+
+	// Appends the GT values of each variant to a genotype_matrix. The GT field is looked up again only when
+	// the variant format changes.
+	class genotype_matrix_builder
+	{
+	protected:
+		genotype_matrix					m_matrix;
+		std::vector <std::uint16_t>		m_column_buffer;	// Allele numbers of the current variant.
+		variant_format const			*m_format{};
+		genotype_field_gt const			*m_gt_field{};
+		std::size_t						m_variant_count{};
+
+	public:
+		genotype_matrix_builder() = default;
+		explicit genotype_matrix_builder(std::size_t const sample_count, std::uint16_t const ploidy = 2);
+
+		void add_variant(transient_variant const &var);
+
+		std::size_t variant_count() const { return m_variant_count; }
+
+		// Move the matrix out of the builder.
+		genotype_matrix finish();
+
+		// Concatenate the columns of the given matrices, which need to have the same number of haplotypes.
+		static genotype_matrix concatenate(std::vector <genotype_matrix> const &matrices);
+	};
+
+
+	// Parse the records of the given reader in parallel and build the matrix from the chunks in file order.
+	genotype_matrix build_genotype_matrix(
+		parallel_reader &reader,
+		std::uint16_t const ploidy = 2,
+		dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue()
+	);
+
+
+	auto genotype_matrix::find_multiallelic_column(std::size_t const variant_idx) const -> multiallelic_column const *
+	{
+		auto const it(std::partition_point(multiallelic_columns.begin(), multiallelic_columns.end(), [variant_idx](auto const &column){
+			return column.variant_idx < variant_idx;
+		}));
+		if (multiallelic_columns.end() == it || it->variant_idx != variant_idx)
+			return nullptr;
+		return &*it;
+	}
+
+
+	std::uint16_t genotype_matrix::allele(std::size_t const variant_idx, std::size_t const haplotype_idx) const
+	{
+		if (auto const *column(find_multiallelic_column(variant_idx)); column)
+			return column->alleles[haplotype_idx];
+		return alleles.values()[idx(variant_idx, haplotype_idx)];
+	}
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_INDEXED_REGION_PARSER_HH
+#define LIBBIO_VCF_INDEXED_REGION_PARSER_HH
+
+#include <cstddef>
+#include <libbio/vcf/contig_table.hh>
+#include <libbio/vcf/interval_index.hh>
+#include <libbio/vcf/offset_index.hh>
+#include <libbio/vcf/vcf_reader_decl.hh>
+#include <string_view>
+
+
+namespace libbio::vcf {
+
+	// Parses the records whose positions are contained in the intervals of an interval_index.
+	// The reader is moved to the regions with an offset_index, so the input needs to be seekable.
+	// Records between the regions that are not skipped with the offset index are rejected
+	// after parsing CHROM and POS. The chromosomes are handled in file order.
+	class indexed_region_parser final : public variant_validator
+	{
+	protected:
+		reader								*m_reader{};
+		offset_index const					*m_offset_index{};
+		interval_index const				*m_intervals{};
+		chromosome_interval_index const		*m_chr_intervals{};
+		offset_index::entry const			*m_next_entry{};		// Non-null if the reader should be moved.
+		std::string_view					m_chr_id;
+		contig_table::contig_index_type		m_contig_index{contig_table::INVALID_INDEX};
+		std::size_t							m_seek_count{};
+
+	public:
+		indexed_region_parser(reader &vcf_reader, offset_index const &offsets, interval_index const &intervals):
+			m_reader(&vcf_reader),
+			m_offset_index(&offsets),
+			m_intervals(&intervals)
+		{
+		}
+
+		// Requires that at least CHROM and POS are parsed.
+		void parse(reader::callback_cq_fn const &callback);
+
+		variant_validation_result validate(transient_variant const &var) override;
+
+		std::size_t seek_count() const { return m_seek_count; }
+	};
+}
+
+#endif
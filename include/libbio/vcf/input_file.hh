@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_INPUT_FILE_HH
+#define LIBBIO_VCF_INPUT_FILE_HH
+
+#include <libbio/assert.hh>
+#include <libbio/vcf/vcf_input.hh>
+#include <memory>
+#include <string>
+
+
+namespace libbio::vcf {
+
+	// Opens a VCF, BCF or BGZF-compressed BCF file. The format is determined from the beginning of the file.
+	// VCF and uncompressed BCF are memory-mapped.
+	class input_file
+	{
+	public:
+		enum class format_type
+		{
+			vcf,
+			bcf,
+			bgzf_bcf
+		};
+
+	protected:
+		mmap_input						m_mmap_input;	// Also holds the mapping of uncompressed BCF.
+		std::unique_ptr <input_base>	m_bcf_input;
+		format_type						m_format{format_type::vcf};
+
+	public:
+		void open(std::string const &path); // throws
+
+		format_type format() const { return m_format; }
+		input_base &input() { if (m_bcf_input) return *m_bcf_input; return m_mmap_input; }
+		input_base const &input() const { if (m_bcf_input) return *m_bcf_input; return m_mmap_input; }
+	};
+}
+
+#endif
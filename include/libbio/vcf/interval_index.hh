@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_INTERVAL_INDEX_HH
+#define LIBBIO_VCF_INTERVAL_INDEX_HH
+
+#include <cstddef>
+#include <libbio/bed_reader.hh>
+#include <libbio/utility/string_hash.hh>
+#include <libbio/vcf/region_variant_validator.hh>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Half-open intervals of one chromosome sorted by the start position. max_ends[i] is the largest end
+	// position of ranges[0, i], which makes it possible to answer the queries with binary search
+	// without merging the intervals.
+	struct chromosome_interval_index
+	{
+		constexpr static inline std::size_t const NOT_FOUND{std::numeric_limits <std::size_t>::max()};
+
+		position_range_vector		ranges;
+		std::vector <std::size_t>	max_ends;
+
+		void finish();
+
+		// Whether pos is contained in some interval.
+		bool contains(std::size_t const pos) const;
+
+		// The first position ≥ pos that is contained in some interval or NOT_FOUND.
+		std::size_t next_contained_position(std::size_t const pos) const;
+	};
+
+
+	class interval_index
+	{
+	public:
+		typedef std::unordered_map <
+			std::string,
+			chromosome_interval_index,
+			libbio::string_hash_transparent,
+			libbio::string_equal_to_transparent
+		> chromosome_map;
+
+	protected:
+		chromosome_map	m_chromosomes;
+
+	public:
+		// Call finish() after adding the intervals.
+		void add_interval(std::string_view const chr_id, std::size_t const begin, std::size_t const end);
+		void finish();
+
+		chromosome_map const &chromosomes() const { return m_chromosomes; }
+		inline chromosome_interval_index const *find(std::string_view const chr_id) const;
+		inline bool contains(std::string_view const chr_id, std::size_t const pos) const;
+	};
+
+
+	// Base class for a BED reader delegate that builds an interval_index.
+	class interval_index_bed_reader_delegate : public bed_reader_delegate // Not final.
+	{
+	protected:
+		interval_index	*m_index{};
+
+	public:
+		interval_index_bed_reader_delegate(interval_index &index):
+			m_index(&index)
+		{
+		}
+
+		virtual ~interval_index_bed_reader_delegate() {}
+
+		void bed_reader_found_region(std::string_view const chr_id, std::size_t const begin, std::size_t const end) override { m_index->add_interval(chr_id, begin, end); }
+		void bed_reader_did_finish() override { m_index->finish(); }
+
+		// Define in a subclass:
+		// void bed_reader_reported_error(std::size_t const lineno) override
+	};
+
+
+	chromosome_interval_index const *interval_index::find(std::string_view const chr_id) const
+	{
+		auto const it(m_chromosomes.find(chr_id));
+		return (m_chromosomes.end() == it ? nullptr : &it->second);
+	}
+
+
+	bool interval_index::contains(std::string_view const chr_id, std::size_t const pos) const
+	{
+		auto const *chr(find(chr_id));
+		return chr && chr->contains(pos);
+	}
+}
+
+#endif
@@ -64,12 +64,15 @@ namespace libbio::vcf {
 		friend class reader;
 
 	protected:
-		std::uint16_t	m_header_index{};
+		std::uint32_t	m_header_index{};	// Position among all of the header lines.
 		std::uint16_t	m_index{};
+		std::int32_t	m_idx{-1};		// Value of the IDX field (used in BCF) or -1 if not given.
 
 	public:
-		constexpr std::uint16_t get_header_index() const { return m_header_index; }
+		constexpr std::uint32_t get_header_index() const { return m_header_index; }
 		constexpr std::uint16_t get_index() const { return m_index; }
+		constexpr std::int32_t get_idx() const { return m_idx; }
+		constexpr bool has_idx() const { return 0 <= m_idx; }
 
 	public:
 		virtual ~metadata_base() {}
@@ -93,6 +96,10 @@ namespace libbio::vcf {
 		virtual void set_number_unknown()								{ throw std::runtime_error("Not implemented"); }
 
 		virtual void set_value_type(metadata_value_type const vt)		{ throw std::runtime_error("Not implemented"); }
+		void set_idx(std::int32_t const val)							{ m_idx = val; }
+
+		// Output “,IDX=n” if the value was given.
+		void output_idx(std::ostream &stream) const;
 
 	public:
 		virtual metadata_type type() const = 0;
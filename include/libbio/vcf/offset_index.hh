@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_OFFSET_INDEX_HH
+#define LIBBIO_VCF_OFFSET_INDEX_HH
+
+#include <cstddef>
+#include <istream>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_reader_decl.hh>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Byte offsets of every nth record and the first record of each chromosome in an uncompressed VCF file.
+	// The index is built during a normal parse by calling add_variant() for each record. The records are
+	// assumed to be sorted by position within each chromosome.
+	class offset_index
+	{
+	public:
+		constexpr static inline std::size_t const DEFAULT_INTERVAL{1024};
+
+		struct entry
+		{
+			std::size_t	chrom_idx{};
+			std::size_t	pos{};
+			std::size_t	offset{};
+			std::size_t	lineno{};
+			std::size_t	variant_index{};
+		};
+
+		struct chromosome
+		{
+			std::string	id;
+			std::size_t	first_entry{};
+			std::size_t	entry_limit{};
+		};
+
+		typedef std::vector <entry>			entry_vector;
+		typedef std::vector <chromosome>	chromosome_vector;
+
+	protected:
+		entry_vector						m_entries;
+		chromosome_vector					m_chromosomes;
+		std::size_t							m_interval{DEFAULT_INTERVAL};
+		std::size_t							m_records_since_last_entry{};
+
+	public:
+		offset_index() = default;
+
+		explicit offset_index(std::size_t const interval):
+			m_interval(interval)
+		{
+		}
+
+		// Call with each parsed record in file order.
+		void add_variant(reader const &vcf_reader, transient_variant const &var);
+
+		// Position the reader at the last indexed record of the given chromosome before pos, i.e. the records
+		// with smaller POS still need to be skipped. Returns false if the chromosome is not in the index.
+		bool seek(reader &vcf_reader, std::string_view const chrom_id, std::size_t const pos) const;
+
+		// Find the last entry before the given position.
+		entry const *find(std::string_view const chrom_id, std::size_t const pos) const;
+
+		entry_vector const &entries() const { return m_entries; }
+		chromosome_vector const &chromosomes() const { return m_chromosomes; }
+		std::size_t interval() const { return m_interval; }
+
+		// Tab-separated text, one entry per line.
+		void output(std::ostream &os) const;
+		void read(std::istream &is);
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_PARALLEL_READER_HH
+#define LIBBIO_VCF_PARALLEL_READER_HH
+
+#include <cstddef>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/dispatch/queue.hh>
+#include <libbio/vcf/constants.hh>
+#include <libbio/vcf/contig_table.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_input.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Parses the records of a memory-mapped VCF file in newline-aligned chunks on a parallel queue.
+	// Each chunk is parsed by a separate reader that receives the header span of the file followed by the chunk.
+	// The chunk readers do not share the subfield descriptors with each other b.c. the genotype field
+	// offsets are reassigned whenever the format changes. They do share the contig indices, though,
+	// so the contigs not listed in the header have the same index in every chunk.
+	class parallel_reader
+	{
+	public:
+		typedef std::function <void(reader &)>									reader_setup_fn;		// Called before reading the header.
+		typedef std::function <bool(std::size_t, transient_variant const &)>	unordered_callback_fn;	// Takes the chunk index.
+		typedef std::function <void(std::size_t)>								chunk_count_fn;			// Called with the number of chunks before parsing.
+		typedef std::function <bool(variant const &)>							ordered_callback_fn;
+		typedef std::vector <std::string_view>									chunk_vector;
+
+		constexpr static inline std::size_t const DEFAULT_CHUNK_SIZE{16 * 1024 * 1024};
+
+	protected:
+		mmap_input						*m_input{};
+		reader							m_reader;			// Parses the header.
+		shared_contig_table				m_contigs;
+		reader_setup_fn					m_setup_fn;
+		std::string_view				m_header;
+		std::size_t						m_chunk_size{DEFAULT_CHUNK_SIZE};
+		std::size_t						m_max_pending_chunks{2 * (std::thread::hardware_concurrency() ?: 1)};
+		field							m_parsed_fields{};
+		reader::sample_number_vector	m_parsed_samples;
+
+	public:
+		explicit parallel_reader(mmap_input &input, reader_setup_fn setup_fn = {}):
+			m_input(&input),
+			m_reader(input),
+			m_setup_fn(std::move(setup_fn))
+		{
+		}
+
+		// The header reader may be used for accessing the metadata and the sample names.
+		// Note that the variants passed to the callbacks refer to the chunk readers.
+		reader &header_reader() { return m_reader; }
+		reader const &header_reader() const { return m_reader; }
+		std::string_view header() const { return m_header; }
+
+		// Includes the contigs not listed in the header after parsing. Not thread-safe.
+		contig_table const &contigs() const { return m_contigs.contigs(); }
+
+		std::size_t chunk_size() const { return m_chunk_size; }
+		void set_chunk_size(std::size_t const size) { libbio_always_assert_lt(0, size); m_chunk_size = size; }
+		std::size_t max_pending_chunks() const { return m_max_pending_chunks; }
+		void set_max_pending_chunks(std::size_t const count) { libbio_always_assert_lt(0, count); m_max_pending_chunks = count; }
+		inline void set_parsed_fields(field const max_field);
+		void set_parsed_samples(reader::sample_number_vector const &sample_numbers) { m_parsed_samples = sample_numbers; }
+
+		void read_header();
+		chunk_vector make_chunks() const;
+
+		// Calls the callback from the worker threads in arbitrary order. The line numbers and
+		// the variant indices are relative to the beginning of the chunk.
+		void parse_unordered(unordered_callback_fn const &callback, dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue()) { parse_unordered({}, callback, queue); }
+		void parse_unordered(chunk_count_fn const &chunk_count_callback, unordered_callback_fn const &callback, dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue());
+
+		// Copies the variants of each chunk and calls the callback serially in file order from a worker thread.
+		// The variants are valid only during the callback since the chunk reader is deallocated after it has been
+		// called for each variant in the chunk.
+		void parse_ordered(ordered_callback_fn const &callback, dispatch::parallel_queue &queue = dispatch::parallel_queue::shared_queue());
+
+	protected:
+		void prepare_chunk_reader(reader &chunk_reader);
+	};
+
+
+	void parallel_reader::set_parsed_fields(field const max_field)
+	{
+		m_parsed_fields = max_field;
+		m_reader.set_parsed_fields(max_field);
+	}
+}
+
+#endif
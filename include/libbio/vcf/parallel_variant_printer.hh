@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_PARALLEL_VARIANT_PRINTER_HH
+#define LIBBIO_VCF_PARALLEL_VARIANT_PRINTER_HH
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <libbio/bounded_mpmc_queue.hh>
+#include <libbio/buffered_writer/buffered_writer_base.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/variant_printer.hh>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>								// std::thread::hardware_concurrency()
+#include <vector>
+
+#if defined(LIBBIO_ENABLE_BGZF_COMPRESSOR) && LIBBIO_ENABLE_BGZF_COMPRESSOR
+#	include <libbio/bgzf/writer.hh>
+#endif
+
+
+namespace libbio::vcf {
+
+	class parallel_variant_printer;
+}
+
+
+namespace libbio::vcf::detail {
+
+	// Appends the output to a reused string.
+	class string_output_buffer final : public std::streambuf
+	{
+	protected:
+		std::string	m_buffer;
+
+	public:
+		std::string_view view() const { return m_buffer; }
+		void clear() { m_buffer.clear(); }
+
+	protected:
+		int_type overflow(int_type const ch) override
+		{
+			if (!traits_type::eq_int_type(ch, traits_type::eof()))
+				m_buffer.push_back(traits_type::to_char_type(ch));
+			return traits_type::not_eof(ch);
+		}
+
+		std::streamsize xsputn(char const *data, std::streamsize const count) override
+		{
+			m_buffer.append(data, count);
+			return count;
+		}
+	};
+
+
+	struct parallel_variant_printer_task
+	{
+		std::vector <variant>		variants;		// Reused.
+		string_output_buffer		buffer;
+		std::ostream				stream{&buffer};
+		parallel_variant_printer	*printer{};
+		std::size_t					size{};
+		std::size_t					batch_index{};
+
+		void run();
+		void operator()() { run(); }
+	};
+}
+
+
+namespace libbio::vcf {
+
+	/*
+	 * Format variants as VCF records in parallel.
+	 *
+	 * The variants are copied into batches, which are formatted with the given printer into per-task
+	 * buffers in worker threads. The buffers are passed to the output function in order by the thread
+	 * that finishes the next batch, as in bgzf::writer. The number of batches in flight is limited by
+	 * the number of tasks; add_variant() blocks when all of them are in use. The printer’s member
+	 * functions need to be safe to call from multiple threads.
+	 */
+	class parallel_variant_printer
+	{
+		typedef detail::parallel_variant_printer_task	task_type;
+		typedef bounded_mpmc_queue <task_type>			task_queue_type;
+		typedef std::vector <task_type *>				task_ptr_vector;
+
+		friend task_type;
+
+	public:
+		typedef variant_printer_base <variant>			printer_type;
+		typedef std::function <void(std::string_view)>	output_fn;
+
+		constexpr static std::size_t const DEFAULT_BATCH_SIZE{256};
+
+	private:
+		task_queue_type									m_task_queue;
+		dispatch::group									m_group;
+		output_fn										m_output;
+		printer_type const								*m_printer{};
+		dispatch::queue									*m_queue{};
+		task_type										*m_current_task{};
+		std::size_t										m_batch_size{};
+		std::size_t										m_next_batch_index{};
+
+		std::mutex										m_mutex;				// Protects the variables below.
+		task_ptr_vector									m_finished_tasks;		// Min-heap by batch index.
+		std::size_t										m_next_written_batch_index{};
+		std::exception_ptr								m_exception;
+
+	private:
+		void task_did_finish(task_type &task, std::exception_ptr exc);
+		void rethrow_exception_if_needed();
+		inline task_type &current_task();
+
+	public:
+		parallel_variant_printer(
+			output_fn output,
+			printer_type const &printer,
+			std::size_t const task_count,					// (Likely) need to be less than the maximum number of threads to avoid deadlocks.
+			std::size_t const batch_size = DEFAULT_BATCH_SIZE,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		);
+
+		// The writers are accessed only from one thread at a time but not necessarily from the caller’s thread.
+		parallel_variant_printer(
+			buffered_writer_base &writer,
+			printer_type const &printer,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			std::size_t const batch_size = DEFAULT_BATCH_SIZE,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			parallel_variant_printer([&writer](std::string_view const sv){ writer << sv; }, printer, task_count, batch_size, queue)
+		{
+		}
+
+#if defined(LIBBIO_ENABLE_BGZF_COMPRESSOR) && LIBBIO_ENABLE_BGZF_COMPRESSOR
+		parallel_variant_printer(
+			bgzf::writer &writer,
+			printer_type const &printer,
+			std::size_t const task_count = (std::thread::hardware_concurrency() ?: 1),
+			std::size_t const batch_size = DEFAULT_BATCH_SIZE,
+			dispatch::queue &queue = dispatch::parallel_queue::shared_queue()
+		):
+			parallel_variant_printer([&writer](std::string_view const sv){ writer.write(sv); }, printer, task_count, batch_size, queue)
+		{
+		}
+#endif
+
+		~parallel_variant_printer();
+
+		// Copy the variant to the current batch. The reader needs to outlive the printer.
+		void add_variant(transient_variant const &var);
+		void add_variant(variant const &var);
+
+		// Pass the current batch to a worker thread.
+		void flush_batch();
+
+		// Format the remaining variants and wait until everything has been passed to the output function.
+		void finish();
+	};
+
+
+	auto parallel_variant_printer::current_task() -> task_type &
+	{
+		if (!m_current_task)
+		{
+			rethrow_exception_if_needed();
+			m_current_task = &m_task_queue.pop(); // Blocks when no more tasks are available.
+			m_current_task->size = 0;
+		}
+
+		return *m_current_task;
+	}
+}
+
+#endif
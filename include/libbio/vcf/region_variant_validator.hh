@@ -10,6 +10,7 @@
 #include <libbio/bed_reader.hh>
 #include <libbio/utility/compare_strings_transparent.hh>
 #include <libbio/utility/string_hash.hh>
+#include <libbio/vcf/contig_table.hh>
 #include <libbio/vcf/vcf_reader_decl.hh>
 #include <string>
 #include <string_view>
@@ -65,7 +66,7 @@ namespace libbio::vcf {
 		region_state_map				m_regions;
 		position_range_vector::iterator	m_range_it{};
 		position_range_vector::iterator	m_range_end{};
-		std::string						m_prev_chr_id;
+		contig_table::contig_index_type	m_prev_contig_index{contig_table::INVALID_INDEX};
 		std::size_t						m_prev_var_pos{};
 		std::size_t						m_chr_id_mismatches{};
 		std::size_t						m_position_mismatches{};
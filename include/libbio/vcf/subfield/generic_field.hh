@@ -22,6 +22,7 @@
 #include <libbio/vcf/subfield/utility/type_mapping.hh>
 #include <ostream>
 #include <string_view>
+#include <type_traits>
 
 
 namespace libbio::vcf::detail {
@@ -65,6 +66,14 @@ namespace libbio::vcf::detail {
 			detail::copy_value(srcv, dstv);
 		}
 
+		static void freeze_ds(t_field const &field, container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena)
+		{
+			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, field.m_offset);
+			libbio_assert(src);
+			libbio_assert(dst);
+			access_type::freeze_ds(src + field.m_offset, dst + field.m_offset, dst_arena);
+		}
+
 		static void reset(t_field const &field, container_type const &ct, std::byte *mem)
 		{
 			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, field.m_offset);
@@ -89,6 +98,18 @@ namespace libbio::vcf::detail {
 			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, field.m_offset);
 			access_type::output_vcf_value(stream, field.buffer_start(ct) + field.m_offset);
 		}
+
+		static void output_bcf_value(t_field const &field, bcf::value_buffer &dst, container_type const &ct)
+		{
+			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, field.m_offset);
+			access_type::output_bcf_value(dst, field.buffer_start(ct) + field.m_offset);
+		}
+
+		static void output_frozen_vcf_value(t_field const &field, std::ostream &stream, std::byte const *mem)
+		{
+			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, field.m_offset);
+			access_type::output_frozen_vcf_value(stream, mem + field.m_offset);
+		}
 	};
 
 
@@ -113,6 +134,8 @@ namespace libbio::vcf::detail {
 		typedef field_access_tpl <true>							transient_field_access;
 		typedef typename field_access::value_type				value_type;
 		typedef typename transient_field_access::value_type		transient_value_type;
+		typedef typename transient_field_access::frozen_value_type	frozen_value_type;
+		typedef typename t_base::frozen_container_type			frozen_container_type;
 
 	protected:
 		typedef generic_field_access <generic_field_tpl, false>	access_wrapper;
@@ -131,6 +154,16 @@ namespace libbio::vcf::detail {
 			transient_access_wrapper::output_vcf_value(*this, stream, ct);
 		}
 
+		virtual void output_bcf_value(bcf::value_buffer &dst, container_type const &ct) const override
+		{
+			access_wrapper::output_bcf_value(*this, dst, ct);
+		}
+
+		virtual void output_bcf_value(bcf::value_buffer &dst, transient_container_type const &ct) const override
+		{
+			transient_access_wrapper::output_bcf_value(*this, dst, ct);
+		}
+
 		// Operator().
 		// If typed_field is a base class, these actually override operator() but not otherwise.
 		// To solve this, we abuse the final keyword b.c. as it implies override.
@@ -158,6 +191,13 @@ namespace libbio::vcf::detail {
 			return val;
 		}
 
+		// Access a value in a frozen_variant or a frozen_variant_sample; the value has to be present.
+		frozen_value_type const &operator()(frozen_container_type const &ct) const
+		{
+			libbio_assert(this->m_metadata, "No metadata associated with VCF field (may not be present in VCF headers)");
+			return transient_field_access::access_frozen_ds(this->buffer_start(ct) + this->m_offset);
+		}
+
 	protected:
 		// Assume that the alignment and the size are close enough for both types.
 		// FIXME: alignment() and byte_size() could be made final in typed_field b.c. the value type is already known there.
@@ -223,6 +263,24 @@ namespace libbio::vcf::detail {
 		{
 			transient_access_wrapper::copy_ds(*this, src_ct, dst_ct, src, dst);
 		}
+
+		// Copy the data structure to a frozen copy.
+		virtual void freeze_ds(container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const override
+		{
+			access_wrapper::freeze_ds(*this, src_ct, src, dst, dst_arena);
+		}
+
+		virtual void freeze_ds(transient_container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const override
+		{
+			transient_access_wrapper::freeze_ds(*this, src_ct, src, dst, dst_arena);
+		}
+
+		// The frozen value types of the transient and the non-transient values are the same.
+		virtual void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) const override
+		{
+			static_assert(std::is_same_v <frozen_value_type, typename field_access::frozen_value_type>);
+			transient_access_wrapper::output_frozen_vcf_value(*this, stream, mem);
+		}
 	};
 
 
@@ -313,6 +371,12 @@ namespace libbio::vcf {
 			parser_type::parse_and_assign(sv, mem + this->m_offset, this->get_metadata());
 			return true; // FIXME: return parse_and_assign’s return value?
 		}
+
+		virtual bool assign_bcf_value(bcf::typed_value const &val, transient_variant &var, std::byte *mem) const override
+		{
+			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, this->m_offset);
+			return parser_type::assign_bcf_value(val, mem + this->m_offset, this->get_metadata());
+		}
 	};
 
 
@@ -345,6 +409,12 @@ namespace libbio::vcf {
 			return parser_type::parse_and_assign(sv, mem + this->m_offset, this->get_metadata());
 		}
 
+		virtual bool assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const override final
+		{
+			libbio_always_assert_neq(subfield_base::INVALID_OFFSET, this->m_offset);
+			return parser_type::assign_bcf_value(val, mem + this->m_offset, this->get_metadata());
+		}
+
 		template <typename t_container>
 		void output_vcf_value_(std::ostream &stream, t_container const &ct) const
 		{
@@ -17,11 +17,23 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 
 
+namespace libbio {
+	class arena; // Fwd.
+}
+
+
+namespace libbio::bcf {
+	struct typed_value; // Fwd.
+	class value_buffer; // Fwd.
+}
+
+
 namespace libbio::vcf::detail {
 	class metadata_setup_helper; // Fwd.
 }
@@ -29,6 +41,7 @@ namespace libbio::vcf::detail {
 
 namespace libbio::vcf {
 
+	class frozen_variant_sample;
 	class variant_format;
 
 
@@ -36,6 +49,7 @@ namespace libbio::vcf {
 	class genotype_field_base :	public subfield_base
 	{
 		friend class reader;
+		friend class frozen_variant_buffer;
 		friend class detail::metadata_setup_helper;
 
 		template <typename, typename>
@@ -56,6 +70,7 @@ namespace libbio::vcf {
 
 		typedef variant_sample_t <false>	container_type;
 		typedef variant_sample_t <true>		transient_container_type;
+		typedef frozen_variant_sample		frozen_container_type;
 
 	protected:
 		metadata_format	*m_metadata{};
@@ -89,16 +104,28 @@ namespace libbio::vcf {
 			std::byte *dst
 		) const = 0;
 
+		// Copy the value to a frozen copy’s buffer. Strings and vectors are copied to the arena.
+		virtual void freeze_ds(container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const = 0;
+		virtual void freeze_ds(transient_container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const = 0;
+
+		// Output the value in a frozen copy’s buffer.
+		virtual void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) const = 0;
+
 		// Parse the contents of a string_view and assign the value to the sample.
 		// Needs to be overridden.
 		virtual bool parse_and_assign(std::string_view const &sv, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const = 0;
 
+		// Assign one sample’s BCF typed value to the sample.
+		virtual bool assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const { throw std::runtime_error("Not implemented"); }
+
 		inline void prepare(transient_variant_sample &dst) const;
 		inline void parse_and_assign(std::string_view const &sv, transient_variant const &var, transient_variant_sample &dst) const;
+		inline void assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &dst) const;
 		virtual genotype_field_base *clone() const override = 0;
 
 		// Access the container’s buffer, for use with operator().
 		std::byte *buffer_start(variant_sample_base const &vs) const { return vs.m_sample_data.get(); }
+		inline std::byte const *buffer_start(frozen_variant_sample const &vs) const;
 
 	public:
 		constexpr std::uint16_t get_index() const { return m_index; }
@@ -110,12 +137,20 @@ namespace libbio::vcf {
 		virtual void output_vcf_value(std::ostream &stream, container_type const &ct) const = 0;
 		virtual void output_vcf_value(std::ostream &stream, transient_container_type const &ct) const = 0;
 
+		// Add the field contents to a BCF value buffer. The value has to be present in the container.
+		virtual void output_bcf_value(bcf::value_buffer &dst, container_type const &ct) const { throw std::runtime_error("Not implemented"); }
+		virtual void output_bcf_value(bcf::value_buffer &dst, transient_container_type const &ct) const { throw std::runtime_error("Not implemented"); }
+
+		// Output the field contents of a frozen sample or “.” if the value is not present.
+		inline void output_vcf_value(std::ostream &stream, frozen_variant_sample const &sample) const;
+
 		metadata_format *get_metadata() const final { return m_metadata; }
 
 		// Check whether the sample has a value for this genotype field.
 		// (The field could just be removed from FORMAT but instead the
 		// specification allows MISSING value to be specified. See VCF 4.3 Section 1.6.2.)
 		constexpr inline bool has_value(variant_sample_base const &sample) const;
+		inline bool has_value(frozen_variant_sample const &sample) const;
 
 		constexpr enum subfield_type subfield_type() const final { return subfield_type::GENOTYPE; }
 	};
@@ -31,6 +31,15 @@ namespace libbio::vcf {
 	}
 
 
+	void genotype_field_base::assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &dst) const
+	{
+		libbio_assert(m_metadata);
+		libbio_assert_neq(this->get_index(), INVALID_INDEX);
+		if (this->assign_bcf_value(val, var, dst, dst.m_sample_data.get()))
+			dst.m_assigned_genotype_fields[this->get_index()] = true;
+	}
+
+
 	constexpr bool genotype_field_base::has_value(variant_sample_base const &sample) const
 	{
 		libbio_assert_neq(this->get_index(), INVALID_INDEX);
@@ -35,6 +35,17 @@ namespace libbio::vcf::detail {
 		template <bool B>
 		using field_access_tpl = value_access;
 	};
+
+
+	// Allele number of a one-character GT part or UINT16_MAX if the character is neither a digit nor “.”.
+	constexpr inline std::uint16_t single_character_allele(char const cc)
+	{
+		if ('.' == cc)
+			return sample_genotype::NULL_ALLELE;
+		if ('0' <= cc && cc <= '9')
+			return cc - '0';
+		return UINT16_MAX;
+	}
 }
 
 
@@ -50,6 +61,7 @@ namespace libbio::vcf {
 
 	protected:
 		virtual bool parse_and_assign(std::string_view const &sv, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const override;
+		virtual bool assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const override;
 		virtual genotype_field_gt *clone() const override { return new genotype_field_gt(*this); }
 
 	public:
@@ -57,10 +69,24 @@ namespace libbio::vcf {
 		constexpr virtual enum metadata_value_type metadata_value_type() const override { return metadata_value_type::STRING; }
 		constexpr virtual std::int32_t number() const override { return 1; }
 
+		// Assign a diploid genotype that has already been parsed; used by vcf::reader for GT-only records.
+		inline void assign_diploid(transient_variant_sample &sample, sample_genotype const first, sample_genotype const second) const;
+
 		using detail::generic_field_tpl <genotype_field_gt_base>::output_vcf_value;
 		virtual void output_vcf_value(std::ostream &stream, container_type const &ct) const override { output_genotype(stream, (*this)(ct)); }
 		virtual void output_vcf_value(std::ostream &stream, transient_container_type const &ct) const override { output_genotype(stream, (*this)(ct)); }
+		virtual void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) const override { output_genotype(stream, transient_field_access::access_frozen_ds(mem + this->m_offset)); }
 	};
+
+
+	void genotype_field_gt::assign_diploid(transient_variant_sample &sample, sample_genotype const first, sample_genotype const second) const
+	{
+		libbio_assert_neq(this->get_index(), INVALID_INDEX);
+		auto *mem(sample.m_sample_data.get() + this->m_offset);
+		value_access::add_value(mem, first);
+		value_access::add_value(mem, second);
+		sample.m_assigned_genotype_fields[this->get_index()] = true;
+	}
 }
 
 #endif
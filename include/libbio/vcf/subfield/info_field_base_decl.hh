@@ -23,6 +23,17 @@
 #include <vector>
 
 
+namespace libbio {
+	class arena; // Fwd.
+}
+
+
+namespace libbio::bcf {
+	struct typed_value; // Fwd.
+	class value_buffer; // Fwd.
+}
+
+
 namespace libbio::vcf::detail {
 	class metadata_setup_helper; // Fwd.
 }
@@ -31,6 +42,7 @@ namespace libbio::vcf::detail {
 namespace libbio::vcf {
 
 	class abstract_variant;
+	class frozen_variant;
 	class metadata_info;
 
 
@@ -38,6 +50,7 @@ namespace libbio::vcf {
 	class info_field_base :	public subfield_base
 	{
 		friend class reader;
+		friend class frozen_variant_buffer;
 		friend class detail::metadata_setup_helper;
 
 		template <typename, typename>
@@ -50,6 +63,7 @@ namespace libbio::vcf {
 	public:
 		typedef variant_base_t <false>	container_type;
 		typedef variant_base_t <true>	transient_container_type;
+		typedef frozen_variant			frozen_container_type;
 
 		template <enum metadata_value_type M, bool B>
 		using typed_field_type = typed_info_field_t <M, B>;
@@ -85,6 +99,13 @@ namespace libbio::vcf {
 			std::byte *dst
 		) const = 0;
 
+		// Copy the value to a frozen copy’s buffer. Strings and vectors are copied to the arena.
+		virtual void freeze_ds(container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const = 0;
+		virtual void freeze_ds(transient_container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const = 0;
+
+		// Output the value in a frozen copy’s buffer.
+		virtual void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) const = 0;
+
 		// Parse the contents of a string_view and assign the value to the variant.
 		// Needs to be overridden.
 		virtual bool parse_and_assign(std::string_view const &sv, transient_variant &var, std::byte *mem) const = 0;
@@ -92,14 +113,19 @@ namespace libbio::vcf {
 		// Assign a value, used for FLAG.
 		virtual bool assign(std::byte *mem) const { throw std::runtime_error("Not implemented"); };
 
+		// Assign a BCF typed value to the variant. Not used for FLAG.
+		virtual bool assign_bcf_value(bcf::typed_value const &val, transient_variant &var, std::byte *mem) const { throw std::runtime_error("Not implemented"); }
+
 		// For use with reader and variant classes:
 		inline void prepare(transient_variant &dst) const;
 		inline void parse_and_assign(std::string_view const &sv, transient_variant &dst) const;
 		inline void assign_flag(transient_variant &dst) const;
+		inline void assign_bcf_value(bcf::typed_value const &val, transient_variant &dst) const;
 		virtual info_field_base *clone() const override = 0;
 
 		// Access the container’s buffer, for use with operator().
 		std::byte *buffer_start(abstract_variant const &ct) const { return ct.m_info.get(); }
+		inline std::byte const *buffer_start(frozen_variant const &ct) const;
 
 	public:
 		constexpr metadata_info *get_metadata() const final { return m_metadata; }
@@ -109,6 +135,10 @@ namespace libbio::vcf {
 		virtual void output_vcf_value(std::ostream &stream, container_type const &ct) const = 0;
 		virtual void output_vcf_value(std::ostream &stream, transient_container_type const &ct) const = 0;
 
+		// Add the field contents to a BCF value buffer. The value has to be present in the container.
+		virtual void output_bcf_value(bcf::value_buffer &dst, container_type const &ct) const { throw std::runtime_error("Not implemented"); }
+		virtual void output_bcf_value(bcf::value_buffer &dst, transient_container_type const &ct) const { throw std::runtime_error("Not implemented"); }
+
 		// Output the given separator and the field contents to a stream if the value in present in the variant.
 		template <typename t_string, typename t_format_access>
 		bool output_vcf_value(
@@ -117,8 +147,12 @@ namespace libbio::vcf {
 			char const *sep
 		) const;
 
+		// Output the given separator and the field contents to a stream if the value in present in the frozen variant.
+		inline bool output_vcf_value(std::ostream &stream, frozen_variant const &var, char const *sep) const;
+
 		// Check whether the variant has a value for this INFO field.
 		constexpr inline bool has_value(abstract_variant const &var) const;
+		inline bool has_value(frozen_variant const &var) const;
 
 		constexpr enum subfield_type subfield_type() const final { return subfield_type::INFO; }
 	};
@@ -32,6 +32,14 @@ namespace libbio::vcf {
 	}
 
 
+	void info_field_base::assign_bcf_value(bcf::typed_value const &val, transient_variant &dst) const
+	{
+		libbio_assert(m_metadata);
+		auto const did_assign(assign_bcf_value(val, dst, dst.m_info.get()));
+		dst.m_assigned_info_fields[m_metadata->get_index()] = did_assign;
+	}
+
+
 	constexpr bool info_field_base::has_value(abstract_variant const &var) const
 	{
 		libbio_assert(m_metadata);
@@ -50,9 +50,12 @@ namespace libbio::vcf::detail {
 			std::byte const *src,
 			std::byte *dst
 		) const override { /* No-op. */ }
+		constexpr void freeze_ds(container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const override { /* No-op. */ }
+		constexpr void freeze_ds(transient_container_type const &src_ct, std::byte const *src, std::byte *dst, arena &dst_arena) const override { /* No-op. */ }
 
 		constexpr void output_vcf_value(std::ostream &stream, container_type const &ct) const override { throw std::runtime_error("Should not be called; parse_and_assign returns false"); }
 		constexpr void output_vcf_value(std::ostream &stream, transient_container_type const &ct) const override { throw std::runtime_error("Should not be called; parse_and_assign returns false"); }
+		constexpr void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) const override { throw std::runtime_error("Should not be called; parse_and_assign returns false"); }
 	};
 }
 
@@ -62,6 +65,7 @@ namespace libbio::vcf {
 	class info_field_placeholder final : public detail::subfield_placeholder_base <info_field_base>
 	{
 		constexpr bool parse_and_assign(std::string_view const &sv, transient_variant &var, std::byte *mem) const override { /* No-op. */ return false; }
+		constexpr bool assign_bcf_value(bcf::typed_value const &val, transient_variant &var, std::byte *mem) const override { /* No-op. */ return false; }
 		info_field_placeholder *clone() const override { return new info_field_placeholder(*this); }
 	};
 
@@ -69,6 +73,7 @@ namespace libbio::vcf {
 	class genotype_field_placeholder final : public detail::subfield_placeholder_base <genotype_field_base>
 	{
 		constexpr bool parse_and_assign(std::string_view const &sv, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const override { /* No-op. */ return false; }
+		constexpr bool assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const override { /* No-op. */ return false; }
 		genotype_field_placeholder *clone() const override { return new genotype_field_placeholder(*this); }
 	};
 }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_SUBFIELD_FROZEN_VALUE_HH
+#define LIBBIO_VCF_SUBFIELD_FROZEN_VALUE_HH
+
+#include <cstddef>
+#include <libbio/arena.hh>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace libbio::vcf::detail {
+
+	// Value types in frozen_variant’s buffers. Strings and vectors are replaced with views
+	// to memory allocated from an arena, so the values need not be destroyed.
+	template <typename t_type>
+	struct frozen_value
+	{
+		typedef t_type type;
+		static_assert(std::is_trivially_destructible_v <type>);
+
+		static void freeze(t_type const &src, type &dst, arena &) { dst = src; }
+	};
+
+
+	template <>
+	struct frozen_value <std::string>
+	{
+		typedef std::string_view type;
+
+		static void freeze(std::string const &src, type &dst, arena &dst_arena) { dst = dst_arena.copy(src); }
+	};
+
+
+	template <>
+	struct frozen_value <std::string_view>
+	{
+		typedef std::string_view type;
+
+		static void freeze(std::string_view const src, type &dst, arena &dst_arena) { dst = dst_arena.copy(src); }
+	};
+
+
+	template <typename t_type>
+	struct frozen_value <std::vector <t_type>>
+	{
+		typedef frozen_value <t_type>			element_helper;
+		typedef typename element_helper::type	element_type;
+		typedef std::span <element_type const>	type;
+
+		static void freeze(std::vector <t_type> const &src, type &dst, arena &dst_arena)
+		{
+			if (src.empty())
+			{
+				dst = {};
+				return;
+			}
+
+			auto *elements(dst_arena.allocate_array <element_type>(src.size()));
+			for (std::size_t idx{}; idx < src.size(); ++idx)
+			{
+				auto *element(new (elements + idx) element_type{});
+				element_helper::freeze(src[idx], *element, dst_arena);
+			}
+			dst = type(elements, src.size());
+		}
+	};
+
+
+	template <typename t_type>
+	using frozen_value_t = typename frozen_value <t_type>::type;
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
 #include <libbio/vcf/constants.hh>
 #include <libbio/vcf/metadata.hh>
 #include <libbio/vcf/subfield/utility/access.hh>
@@ -32,12 +33,14 @@ namespace libbio::vcf {
 	{
 		typedef field_type_mapping_t <metadata_value_type::INTEGER, true>	value_type;
 		static bool parse(std::string_view const &sv, value_type &dst, metadata_formatted_field const *field);
+		static value_type bcf_value(bcf::typed_value const &val, std::size_t const idx) { return val.integer_at(idx); }
 	};
 
 	template <> struct subfield_parser <metadata_value_type::FLOAT> final : public subfield_parser_base
 	{
 		typedef field_type_mapping_t <metadata_value_type::FLOAT, true>	value_type;
 		static bool parse(std::string_view const &sv, value_type &dst, metadata_formatted_field const *field);
+		static value_type bcf_value(bcf::typed_value const &val, std::size_t const idx) { return val.float_at(idx); }
 	};
 
 	template <> struct subfield_parser <metadata_value_type::STRING> final : public subfield_parser_base
@@ -99,6 +102,37 @@ namespace libbio::vcf {
 			}
 			return true;
 		}
+
+		bool assign_bcf_value(bcf::typed_value const &val, std::byte *mem, metadata_formatted_field const *field) const
+		{
+			// mem needs to include the offset.
+			if constexpr (t_metadata_value_type == metadata_value_type::FLAG)
+				libbio_fail("assign_bcf_value should not be called for FLAG type fields");
+			else
+			{
+				if (val.is_missing())
+					return false;
+
+				typedef subfield_parser <t_metadata_value_type> parser_type;
+				if constexpr (parser_type::type_needs_parsing())
+				{
+					// As in parse_and_assign, missing values inside the vector are replaced with zero.
+					auto const count(val.value_count());
+					for (std::uint32_t i{}; i < count; ++i)
+					{
+						typename parser_type::value_type value{};
+						if (!val.is_missing_at(i))
+							value = parser_type::bcf_value(val, i);
+						field_access::add_value(mem, value);
+					}
+				}
+				else
+				{
+					field_access::add_value(mem, val.string());
+				}
+			}
+			return true;
+		}
 	};
 
 	// Non-specialization for values with zero elements.
@@ -110,6 +144,12 @@ namespace libbio::vcf {
 			libbio_fail("parse_and_assign should not be called for FLAG type fields");
 			return false;
 		}
+
+		constexpr bool assign_bcf_value(bcf::typed_value const &val, std::byte *mem, metadata_formatted_field const *field) const
+		{
+			libbio_fail("assign_bcf_value should not be called for FLAG type fields");
+			return false;
+		}
 	};
 
 	// Specialization for scalar values.
@@ -145,6 +185,26 @@ namespace libbio::vcf {
 
 			return true;
 		}
+
+		bool assign_bcf_value(bcf::typed_value const &val, std::byte *mem, metadata_formatted_field const *field) const
+		{
+			// mem needs to include the offset.
+			if constexpr (t_metadata_value_type == metadata_value_type::FLAG)
+				libbio_fail("assign_bcf_value should not be called for FLAG type fields");
+			else
+			{
+				typedef subfield_parser <t_metadata_value_type> parser_type;
+				if (val.is_missing())
+					return false;
+
+				if constexpr (parser_type::type_needs_parsing())
+					field_access::add_value(mem, parser_type::bcf_value(val, 0));
+				else
+					field_access::add_value(mem, val.string());
+			}
+
+			return true;
+		}
 	};
 }
 
@@ -9,7 +9,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <libbio/assert.hh>
+#include <libbio/bcf/value_buffer.hh>
 #include <libbio/vcf/constants.hh>
+#include <libbio/vcf/subfield/utility/frozen_value.hh>
 #include <libbio/vcf/subfield/utility/type_mapping.hh>
 #include <libbio/vcf/subfield/utility/vector_value_helper.hh>
 #include <libbio/vcf/metadata.hh>
@@ -25,7 +27,8 @@ namespace libbio::vcf {
 	template <typename t_type>
 	struct value_access_base
 	{
-		typedef t_type value_type;
+		typedef t_type								value_type;
+		typedef detail::frozen_value_t <value_type>	frozen_value_type;	// Stored in frozen_variant’s buffers.
 
 		// Not currently needed b.c. all memory for INFO fields and samples is preallocated.
 		//static_assert(std::is_trivially_move_constructible_v <value_type>);
@@ -75,6 +78,23 @@ namespace libbio::vcf {
 		}
 
 		static void output_vcf_value(std::ostream &stream, std::byte *mem) { stream << access_ds(mem); }
+		static void output_bcf_value(bcf::value_buffer &dst, std::byte *mem) { dst.add_value(access_ds(mem)); }
+
+		// Construct the frozen value in dst. The memory for strings and vectors is allocated from the arena.
+		static void freeze_ds(std::byte const *src, std::byte *dst, arena &dst_arena)
+		{
+			static_assert(sizeof(frozen_value_type) <= sizeof(value_type));
+			static_assert(alignof(frozen_value_type) <= alignof(value_type));
+			auto *dst_val(new (dst) frozen_value_type{});
+			detail::frozen_value <value_type>::freeze(access_ds(src), *dst_val, dst_arena);
+		}
+
+		constexpr static frozen_value_type const &access_frozen_ds(std::byte const *mem)
+		{
+			return *reinterpret_cast <frozen_value_type const *>(mem);
+		}
+
+		static void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem) { stream << access_frozen_ds(mem); }
 	};
 
 
@@ -93,6 +113,11 @@ namespace libbio::vcf {
 			auto const value(access_ds(mem));
 			::libbio::vcf::output_vcf_value(stream, value);
 		}
+
+		static void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem)
+		{
+			::libbio::vcf::output_vcf_value(stream, access_frozen_ds(mem));
+		}
 	};
 
 
@@ -115,10 +140,12 @@ namespace libbio::vcf {
 	struct vector_value_access : public object_value_access <std::vector <t_element_type>>
 	{
 		static_assert(value_count_corresponds_to_vector(t_number));
-		typedef std::vector <t_element_type>	vector_type;
-		typedef vector_type						value_type;
+		typedef std::vector <t_element_type>							vector_type;
+		typedef vector_type												value_type;
+		typedef typename object_value_access <vector_type>::frozen_value_type	frozen_value_type;
 
 		using object_value_access <vector_type>::access_ds;
+		using object_value_access <vector_type>::access_frozen_ds;
 
 		template <typename t_metadata>
 		static void construct_ds(std::byte *mem, std::uint16_t const alt_count, t_metadata const &metadata)
@@ -145,6 +172,18 @@ namespace libbio::vcf {
 			auto const &vec(access_ds(mem));
 			ranges::copy(vec, ranges::make_ostream_joiner(stream, ","));
 		}
+
+		static void output_bcf_value(bcf::value_buffer &dst, std::byte *mem)
+		{
+			for (auto const &val : access_ds(mem))
+				dst.add_value(val);
+		}
+
+		static void output_frozen_vcf_value(std::ostream &stream, std::byte const *mem)
+		{
+			auto const &values(access_frozen_ds(mem));
+			ranges::copy(values, ranges::make_ostream_joiner(stream, ","));
+		}
 	};
 }
 
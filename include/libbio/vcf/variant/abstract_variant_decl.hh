@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <libbio/buffer.hh>
 #include <libbio/vcf/constants.hh>
+#include <libbio/vcf/contig_table.hh>
 #include <vector>
 
 
@@ -31,6 +32,7 @@ namespace libbio::vcf {
 		template <metadata_value_type, std::int32_t>
 		friend class generic_info_field_base;
 
+		friend class frozen_variant_buffer;
 		friend class info_field_base;
 		friend class reader;
 		friend class storable_info_field_base;
@@ -38,6 +40,7 @@ namespace libbio::vcf {
 	public:
 		inline static constexpr double UNKNOWN_QUALITY{-1};
 		typedef std::vector <metadata_filter const *>		filter_ptr_vector;
+		typedef contig_table::contig_index_type				contig_index_type;
 
 	protected:
 		class reader										*m_reader{};
@@ -49,6 +52,7 @@ namespace libbio::vcf {
 		std::size_t											m_variant_index{0};
 		std::size_t											m_lineno{0};
 		std::size_t											m_pos{0};
+		contig_index_type									m_contig_index{contig_table::INVALID_INDEX};	// Index of CHROM in the reader’s contig table.
 
 	public:
 		// Make sure that both m_info and m_samples have zero return value for size(), see the formatters’ destructors.
@@ -66,6 +70,7 @@ namespace libbio::vcf {
 		void set_lineno(std::size_t const lineno)						{ m_lineno = lineno; }
 		void set_pos(std::size_t const pos)								{ m_pos = pos; }
 		void set_qual(double const qual)								{ m_qual = qual; }
+		void set_contig_index(contig_index_type const idx)				{ m_contig_index = idx; }
 
 		class reader *reader() const									{ return m_reader; }
 		filter_ptr_vector const &filters() const						{ return m_filters; }
@@ -74,6 +79,7 @@ namespace libbio::vcf {
 		std::size_t pos() const											{ return m_pos; }
 		inline std::size_t zero_based_pos() const;
 		double qual() const												{ return m_qual; }
+		contig_index_type contig_index() const							{ return m_contig_index; }
 
 	protected:
 		inline void reset();
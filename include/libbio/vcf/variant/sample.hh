@@ -11,6 +11,7 @@
 #include <libbio/buffer.hh>
 #include <libbio/vcf/constants.hh>
 #include <ostream>
+#include <span>
 #include <vector>
 
 
@@ -42,6 +43,7 @@ namespace libbio::vcf {
 		template <typename, typename>
 		friend class formatted_variant;
 
+		friend class frozen_variant_buffer;
 		friend class genotype_field_base;
 		friend class storable_genotype_field_base;
 
@@ -131,7 +133,7 @@ namespace libbio::vcf {
 	}
 
 
-	void output_genotype(std::ostream &stream, std::vector <sample_genotype> const &genotype);
+	void output_genotype(std::ostream &stream, std::span <sample_genotype const> const genotype);
 }
 
 #endif
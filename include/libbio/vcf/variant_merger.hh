@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#ifndef LIBBIO_VCF_VARIANT_MERGER_HH
+#define LIBBIO_VCF_VARIANT_MERGER_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/vcf/frozen_variant.hh>
+#include <libbio/vcf/vcf_reader_decl.hh>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	// Merges the records of position-sorted inputs. Each input is parsed in its own thread into blocks of
+	// frozen copies of the variants, which are passed to the merging thread through a bounded ring of blocks. The inputs
+	// are merged with a loser tree and the records with equal POS are reported to the callback in groups
+	// that contain at most one record from each input, in input order. As in vcfmerge, CHROM is not compared.
+	class variant_merger
+	{
+	public:
+		struct sourced_variant
+		{
+			frozen_variant	var{};
+			std::size_t		input_index{};
+		};
+
+		typedef std::vector <sourced_variant>				variant_group;
+		typedef std::function <bool(variant_group const &)>	callback_fn;
+
+		constexpr static inline std::size_t const DEFAULT_BLOCK_SIZE{256};
+		constexpr static inline std::size_t const DEFAULT_BLOCK_COUNT{4};
+
+	protected:
+		struct block
+		{
+			frozen_variant_buffer			buffer;		// Reused.
+			std::vector <frozen_variant>	variants;
+			bool							is_last{};
+
+			std::size_t size() const { return variants.size(); }
+		};
+
+		// Per-input state shared by the parsing thread and the merging thread.
+		class input_channel
+		{
+		protected:
+			reader					*m_reader{};
+			std::vector <block>		m_blocks;
+			std::mutex				m_mutex;
+			std::condition_variable	m_cv;
+			std::exception_ptr		m_exception;
+			std::thread				m_thread;
+			std::size_t				m_block_size{};
+			std::size_t				m_first_filled{};	// Index of the first filled block.
+			std::size_t				m_filled_count{};	// Including the ones still used by the merging thread.
+			bool					m_should_stop{};
+
+		public:
+			input_channel(reader &reader_, std::size_t const block_size, std::size_t const block_count):
+				m_reader(&reader_),
+				m_blocks(block_count),
+				m_block_size(block_size)
+			{
+			}
+
+			~input_channel() { stop(); }
+
+			void start() { m_thread = std::thread([this]{ run(); }); }
+			void stop();
+
+			// Called from the merging thread. The nth filled block, waits until it is available.
+			block &filled_block(std::size_t const nth);
+			void release_block();
+			void rethrow_if_failed();
+
+		protected:
+			void run();
+			block *acquire_block();
+			void publish_block();
+		};
+
+		struct input_cursor
+		{
+			block const		*current_block{};
+			std::size_t		index{};
+			bool			should_release{};	// Release the previous block after calling the callback.
+		};
+
+		typedef std::unique_ptr <input_channel>		input_channel_ptr;
+
+	protected:
+		std::vector <input_channel_ptr>	m_inputs;
+		std::size_t						m_block_size{DEFAULT_BLOCK_SIZE};
+		std::size_t						m_block_count{DEFAULT_BLOCK_COUNT};
+
+	public:
+		std::size_t block_size() const { return m_block_size; }
+		std::size_t block_count() const { return m_block_count; }
+		void set_block_size(std::size_t const size) { libbio_always_assert_lt(0, size); m_block_size = size; }
+		void set_block_count(std::size_t const count) { libbio_always_assert_lte(2, count); m_block_count = count; }
+
+		// The header needs to have been read and the parsed fields set. The input indices
+		// in the groups correspond to the order in which the readers were added.
+		void add_input(reader &reader_) { m_inputs.emplace_back(std::make_unique <input_channel>(reader_, m_block_size, m_block_count)); }
+		std::size_t input_count() const { return m_inputs.size(); }
+
+		// Stops when the callback returns false. Rethrows the exceptions from the parsing threads.
+		void merge(callback_fn const &callback);
+
+	protected:
+		bool advance(std::size_t const input_idx, input_cursor &cursor);
+		void stop();
+	};
+}
+
+#endif
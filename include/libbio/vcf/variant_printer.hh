@@ -8,6 +8,7 @@
 
 #include <cstddef>
 #include <libbio/assert.hh>
+#include <libbio/utility/output_integer.hh>
 #include <libbio/vcf/constants.hh>
 #include <libbio/vcf/variant/abstract_variant_decl.hh>
 #include <libbio/vcf/variant/formatted_variant_decl.hh>
@@ -83,7 +84,7 @@ namespace libbio::vcf {
 	void variant_printer_base <t_variant>::output_pos(std::ostream &os, variant_type const &var) const
 	{
 		// POS
-		os << var.pos();
+		output_integer(os, var.pos());
 	}
 
 
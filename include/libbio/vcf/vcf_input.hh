@@ -8,14 +8,17 @@
 
 #include <cstddef>
 #include <istream>
+#include <libbio/assert.hh>
 #include <libbio/file_handling.hh>
 #include <libbio/mmap_file_handle.hh>
 #include <string>
+#include <string_view>
 
 
 namespace libbio::vcf {
 
 	class reader;
+	class bcf_input_base;
 
 
 	class input_base
@@ -24,11 +27,13 @@ namespace libbio::vcf {
 
 	protected:
 		std::size_t					m_first_variant_lineno{};
+		std::size_t					m_first_variant_offset{};
 
 	public:
 		virtual ~input_base() {}
 
 		std::size_t first_variant_lineno() const { return m_first_variant_lineno; }
+		std::size_t first_variant_offset() const { return m_first_variant_offset; }
 		std::size_t last_header_lineno() const { return m_first_variant_lineno - 1; }
 		virtual char const *path() const { return "(unknown)"; }
 
@@ -36,7 +41,9 @@ namespace libbio::vcf {
 		virtual void reader_will_take_input() {}
 		virtual char const *buffer_start() const = 0;
 		virtual void fill_buffer(reader &vcf_reader) = 0;
+		virtual bcf_input_base *as_bcf_input() { return nullptr; }	// Non-null if the records are in BCF.
 		void set_first_variant_lineno(std::size_t lineno) { m_first_variant_lineno = lineno; }
+		void set_first_variant_offset(std::size_t offset) { m_first_variant_offset = offset; }
 	};
 
 
@@ -50,7 +57,11 @@ namespace libbio::vcf {
 
 	class seekable_input_base : public input_base
 	{
-		// TODO: implement seeking.
+		friend class reader;
+
+	protected:
+		// Continue from the given byte offset, which should be at the start of a line, when the reader fills its buffer next time.
+		virtual void seek(std::size_t const offset) = 0;
 	};
 
 
@@ -122,6 +133,9 @@ namespace libbio::vcf {
 	{
 	public:
 		using stream_input_tpl <t_stream, seekable_input_base>::stream_input_tpl;
+
+	protected:
+		void seek(std::size_t const offset) override;
 	};
 
 
@@ -132,6 +146,7 @@ namespace libbio::vcf {
 
 	protected:
 		handle_type					m_handle{};
+		std::size_t					m_offset{};
 
 	public:
 		handle_type &handle() { return m_handle; }
@@ -139,7 +154,32 @@ namespace libbio::vcf {
 		char const *path() const override { return m_handle.path().data(); }
 
 	protected:
-		char const *buffer_start() const override { return m_handle.data(); }
+		char const *buffer_start() const override { return m_handle.data() + m_offset; }
+		void fill_buffer(reader &vcf_reader) override;
+		void seek(std::size_t const offset) override { libbio_assert_lte(offset, m_handle.size()); m_offset = offset; }
+	};
+
+
+	// Serves the given header followed by a newline-aligned range of records, e.g. a part of an mmap_input’s contents.
+	class chunk_input final : public input_base
+	{
+	protected:
+		std::string_view			m_header;
+		std::string_view			m_records;
+		char const					*m_buffer_start{};
+		bool						m_has_served_header{};
+
+	public:
+		chunk_input() = default;
+
+		chunk_input(std::string_view const header, std::string_view const records):
+			m_header(header),
+			m_records(records)
+		{
+		}
+
+	protected:
+		char const *buffer_start() const override { return m_buffer_start; }
 		void fill_buffer(reader &vcf_reader) override;
 	};
 
@@ -150,6 +190,17 @@ namespace libbio::vcf {
 		t_base::reader_will_take_input();
 		stream_input_base::reader_will_take_input();
 	}
+
+
+	template <typename t_stream>
+	void seekable_stream_input <t_stream>::seek(std::size_t const offset)
+	{
+		// Discard the buffer contents.
+		this->m_len = 0;
+		this->m_pos = 0;
+		this->m_stream.clear();
+		this->m_stream.seekg(offset);
+	}
 }
 
 #endif
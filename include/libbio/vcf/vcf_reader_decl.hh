@@ -15,6 +15,7 @@
 #include <libbio/copyable_atomic.hh>
 #include <libbio/utility.hh>
 #include <libbio/vcf/constants.hh>
+#include <libbio/vcf/contig_table.hh>
 #include <libbio/vcf/metadata.hh>
 #include <libbio/vcf/subfield/decl.hh>
 #include <libbio/vcf/subfield/genotype_field_base_decl.hh>
@@ -77,6 +78,7 @@ namespace libbio::vcf::detail {
 
 namespace libbio::vcf {
 
+	class genotype_field_gt;
 	class transient_variant;
 
 
@@ -85,6 +87,8 @@ namespace libbio::vcf {
 		friend class empty_input;
 		friend class stream_input_base;
 		friend class mmap_input;
+		friend class chunk_input;
+		friend class bcf_input_base;
 
 		friend class variant_format_access;
 		friend class transient_variant_format_access;
@@ -97,6 +101,8 @@ namespace libbio::vcf {
 		typedef std::function <bool(transient_variant const &var)>					callback_cq_fn;
 		typedef std::vector <std::string>											sample_name_vector;
 		typedef std::map <std::string, std::size_t, compare_strings_transparent>	sample_name_map; // Use a transparent comparator.
+		typedef std::vector <std::size_t>											sample_number_vector;
+		typedef std::vector <std::string_view>										sample_column_vector;
 
 		// Enough state information to make it possible to resume parsing from the start of a line.
 		// TODO: consider moving more (most?) state information here since reset() will affect the machine state anyway.
@@ -128,14 +134,18 @@ namespace libbio::vcf {
 		input_base						*m_input{nullptr};
 		fsm								m_fsm;
 		class metadata					m_metadata;
+		contig_table					m_contigs;
 		info_field_map					m_info_fields;
 		info_field_ptr_vector			m_info_fields_in_headers;
 		info_field_ptr_vector			m_current_record_info_fields;
 		genotype_field_map				m_genotype_fields;
 		variant_format_ptr				m_current_format{new variant_format()};
 		genotype_ptr_vector				m_current_format_vec;					// Non-owning, contents point to m_current_format’s fields.
+		genotype_field_gt const			*m_gt_only_field{};						// Non-null if the current format consists of GT only.
 		sample_name_vector				m_sample_names_by_index;
 		sample_name_map					m_sample_indices_by_name;
+		std::vector <bool>				m_parsed_samples;						// Empty if every sample is parsed.
+		sample_column_vector			m_sample_columns;						// Skipped sample columns of the current record.
 		transient_variant				m_current_variant;						// FIXME: Consider moving to parser_state. On the other hand, most of the data members have to do with state.
 		reader_delegate					*m_delegate{&detail::g_vcf_reader_default_delegate};
 		struct variant_validator		*m_chrom_pos_validator{&detail::g_vcf_reader_default_variant_validator};
@@ -161,6 +171,9 @@ namespace libbio::vcf {
 		void set_variant_format(variant_format *fmt) { libbio_always_assert(fmt); m_current_format.reset(fmt); m_have_assigned_variant_format = true; }
 		void set_should_skip_invalid_records(bool const flag) { m_should_skip_invalid = flag; }
 		void read_header();
+		// Continue parsing from the given byte offset, which needs to be at the start of a record. The input needs to be seekable.
+		void seek_to_variant(std::size_t const offset, std::size_t const lineno, std::size_t const variant_index);
+		void reset(); // Continue from the first record.
 		void parse_nc(callback_fn const &callback);	// Callback takes non-const transient_variant.
 		void parse_nc(callback_fn &&callback);		// Callback takes non-const transient_variant.
 		void parse(callback_cq_fn const &callback);
@@ -180,6 +193,8 @@ namespace libbio::vcf {
 		bool has_assigned_variant_format() const { return m_have_assigned_variant_format; }
 		class metadata &metadata() { return m_metadata; }
 		class metadata const &metadata() const { return m_metadata; }
+		contig_table &contigs() { return m_contigs; }
+		contig_table const &contigs() const { return m_contigs; }
 		info_field_map &info_fields() { return m_info_fields; }
 		info_field_map const &info_fields() const { return m_info_fields; }
 		info_field_ptr_vector const &info_fields_in_headers() const { return m_info_fields_in_headers; }
@@ -204,6 +219,12 @@ namespace libbio::vcf {
 		sample_name_map const &sample_indices_by_name() const { return m_sample_indices_by_name; }
 		field parsed_fields() const { return m_max_parsed_field; }
 		inline void set_parsed_fields(field max_field);
+		// Parse only the given samples. The numbers are 1-based as in sample_indices_by_name().
+		// The other samples are left without values; an empty vector restores parsing every sample.
+		void set_parsed_samples(sample_number_vector const &sample_numbers);
+		bool is_parsed_sample(std::size_t const sample_idx) const { return m_parsed_samples.empty() || m_parsed_samples[sample_idx]; } // 0-based.
+		std::string_view skipped_sample_column(std::size_t const sample_idx) const { return m_sample_columns[sample_idx]; } // Valid in parse()’s callback.
+		void parse_skipped_sample(std::size_t const sample_idx); // Valid in parse()’s callback.
 		std::size_t counter_value() const { return m_counter; } // Thread-safe.
 		inline std::string_view buffer_tail() const; // Valid in parse()’s callback.
 
@@ -221,6 +242,8 @@ namespace libbio::vcf {
 		void fill_buffer();
 
 		void skip_to_next_nl();
+		char const *skip_sample_columns(char const *column_start, std::size_t &sample_idx);
+		char const *parse_diploid_gt_columns(char const *column_start, std::size_t &sample_idx);
 		void set_buffer_start(char const *p) { m_fsm.p = p; }
 		void set_buffer_end(char const *pe) { m_fsm.pe = pe; }
 		void set_eof(char const *eof) { m_fsm.eof = eof; }
@@ -231,9 +254,13 @@ namespace libbio::vcf {
 		template <typename t_cb>
 		inline bool parse2(t_cb const &cb, parser_state &state, bool const stop_after_newline);
 
+		// Parse the records from a BCF input.
+		bool parse_bcf(callback_fn const &cb, parser_state &state, bool const stop_after_record);
+
 		std::pair <std::uint16_t, std::uint16_t> assign_info_field_offsets();
 		std::pair <std::uint16_t, std::uint16_t> assign_format_field_indices_and_offsets();
 		void parse_format(std::string_view const &new_format);
+		void update_variant_format(std::string_view const &new_format, parser_state &state);
 	};
 }
 
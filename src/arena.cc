@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <libbio/arena.hh>
+
+
+namespace libbio {
+
+	void *arena::allocate_slow(std::size_t const size, std::size_t const alignment)
+	{
+		// Try the remaining blocks, then add a new one. Blocks that are skipped
+		// remain unused until release() is called.
+		auto const try_block([this, size, alignment](std::size_t const idx) -> void * {
+			auto &blk(m_blocks[idx]);
+			auto const start(reinterpret_cast <std::uintptr_t>(blk.data.get()));
+			auto const aligned_offset(((start + alignment - 1) & ~(alignment - 1)) - start);
+			if (blk.size < aligned_offset + size)
+				return nullptr;
+
+			m_block_idx = idx;
+			m_offset = aligned_offset + size;
+			m_bytes_used += size;
+			return blk.data.get() + aligned_offset;
+		});
+
+		for (std::size_t idx(m_block_idx + (m_block_idx < m_blocks.size() ? 1 : 0)); idx < m_blocks.size(); ++idx)
+		{
+			if (auto *retval(try_block(idx)); retval)
+				return retval;
+		}
+
+		auto const block_size(std::max(m_block_size, size + alignment));
+		m_blocks.emplace_back(block_ptr(detail::alloc <std::byte>(block_size)), block_size);
+		auto *retval(try_block(m_blocks.size() - 1));
+		libbio_assert(retval);
+		return retval;
+	}
+}
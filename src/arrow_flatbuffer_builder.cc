@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <libbio/arrow/flatbuffer_builder.hh>
+#include <cstring>
+#include <libbio/assert.hh>
+#include <limits>
+
+
+namespace libbio::arrow {
+
+	std::byte *flatbuffer_builder::make_space(std::size_t const length)
+	{
+		if (m_buffer.size() < m_size + length)
+		{
+			// Move the contents to the end of a larger buffer.
+			std::vector <std::byte> buffer(std::max({std::size_t(1024), 2 * m_buffer.size(), m_size + length}));
+			std::copy(m_buffer.end() - m_size, m_buffer.end(), buffer.end() - m_size);
+			m_buffer = std::move(buffer);
+		}
+
+		m_size += length;
+		return m_buffer.data() + m_buffer.size() - m_size;
+	}
+
+
+	auto flatbuffer_builder::refer_to(offset_type const offset) -> offset_type
+	{
+		// The offset is relative to its own position, which is after the alignment.
+		align(sizeof(offset_type));
+		libbio_assert_lte(offset, m_size);
+		return m_size + sizeof(offset_type) - offset;
+	}
+
+
+	auto flatbuffer_builder::create_string(std::string_view const sv) -> offset_type
+	{
+		// Length, characters, NUL.
+		pre_align(sv.size() + 1, sizeof(offset_type));
+		push(std::uint8_t(0));
+		std::copy(sv.begin(), sv.end(), reinterpret_cast <char *>(make_space(sv.size())));
+		push(offset_type(sv.size()));
+		return m_size;
+	}
+
+
+	auto flatbuffer_builder::create_offset_vector(std::span <offset_type const> const offsets) -> offset_type
+	{
+		start_vector(offsets.size(), sizeof(offset_type), sizeof(offset_type));
+		for (auto it(offsets.rbegin()); it != offsets.rend(); ++it)
+			push(refer_to(*it));
+		return end_vector(offsets.size());
+	}
+
+
+	void flatbuffer_builder::start_vector(std::size_t const count, std::size_t const element_size, std::size_t const alignment)
+	{
+		pre_align(count * element_size, sizeof(offset_type));
+		pre_align(count * element_size, alignment);
+	}
+
+
+	auto flatbuffer_builder::end_vector(std::size_t const count) -> offset_type
+	{
+		align(sizeof(offset_type));
+		push(offset_type(count));
+		return m_size;
+	}
+
+
+	void flatbuffer_builder::start_table()
+	{
+		libbio_assert(m_fields.empty());
+		m_table_start = m_size;
+	}
+
+
+	void flatbuffer_builder::add_offset_field(std::uint16_t const field_id, offset_type const offset)
+	{
+		push(refer_to(offset));
+		m_fields.emplace_back(field_id, m_size);
+	}
+
+
+	auto flatbuffer_builder::end_table() -> offset_type
+	{
+		// Placeholder for the offset of the vtable.
+		add_field(std::numeric_limits <std::uint16_t>::max(), std::int32_t(0));
+		m_fields.pop_back();
+		auto const table_pos(m_size);
+
+		// The vtable consists of its size, the size of the table and the offsets of the fields from the table start.
+		std::uint16_t field_count{};
+		for (auto const &[field_id, pos] : m_fields)
+			field_count = std::max(field_count, std::uint16_t(1 + field_id));
+
+		std::vector <std::uint16_t> field_offsets(field_count, 0);
+		for (auto const &[field_id, pos] : m_fields)
+		{
+			libbio_assert_lt(table_pos - pos, std::numeric_limits <std::uint16_t>::max());
+			field_offsets[field_id] = table_pos - pos;
+		}
+
+		for (auto it(field_offsets.rbegin()); it != field_offsets.rend(); ++it)
+			push(*it);
+		push(std::uint16_t(table_pos - m_table_start));
+		std::uint16_t const vtable_size(sizeof(std::uint16_t) * (2 + field_count));
+		push(vtable_size);
+
+		// The table refers to its vtable with a signed offset, which is negative if the vtable was written before the table.
+		auto const vtable_pos(deduplicate_vtable(vtable_size));
+		store_le(at(table_pos), std::int32_t(vtable_pos) - std::int32_t(table_pos));
+		m_fields.clear();
+		return table_pos;
+	}
+
+
+	auto flatbuffer_builder::deduplicate_vtable(std::uint16_t const vtable_size) -> offset_type
+	{
+		// Compare the vtable just written to the previous ones and remove it if a match is found.
+		// The vtables begin with their sizes, so comparing the first two bytes first keeps the reads in bounds.
+		auto const *vtable(at(m_size));
+		for (auto const pos : m_vtables)
+		{
+			auto const *other(at(pos));
+			if (0 == std::memcmp(vtable, other, sizeof(std::uint16_t)) && 0 == std::memcmp(vtable, other, vtable_size))
+			{
+				m_size -= vtable_size;
+				return pos;
+			}
+		}
+
+		m_vtables.push_back(m_size);
+		return m_size;
+	}
+
+
+	void flatbuffer_builder::finish(offset_type const root)
+	{
+		pre_align(sizeof(offset_type), m_min_alignment);
+		push(refer_to(root));
+	}
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <array>
+#include <libbio/arrow/ipc_file_writer.hh>
+#include <libbio/assert.hh>
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+
+	namespace arrow = libbio::arrow;
+
+	typedef arrow::flatbuffer_builder::offset_type	offset_type;
+
+
+	constexpr static std::array const MAGIC{std::byte{'A'}, std::byte{'R'}, std::byte{'R'}, std::byte{'O'}, std::byte{'W'}, std::byte{'1'}};
+	constexpr static std::uint32_t const CONTINUATION_MARKER{0xFFFFFFFF};
+	constexpr static std::int16_t const METADATA_VERSION_V5{4};
+
+
+	// Values from Message.fbs.
+	enum class message_header_type : std::uint8_t
+	{
+		SCHEMA				= 1,
+		DICTIONARY_BATCH	= 2,
+		RECORD_BATCH		= 3
+	};
+
+
+	offset_type build_int_type(arrow::flatbuffer_builder &builder, std::int32_t const bit_width, bool const is_signed)
+	{
+		builder.start_table();
+		builder.add_field(0, bit_width);
+		builder.add_field(1, std::uint8_t(is_signed));
+		return builder.end_table();
+	}
+
+
+	offset_type build_type(arrow::flatbuffer_builder &builder, arrow::field const &fd)
+	{
+		switch (fd.type)
+		{
+			case arrow::type_id::INT:
+				return build_int_type(builder, fd.bit_width, fd.is_signed);
+
+			case arrow::type_id::FLOATING_POINT:
+				builder.start_table();
+				builder.add_field(0, std::to_underlying(fd.precision));
+				return builder.end_table();
+
+			case arrow::type_id::FIXED_SIZE_LIST:
+				builder.start_table();
+				builder.add_field(0, fd.list_size);
+				return builder.end_table();
+
+			case arrow::type_id::UTF8:
+			case arrow::type_id::BOOL:
+			case arrow::type_id::LIST:
+				// Empty tables.
+				builder.start_table();
+				return builder.end_table();
+		}
+
+		throw std::invalid_argument("Unexpected field type");
+	}
+
+
+	offset_type build_field(arrow::flatbuffer_builder &builder, arrow::field const &fd)
+	{
+		std::vector <offset_type> children;
+		children.reserve(fd.children.size());
+		for (auto const &child : fd.children)
+			children.push_back(build_field(builder, child));
+
+		auto const children_offset(builder.create_offset_vector(children));
+		auto const name_offset(builder.create_string(fd.name));
+		auto const type_offset(build_type(builder, fd));
+
+		offset_type dictionary_offset{};
+		if (0 <= fd.dictionary_id)
+		{
+			auto const index_type_offset(build_int_type(builder, 32, true));
+			builder.start_table();
+			builder.add_field(0, fd.dictionary_id);
+			builder.add_offset_field(1, index_type_offset);
+			dictionary_offset = builder.end_table();
+		}
+
+		builder.start_table();
+		builder.add_offset_field(0, name_offset);
+		builder.add_field(1, std::uint8_t(fd.nullable));
+		builder.add_field(2, std::to_underlying(fd.type));
+		builder.add_offset_field(3, type_offset);
+		if (dictionary_offset)
+			builder.add_offset_field(4, dictionary_offset);
+		builder.add_offset_field(5, children_offset);
+		return builder.end_table();
+	}
+
+
+	offset_type build_schema(
+		arrow::flatbuffer_builder &builder,
+		arrow::field_vector const &schema,
+		arrow::ipc_file_writer::key_value_vector const &metadata
+	)
+	{
+		std::vector <offset_type> offsets;
+		offsets.reserve(std::max(schema.size(), metadata.size()));
+		for (auto const &fd : schema)
+			offsets.push_back(build_field(builder, fd));
+		auto const fields_offset(builder.create_offset_vector(offsets));
+
+		offsets.clear();
+		for (auto const &[key, value] : metadata)
+		{
+			auto const key_offset(builder.create_string(key));
+			auto const value_offset(builder.create_string(value));
+			builder.start_table();
+			builder.add_offset_field(0, key_offset);
+			builder.add_offset_field(1, value_offset);
+			offsets.push_back(builder.end_table());
+		}
+		auto const metadata_offset(builder.create_offset_vector(offsets));
+
+		builder.start_table();
+		builder.add_field(0, std::int16_t(0)); // Little endian.
+		builder.add_offset_field(1, fields_offset);
+		builder.add_offset_field(2, metadata_offset);
+		return builder.end_table();
+	}
+
+
+	offset_type build_record_batch(arrow::flatbuffer_builder &builder, arrow::record_batch const &batch)
+	{
+		// Structs are pushed in reverse order of both the elements and the members.
+		auto const &nodes(batch.nodes());
+		builder.start_vector(nodes.size(), 2 * sizeof(std::int64_t), alignof(std::int64_t));
+		for (auto it(nodes.rbegin()); it != nodes.rend(); ++it)
+		{
+			builder.push(it->null_count);
+			builder.push(it->length);
+		}
+		auto const nodes_offset(builder.end_vector(nodes.size()));
+
+		auto const &buffers(batch.buffers());
+		builder.start_vector(buffers.size(), 2 * sizeof(std::int64_t), alignof(std::int64_t));
+		for (auto it(buffers.rbegin()); it != buffers.rend(); ++it)
+		{
+			builder.push(it->length);
+			builder.push(it->offset);
+		}
+		auto const buffers_offset(builder.end_vector(buffers.size()));
+
+		builder.start_table();
+		builder.add_field(0, batch.length());
+		builder.add_offset_field(1, nodes_offset);
+		builder.add_offset_field(2, buffers_offset);
+		return builder.end_table();
+	}
+
+
+	void finish_message(
+		arrow::flatbuffer_builder &builder,
+		message_header_type const header_type,
+		offset_type const header,
+		std::int64_t const body_length
+	)
+	{
+		builder.start_table();
+		builder.add_field(0, METADATA_VERSION_V5);
+		builder.add_field(1, std::to_underlying(header_type));
+		builder.add_offset_field(2, header);
+		builder.add_field(3, body_length);
+		builder.finish(builder.end_table());
+	}
+}
+
+
+namespace libbio::arrow {
+
+	void ipc_file_writer::write(std::span <std::byte const> const bytes)
+	{
+		libbio_assert(m_stream);
+		m_stream->write(reinterpret_cast <char const *>(bytes.data()), bytes.size());
+		if (!*m_stream)
+			throw std::runtime_error("Unable to write the Arrow IPC file");
+		m_offset += bytes.size();
+	}
+
+
+	auto ipc_file_writer::write_message(std::span <std::byte const> const body) -> block
+	{
+		// Encapsulated message: continuation marker, metadata length, metadata padded to eight bytes, body.
+		block retval{std::int64_t(m_offset), 0, std::int64_t(body.size())};
+		auto const metadata(m_builder.data());
+		auto const padding((~metadata.size() + 1) & (record_batch::BUFFER_ALIGNMENT - 1));
+		auto const metadata_length(std::int32_t(metadata.size() + padding));
+		retval.metadata_length = 2 * sizeof(std::uint32_t) + metadata_length;
+
+		std::array <std::byte, 2 * sizeof(std::uint32_t)> prefix;
+		store_le(prefix.data(), CONTINUATION_MARKER);
+		store_le(prefix.data() + sizeof(std::uint32_t), metadata_length);
+		std::array <std::byte, record_batch::BUFFER_ALIGNMENT> const zeros{};
+
+		write(prefix);
+		write(metadata);
+		write(std::span(zeros).first(padding));
+		write(body);
+
+		m_builder.clear();
+		return retval;
+	}
+
+
+	void ipc_file_writer::write_schema(field_vector schema, key_value_vector metadata)
+	{
+		// The magic string is padded to eight bytes.
+		std::array <std::byte, 2> const padding{};
+		write(MAGIC);
+		write(padding);
+
+		m_schema = std::move(schema);
+		m_schema_metadata = std::move(metadata);
+		auto const schema_offset(build_schema(m_builder, m_schema, m_schema_metadata));
+		finish_message(m_builder, message_header_type::SCHEMA, schema_offset, 0);
+		write_message({});
+	}
+
+
+	void ipc_file_writer::write_dictionary_batch(std::int64_t const id, record_batch const &batch)
+	{
+		auto const batch_offset(build_record_batch(m_builder, batch));
+		m_builder.start_table();
+		m_builder.add_field(0, id);
+		m_builder.add_offset_field(1, batch_offset);
+		auto const dictionary_batch_offset(m_builder.end_table());
+		finish_message(m_builder, message_header_type::DICTIONARY_BATCH, dictionary_batch_offset, batch.body().size());
+		m_dictionary_blocks.push_back(write_message(batch.body()));
+	}
+
+
+	void ipc_file_writer::write_record_batch(record_batch const &batch)
+	{
+		auto const batch_offset(build_record_batch(m_builder, batch));
+		finish_message(m_builder, message_header_type::RECORD_BATCH, batch_offset, batch.body().size());
+		m_record_batch_blocks.push_back(write_message(batch.body()));
+	}
+
+
+	void ipc_file_writer::finish()
+	{
+		// End-of-stream marker.
+		{
+			std::array <std::byte, 2 * sizeof(std::uint32_t)> eos{};
+			store_le(eos.data(), CONTINUATION_MARKER);
+			write(eos);
+		}
+
+		// Footer.
+		auto const build_blocks([this](block_vector const &blocks){
+			m_builder.start_vector(blocks.size(), 3 * sizeof(std::int64_t), alignof(std::int64_t));
+			for (auto it(blocks.rbegin()); it != blocks.rend(); ++it)
+			{
+				m_builder.push(it->body_length);
+				m_builder.push(std::int32_t(0)); // Padding.
+				m_builder.push(it->metadata_length);
+				m_builder.push(it->offset);
+			}
+			return m_builder.end_vector(blocks.size());
+		});
+
+		auto const schema_offset(build_schema(m_builder, m_schema, m_schema_metadata));
+		auto const dictionaries_offset(build_blocks(m_dictionary_blocks));
+		auto const record_batches_offset(build_blocks(m_record_batch_blocks));
+		m_builder.start_table();
+		m_builder.add_field(0, METADATA_VERSION_V5);
+		m_builder.add_offset_field(1, schema_offset);
+		m_builder.add_offset_field(2, dictionaries_offset);
+		m_builder.add_offset_field(3, record_batches_offset);
+		m_builder.finish(m_builder.end_table());
+
+		auto const footer(m_builder.data());
+		std::array <std::byte, sizeof(std::int32_t)> footer_length;
+		store_le(footer_length.data(), std::int32_t(footer.size()));
+		write(footer);
+		write(footer_length);
+		write(MAGIC);
+
+		m_builder.clear();
+		m_dictionary_blocks.clear();
+		m_record_batch_blocks.clear();
+	}
+}
@@ -40,7 +40,8 @@ namespace libbio::bam {
 				read_field <&sam::record::qname>();
 				range().seek(1); // Skip the NUL byte.
 
-				read_field <&sam::record::cigar, fields::cigar>();
+				// Read the CIGAR and calculate the alignment geometry in the same pass.
+				fields::cigar <&sam::record::cigar>{}.read_value <byte_order>(range(), target().cigar, target().geometry);
 				read_field <&sam::record::seq, fields::seq>();
 				read_field <&sam::record::qual, fields::qual>();
 
@@ -50,6 +51,7 @@ namespace libbio::bam {
 
 				while (range())
 					read_field <&sam::record::optional_fields, fields::optional>();
+				fields::detail::optional_helper::finish(target().optional_fields);
 			}
 		);
 	}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <libbio/bcf/dictionary.hh>
+#include <libbio/vcf/metadata.hh>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace {
+
+	struct dictionary_entry
+	{
+		std::string_view					id;
+		libbio::vcf::metadata_base const	*metadata{};
+	};
+
+	typedef std::vector <dictionary_entry>	entry_vector;
+	typedef std::vector <std::string_view>	string_vector;
+
+
+	template <typename t_map>
+	void add_entries(t_map const &map, entry_vector &dst)
+	{
+		for (auto const &[key, meta] : map)
+			dst.emplace_back(std::string_view{key}, &meta);
+	}
+
+
+	void set_entry(string_vector &dst, std::size_t const idx, std::string_view const id)
+	{
+		if (! (idx < dst.size()))
+			dst.resize(1 + idx);
+
+		if (!dst[idx].empty() && dst[idx] != id)
+			throw std::runtime_error("Conflicting IDX values in VCF header");
+
+		dst[idx] = id;
+	}
+
+
+	void make_dictionary(entry_vector &entries, string_vector &dst, std::string_view const first_id)
+	{
+		// Use the order of the header records. Records not read from a header all have index zero.
+		std::stable_sort(entries.begin(), entries.end(), [](auto const &lhs, auto const &rhs){
+			return lhs.metadata->get_header_index() < rhs.metadata->get_header_index();
+		});
+
+		dst.clear();
+		for (auto const &entry : entries)
+		{
+			if (entry.metadata->has_idx())
+				set_entry(dst, entry.metadata->get_idx(), entry.id);
+		}
+
+		auto const contains([&dst](std::string_view const id){
+			return dst.end() != std::find(dst.begin(), dst.end(), id);
+		});
+
+		if (!first_id.empty() && !contains(first_id))
+		{
+			if (dst.empty() || dst.front().empty())
+				set_entry(dst, 0, first_id);
+			else
+				dst.emplace_back(first_id);
+		}
+
+		for (auto const &entry : entries)
+		{
+			if (!entry.metadata->has_idx() && !contains(entry.id))
+				dst.emplace_back(entry.id);
+		}
+	}
+}
+
+
+namespace libbio::bcf {
+
+	void dictionary::build(vcf::metadata const &meta)
+	{
+		{
+			// The same identifier may be used in more than one type of record.
+			entry_vector entries;
+			add_entries(meta.filter(), entries);
+			add_entries(meta.info(), entries);
+			add_entries(meta.format(), entries);
+			make_dictionary(entries, m_strings, "PASS");
+		}
+
+		{
+			entry_vector entries;
+			add_entries(meta.contig(), entries);
+			make_dictionary(entries, m_contigs, {});
+		}
+	}
+}
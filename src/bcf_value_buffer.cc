@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/bcf/value_buffer.hh>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace {
+
+	namespace bcf = libbio::bcf;
+
+
+	// The smallest values that are not reserved, BCF 2.2 § 6.3.3.
+	constexpr inline std::int32_t const INT8_MIN_VALUE{INT8_MIN + 8};
+	constexpr inline std::int32_t const INT16_MIN_VALUE{INT16_MIN + 8};
+
+
+	bcf::value_type integer_type_for_range(std::int32_t const min, std::int32_t const max)
+	{
+		if (INT8_MIN_VALUE <= min && max <= INT8_MAX)
+			return bcf::value_type::INT8;
+		if (INT16_MIN_VALUE <= min && max <= INT16_MAX)
+			return bcf::value_type::INT16;
+		return bcf::value_type::INT32;
+	}
+
+
+	// Convert the special values to the ones of the target type.
+	void append_integer(bcf::byte_vector &dst, bcf::value_type const vt, std::int32_t const val, bool const is_end_of_vector = false)
+	{
+		switch (vt)
+		{
+			case bcf::value_type::INT8:
+			{
+				auto const val_(is_end_of_vector ? bcf::INT8_END_OF_VECTOR : (bcf::INT32_MISSING == val ? bcf::INT8_MISSING : val));
+				bcf::append_le(dst, std::int8_t(val_));
+				break;
+			}
+
+			case bcf::value_type::INT16:
+			{
+				auto const val_(is_end_of_vector ? bcf::INT16_END_OF_VECTOR : (bcf::INT32_MISSING == val ? bcf::INT16_MISSING : val));
+				bcf::append_le(dst, std::int16_t(val_));
+				break;
+			}
+
+			case bcf::value_type::INT32:
+				bcf::append_le(dst, std::int32_t(is_end_of_vector ? bcf::INT32_END_OF_VECTOR : val));
+				break;
+
+			default:
+				throw std::runtime_error("Expected an integer type");
+		}
+	}
+}
+
+
+namespace libbio::bcf {
+
+	void append_type_descriptor(byte_vector &dst, value_type const vt, std::size_t const count)
+	{
+		if (count < OVERFLOW_COUNT)
+			dst.push_back(std::byte((count << 4) | std::uint8_t(vt)));
+		else
+		{
+			if (INT32_MAX < count)
+				throw std::runtime_error("Too many values in BCF typed value");
+
+			dst.push_back(std::byte((OVERFLOW_COUNT << 4) | std::uint8_t(vt)));
+			append_typed_integer(dst, count);
+		}
+	}
+
+
+	void append_typed_integer(byte_vector &dst, std::int32_t const val)
+	{
+		auto const vt(integer_type_for_range(val, val));
+		append_type_descriptor(dst, vt, 1);
+		append_integer(dst, vt, val);
+	}
+
+
+	void append_typed_string(byte_vector &dst, std::string_view const sv)
+	{
+		append_type_descriptor(dst, value_type::CHAR, sv.size());
+		for (auto const cc : sv)
+			dst.push_back(std::byte(cc));
+	}
+
+
+	std::size_t value_buffer::item_end(std::size_t const idx) const
+	{
+		if (1 + idx < m_item_starts.size())
+			return m_item_starts[1 + idx];
+
+		switch (m_type)
+		{
+			case value_type::INT32:	return m_integers.size();
+			case value_type::FLOAT:	return m_float_bits.size();
+			case value_type::CHAR:	return m_characters.size();
+			default:				return 0;
+		}
+	}
+
+
+	void value_buffer::output(byte_vector &dst) const
+	{
+		switch (m_type)
+		{
+			case value_type::MISSING:
+			{
+				append_type_descriptor(dst, value_type::MISSING, 0);
+				break;
+			}
+
+			case value_type::INT32:
+			{
+				auto const count(std::max <std::size_t>(1, max_item_value_count()));
+				std::int32_t min{INT32_MAX};
+				std::int32_t max{INT32_MIN};
+				for (auto const val : m_integers)
+				{
+					if (INT32_MISSING == val)
+						continue;
+					min = std::min(min, val);
+					max = std::max(max, val);
+				}
+
+				auto const vt(min <= max ? integer_type_for_range(min, max) : value_type::INT8);
+				append_type_descriptor(dst, vt, count);
+				for (std::size_t i{}; i < m_item_starts.size(); ++i)
+				{
+					auto const begin(m_item_starts[i]);
+					auto const end(item_end(i));
+					if (begin == end)
+						append_integer(dst, vt, INT32_MISSING);
+					for (auto j(begin); j < end; ++j)
+						append_integer(dst, vt, m_integers[j]);
+					for (auto j(std::max <std::size_t>(1, end - begin)); j < count; ++j)
+						append_integer(dst, vt, 0, true);
+				}
+				break;
+			}
+
+			case value_type::FLOAT:
+			{
+				auto const count(std::max <std::size_t>(1, max_item_value_count()));
+				append_type_descriptor(dst, value_type::FLOAT, count);
+				for (std::size_t i{}; i < m_item_starts.size(); ++i)
+				{
+					auto const begin(m_item_starts[i]);
+					auto const end(item_end(i));
+					if (begin == end)
+						append_le(dst, FLOAT_MISSING_BITS);
+					for (auto j(begin); j < end; ++j)
+						append_le(dst, m_float_bits[j]);
+					for (auto j(std::max <std::size_t>(1, end - begin)); j < count; ++j)
+						append_le(dst, FLOAT_END_OF_VECTOR_BITS);
+				}
+				break;
+			}
+
+			case value_type::CHAR:
+			{
+				// Pad with NUL characters.
+				std::size_t count{};
+				for (std::size_t i{}; i < m_item_starts.size(); ++i)
+					count = std::max(count, item_end(i) - m_item_starts[i]);
+
+				append_type_descriptor(dst, value_type::CHAR, count);
+				for (std::size_t i{}; i < m_item_starts.size(); ++i)
+				{
+					auto const begin(m_item_starts[i]);
+					auto const end(item_end(i));
+					for (auto j(begin); j < end; ++j)
+						dst.push_back(std::byte(m_characters[j]));
+					dst.insert(dst.end(), count - (end - begin), std::byte{});
+				}
+				break;
+			}
+
+			default:
+				throw std::runtime_error("Unexpected value type");
+		}
+	}
+}
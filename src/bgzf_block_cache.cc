@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+
+#include <algorithm>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/block.hh>
+#include <libbio/bgzf/block_cache.hh>
+#include <libbio/bgzf/parser.hh>
+#include <libbio/binary_parsing/range.hh>
+#include <stdexcept>
+
+
+namespace libbio::bgzf {
+
+	block_cache::block_cache(std::span <std::byte const> compressed_data, gzi_index const &index, std::size_t const capacity):
+		m_compressed_data(compressed_data),
+		m_index(&index),
+		m_blocks(capacity)
+	{
+		libbio_always_assert_lt(0, capacity);
+		m_decompressor.prepare();
+	}
+
+
+	void block_cache::decompress(gzi_index::entry const &entry, cached_block &dst)
+	{
+		if (m_compressed_data.size() <= entry.compressed_offset)
+			throw std::runtime_error("GZI index does not match the BGZF file");
+
+		auto const remaining(m_compressed_data.subspan(entry.compressed_offset));
+		binary_parsing::range range_(remaining.data(), remaining.size());
+		block bb;
+		parser pp(range_, bb);
+		pp.parse();
+
+		dst.data.resize(bb.isize);
+		auto const res(m_decompressor.decompress({bb.compressed_data, bb.compressed_data_size}, dst.data));
+		if (res.size() != bb.isize)
+			throw std::runtime_error("Unexpected number of bytes decompressed from a BGZF block");
+
+		dst.compressed_offset = entry.compressed_offset;
+		dst.uncompressed_offset = entry.uncompressed_offset;
+	}
+
+
+	auto block_cache::block_containing(std::uint64_t const uncompressed_offset) -> cached_block const &
+	{
+		libbio_assert(m_index);
+		auto const &entry(m_index->find(uncompressed_offset));
+		++m_time;
+
+		auto const it(std::find_if(m_blocks.begin(), m_blocks.end(), [&entry](auto const &bb){
+			return bb.compressed_offset == entry.compressed_offset;
+		}));
+		if (m_blocks.end() != it)
+		{
+			++m_hits;
+			it->last_used = m_time;
+			return *it;
+		}
+
+		// Replace the least recently used block.
+		++m_misses;
+		auto &dst(*std::min_element(m_blocks.begin(), m_blocks.end(), [](auto const &lhs, auto const &rhs){
+			return lhs.last_used < rhs.last_used;
+		}));
+		dst.compressed_offset = UINT64_MAX;
+		decompress(entry, dst);
+		dst.last_used = m_time;
+		return dst;
+	}
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if defined(LIBBIO_ENABLE_BGZF_COMPRESSOR) && LIBBIO_ENABLE_BGZF_COMPRESSOR
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/bgzf/deflate_compressor.hh>
+#include <libdeflate.h>
+#include <span>
+#include <stdexcept>
+
+
+namespace {
+
+	// SAMv1 § 4.1.
+	constexpr inline std::array const block_header{
+		std::byte{0x1f}, std::byte{0x8b}, std::byte{0x08}, std::byte{0x04},	// ID1, ID2, CM, FLG
+		std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00},	// MTIME
+		std::byte{0x00}, std::byte{0xff},										// XFL, OS
+		std::byte{0x06}, std::byte{0x00},										// XLEN
+		std::byte{'B'}, std::byte{'C'}, std::byte{0x02}, std::byte{0x00}		// SI1, SI2, SLEN
+	};
+
+	constexpr inline std::size_t const header_size{block_header.size() + 2};	// Includes BSIZE.
+	constexpr inline std::size_t const footer_size{8};							// CRC32, ISIZE
+
+
+	void write_le(std::byte *dst, std::uint32_t val, std::size_t const size)
+	{
+		for (std::size_t i{}; i < size; ++i)
+		{
+			dst[i] = std::byte(val & 0xff);
+			val >>= 8;
+		}
+	}
+}
+
+
+namespace libbio::bgzf::detail {
+
+	std::span <std::byte> deflate_compressor::compress_block(std::span <std::byte const> in, std::span <std::byte> out)
+	{
+		if (out.size() < header_size + footer_size)
+			throw std::runtime_error("Ran out of space while compressing");
+
+		auto const compressed_size(libdeflate_deflate_compress(
+			compressor,
+			in.data(),
+			in.size(),
+			out.data() + header_size,
+			out.size() - header_size - footer_size
+		));
+
+		if (0 == compressed_size)
+			throw std::runtime_error("Ran out of space while compressing");
+
+		auto const block_size(header_size + compressed_size + footer_size);
+		if (UINT16_MAX < block_size - 1)
+			throw std::runtime_error("Compressed BGZF block too large");
+
+		auto *dst(std::copy(block_header.begin(), block_header.end(), out.data()));
+		write_le(dst, block_size - 1, 2);
+		dst += 2 + compressed_size;
+		write_le(dst, libdeflate_crc32(0, in.data(), in.size()), 4);
+		write_le(dst + 4, in.size(), 4);
+
+		return out.first(block_size);
+	}
+}
+
+#endif
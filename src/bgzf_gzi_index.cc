@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/block.hh>
+#include <libbio/bgzf/gzi_index.hh>
+#include <libbio/bgzf/parser.hh>
+#include <libbio/binary_parsing/range.hh>
+#include <ranges>
+#include <stdexcept>
+
+
+namespace {
+
+	std::uint64_t read_uint64(std::istream &is)
+	{
+		std::array <unsigned char, 8> buffer{};
+		if (!is.read(reinterpret_cast <char *>(buffer.data()), buffer.size()))
+			throw std::runtime_error("Unable to read the GZI index");
+
+		std::uint64_t retval{};
+		for (std::size_t i{}; i < buffer.size(); ++i)
+			retval |= std::uint64_t(buffer[i]) << (8 * i);
+		return retval;
+	}
+
+
+	void write_uint64(std::ostream &os, std::uint64_t val)
+	{
+		std::array <char, 8> buffer{};
+		for (auto &cc : buffer)
+		{
+			cc = val & 0xff;
+			val >>= 8;
+		}
+		os.write(buffer.data(), buffer.size());
+	}
+}
+
+
+namespace libbio::bgzf {
+
+	void gzi_index::build(std::span <std::byte const> compressed_data)
+	{
+		clear();
+
+		binary_parsing::range range_(compressed_data.data(), compressed_data.size());
+		std::uint64_t uncompressed_offset{};
+		while (range_)
+		{
+			block bb;
+			parser pp(range_, bb);
+			pp.parse();
+
+			uncompressed_offset += bb.isize;
+			if (range_)
+			{
+				// Skip the empty blocks by replacing the previous entry.
+				std::uint64_t const compressed_offset(range_.it - compressed_data.data());
+				if (m_entries.back().uncompressed_offset == uncompressed_offset)
+					m_entries.back().compressed_offset = compressed_offset;
+				else
+					m_entries.emplace_back(compressed_offset, uncompressed_offset);
+			}
+		}
+	}
+
+
+	void gzi_index::read(std::istream &is)
+	{
+		clear();
+
+		auto const count(read_uint64(is));
+		m_entries.reserve(1 + count);
+		for (std::uint64_t i{}; i < count; ++i)
+		{
+			auto const compressed_offset(read_uint64(is));
+			auto const uncompressed_offset(read_uint64(is));
+			m_entries.emplace_back(compressed_offset, uncompressed_offset);
+		}
+	}
+
+
+	void gzi_index::write(std::ostream &os) const
+	{
+		libbio_assert(!m_entries.empty());
+		write_uint64(os, m_entries.size() - 1);
+		for (auto const &ee : m_entries | std::views::drop(1))
+		{
+			write_uint64(os, ee.compressed_offset);
+			write_uint64(os, ee.uncompressed_offset);
+		}
+	}
+
+
+	auto gzi_index::find(std::uint64_t const uncompressed_offset) const -> entry const &
+	{
+		// Find the last block that begins at or before the offset.
+		auto const it(std::upper_bound(m_entries.begin(), m_entries.end(), uncompressed_offset, [](auto const offset, entry const &ee){
+			return offset < ee.uncompressed_offset;
+		}));
+		libbio_assert(m_entries.begin() != it);
+		return *(it - 1);
+	}
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/in_order_reader.hh>
+#include <libbio/bgzf/streaming_reader.hh>
+#include <mutex>
+#include <utility>
+
+
+namespace libbio::bgzf {
+
+	in_order_reader::~in_order_reader()
+	{
+		stop();
+	}
+
+
+	void in_order_reader::start()
+	{
+		m_has_started = true;
+		m_thread = std::thread([this]{
+			try
+			{
+				m_bgzf_reader.run(*m_queue);
+			}
+			catch (...)
+			{
+				std::lock_guard const lock(m_mutex);
+				m_exception = std::current_exception();
+			}
+
+			// Wait for the decompression tasks s.t. all of the blocks have been passed to the delegate.
+			m_group.wait();
+
+			{
+				std::lock_guard const lock(m_mutex);
+				m_did_finish = true;
+			}
+
+			m_cv.notify_one();
+		});
+	}
+
+
+	void in_order_reader::stop()
+	{
+		if (!m_has_started)
+			return;
+
+		m_bgzf_reader.stop();
+
+		{
+			// Release the blocks that have not been parsed s.t. run() can finish.
+			std::lock_guard const lock(m_mutex);
+			m_is_stopping = true;
+			if (m_holds_block)
+			{
+				m_holds_block = false;
+				m_semaphore.release();
+			}
+
+			m_semaphore.release(m_pending_blocks.size());
+			m_pending_blocks.clear();
+		}
+
+		m_thread.join();
+	}
+
+
+	void in_order_reader::release_current_block()
+	{
+		if (!m_holds_block)
+			return;
+
+		m_holds_block = false;
+		m_current_block_offset = 0;
+		m_semaphore.release();
+
+		std::lock_guard const lock(m_mutex);
+		m_current_block.clear();
+		m_free_buffers.emplace_back(std::move(m_current_block));
+	}
+
+
+	void in_order_reader::streaming_reader_did_decompress_block(
+		streaming_reader &reader,
+		std::size_t block_index,
+		buffer_type &buffer
+	)
+	{
+		{
+			std::lock_guard const lock(m_mutex);
+			if (m_is_stopping)
+				m_semaphore.release();
+			else
+			{
+				// Swap the contents s.t. the output buffer can be returned immediately.
+				buffer_type data;
+				if (!m_free_buffers.empty())
+				{
+					data = std::move(m_free_buffers.back());
+					m_free_buffers.pop_back();
+				}
+
+				using std::swap;
+				swap(data, buffer);
+				m_pending_blocks.emplace_back(block_index, std::move(data));
+				std::push_heap(m_pending_blocks.begin(), m_pending_blocks.end(), std::greater <>{});
+			}
+		}
+
+		m_cv.notify_one();
+		reader.return_output_buffer(buffer);
+	}
+
+
+	bool in_order_reader::next_block(byte_span &block)
+	{
+		if (!m_has_started)
+			start();
+
+		release_current_block();
+
+		std::unique_lock lock(m_mutex);
+		while (true)
+		{
+			if (!m_pending_blocks.empty() && m_next_block_index == m_pending_blocks.front().index)
+			{
+				std::pop_heap(m_pending_blocks.begin(), m_pending_blocks.end(), std::greater <>{});
+				m_current_block = std::move(m_pending_blocks.back().data);
+				m_pending_blocks.pop_back();
+				m_holds_block = true;
+				++m_next_block_index;
+
+				block = byte_span{m_current_block.data(), m_current_block.size()};
+				return true;
+			}
+
+			if (m_exception)
+				std::rethrow_exception(m_exception);
+
+			if (m_did_finish)
+			{
+				libbio_always_assert(m_pending_blocks.empty(), "Missing BGZF block");
+				return false;
+			}
+
+			m_cv.wait(lock);
+		}
+	}
+
+
+	std::size_t in_order_reader::read(std::size_t const len, std::byte *dst)
+	{
+		if (!m_holds_block || m_current_block.size() == m_current_block_offset)
+		{
+			// Skip empty blocks.
+			byte_span block;
+			do
+			{
+				if (!next_block(block))
+					return 0;
+			}
+			while (block.empty());
+		}
+
+		auto const count(std::min(len, m_current_block.size() - m_current_block_offset));
+		std::memcpy(dst, m_current_block.data() + m_current_block_offset, count);
+		m_current_block_offset += count;
+		return count;
+	}
+}
+
+#endif
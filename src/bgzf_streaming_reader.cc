@@ -118,7 +118,7 @@ namespace libbio::bgzf {
 		});
 
 		std::size_t current_offset{};
-		while (true)
+		while (!is_stopped())
 		{
 			// Update the buffer.
 			std::size_t bytes_read{};
@@ -142,7 +142,7 @@ namespace libbio::bgzf {
 			binary_parsing::range reading_range_(reading_range);
 
 			// Read until at most block_size bytes left.
-			while (block_size < reading_range.size())
+			while (block_size < reading_range.size() && !is_stopped())
 			{
 				// Parse a BGZF block.
 				block bb;
@@ -199,10 +199,13 @@ namespace libbio::bgzf {
 			}
 		}
 
+		if (is_stopped())
+			return;
+
 		// EOF found. Read until the end of the input.
 		{
 			binary_parsing::range reading_range_(reading_range);
-			while (reading_range_)
+			while (reading_range_ && !is_stopped())
 			{
 				// Parse a BGZF block.
 				block bb;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if defined(LIBBIO_ENABLE_BGZF_COMPRESSOR) && LIBBIO_ENABLE_BGZF_COMPRESSOR
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <libbio/assert.hh>
+#include <libbio/bgzf/writer.hh>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+
+	// SAMv1 § 4.1.2.
+	constexpr inline std::array const eof_block{
+		std::byte{0x1f}, std::byte{0x8b}, std::byte{0x08}, std::byte{0x04},
+		std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00},
+		std::byte{0x00}, std::byte{0xff}, std::byte{0x06}, std::byte{0x00},
+		std::byte{0x42}, std::byte{0x43}, std::byte{0x02}, std::byte{0x00},
+		std::byte{0x1b}, std::byte{0x00}, std::byte{0x03}, std::byte{0x00},
+		std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00},
+		std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00}
+	};
+
+
+	struct task_cmp
+	{
+		template <typename t_task>
+		bool operator()(t_task const *lhs, t_task const *rhs) const { return lhs->block_index > rhs->block_index; }
+	};
+}
+
+
+namespace libbio::bgzf::detail {
+
+	void writer_compression_task::prepare(int const compression_level)
+	{
+		compressor.prepare(compression_level);
+		input.reserve(writer::max_input_size);
+		output.resize(writer::max_block_size);
+	}
+
+
+	void writer_compression_task::run()
+	{
+		libbio_assert(bgzf_writer);
+
+		// The task needs to be returned to the writer also in case of an error.
+		std::exception_ptr exc;
+		try
+		{
+			compressed_block = compressor.compress_block(
+				std::span{input.data(), input.size()},
+				std::span{output.data(), output.size()}
+			);
+		}
+		catch (...)
+		{
+			exc = std::current_exception();
+		}
+
+		bgzf_writer->compression_task_did_finish(*this, exc);
+	}
+}
+
+
+namespace libbio::bgzf {
+
+	writer::writer(
+		file_handle &handle,
+		std::size_t const task_count,
+		int const compression_level,
+		dispatch::queue &queue
+	):
+		m_task_queue(task_count, task_queue_type::start_from_reading{true}),
+		m_handle(&handle),
+		m_queue(&queue)
+	{
+		libbio_assert_lt(0, task_count);
+		for (auto &task : m_task_queue.values())
+		{
+			task.bgzf_writer = this;
+			task.prepare(compression_level);
+		}
+
+		m_finished_tasks.reserve(m_task_queue.size());
+		m_ready_tasks.reserve(m_task_queue.size());
+	}
+
+
+	writer::~writer()
+	{
+		// Make sure that the worker threads do not access the tasks after destruction.
+		m_group.wait();
+	}
+
+
+	void writer::write_block(std::span <std::byte const> block)
+	{
+		auto const *data(reinterpret_cast <char const *>(block.data()));
+		auto remaining(block.size());
+		while (remaining)
+		{
+			auto const count(m_handle->write(data, remaining));
+			data += count;
+			remaining -= count;
+		}
+	}
+
+
+	void writer::rethrow_exception_if_needed()
+	{
+		std::lock_guard const lock(m_mutex);
+		if (m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+
+	void writer::compression_task_did_finish(compression_task &task, std::exception_ptr exc)
+	{
+		// Called from worker threads. The tasks are returned in order also after an error.
+		// Only one thread writes at a time; the others just add their tasks to the heap,
+		// so the blocks can be written without holding the mutex.
+		std::unique_lock lock(m_mutex);
+		if (exc && !m_exception)
+			m_exception = std::move(exc);
+
+		m_finished_tasks.push_back(&task);
+		std::push_heap(m_finished_tasks.begin(), m_finished_tasks.end(), task_cmp{});
+
+		if (m_is_writing)
+			return; // The writing thread will handle the task.
+
+		m_is_writing = true;
+		while (true)
+		{
+			// Take the contiguous ready blocks.
+			libbio_assert(m_ready_tasks.empty());
+			while (!m_finished_tasks.empty() && m_finished_tasks.front()->block_index == m_next_written_block_index)
+			{
+				std::pop_heap(m_finished_tasks.begin(), m_finished_tasks.end(), task_cmp{});
+				m_ready_tasks.push_back(m_finished_tasks.back());
+				m_finished_tasks.pop_back();
+				++m_next_written_block_index;
+			}
+
+			if (m_ready_tasks.empty())
+			{
+				m_is_writing = false;
+				return;
+			}
+
+			auto should_write(!m_exception);
+			lock.unlock();
+
+			std::exception_ptr write_exc;
+			for (auto *next_task : m_ready_tasks)
+			{
+				if (should_write)
+				{
+					try
+					{
+						write_block(next_task->compressed_block);
+					}
+					catch (...)
+					{
+						write_exc = std::current_exception();
+						should_write = false;
+					}
+				}
+
+				m_task_queue.push(*next_task);
+				// Task no longer valid.
+			}
+
+			m_ready_tasks.clear();
+			lock.lock();
+
+			if (write_exc && !m_exception)
+				m_exception = std::move(write_exc);
+		}
+	}
+
+
+	void writer::write(std::span <std::byte const> data)
+	{
+		while (!data.empty())
+		{
+			if (!m_current_task)
+			{
+				rethrow_exception_if_needed();
+				m_current_task = &m_task_queue.pop(); // Blocks when no more tasks are available.
+				m_current_task->input.clear();
+			}
+
+			auto &input(m_current_task->input);
+			auto const count(std::min(data.size(), max_input_size - input.size()));
+			input.insert(input.end(), data.begin(), data.begin() + count);
+			data = data.subspan(count);
+
+			if (max_input_size == input.size())
+				flush_block();
+		}
+	}
+
+
+	void writer::flush_block()
+	{
+		if (!m_current_task)
+			return;
+
+		m_current_task->block_index = m_next_block_index++;
+		m_queue->group_async(m_group, m_current_task);
+		m_current_task = nullptr;
+	}
+
+
+	void writer::finish()
+	{
+		flush_block();
+		m_group.wait();
+		rethrow_exception_if_needed();
+		libbio_assert_eq(m_next_block_index, m_next_written_block_index);
+		write_block(eof_block);
+	}
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <libbio/decompressing_reading_handle.hh>
+#include <libbio/file_handling.hh>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+#	include <libbio/bgzf/in_order_reader.hh>
+#endif
+
+
+namespace {
+
+	typedef libbio::decompressing_reading_handle::compression_type	compression_type;
+
+
+	compression_type detect_compression(std::span <std::byte const> const header)
+	{
+		// Check the gzip magic number and the BC extra subfield, which comes first in BGZF.
+		auto const byte_at([header](std::size_t const idx){ return std::to_integer <unsigned char>(header[idx]); });
+		if (header.size() < 2 || !(0x1f == byte_at(0) && 0x8b == byte_at(1)))
+			return compression_type::none;
+
+		if (libbio::prefix_reading_handle::PREFIX_SIZE == header.size() && (0x04 & byte_at(3)) && 'B' == byte_at(12) && 'C' == byte_at(13))
+			return compression_type::bgzf;
+
+		return compression_type::gzip;
+	}
+}
+
+
+namespace libbio {
+
+	std::span <std::byte const> prefix_reading_handle::read_prefix(reading_handle &handle)
+	{
+		// Pipes may return fewer bytes than requested.
+		m_handle = &handle;
+		m_prefix_size = 0;
+		m_prefix_pos = 0;
+		while (m_prefix_size < PREFIX_SIZE)
+		{
+			auto const res(handle.read(PREFIX_SIZE - m_prefix_size, m_prefix.data() + m_prefix_size));
+			if (!res)
+				break;
+			m_prefix_size += res;
+		}
+
+		return std::span(m_prefix.data(), m_prefix_size);
+	}
+
+
+	std::size_t prefix_reading_handle::read(std::size_t const len, std::byte *dst)
+	{
+		libbio_assert(m_handle);
+		if (m_prefix_pos < m_prefix_size)
+		{
+			auto const count(std::min(len, m_prefix_size - m_prefix_pos));
+			std::copy_n(m_prefix.data() + m_prefix_pos, count, dst);
+			m_prefix_pos += count;
+			return count;
+		}
+
+		return m_handle->read(len, dst);
+	}
+
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+	void decompressing_reading_handle::bgzf_reader_deleter::operator()(bgzf::in_order_reader *reader) const
+	{
+		delete reader;
+	}
+#else
+	void decompressing_reading_handle::bgzf_reader_deleter::operator()(bgzf::in_order_reader *) const
+	{
+		// The reader is never allocated.
+	}
+#endif
+
+
+	void decompressing_reading_handle::prepare_gzip_handle()
+	{
+		if (m_has_prepared_gzip_handle)
+			m_gzip_handle.finish();
+		else
+		{
+			m_gzip_handle.prepare();
+			m_has_prepared_gzip_handle = true;
+		}
+
+		m_gzip_handle.set_gzip_input_handle(m_prefix_handle);
+	}
+
+
+	void decompressing_reading_handle::open(std::string const &path)
+	{
+		open(file_handle(open_file_for_reading(path)));
+	}
+
+
+	void decompressing_reading_handle::open(file_handle &&handle)
+	{
+		m_bgzf_reader.reset();
+		m_handle = std::move(handle);
+		m_compression = detect_compression(m_prefix_handle.read_prefix(m_handle));
+
+		// The prefix is passed to the decompressor.
+		switch (m_compression)
+		{
+			case compression_type::none:
+				m_reading_handle = &m_prefix_handle;
+				break;
+
+			case compression_type::gzip:
+				prepare_gzip_handle();
+				m_reading_handle = &m_gzip_handle;
+				break;
+
+			case compression_type::bgzf:
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+				m_bgzf_reader.reset(new bgzf::in_order_reader(m_prefix_handle));
+				m_reading_handle = m_bgzf_reader.get();
+#else
+				throw std::runtime_error("libbio was built without BGZF support");
+#endif
+				break;
+		}
+	}
+}
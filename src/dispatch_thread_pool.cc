@@ -197,14 +197,25 @@ namespace libbio::dispatch {
 					} // Inner while (true)
 				} // Critical section 1
 
+				// Critical section 2.
+				lock.lock();
+
+				// A task may have been added after the queues were checked but before the lock was acquired.
+				// notify() does not wake up any worker in that case if all of them are busy.
+				if (pool.m_has_unclaimed_tasks)
+				{
+					pool.m_has_unclaimed_tasks = false;
+					pool.m_waiting_tasks -= executed_tasks;
+					lock.unlock();
+					continue;
+				}
+
 				{
 					// Check the last wake-up time.
 					auto const now{clock_type::now()};
 					auto const diff(now - last_wake_up_time);
 					if (0 == executed_tasks && m_max_idle_time <= diff)
 					{
-						// Critical section 2.
-						lock.lock();
 						remove_from_pool(executed_tasks); // zero but does not matter.
 						return;
 					}
@@ -212,9 +223,7 @@ namespace libbio::dispatch {
 					last_wake_up_time = now;
 				}
 
-				// Critical section 2.
 				{
-					lock.lock();
 					begin_idle(executed_tasks);
 
 					// Handle spurious wake-ups by repeatedly calling wait_for().
@@ -315,7 +324,11 @@ namespace libbio::dispatch {
 			}
 
 			if (m_max_workers <= m_current_workers && m_min_workers <= m_current_workers)
+			{
+				// Make the busy workers check the queues again before going idle.
+				m_has_unclaimed_tasks = true;
 				return;
+			}
 
 			// Can start a new thread.
 			start_worker_();
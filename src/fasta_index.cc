@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <libbio/fasta_index.hh>
+#include <libbio/utility/misc.hh>	// libbio::parse_integer
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace {
+
+	std::string_view next_field(std::string_view &line)
+	{
+		auto const tab_pos(line.find('\t'));
+		auto const retval(line.substr(0, tab_pos));
+		line.remove_prefix(std::string_view::npos == tab_pos ? line.size() : 1 + tab_pos);
+		return retval;
+	}
+
+
+	template <typename t_integer>
+	t_integer parse_field(std::string_view &line)
+	{
+		t_integer retval{};
+		if (!libbio::parse_integer(next_field(line), retval))
+			throw std::runtime_error("Unable to parse FASTA index");
+		return retval;
+	}
+}
+
+
+namespace libbio {
+
+	void fasta_index::add_entry(fasta_index_entry &&entry)
+	{
+		auto const [it, did_emplace] = m_entry_indices.emplace(entry.name, m_entries.size());
+		if (!did_emplace)
+			throw std::runtime_error("Duplicate sequence name in FASTA: " + entry.name);
+		m_entries.emplace_back(std::move(entry));
+	}
+
+
+	bool fasta_line_length_checker::add_line(fasta_index_entry &entry, std::uint64_t const bases, std::uint64_t const width)
+	{
+		bool retval{true};
+		if (bases)
+		{
+			if (m_has_short_line)
+				retval = false;
+
+			if (!entry.line_bases)
+			{
+				entry.line_bases = bases;
+				entry.line_width = width;
+			}
+			else if (entry.line_bases < bases)
+			{
+				retval = false;
+			}
+		}
+
+		// Only the last line may be shorter (or an empty line at the end of the sequence).
+		if (bases < entry.line_bases || width != entry.line_width)
+			m_has_short_line = true;
+
+		return retval;
+	}
+
+
+	fasta_index_builder::fasta_index_builder(fasta_index &index):
+		m_index(&index)
+	{
+		index.clear();
+	}
+
+
+	void fasta_index_builder::add_line(std::string_view line, std::uint32_t const width)
+	{
+		auto const next_offset(m_line_offset + width);
+		if (line.starts_with('>'))
+		{
+			if (m_in_sequence)
+				m_index->add_entry(std::move(m_entry));
+
+			// The name is the identifier up to the first whitespace character, as in samtools faidx.
+			line.remove_prefix(1);
+			m_entry = fasta_index_entry{};
+			m_entry.name = line.substr(0, line.find_first_of(" \t\r"));
+			m_entry.offset = next_offset;
+			m_in_sequence = true;
+			m_line_lengths.reset();
+		}
+		else if (m_in_sequence)
+		{
+			if (line.ends_with('\r'))
+				line.remove_suffix(1);
+
+			if (!m_line_lengths.add_line(m_entry, line.size(), width))
+				throw std::runtime_error("Different line lengths in FASTA sequence " + m_entry.name);
+
+			m_entry.length += line.size();
+		}
+		else if (!line.empty())
+		{
+			throw std::runtime_error("Unexpected text before the first FASTA header");
+		}
+
+		m_line_offset = next_offset;
+	}
+
+
+	void fasta_index_builder::add(std::string_view chunk)
+	{
+		while (!chunk.empty())
+		{
+			auto const nl_pos(chunk.find('\n'));
+			if (std::string_view::npos == nl_pos)
+			{
+				m_partial_line.append(chunk);
+				return;
+			}
+
+			if (m_partial_line.empty())
+				add_line(chunk.substr(0, nl_pos), 1 + nl_pos);
+			else
+			{
+				m_partial_line.append(chunk.substr(0, nl_pos));
+				add_line(m_partial_line, 1 + m_partial_line.size());
+				m_partial_line.clear();
+			}
+
+			chunk.remove_prefix(1 + nl_pos);
+		}
+	}
+
+
+	void fasta_index_builder::finish()
+	{
+		// Handle the last line if it does not end in a newline.
+		if (!m_partial_line.empty())
+		{
+			add_line(m_partial_line, m_partial_line.size());
+			m_partial_line.clear();
+		}
+
+		if (m_in_sequence)
+			m_index->add_entry(std::move(m_entry));
+		m_in_sequence = false;
+	}
+
+
+	void fasta_index::build(std::string_view const content)
+	{
+		fasta_index_builder builder(*this);
+		builder.add(content);
+		builder.finish();
+	}
+
+
+	void fasta_index::read(std::istream &is)
+	{
+		clear();
+
+		std::string buffer;
+		while (std::getline(is, buffer))
+		{
+			std::string_view line(buffer);
+			if (line.empty())
+				continue;
+
+			fasta_index_entry entry;
+			entry.name = next_field(line);
+			entry.length = parse_field <std::uint64_t>(line);
+			entry.offset = parse_field <std::uint64_t>(line);
+			entry.line_bases = parse_field <std::uint32_t>(line);
+			entry.line_width = parse_field <std::uint32_t>(line);
+			add_entry(std::move(entry));
+		}
+	}
+
+
+	void fasta_index::write(std::ostream &os) const
+	{
+		for (auto const &entry : m_entries)
+			os << entry.name << '\t' << entry.length << '\t' << entry.offset << '\t' << entry.line_bases << '\t' << entry.line_width << '\n';
+	}
+
+
+	fasta_index_entry const *fasta_index::find(std::string_view const name) const
+	{
+		auto const it(m_entry_indices.find(name));
+		if (m_entry_indices.end() == it)
+			return nullptr;
+		return &m_entries[it->second];
+	}
+}
@@ -111,6 +111,7 @@ namespace libbio
 	void fasta_reader_base::prepare()
 	{
 		m_fsm = fsm{m_buffer.data()};
+		m_newline_stripping_state = newline_stripping_state{};
 		m_extra_fields.clear();
 		m_buffer.clear();
 		%% write init;
@@ -126,6 +127,9 @@ namespace libbio
 
 	auto fasta_reader_base::parse_(handle_type &handle, std::size_t blocksize) -> parsing_status
 	{
+		if (m_strips_newlines)
+			return parse_stripping_newlines_(handle, blocksize);
+
 		if (0 == blocksize)
 			blocksize = 16384; // Best guess.
 
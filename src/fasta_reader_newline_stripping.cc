@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/fasta_reader.hh>
+#include <libbio/utility/strip_newlines.hh>
+#include <new>
+#include <span>
+#include <string_view>
+
+
+namespace {
+
+	bool is_header_separator(char const cc) { return std::isspace(static_cast <unsigned char>(cc)); }
+	bool is_header_start(char const cc) { return '>' == cc || ';' == cc; }
+}
+
+
+namespace libbio {
+
+	void fasta_reader_base::update_line_lengths(std::uint64_t const bases, std::uint64_t const width)
+	{
+		auto &state(m_newline_stripping_state);
+		if (!state.line_lengths.add_line(state.index_entry, bases, width))
+			state.has_uniform_line_lengths = false;
+	}
+
+
+	char const *fasta_reader_base::handle_sequence_lines(char const * const start, char const * const end)
+	{
+		// Find the line ends with memchr, which is vectorised in the common C libraries.
+		// Stop at the next header.
+		auto &state(m_newline_stripping_state);
+		auto const *pp(start);
+		auto const *retval(end);
+		while (pp != end)
+		{
+			auto const *nl(static_cast <char const *>(std::memchr(pp, '\n', end - pp)));
+			if (!nl)
+			{
+				state.line_length += end - pp;
+				break;
+			}
+
+			state.line_length += nl - pp;
+			auto const has_carriage_return('\r' == (nl == start ? state.previous_character : nl[-1]));
+			update_line_lengths(state.line_length - has_carriage_return, 1 + state.line_length);
+			state.line_length = 0;
+			++m_fsm.lineno;
+
+			pp = nl + 1;
+			if (pp != end && is_header_start(*pp))
+			{
+				retval = pp;
+				break;
+			}
+		}
+
+		if (start != retval)
+			state.previous_character = retval[-1];
+		return retval;
+	}
+
+
+	void fasta_reader_base::finish_sequence_lines()
+	{
+		// Handle the last line if it does not end in a newline.
+		auto &state(m_newline_stripping_state);
+		if (state.line_length)
+			update_line_lengths(state.line_length - ('\r' == state.previous_character), state.line_length);
+
+		state.line_length = 0;
+		state.in_sequence = false;
+	}
+
+
+	auto fasta_reader_base::handle_header_line(char const * const line_start, char const * const line_end) -> parsing_status
+	{
+		auto &state(m_newline_stripping_state);
+		auto const *pp(line_start + 1);
+		auto const *identifier_end(std::find_if(pp, line_end, is_header_separator));
+		if (pp == identifier_end)
+		{
+			m_fsm.line_start = line_start;
+			m_fsm.p = pp;
+			report_unexpected_character(m_fsm.cs);
+			return parsing_status::failure;
+		}
+
+		std::string_view const identifier{pp, identifier_end};
+		pp = identifier_end;
+		m_extra_fields.clear();
+		while (true)
+		{
+			pp = std::find_if_not(pp, line_end, is_header_separator);
+			if (pp == line_end)
+				break;
+
+			auto const *field_end(std::find_if(pp, line_end, is_header_separator));
+			new (&m_extra_fields.emplace_back(0, 0).sv) std::string_view{pp, field_end};
+			pp = field_end;
+		}
+
+		state.index_entry = fasta_index_entry{};
+		state.index_entry.name = identifier;
+		state.index_entry.offset = state.buffer_offset + (line_end + 1 - m_buffer.data());
+		state.line_length = 0;
+		state.at_line_start = true;
+		state.in_sequence = true;
+		state.line_lengths.reset();
+		state.has_uniform_line_lengths = true;
+
+		std::span const extra_fields{reinterpret_cast <std::string_view *>(m_extra_fields.data()), m_extra_fields.size()};
+		auto const should_continue(m_delegate->handle_identifier(*this, identifier, extra_fields));
+		m_extra_fields.clear();
+		return should_continue ? parsing_status::success : parsing_status::cancelled;
+	}
+
+
+	auto fasta_reader_base::parse_stripping_newlines_(handle_type &handle, std::size_t blocksize) -> parsing_status
+	{
+		if (0 == blocksize)
+			blocksize = 16384; // Best guess.
+
+		// The state is updated before calling the delegate s.t. parsing may be continued with parse_() after cancelling.
+		auto &state(m_newline_stripping_state);
+		while (true)
+		{
+			if (m_buffer.size() == state.buffer_position)
+			{
+				state.buffer_offset += m_buffer.size();
+				state.buffer_position = 0;
+				m_buffer.resize(blocksize);
+				auto const count(handle.read(blocksize, m_buffer.data()));
+				m_buffer.resize(count);
+
+				if (0 == count)
+				{
+					if (state.in_sequence)
+					{
+						finish_sequence_lines();
+						if (!m_delegate->handle_sequence_end(*this))
+							return parsing_status::cancelled;
+					}
+
+					return parsing_status::success;
+				}
+			}
+
+			auto const *begin(m_buffer.data());
+			auto const *end(begin + m_buffer.size());
+			auto const *pp(begin + state.buffer_position);
+
+			if (state.at_line_start && is_header_start(*pp))
+			{
+				auto const *nl(static_cast <char const *>(std::memchr(pp, '\n', end - pp)));
+				if (!nl)
+				{
+					// Move the incomplete header line to the beginning of the buffer and read more.
+					auto const length(end - pp);
+					state.buffer_offset += pp - begin;
+					state.buffer_position = 0;
+					std::memmove(m_buffer.data(), pp, length);
+					m_buffer.resize(length + blocksize);
+					auto const count(handle.read(blocksize, m_buffer.data() + length));
+					m_buffer.resize(length + count);
+
+					if (0 == count)
+					{
+						m_fsm.line_start = m_buffer.data();
+						m_fsm.p = m_buffer.data() + length;
+						report_unexpected_eof(m_fsm.cs);
+						return parsing_status::failure;
+					}
+
+					continue;
+				}
+
+				if (state.in_sequence)
+				{
+					finish_sequence_lines();
+					if (!m_delegate->handle_sequence_end(*this))
+						return parsing_status::cancelled;
+				}
+
+				state.buffer_position = nl + 1 - begin;
+				++m_fsm.lineno;
+				if (auto const res(handle_header_line(pp, nl)); parsing_status::success != res)
+					return res;
+			}
+			else
+			{
+				if (!state.in_sequence)
+				{
+					// Sequence without a header.
+					state.index_entry = fasta_index_entry{};
+					state.index_entry.offset = state.buffer_offset + state.buffer_position;
+					state.in_sequence = true;
+					state.line_lengths.reset();
+					state.has_uniform_line_lengths = true;
+				}
+
+				// Pass the remaining sequence in the buffer to the delegate as one chunk.
+				auto const *region_end(handle_sequence_lines(pp, end));
+				state.buffer_position = region_end - begin;
+				state.at_line_start = ('\n' == region_end[-1]);
+				state.sequence_buffer.resize(region_end - pp);
+				auto const count(strip_newlines(std::string_view{pp, region_end}, state.sequence_buffer.data()));
+				state.index_entry.length += count;
+
+				if (count && !m_delegate->handle_sequence_chunk(*this, std::string_view{state.sequence_buffer.data(), count}, false))
+					return parsing_status::cancelled;
+			}
+		}
+	}
+}
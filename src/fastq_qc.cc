@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/fastq_qc.hh>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(LIBBIO_ENABLE_HIGHWAY) && LIBBIO_ENABLE_HIGHWAY
+#	include <libbio/hwy_apply.hh>
+#endif
+
+
+namespace {
+
+	struct sequence_counts
+	{
+		std::uint64_t	gc_count{};
+		std::uint64_t	n_count{};
+	};
+
+
+	constexpr std::size_t QUALITY_VALUE_COUNT{libbio::fastq_qc_statistics::QUALITY_VALUE_COUNT};
+
+
+	constexpr char to_upper(char const cc) { return cc & ~0x20; }
+
+
+#if defined(LIBBIO_ENABLE_HIGHWAY) && LIBBIO_ENABLE_HIGHWAY
+	namespace hn = hwy::HWY_NAMESPACE;
+
+	typedef libbio::hwy_apply <hn::ScalableTag <std::uint8_t>>	byte_apply_type;
+
+
+	HWY_ATTR sequence_counts count_characters(std::string_view const seq)
+	{
+		// LoadN fills the remaining lanes with zeros, which are not counted.
+		byte_apply_type const apply;
+		auto const *src(reinterpret_cast <std::uint8_t const *>(seq.data()));
+		sequence_counts retval;
+		apply(seq.size(), [&](auto const &cb) HWY_ATTR {
+			auto const vec(hn::And(cb.load_u(src), cb.set(0xdf))); // To upper case.
+			auto const is_gc(hn::Or(hn::Eq(vec, cb.set('C')), hn::Eq(vec, cb.set('G'))));
+			auto const is_n(hn::Eq(vec, cb.set('N')));
+			retval.gc_count += hn::CountTrue(byte_apply_type::dd, is_gc);
+			retval.n_count += hn::CountTrue(byte_apply_type::dd, is_n);
+		});
+		return retval;
+	}
+
+
+	HWY_ATTR std::uint64_t quality_sum(std::string_view const quality)
+	{
+		byte_apply_type const apply;
+		hn::Repartition <std::uint64_t, byte_apply_type::tag_type> const d64;
+		auto const *src(reinterpret_cast <std::uint8_t const *>(quality.data()));
+		auto sums(hn::Zero(d64));
+		apply(quality.size(), [&](auto const &cb) HWY_ATTR {
+			sums = hn::Add(sums, hn::SumsOf8(cb.load_u(src)));
+		});
+		return hn::ReduceSum(d64, sums);
+	}
+
+
+	HWY_ATTR bool is_quality_in_range(std::string_view const quality, std::uint8_t const offset)
+	{
+		// Subtracting the offset makes the values below it wrap around, so checking the maximum suffices.
+		// LoadN fills the remaining lanes with zeros, which would wrap around, too.
+		byte_apply_type const apply;
+		auto const *src(reinterpret_cast <std::uint8_t const *>(quality.data()));
+		auto max_values(hn::Zero(byte_apply_type::dd));
+		apply(quality.size(), [&](auto const &cb) HWY_ATTR {
+			auto values(hn::Sub(cb.load_u(src), cb.set(offset)));
+			if (cb.is_handling_remaining())
+				values = hn::IfThenElseZero(hn::FirstN(byte_apply_type::dd, cb.count()), values);
+			max_values = hn::Max(max_values, values);
+		});
+		return hn::ReduceMax(byte_apply_type::dd, max_values) < QUALITY_VALUE_COUNT;
+	}
+#else
+	sequence_counts count_characters(std::string_view const seq)
+	{
+		sequence_counts retval;
+		for (auto const cc : seq)
+		{
+			auto const uc(to_upper(cc));
+			retval.gc_count += ('C' == uc || 'G' == uc);
+			retval.n_count += ('N' == uc);
+		}
+		return retval;
+	}
+
+
+	std::uint64_t quality_sum(std::string_view const quality)
+	{
+		std::uint64_t retval{};
+		for (auto const cc : quality)
+			retval += std::uint8_t(cc);
+		return retval;
+	}
+
+
+	bool is_quality_in_range(std::string_view const quality, std::uint8_t const offset)
+	{
+		// Subtracting the offset makes the values below it wrap around, so checking the maximum suffices.
+		// Written as a reduction s.t. the compiler can vectorise the loop.
+		std::uint8_t max_value{};
+		for (auto const cc : quality)
+			max_value = std::max <std::uint8_t>(max_value, std::uint8_t(cc) - offset);
+		return max_value < QUALITY_VALUE_COUNT;
+	}
+#endif
+
+
+	void add_counts(std::vector <std::uint64_t> &dst, std::vector <std::uint64_t> const &src)
+	{
+		if (dst.size() < src.size())
+			dst.resize(src.size(), 0);
+		std::transform(src.begin(), src.end(), dst.begin(), dst.begin(), std::plus{});
+	}
+}
+
+
+namespace libbio {
+
+	void fastq_qc_statistics::reserve_positions(std::size_t const length)
+	{
+		if (m_position_n_counts.size() < length)
+		{
+			m_position_quality_counts.resize(length * QUALITY_VALUE_COUNT, 0);
+			m_position_n_counts.resize(length, 0);
+		}
+	}
+
+
+	void fastq_qc_statistics::update(std::string_view const sequence, std::string_view const quality)
+	{
+		// Validate the record before updating any of the counts.
+		if (sequence.size() != quality.size())
+			throw std::runtime_error("Sequence and quality lengths do not match");
+		if (!is_quality_in_range(quality, m_quality_offset))
+			throw std::runtime_error("Quality value out of range");
+
+		auto const length(sequence.size());
+		++m_read_count;
+		if (m_length_counts.size() <= length)
+			m_length_counts.resize(1 + length, 0);
+		++m_length_counts[length];
+
+		if (0 == length)
+			return;
+
+		reserve_positions(length);
+
+		// The histograms are updated one position at a time. The increments are scattered, so
+		// the range check was done beforehand to keep this loop free of branches.
+		{
+			auto *counts(m_position_quality_counts.data());
+			for (auto const cc : quality)
+			{
+				++counts[std::uint8_t(std::uint8_t(cc) - m_quality_offset)];
+				counts += QUALITY_VALUE_COUNT;
+			}
+		}
+
+		for (std::size_t i{}; i < length; ++i)
+			m_position_n_counts[i] += ('N' == to_upper(sequence[i]));
+
+		auto const counts(count_characters(sequence));
+		auto const read_quality_sum(quality_sum(quality) - length * m_quality_offset);
+		auto const mean_quality(double(read_quality_sum) / length);
+		auto const gc_percentage(std::lround(100.0 * counts.gc_count / length));
+
+		m_mean_quality.update(mean_quality);
+		++m_mean_quality_counts[std::size_t(mean_quality)];
+		++m_gc_percentage_counts[gc_percentage];
+		m_base_count.update(length);
+		m_gc_count.update(counts.gc_count);
+		m_n_count.update(counts.n_count);
+	}
+
+
+	void fastq_qc_statistics::pairwise_update(fastq_qc_statistics const &other)
+	{
+		libbio_assert_eq(m_quality_offset, other.m_quality_offset);
+
+		add_counts(m_position_quality_counts, other.m_position_quality_counts);
+		add_counts(m_position_n_counts, other.m_position_n_counts);
+		add_counts(m_length_counts, other.m_length_counts);
+		add_counts(m_mean_quality_counts, other.m_mean_quality_counts);
+		add_counts(m_gc_percentage_counts, other.m_gc_percentage_counts);
+
+		// The mean is not defined for empty accumulators.
+		if (m_mean_quality.empty())
+			m_mean_quality = other.m_mean_quality;
+		else if (!other.m_mean_quality.empty())
+			m_mean_quality.pairwise_update(other.m_mean_quality);
+
+		m_base_count.pairwise_update(other.m_base_count);
+		m_gc_count.pairwise_update(other.m_gc_count);
+		m_n_count.pairwise_update(other.m_n_count);
+		m_read_count += other.m_read_count;
+	}
+
+
+	fastq_qc_statistics collect_fastq_qc_statistics(
+		parallel_fastq_reader &reader,
+		std::uint8_t const quality_offset,
+		dispatch::parallel_queue &queue
+	)
+	{
+		// The number of partial statistics is bounded by the number of concurrently running callbacks.
+		std::mutex mutex;
+		std::vector <fastq_qc_statistics> free_statistics;
+
+		reader.parse_unordered([&](fastq_record_batch const &batch){
+			fastq_qc_statistics stats(quality_offset);
+
+			{
+				std::lock_guard const lock(mutex);
+				if (!free_statistics.empty())
+				{
+					stats = std::move(free_statistics.back());
+					free_statistics.pop_back();
+				}
+			}
+
+			for (auto const &rec : batch.records)
+				stats.update(rec);
+
+			{
+				std::lock_guard const lock(mutex);
+				free_statistics.emplace_back(std::move(stats));
+			}
+
+			return true;
+		}, queue);
+
+		fastq_qc_statistics retval(quality_offset);
+		for (auto const &stats : free_statistics)
+			retval.pairwise_update(stats);
+		return retval;
+	}
+}
@@ -21,7 +21,7 @@ namespace libbio {
 	}
 
 
-	void gzip_reading_handle::set_gzip_input_handle(file_handle &handle)
+	void gzip_reading_handle::set_gzip_input_handle(reading_handle &handle)
 	{
 		m_gzip_handle = &handle;
 
@@ -58,9 +58,9 @@ namespace libbio {
 		m_stream.next_out = reinterpret_cast <unsigned char *>(dst);
 		while (true)
 		{
-			auto const * const prev_input_pos{m_stream.next_in};
 			while (m_stream.avail_in && m_stream.avail_out)
 			{
+				auto const * const prev_input_pos{m_stream.next_in};
 				auto const res{::inflate(&m_stream, Z_SYNC_FLUSH)};
 				switch (res)
 				{
@@ -82,6 +82,10 @@ namespace libbio {
 						if (read_amount)
 							return read_amount;
 
+						// The input may have ended in the middle of a deflate block, e.g. after a short read from a pipe.
+						if (!m_stream.avail_in)
+							break;
+
 						throw std::runtime_error("Not enough memory in the provided buffer");
 					}
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <libbio/hash_counter.hh>
+#include <mutex>
+#include <span>
+#include <vector>
+
+
+namespace libbio {
+
+	void hash_counter::add(std::span <std::uint64_t const> const hashes, hash_vector &buffer, offset_vector &offsets)
+	{
+		if (hashes.empty())
+			return;
+
+		// Partition in the caller’s thread s.t. each partition needs to be locked only once.
+		auto const partition_count(m_partitions.size());
+		offsets.clear();
+		offsets.resize(1 + partition_count, 0);
+		for (auto const hash : hashes)
+			++offsets[1 + partition_index(hash)];
+		for (std::size_t i{1}; i <= partition_count; ++i)
+			offsets[i] += offsets[i - 1];
+
+		buffer.resize(hashes.size());
+		{
+			auto next_offsets(offsets); // Copy.
+			for (auto const hash : hashes)
+				buffer[next_offsets[partition_index(hash)]++] = hash;
+		}
+
+		for (std::size_t i{}; i < partition_count; ++i)
+		{
+			if (offsets[i] == offsets[i + 1])
+				continue;
+
+			auto &partition(m_partitions[i]);
+			std::lock_guard const lock(partition.mutex);
+			partition.hashes.insert(partition.hashes.end(), buffer.begin() + offsets[i], buffer.begin() + offsets[i + 1]);
+		}
+	}
+
+
+	auto hash_counter::count(dispatch::parallel_queue &queue) -> count_vector
+	{
+		// Sort and count each partition.
+		std::vector <count_vector> partition_counts(m_partitions.size());
+		dispatch::group group;
+		std::mutex exception_mutex;
+		std::exception_ptr exception;
+		for (std::size_t i{}; i < m_partitions.size(); ++i)
+		{
+			if (m_partitions[i].hashes.empty())
+				continue;
+
+			queue.group_async(group, [&, i]{
+				try
+				{
+					auto &hashes(m_partitions[i].hashes);
+					auto &counts(partition_counts[i]);
+					std::sort(hashes.begin(), hashes.end());
+					for (auto const hash : hashes)
+					{
+						if (counts.empty() || counts.back().hash != hash)
+							counts.emplace_back(hash, 1);
+						else
+							++counts.back().count;
+					}
+
+					hash_vector().swap(hashes);
+				}
+				catch (...)
+				{
+					std::lock_guard const lock(exception_mutex);
+					exception = std::current_exception();
+				}
+			});
+		}
+
+		group.wait();
+		if (exception)
+			std::rethrow_exception(exception);
+
+		// The partitions are ordered by the most significant bits.
+		count_vector retval;
+		std::size_t total_size{};
+		for (auto const &counts : partition_counts)
+			total_size += counts.size();
+		retval.reserve(total_size);
+		for (auto const &counts : partition_counts)
+			retval.insert(retval.end(), counts.begin(), counts.end());
+		return retval;
+	}
+}
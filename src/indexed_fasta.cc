@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <libbio/assert.hh>
+#include <libbio/file_handling.hh>
+#include <libbio/indexed_fasta.hh>
+#include <stdexcept>
+#include <utility>
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+#	include <libbio/bgzf/block_cache.hh>
+#endif
+
+
+namespace {
+
+	bool is_bgzf(std::string_view const content)
+	{
+		// gzip magic number, deflate and FEXTRA, which bgzip always sets.
+		return 4 <= content.size() && content.starts_with("\x1f\x8b\x08\x04");
+	}
+}
+
+
+namespace libbio {
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+	void indexed_fasta::block_cache_deleter::operator()(bgzf::block_cache *cache) const
+	{
+		delete cache;
+	}
+
+
+	bool indexed_fasta::prepare_compressed(std::string const &path)
+	{
+		if (!is_bgzf(m_handle.to_string_view()))
+			return false;
+
+		std::span const compressed_data(reinterpret_cast <std::byte const *>(m_handle.data()), m_handle.size());
+		file_istream stream;
+		if (try_open_file_for_reading(path + ".gzi", stream))
+			m_gzi_index.read(stream);
+		else
+			m_gzi_index.build(compressed_data);
+
+		m_block_cache.reset(new bgzf::block_cache(compressed_data, m_gzi_index));
+		return true;
+	}
+
+
+	void indexed_fasta::build_index()
+	{
+		if (!m_block_cache)
+		{
+			m_index.build(m_handle.to_string_view());
+			return;
+		}
+
+		// Decompress the blocks in order.
+		fasta_index_builder builder(m_index);
+		for (auto const &entry : m_gzi_index.entries())
+		{
+			auto const &block(m_block_cache->block_containing(entry.uncompressed_offset));
+			builder.add(std::string_view(reinterpret_cast <char const *>(block.data.data()), block.data.size()));
+		}
+		builder.finish();
+	}
+
+
+	std::uint64_t indexed_fasta::uncompressed_size() const
+	{
+		if (!m_block_cache)
+			return m_handle.size();
+
+		auto const &entries(m_gzi_index.entries());
+		libbio_assert(!entries.empty());
+		auto const &block(m_block_cache->block_containing(entries.back().uncompressed_offset));
+		return block.uncompressed_offset + block.data.size();
+	}
+
+
+	void indexed_fasta::copy_compressed(std::uint64_t offset, std::uint64_t count, std::string &dst) const
+	{
+		libbio_assert(m_block_cache);
+		while (count)
+		{
+			// The range may continue in the next block.
+			auto const &block(m_block_cache->block_containing(offset));
+			auto const block_offset(offset - block.uncompressed_offset);
+			if (block.data.size() <= block_offset)
+				throw std::runtime_error("FASTA index does not match the BGZF file");
+
+			auto const copied(std::min <std::uint64_t>(count, block.data.size() - block_offset));
+			dst.append(reinterpret_cast <char const *>(block.data.data()) + block_offset, copied);
+			offset += copied;
+			count -= copied;
+		}
+	}
+#else
+	void indexed_fasta::block_cache_deleter::operator()(bgzf::block_cache *) const
+	{
+		// The cache is never allocated.
+	}
+
+
+	bool indexed_fasta::prepare_compressed(std::string const &path)
+	{
+		if (is_bgzf(m_handle.to_string_view()))
+			throw std::runtime_error("libbio was built without BGZF support: " + path);
+		return false;
+	}
+
+
+	void indexed_fasta::build_index() { m_index.build(m_handle.to_string_view()); }
+	std::uint64_t indexed_fasta::uncompressed_size() const { return m_handle.size(); }
+#endif
+
+
+	void indexed_fasta::open(std::string const &path)
+	{
+		close();
+		m_handle.open(path);
+		prepare_compressed(path);
+
+		file_istream stream;
+		if (try_open_file_for_reading(path + ".fai", stream))
+		{
+			m_index.read(stream);
+			check_index();
+			return;
+		}
+
+		build_index();
+	}
+
+
+	void indexed_fasta::open(std::string const &path, fasta_index &&index)
+	{
+		close();
+		m_handle.open(path);
+		prepare_compressed(path);
+		m_index = std::move(index);
+		check_index();
+	}
+
+
+	void indexed_fasta::close()
+	{
+		m_block_cache.reset();
+		m_gzi_index.clear();
+		m_index.clear();
+		m_handle.close();
+	}
+
+
+	void indexed_fasta::check_index() const
+	{
+		// Check that the index refers to the mapped (or decompressed) range.
+		auto const size(uncompressed_size());
+		for (auto const &entry : m_index.entries())
+		{
+			if (entry.length && (!entry.line_bases || size < entry.position_offset(entry.length - 1) + 1))
+				throw std::runtime_error("FASTA index does not match the file: " + entry.name);
+		}
+	}
+
+
+	bool indexed_fasta::subsequence(std::string_view const name, std::uint64_t const begin, std::uint64_t const end, std::string &dst) const
+	{
+		auto const *entry(m_index.find(name));
+		if (!entry)
+			return false;
+
+		subsequence(*entry, begin, end, dst);
+		return true;
+	}
+
+
+	void indexed_fasta::subsequence(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t end, std::string &dst) const
+	{
+		check_range(entry, begin, end);
+		dst.clear();
+		if (begin == end)
+			return;
+
+		dst.reserve(end - begin);
+		auto const *data(m_handle.data());
+		auto pos(begin);
+		while (pos < end)
+		{
+			// Copy up to the end of the current line.
+			auto const line_remaining(entry.line_bases - pos % entry.line_bases);
+			auto const count(std::min <std::uint64_t>(line_remaining, end - pos));
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+			if (m_block_cache)
+			{
+				copy_compressed(entry.position_offset(pos), count, dst);
+				pos += count;
+				continue;
+			}
+#endif
+
+			dst.append(data + entry.position_offset(pos), count);
+			pos += count;
+		}
+	}
+
+
+	std::string_view indexed_fasta::subsequence_view(fasta_index_entry const &entry, std::uint64_t const begin, std::uint64_t end) const
+	{
+		check_range(entry, begin, end);
+		if (begin == end)
+			return {};
+
+		if (begin / entry.line_bases != (end - 1) / entry.line_bases)
+			return {};
+
+		auto const offset(entry.position_offset(begin));
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+		if (m_block_cache)
+		{
+			auto const &block(m_block_cache->block_containing(offset));
+			auto const block_offset(offset - block.uncompressed_offset);
+			if (block.data.size() < block_offset + (end - begin))
+				return {};
+			return std::string_view(reinterpret_cast <char const *>(block.data.data()) + block_offset, end - begin);
+		}
+#endif
+
+		return std::string_view(m_handle.data() + offset, end - begin);
+	}
+}
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/fasta_reader.hh>
+#include <libbio/packed_sequence_store.hh>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+namespace lb	= libbio;
+
+
+namespace {
+
+	constexpr std::size_t const BASES_PER_WORD{32};
+
+	constexpr std::array <char, 4> const BASES{'A', 'C', 'G', 'T'};
+
+
+	// Four decoded bases for each byte of a word.
+	constexpr auto const DECODING_TABLE([]{
+		std::array <std::array <char, 4>, 256> retval{};
+		for (std::size_t i{}; i < 256; ++i)
+		{
+			for (std::size_t j{}; j < 4; ++j)
+				retval[i][j] = BASES[(i >> (2 * j)) & 0x3];
+		}
+		return retval;
+	}());
+
+
+	constexpr std::uint8_t const NOT_BASE{0xff};
+
+
+	constexpr auto const ENCODING_TABLE([]{
+		std::array <std::uint8_t, 256> retval{};
+		std::fill(retval.begin(), retval.end(), NOT_BASE);
+		for (std::uint8_t i{}; i < 4; ++i)
+		{
+			retval[BASES[i]] = i;
+			retval[BASES[i] | 0x20] = i;
+		}
+		return retval;
+	}());
+
+
+	constexpr bool is_lower(char const cc) { return 'a' <= cc && cc <= 'z'; }
+	constexpr char to_upper(char const cc) { return is_lower(cc) ? cc & ~0x20 : cc; }
+
+
+	// Layout of the mappable file. Each section is aligned to eight bytes.
+	constexpr std::array <char, 8> const MAPPABLE_MAGIC{'L', 'B', 'P', 'S', 'Q', 'S', '\0', '\0'};
+	constexpr std::uint32_t const MAPPABLE_BYTE_ORDER_MARK{0x01020304};	// Reads differently if the byte order does not match.
+	constexpr std::uint32_t const MAPPABLE_VERSION{1};
+
+	struct mappable_header
+	{
+		std::array <char, 8>	magic{};
+		std::uint32_t			byte_order_mark{};
+		std::uint32_t			version{};
+		std::uint64_t			contig_count{};
+		std::uint64_t			word_count{};
+		std::uint64_t			ambiguity_run_count{};
+		std::uint64_t			mask_run_count{};
+		std::uint64_t			name_size{};
+	};
+
+	static_assert(std::is_trivially_copyable_v <mappable_header>);
+	static_assert(std::has_unique_object_representations_v <mappable_header>);
+
+
+	constexpr std::size_t padded_size(std::size_t const size) { return (size + 7) / 8 * 8; }
+
+
+	template <typename t_type>
+	void write_section(std::ostream &stream, std::span <t_type const> const values)
+	{
+		constexpr std::array <char, 8> const padding{};
+		auto const size(values.size_bytes());
+		stream.write(reinterpret_cast <char const *>(values.data()), size);
+		stream.write(padding.data(), padded_size(size) - size);
+	}
+
+
+	template <typename t_type>
+	std::span <t_type const> read_section(std::span <std::byte const> &buffer, std::size_t const count)
+	{
+		if (std::numeric_limits <std::size_t>::max() / sizeof(t_type) < count)
+			throw std::runtime_error("Invalid packed sequence store");
+
+		auto const size(padded_size(count * sizeof(t_type)));
+		if (buffer.size() < size)
+			throw std::runtime_error("Unexpected end of packed sequence store");
+
+		std::span const retval(reinterpret_cast <t_type const *>(buffer.data()), count);
+		buffer = buffer.subspan(size);
+		return retval;
+	}
+
+
+	class store_delegate final : public lb::fasta_reader_delegate
+	{
+	private:
+		lb::packed_sequence_store	*m_store{};
+
+	public:
+		explicit store_delegate(lb::packed_sequence_store &store):
+			m_store(&store)
+		{
+		}
+
+		bool handle_identifier(lb::fasta_reader_base &reader, std::string_view const identifier, std::span <std::string_view const> additional_info) override
+		{
+			m_store->add_contig(identifier);
+			return true;
+		}
+
+		bool handle_sequence_chunk(lb::fasta_reader_base &reader, std::string_view const sv, bool const has_newline) override
+		{
+			// The input may consist of one sequence without a header.
+			if (0 == m_store->contig_count())
+				m_store->add_contig("");
+
+			m_store->append_sequence(sv);
+			return true;
+		}
+
+		bool handle_sequence_end(lb::fasta_reader_base &reader) override
+		{
+			return true;
+		}
+	};
+}
+
+
+namespace libbio {
+
+	packed_sequence_view packed_sequence_view::from_mappable(std::span <std::byte const> buffer)
+	{
+		if (buffer.size() < sizeof(mappable_header))
+			throw std::runtime_error("Unexpected end of packed sequence store");
+
+		mappable_header header;
+		std::memcpy(&header, buffer.data(), sizeof(mappable_header));
+		if (MAPPABLE_MAGIC != header.magic)
+			throw std::runtime_error("Unexpected packed sequence store format");
+		if (MAPPABLE_BYTE_ORDER_MARK != header.byte_order_mark)
+			throw std::runtime_error("Packed sequence store was written with a different byte order");
+		if (MAPPABLE_VERSION != header.version)
+			throw std::runtime_error("Unsupported packed sequence store version");
+		buffer = buffer.subspan(sizeof(mappable_header));
+
+		auto const contigs(read_section <packed_sequence_contig>(buffer, header.contig_count));
+		auto const words(read_section <std::uint64_t>(buffer, header.word_count));
+		auto const ambiguity_runs(read_section <packed_sequence_ambiguity_run>(buffer, header.ambiguity_run_count));
+		auto const mask_runs(read_section <packed_sequence_mask_run>(buffer, header.mask_run_count));
+		auto const names(read_section <char>(buffer, header.name_size));
+
+		// Check the ranges once s.t. they need not be checked when accessing the sequences.
+		for (auto const &contig : contigs)
+		{
+			if (
+				contig.base_offset + contig.length < contig.base_offset ||
+				words.size() * BASES_PER_WORD < contig.base_offset + contig.length ||
+				contig.ambiguity_run_end < contig.ambiguity_run_begin ||
+				ambiguity_runs.size() < contig.ambiguity_run_end ||
+				contig.mask_run_end < contig.mask_run_begin ||
+				mask_runs.size() < contig.mask_run_end ||
+				names.size() < contig.name_offset ||
+				names.size() - contig.name_offset < contig.name_length
+			)
+				throw std::runtime_error("Invalid packed sequence store");
+		}
+
+		return packed_sequence_view(words, contigs, ambiguity_runs, mask_runs, std::string_view(names.data(), names.size()));
+	}
+
+
+	packed_sequence_contig const *packed_sequence_view::find(std::string_view const name_) const
+	{
+		for (auto const &contig : m_contigs)
+		{
+			if (name(contig) == name_)
+				return &contig;
+		}
+
+		return nullptr;
+	}
+
+
+	void packed_sequence_view::decode(std::uint64_t pos, std::uint64_t const count, char *dst) const
+	{
+		auto const end(pos + count);
+		auto const load([this](std::uint64_t const pos){
+			return m_words[pos / BASES_PER_WORD] >> (2 * (pos % BASES_PER_WORD));
+		});
+
+		// Handle the bases before the first full byte.
+		while (pos < end && pos % 4)
+			*dst++ = BASES[load(pos++) & 0x3];
+
+		// Decode four bases at a time.
+		while (pos + 4 <= end)
+		{
+			auto const &decoded(DECODING_TABLE[load(pos) & 0xff]);
+			dst = std::copy(decoded.begin(), decoded.end(), dst);
+			pos += 4;
+		}
+
+		while (pos < end)
+			*dst++ = BASES[load(pos++) & 0x3];
+	}
+
+
+	void packed_sequence_view::extract(
+		packed_sequence_contig const &contig,
+		std::uint64_t const start,
+		std::uint64_t const end,
+		char *dst,
+		bool const soft_masked
+	) const
+	{
+		libbio_assert_lte(start, end);
+		libbio_assert_lte(end, contig.length);
+
+		auto const global_start(contig.base_offset + start);
+		auto const global_end(contig.base_offset + end);
+		decode(global_start, end - start, dst);
+
+		// Find the first run that may overlap the range, i.e. the last one that begins before the range.
+		auto const overlapping_runs([global_start](auto const runs){
+			auto it(std::upper_bound(runs.begin(), runs.end(), global_start, [](auto const pos, auto const &run){
+				return pos < run.position;
+			}));
+			if (it != runs.begin())
+				--it;
+			return runs.subspan(it - runs.begin());
+		});
+
+		auto const apply([global_start, global_end, dst](auto const &run, auto &&fn){
+			auto const run_start(std::max <std::uint64_t>(run.position, global_start));
+			auto const run_end(std::min <std::uint64_t>(run.position + run.length, global_end));
+			for (auto pos(run_start); pos < run_end; ++pos)
+				fn(dst[pos - global_start]);
+		});
+
+		auto const ambiguity_runs(m_ambiguity_runs.subspan(contig.ambiguity_run_begin, contig.ambiguity_run_end - contig.ambiguity_run_begin));
+		for (auto const &run : overlapping_runs(ambiguity_runs))
+		{
+			if (global_end <= run.position)
+				break;
+			apply(run, [cc = run.character](char &dst_cc){ dst_cc = cc; });
+		}
+
+		if (soft_masked)
+		{
+			auto const mask_runs(m_mask_runs.subspan(contig.mask_run_begin, contig.mask_run_end - contig.mask_run_begin));
+			for (auto const &run : overlapping_runs(mask_runs))
+			{
+				if (global_end <= run.position)
+					break;
+				apply(run, [](char &dst_cc){ dst_cc |= 0x20; });
+			}
+		}
+	}
+
+
+	bool packed_sequence_view::compare(packed_sequence_contig const &contig, std::uint64_t const pos, std::string_view ref) const
+	{
+		if (contig.length < pos || contig.length - pos < ref.size())
+			return false;
+
+		// Decode in blocks to avoid allocating.
+		std::array <char, 256> buffer;
+		auto start(pos);
+		while (!ref.empty())
+		{
+			auto const count(std::min(ref.size(), buffer.size()));
+			extract(contig, start, start + count, buffer.data(), false);
+			if (!std::equal(ref.begin(), ref.begin() + count, buffer.begin(), [](char const lhs, char const rhs){ return to_upper(lhs) == rhs; }))
+				return false;
+
+			start += count;
+			ref.remove_prefix(count);
+		}
+
+		return true;
+	}
+
+
+	void packed_sequence_store::load_fasta(reading_handle &handle)
+	{
+		store_delegate delegate(*this);
+		fasta_reader reader;
+		reader.parse(handle, delegate);
+	}
+
+
+	void packed_sequence_store::add_contig(std::string_view const name)
+	{
+		auto &contig(m_contigs.emplace_back());
+		contig.base_offset = m_bases.size();
+		contig.ambiguity_run_begin = m_ambiguity_runs.size();
+		contig.ambiguity_run_end = m_ambiguity_runs.size();
+		contig.mask_run_begin = m_mask_runs.size();
+		contig.mask_run_end = m_mask_runs.size();
+		contig.name_offset = m_names.size();
+		contig.name_length = name.size();
+		m_names += name;
+	}
+
+
+	void packed_sequence_store::append_sequence(std::string_view const seq)
+	{
+		libbio_always_assert(!m_contigs.empty());
+		auto &contig(m_contigs.back());
+		auto pos(m_bases.size());
+		m_bases.resize(pos + seq.size()); // Fills with zeros.
+
+		for (auto const cc : seq)
+		{
+			auto const code(ENCODING_TABLE[std::uint8_t(cc)]);
+			if (NOT_BASE == code)
+			{
+				// Extend the previous run if possible.
+				auto const uc(to_upper(cc));
+				if (
+					contig.ambiguity_run_begin < m_ambiguity_runs.size() &&
+					m_ambiguity_runs.back().position + m_ambiguity_runs.back().length == pos &&
+					m_ambiguity_runs.back().character == uc &&
+					m_ambiguity_runs.back().length < std::numeric_limits <std::uint32_t>::max()
+				)
+					++m_ambiguity_runs.back().length;
+				else
+					m_ambiguity_runs.emplace_back(pos, 1, uc);
+			}
+			else
+			{
+				m_bases.word_at(pos / BASES_PER_WORD) |= std::uint64_t(code) << (2 * (pos % BASES_PER_WORD));
+			}
+
+			if (is_lower(cc))
+			{
+				if (contig.mask_run_begin < m_mask_runs.size() && m_mask_runs.back().position + m_mask_runs.back().length == pos)
+					++m_mask_runs.back().length;
+				else
+					m_mask_runs.emplace_back(pos, 1);
+			}
+
+			++pos;
+		}
+
+		contig.length += seq.size();
+		contig.ambiguity_run_end = m_ambiguity_runs.size();
+		contig.mask_run_end = m_mask_runs.size();
+	}
+
+
+	void packed_sequence_store::clear()
+	{
+		m_bases.clear();
+		m_contigs.clear();
+		m_ambiguity_runs.clear();
+		m_mask_runs.clear();
+		m_names.clear();
+	}
+
+
+	void packed_sequence_store::write_mappable(std::ostream &stream) const
+	{
+		mappable_header const header{
+			.magic = MAPPABLE_MAGIC,
+			.byte_order_mark = MAPPABLE_BYTE_ORDER_MARK,
+			.version = MAPPABLE_VERSION,
+			.contig_count = m_contigs.size(),
+			.word_count = m_bases.word_size(),
+			.ambiguity_run_count = m_ambiguity_runs.size(),
+			.mask_run_count = m_mask_runs.size(),
+			.name_size = m_names.size()
+		};
+
+		stream.write(reinterpret_cast <char const *>(&header), sizeof(mappable_header));
+		write_section <packed_sequence_contig>(stream, m_contigs);
+		write_section <std::uint64_t>(stream, {std::to_address(m_bases.word_cbegin()), m_bases.word_size()});
+		write_section <packed_sequence_ambiguity_run>(stream, m_ambiguity_runs);
+		write_section <packed_sequence_mask_run>(stream, m_mask_runs);
+		write_section <char>(stream, m_names);
+	}
+}
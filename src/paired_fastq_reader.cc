@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <libbio/paired_fastq_reader.hh>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+	std::string_view rebase(std::string_view const sv, char const *old_base, char const *new_base)
+	{
+		return std::string_view(new_base + (sv.data() - old_base), sv.size());
+	}
+
+
+	std::string_view identifier_prefix(std::string_view sv)
+	{
+		// Remove the comment and the mate number.
+		sv = sv.substr(0, sv.find_first_of(" \t"));
+		if (sv.ends_with("/1") || sv.ends_with("/2"))
+			sv.remove_suffix(2);
+		return sv;
+	}
+}
+
+
+namespace libbio::detail {
+
+	void fastq_batch_producer::start()
+	{
+		m_thread = std::thread([this]{
+			try
+			{
+				run();
+			}
+			catch (...)
+			{
+				std::lock_guard const lock(m_mutex);
+				m_exception = std::current_exception();
+			}
+
+			{
+				std::lock_guard const lock(m_mutex);
+				m_did_finish = true;
+			}
+
+			m_cv.notify_all();
+		});
+	}
+
+
+	void fastq_batch_producer::stop()
+	{
+		if (!m_thread.joinable())
+			return;
+
+		{
+			std::lock_guard const lock(m_mutex);
+			m_is_stopping = true;
+		}
+
+		m_cv.notify_all();
+		m_thread.join();
+	}
+
+
+	fastq_text_batch fastq_batch_producer::make_batch()
+	{
+		std::lock_guard const lock(m_mutex);
+		if (m_free_batches.empty())
+			return {};
+
+		auto retval(std::move(m_free_batches.back()));
+		m_free_batches.pop_back();
+		return retval;
+	}
+
+
+	bool fastq_batch_producer::add_batch(fastq_text_batch &&batch)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_cv.wait(lock, [this]{ return m_is_stopping || m_pending_batches.size() < m_max_pending_batches; });
+			if (m_is_stopping)
+				return false;
+
+			m_pending_batches.emplace_back(std::move(batch));
+		}
+
+		m_cv.notify_all();
+		return true;
+	}
+
+
+	void fastq_batch_producer::run()
+	{
+		auto const blocksize(m_handle->io_op_blocksize() ?: 65536);
+		auto batch(make_batch());
+		std::size_t parsed_end{};		// Offset of the first unparsed character.
+		std::size_t added_records{};	// Number of records in the previous batches.
+		bool is_last{};
+
+		while (true)
+		{
+			{
+				std::string_view const unparsed(batch.text.data() + parsed_end, batch.text.size() - parsed_end);
+				auto const preceding_records(added_records + batch.records.size());
+				try
+				{
+					parsed_end += parallel_fastq_reader::parse_records(unparsed, is_last, m_batch_size - batch.records.size(), batch.records);
+				}
+				catch (fastq_parse_error const &exc)
+				{
+					// Each record has exactly four lines.
+					throw fastq_parse_error(exc.reason(), exc.lineno() + 4 * preceding_records);
+				}
+			}
+
+			if (m_batch_size == batch.records.size() || is_last)
+			{
+				if (batch.records.empty())
+					break;
+
+				// Move the unparsed characters to the next batch. Resizing to a smaller size does not move the text.
+				auto next_batch(make_batch());
+				next_batch.text.assign(batch.text.begin() + parsed_end, batch.text.end());
+				batch.text.resize(parsed_end);
+				added_records += batch.records.size();
+				if (!add_batch(std::move(batch)))
+					return;
+
+				batch = std::move(next_batch);
+				parsed_end = 0;
+				continue;
+			}
+
+			// Read more. Grow the buffer manually s.t. the views can be updated.
+			auto const size(batch.text.size());
+			if (batch.text.capacity() < size + blocksize)
+			{
+				std::vector <char> text;
+				text.reserve(std::max(2 * batch.text.capacity(), size + blocksize));
+				text.assign(batch.text.begin(), batch.text.end());
+				for (auto &rec : batch.records)
+				{
+					rec.identifier = rebase(rec.identifier, batch.text.data(), text.data());
+					rec.sequence = rebase(rec.sequence, batch.text.data(), text.data());
+					rec.quality = rebase(rec.quality, batch.text.data(), text.data());
+				}
+
+				using std::swap;
+				swap(text, batch.text);
+			}
+
+			batch.text.resize(size + blocksize);
+			auto const count(m_handle->read(blocksize, batch.text.data() + size));
+			batch.text.resize(size + count);
+			if (0 == count)
+				is_last = true;
+		}
+	}
+
+
+	bool fastq_batch_producer::next_batch(fastq_text_batch &dst)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_cv.wait(lock, [this]{ return !m_pending_batches.empty() || m_did_finish; });
+
+			if (m_pending_batches.empty())
+			{
+				if (m_exception)
+					std::rethrow_exception(m_exception);
+				return false;
+			}
+
+			dst.clear();
+			m_free_batches.emplace_back(std::move(dst));
+			dst = std::move(m_pending_batches.front());
+			m_pending_batches.pop_front();
+		}
+
+		m_cv.notify_all();
+		return true;
+	}
+}
+
+
+namespace libbio {
+
+	bool paired_fastq_reader::identifiers_match(std::string_view const lhs, std::string_view const rhs)
+	{
+		return identifier_prefix(lhs) == identifier_prefix(rhs);
+	}
+
+
+	bool paired_fastq_reader::next_batch(paired_fastq_batch &batch)
+	{
+		if (!m_has_started)
+		{
+			m_first.start();
+			m_second.start();
+			m_has_started = true;
+		}
+
+		auto const has_first(m_first.next_batch(batch.first));
+		auto const has_second(m_second.next_batch(batch.second));
+		if (!(has_first || has_second))
+			return false;
+
+		if (has_first != has_second || batch.first.records.size() != batch.second.records.size())
+			throw std::runtime_error("Paired FASTQ inputs have different numbers of records");
+
+		batch.first_record_index = m_record_index;
+		if (m_validates_identifiers)
+		{
+			for (std::size_t i{}; i < batch.size(); ++i)
+			{
+				auto const &lhs(batch.first.records[i].identifier);
+				auto const &rhs(batch.second.records[i].identifier);
+				if (!identifiers_match(lhs, rhs))
+				{
+					throw std::runtime_error(
+						"Mismatched identifiers in paired FASTQ record " + std::to_string(1 + m_record_index + i) + ": " +
+						std::string(lhs) + ", " + std::string(rhs)
+					);
+				}
+			}
+		}
+
+		m_record_index += batch.size();
+		return true;
+	}
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <libbio/assert.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+	typedef std::counting_semaphore <UINT16_MAX>	semaphore_type;
+	typedef std::unique_ptr <libbio::fastq_record_batch>	batch_ptr;
+
+
+	struct batch_ptr_cmp
+	{
+		bool operator()(batch_ptr const &lhs, batch_ptr const &rhs) const { return lhs->chunk_index > rhs->chunk_index; }
+	};
+
+
+	struct parsing_status
+	{
+		std::exception_ptr	exception;
+		std::mutex			mutex;
+		std::atomic_bool	should_stop{};
+
+		bool is_stopped() const { return should_stop.load(std::memory_order_acquire); }
+		void stop() { should_stop.store(true, std::memory_order_release); }
+
+		void stop_with_current_exception()
+		{
+			{
+				std::lock_guard const lock(mutex);
+				if (!exception)
+					exception = std::current_exception();
+			}
+
+			stop();
+		}
+
+		void rethrow_if_needed()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+	};
+
+
+	std::ptrdiff_t pending_chunk_limit(std::size_t const count)
+	{
+		return std::min <std::ptrdiff_t>(count, semaphore_type::max());
+	}
+
+
+	// Return the line that begins at pos without the newline and move pos to the next line.
+	std::string_view next_line(std::string_view const content, std::size_t &pos)
+	{
+		auto const nl_pos(content.find('\n', pos));
+		auto const end(std::string_view::npos == nl_pos ? content.size() : nl_pos);
+		auto const retval(content.substr(pos, end - pos));
+		pos = (std::string_view::npos == nl_pos ? content.size() : 1 + nl_pos);
+		return retval;
+	}
+
+
+	bool is_record_start(std::string_view const content, std::size_t pos)
+	{
+		// A quality line may also begin with @ but in that case the line after the next one
+		// is a sequence line, which cannot begin with +.
+		if (content.size() <= pos || '@' != content[pos])
+			return false;
+
+		next_line(content, pos);
+		if (content.size() <= pos) return false;
+		auto const sequence(next_line(content, pos));
+		if (content.size() <= pos) return false;
+		auto const separator(next_line(content, pos));
+		if (content.size() <= pos) return false;
+		auto const quality(next_line(content, pos));
+		return separator.starts_with('+') && sequence.size() == quality.size();
+	}
+}
+
+
+namespace libbio {
+
+	std::size_t parallel_fastq_reader::find_record_start(std::string_view const content, std::size_t pos)
+	{
+		// Move to the beginning of the next line if needed.
+		if (content.size() <= pos)
+			return content.size();
+		if (0 < pos && '\n' != content[pos - 1])
+			next_line(content, pos);
+
+		while (pos < content.size())
+		{
+			if (is_record_start(content, pos))
+				return pos;
+			next_line(content, pos);
+		}
+
+		return content.size();
+	}
+
+
+	std::size_t parallel_fastq_reader::parse_records(
+		std::string_view const buffer,
+		bool const is_last,
+		std::size_t const max_count,
+		std::vector <fastq_record_view> &dst
+	)
+	{
+		std::size_t pos{};
+		std::size_t lineno{1};
+		auto const report_error([&lineno](char const *message){
+			throw fastq_parse_error(message, lineno);
+		});
+
+		for (std::size_t count{}; count < max_count && pos < buffer.size(); ++count)
+		{
+			// Check that the record is complete before storing it.
+			auto next_pos(pos);
+			auto const identifier(next_line(buffer, next_pos));
+			auto const sequence(next_line(buffer, next_pos));
+			auto const separator(next_line(buffer, next_pos));
+			auto const quality_start(next_pos);
+			auto const quality(next_line(buffer, next_pos));
+			if (buffer.size() == quality_start || '\n' != buffer[next_pos - 1])
+			{
+				if (!is_last)
+					break;
+				if (buffer.size() == quality_start)
+					report_error("Unexpected end of FASTQ record");
+			}
+
+			if (!identifier.starts_with('@'))
+				report_error("Expected a FASTQ record identifier");
+			if (!separator.starts_with('+'))
+				report_error("Expected a FASTQ separator line");
+			if (sequence.size() != quality.size())
+				report_error("Sequence length mismatch");
+
+			dst.emplace_back(identifier.substr(1), sequence, quality);
+			pos = next_pos;
+			lineno += 4;
+		}
+
+		return pos;
+	}
+
+
+	void parallel_fastq_reader::parse_content_chunk(std::string_view const chunk, std::vector <fastq_record_view> &dst) const
+	{
+		try
+		{
+			parse_chunk(chunk, dst);
+		}
+		catch (fastq_parse_error const &exc)
+		{
+			// Count the preceding lines only if needed, since doing so requires a pass over the content.
+			libbio_assert_lte(m_content.data(), chunk.data());
+			auto const preceding(m_content.substr(0, chunk.data() - m_content.data()));
+			throw fastq_parse_error(exc.reason(), exc.lineno() + std::ranges::count(preceding, '\n'));
+		}
+	}
+
+
+	auto parallel_fastq_reader::make_chunks() const -> chunk_vector
+	{
+		chunk_vector retval;
+		retval.reserve(1 + m_content.size() / m_chunk_size);
+		std::size_t pos{};
+		while (pos < m_content.size())
+		{
+			auto const end(find_record_start(m_content, std::min(pos + m_chunk_size, m_content.size())));
+			retval.emplace_back(m_content.substr(pos, end - pos));
+			pos = end;
+		}
+
+		return retval;
+	}
+
+
+	void parallel_fastq_reader::parse_unordered(batch_callback_fn const &callback, dispatch::parallel_queue &queue)
+	{
+		auto const chunks(make_chunks());
+		semaphore_type semaphore(pending_chunk_limit(m_max_pending_chunks));
+		dispatch::group group;
+		parsing_status status;
+
+		for (std::size_t idx{}; idx < chunks.size(); ++idx)
+		{
+			semaphore.acquire();
+			if (status.is_stopped())
+			{
+				semaphore.release();
+				break;
+			}
+
+			queue.group_async(group, [this, &callback, &semaphore, &status, chunk = chunks[idx], idx]{
+				try
+				{
+					fastq_record_batch batch;
+					batch.chunk_index = idx;
+					parse_content_chunk(chunk, batch.records);
+					if (!status.is_stopped() && !callback(batch))
+						status.stop();
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+
+				semaphore.release();
+			});
+		}
+
+		group.wait();
+		status.rethrow_if_needed();
+	}
+
+
+	void parallel_fastq_reader::parse_ordered(batch_callback_fn const &callback, dispatch::parallel_queue &queue)
+	{
+		auto const chunks(make_chunks());
+		semaphore_type semaphore(pending_chunk_limit(m_max_pending_chunks));
+		dispatch::group group;
+		dispatch::serial_queue delivery_queue(queue);
+		parsing_status status;
+
+		// Accessed only from delivery_queue.
+		std::vector <batch_ptr> pending_batches;	// Min-heap by chunk index.
+		std::size_t next_chunk_index{};
+		std::uint64_t record_offset{};
+
+		auto const deliver([&](fastq_record_batch &batch){
+			if (!status.is_stopped())
+			{
+				try
+				{
+					batch.first_record_index = record_offset;
+					record_offset += batch.records.size();
+					if (!callback(batch))
+						status.stop();
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+			}
+
+			++next_chunk_index;
+			semaphore.release();
+		});
+
+		for (std::size_t idx{}; idx < chunks.size(); ++idx)
+		{
+			semaphore.acquire();
+			if (status.is_stopped())
+			{
+				semaphore.release();
+				break;
+			}
+
+			queue.group_async(group, [&, chunk = chunks[idx], idx]{
+				// Always pass the batch to the delivery queue, even if parsing failed, s.t. the following batches get released.
+				auto batch(std::make_unique <fastq_record_batch>());
+				batch->chunk_index = idx;
+				try
+				{
+					if (!status.is_stopped())
+						parse_content_chunk(chunk, batch->records);
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+
+				delivery_queue.group_async(group, [&, batch = std::move(batch)] mutable {
+					if (next_chunk_index != batch->chunk_index)
+					{
+						pending_batches.emplace_back(std::move(batch));
+						std::push_heap(pending_batches.begin(), pending_batches.end(), batch_ptr_cmp{});
+						return;
+					}
+
+					deliver(*batch);
+					batch.reset();
+
+					while (!pending_batches.empty() && next_chunk_index == pending_batches.front()->chunk_index)
+					{
+						std::pop_heap(pending_batches.begin(), pending_batches.end(), batch_ptr_cmp{});
+						auto batch_(std::move(pending_batches.back()));
+						pending_batches.pop_back();
+						deliver(*batch_);
+					}
+				});
+			});
+		}
+
+		group.wait();
+		status.rethrow_if_needed();
+	}
+}
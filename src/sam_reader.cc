@@ -266,7 +266,7 @@ namespace libbio::sam::detail {
 		using std::swap;
 
 		swap(std::get <QNAME>(src), dst.qname);
-		swap(std::get <CIGAR>(src), dst.cigar);
+		swap(std::get <CIGAR>(src).runs, dst.cigar);
 		swap(std::get <SEQ>(src), dst.seq);
 		swap(std::get <QUAL>(src), dst.qual);
 		swap(std::get <OPTIONAL>(src), dst.optional_fields);
@@ -281,6 +281,7 @@ namespace libbio::sam::detail {
 		else
 			dst.rnext_id = header_.find_reference(std::get <RNEXT>(src));
 
+		dst.geometry = std::get <CIGAR>(src).geometry;
 		dst.pos = std::get <POS>(src);
 		dst.pnext = std::get <PNEXT>(src);
 		dst.tlen = std::get <TLEN>(src);
@@ -297,7 +298,7 @@ namespace libbio::sam::detail {
 		using std::swap;
 
 		swap(std::get <QNAME>(dst), src.qname);
-		swap(std::get <CIGAR>(dst), src.cigar);
+		swap(std::get <CIGAR>(dst).runs, src.cigar);
 		swap(std::get <SEQ>(dst), src.seq);
 		swap(std::get <QUAL>(dst), src.qual);
 		swap(std::get <OPTIONAL>(dst), src.optional_fields);
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <libbio/sequence_batch_reader.hh>
+#include <libbio/utility/strip_newlines.hh>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace libbio {
+
+	bool sequence_batch_reader_base::fill()
+	{
+		if (m_is_eof)
+			return false;
+
+		// Move the unread characters to the beginning of the buffer.
+		if (m_pos)
+		{
+			m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_pos);
+			m_pos = 0;
+		}
+
+		auto const size(m_buffer.size());
+		m_buffer.resize(size + m_blocksize);
+		auto const count(m_handle->read(m_blocksize, m_buffer.data() + size));
+		m_buffer.resize(size + count);
+		if (0 == count)
+		{
+			m_is_eof = true;
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool sequence_batch_reader_base::skip_empty_lines()
+	{
+		while (true)
+		{
+			auto const buffer(unread());
+			auto const pos(buffer.find_first_not_of("\r\n"));
+			if (std::string_view::npos != pos)
+			{
+				m_pos += pos;
+				return true;
+			}
+
+			m_pos = m_buffer.size();
+			if (!fill())
+				return false;
+		}
+	}
+
+
+	bool fasta_batch_reader::read_record(sequence_record_batch &batch)
+	{
+		if (!skip_empty_lines())
+			return false;
+
+		if ('>' != m_buffer[m_pos])
+			throw std::runtime_error("Expected a FASTA header");
+
+		// The offsets are relative to m_pos, which fill() may change.
+		std::size_t header_end{};
+		{
+			std::size_t search_pos{1};
+			while (true)
+			{
+				auto const buffer(unread());
+				header_end = buffer.find('\n', search_pos);
+				if (std::string_view::npos != header_end)
+					break;
+
+				search_pos = buffer.size();
+				if (!fill())
+				{
+					header_end = unread().size();
+					break;
+				}
+			}
+		}
+
+		// The sequence ends at the next header or at EOF.
+		std::size_t sequence_end{};
+		{
+			auto search_pos(header_end);
+			while (true)
+			{
+				auto const buffer(unread());
+				sequence_end = buffer.find("\n>", search_pos);
+				if (std::string_view::npos != sequence_end)
+				{
+					++sequence_end;
+					break;
+				}
+
+				// Check the last character again in case it is a newline.
+				search_pos = std::max(header_end, buffer.size() - 1);
+				if (!fill())
+				{
+					sequence_end = unread().size();
+					break;
+				}
+			}
+		}
+
+		auto const buffer(unread());
+		auto header(buffer.substr(1, header_end - 1));
+		if (header.ends_with('\r'))
+			header.remove_suffix(1);
+
+		batch.identifiers += header;
+		append_without_newlines(buffer.substr(header_end, sequence_end - header_end), batch.sequences);
+		batch.finish_record();
+
+		m_pos += sequence_end;
+		++m_record_count;
+		return true;
+	}
+
+
+	bool fasta_batch_reader::read_batch(
+		sequence_record_batch &batch,
+		std::size_t const max_records,
+		std::size_t const max_sequence_length
+	)
+	{
+		batch.clear();
+		while (batch.size() < max_records && batch.sequences.size() < max_sequence_length)
+		{
+			if (!read_record(batch))
+				break;
+		}
+
+		return !batch.empty();
+	}
+
+
+	bool fastq_batch_reader::read_batch(
+		sequence_record_batch &batch,
+		std::size_t const max_records,
+		std::size_t const max_sequence_length
+	)
+	{
+		batch.clear();
+		while (batch.size() < max_records && batch.sequences.size() < max_sequence_length)
+		{
+			if (!skip_empty_lines())
+				break;
+
+			// Parse one record at a time s.t. the buffer may be refilled.
+			m_records.clear();
+			m_pos += parallel_fastq_reader::parse_records(unread(), m_is_eof, 1, m_records);
+			if (m_records.empty())
+			{
+				if (m_is_eof)
+					break;
+
+				fill();
+				continue;
+			}
+
+			auto const &rec(m_records.front());
+			batch.identifiers += rec.identifier;
+			batch.sequences += rec.sequence;
+			batch.qualities += rec.quality;
+			batch.finish_record();
+			++m_record_count;
+		}
+
+		return !batch.empty();
+	}
+}
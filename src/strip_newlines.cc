@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/utility/strip_newlines.hh>
+#include <string_view>
+
+#if defined(LIBBIO_ENABLE_HIGHWAY) && LIBBIO_ENABLE_HIGHWAY
+#	include <hwy/highway.h>
+#endif
+
+
+namespace {
+
+	char *copy_without_character(char const *src, char const *end, char *dst, char const cc)
+	{
+		while (true)
+		{
+			auto const *pos(static_cast <char const *>(std::memchr(src, cc, end - src)));
+			if (!pos)
+				return std::copy(src, end, dst);
+
+			dst = std::copy(src, pos, dst);
+			src = pos + 1;
+		}
+	}
+
+
+	std::size_t strip_newlines_scalar(char const *src, std::size_t const size, char *dst)
+	{
+		// memchr is vectorised in the common C libraries, and the lines are typically long.
+		auto const *end(src + size);
+		auto *dst_(dst);
+		while (src != end)
+		{
+			auto const *nl(static_cast <char const *>(std::memchr(src, '\n', end - src)));
+			auto const *line_end(nl ?: end);
+			dst_ = copy_without_character(src, line_end, dst_, '\r');
+			src = (nl ? nl + 1 : end);
+		}
+
+		return dst_ - dst;
+	}
+
+
+#if defined(LIBBIO_ENABLE_HIGHWAY) && LIBBIO_ENABLE_HIGHWAY
+	namespace hn = hwy::HWY_NAMESPACE;
+
+	HWY_ATTR std::size_t strip_newlines_hwy(char const *src_, std::size_t const size, char *dst_)
+	{
+		hn::ScalableTag <std::uint8_t> const dd;
+		auto const lanes(hn::Lanes(dd));
+		auto const nl(hn::Set(dd, '\n'));
+		auto const cr(hn::Set(dd, '\r'));
+		auto const *src(reinterpret_cast <std::uint8_t const *>(src_));
+		auto *dst(reinterpret_cast <std::uint8_t *>(dst_));
+
+		// Compact each vector by the newline mask.
+		std::size_t ii{};
+		std::size_t count{};
+		for (; ii + lanes <= size; ii += lanes)
+		{
+			auto const vec(hn::LoadU(dd, src + ii));
+			auto const mask(hn::Not(hn::Or(hn::Eq(vec, nl), hn::Eq(vec, cr))));
+			count += hn::CompressBlendedStore(vec, mask, dd, dst + count);
+		}
+
+		return count + strip_newlines_scalar(src_ + ii, size - ii, dst_ + count);
+	}
+#endif
+}
+
+
+namespace libbio {
+
+	std::size_t strip_newlines(std::string_view const src, char *dst)
+	{
+#if defined(LIBBIO_ENABLE_HIGHWAY) && LIBBIO_ENABLE_HIGHWAY
+		return strip_newlines_hwy(src.data(), src.size(), dst);
+#else
+		return strip_newlines_scalar(src.data(), src.size(), dst);
+#endif
+	}
+}
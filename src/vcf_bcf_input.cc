@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/binary_parsing/range.hh>
+#include <libbio/binary_parsing/read_value.hh>
+#include <libbio/vcf/bcf_input.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace {
+
+	typedef libbio::vcf::bcf_input_base::byte_span	byte_span;
+
+
+	std::uint32_t read_uint32(byte_span const span)
+	{
+		libbio::binary_parsing::range rr(span.data(), span.size());
+		return libbio::binary_parsing::take <std::uint32_t, libbio::binary_parsing::endian::little>(rr);
+	}
+}
+
+
+namespace libbio::vcf {
+
+	auto bcf_input_base::take(std::size_t const size) -> byte_span
+	{
+		m_offset += size;
+		if (size <= m_chunk.size())
+		{
+			auto const retval(m_chunk.first(size));
+			m_chunk = m_chunk.subspan(size);
+			return retval;
+		}
+
+		// The requested range spans multiple chunks.
+		m_spill_buffer.clear();
+		m_spill_buffer.reserve(size);
+		while (true)
+		{
+			auto const count(std::min(size - m_spill_buffer.size(), m_chunk.size()));
+			m_spill_buffer.insert(m_spill_buffer.end(), m_chunk.begin(), m_chunk.begin() + count);
+			m_chunk = m_chunk.subspan(count);
+			if (m_spill_buffer.size() == size)
+				return byte_span{m_spill_buffer.data(), m_spill_buffer.size()};
+
+			if (!next_chunk(m_chunk))
+				throw std::runtime_error("Unexpected end of BCF input");
+		}
+	}
+
+
+	bool bcf_input_base::has_remaining_input()
+	{
+		while (m_chunk.empty())
+		{
+			if (!next_chunk(m_chunk))
+				return false;
+		}
+
+		return true;
+	}
+
+
+	bool bcf_input_base::take_record(byte_span &shared, byte_span &indiv)
+	{
+		// BCF 2.2 § 6.3.1. The record starts with l_shared and l_indiv.
+		if (!has_remaining_input())
+			return false;
+
+		auto const lengths(take(8));
+		auto const l_shared(read_uint32(lengths.first(4)));
+		auto const l_indiv(read_uint32(lengths.last(4)));
+		auto const record(take(std::size_t(l_shared) + l_indiv));
+		shared = record.first(l_shared);
+		indiv = record.subspan(l_shared);
+		return true;
+	}
+
+
+	void bcf_input_base::read_header_text()
+	{
+		// BCF 2.2 § 6.2.
+		{
+			auto const magic(take(5));
+			if (! (
+				std::byte{'B'} == magic[0] &&
+				std::byte{'C'} == magic[1] &&
+				std::byte{'F'} == magic[2] &&
+				std::byte{2} == magic[3] &&
+				(std::byte{1} == magic[4] || std::byte{2} == magic[4])
+			))
+				throw std::runtime_error("Invalid BCF magic string");
+		}
+
+		// The text is NUL-terminated and may be padded.
+		auto const l_text(read_uint32(take(4)));
+		auto const text(take(l_text));
+		std::string_view text_sv(reinterpret_cast <char const *>(text.data()), text.size());
+		auto const pos(text_sv.find_last_not_of('\0'));
+		text_sv = (std::string_view::npos == pos ? std::string_view{} : text_sv.substr(0, 1 + pos));
+
+		m_header_text = text_sv;
+		if (!m_header_text.empty() && '\n' != m_header_text.back())
+			m_header_text += '\n';
+	}
+
+
+	void bcf_input_base::fill_buffer(reader &vcf_reader)
+	{
+		// The header is served without EOF; the reader does not request more input after parsing it.
+		if (m_has_served_header)
+			throw std::runtime_error("Unexpected end of BCF header text");
+
+		read_header_text();
+		m_has_served_header = true;
+
+		auto const *begin(m_header_text.data());
+		vcf_reader.set_buffer_start(begin);
+		vcf_reader.set_buffer_end(begin + m_header_text.size());
+		vcf_reader.set_eof(nullptr);
+	}
+
+
+	void bcf_input_base::prepare_for_parsing(reader &vcf_reader)
+	{
+		if (m_has_lookup_tables)
+			return;
+
+		m_dictionary.build(vcf_reader.metadata());
+
+		auto const &strings(m_dictionary.strings());
+		auto const &info_fields(vcf_reader.info_fields());
+		auto const &filters(vcf_reader.metadata().filter());
+		m_info_fields_by_key.clear();
+		m_filters_by_key.clear();
+		m_info_fields_by_key.resize(strings.size(), nullptr);
+		m_filters_by_key.resize(strings.size(), nullptr);
+		m_pass_key = -1;
+
+		for (std::size_t idx{}; idx < strings.size(); ++idx)
+		{
+			auto const id(strings[idx]);
+			if ("PASS" == id)
+				m_pass_key = idx;
+
+			if (auto const it(info_fields.find(id)); info_fields.end() != it && it->second->get_metadata())
+				m_info_fields_by_key[idx] = it->second.get();
+
+			if (auto const it(filters.find(id)); filters.end() != it)
+				m_filters_by_key[idx] = &it->second;
+		}
+
+		m_has_lookup_tables = true;
+	}
+
+
+	bool bcf_buffer_input::next_chunk(byte_span &chunk)
+	{
+		if (m_has_served_buffer)
+			return false;
+
+		m_has_served_buffer = true;
+		chunk = m_buffer;
+		return true;
+	}
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/bcf/value_buffer.hh>
+#include <libbio/vcf/bcf_variant_printer.hh>
+#include <libbio/vcf/metadata.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace {
+
+	namespace vcf = libbio::vcf;
+
+	typedef std::vector <vcf::metadata_base const *>	metadata_ptr_vector;
+
+
+	template <typename t_map>
+	void add_metadata(t_map const &map, metadata_ptr_vector &dst)
+	{
+		for (auto const &[key, meta] : map)
+			dst.push_back(&meta);
+	}
+
+
+	template <typename t_map>
+	void add_keys(t_map &dst, std::vector <std::string_view> const &ids)
+	{
+		dst.clear();
+		for (std::size_t idx{}; idx < ids.size(); ++idx)
+		{
+			if (!ids[idx].empty())
+				dst.emplace(ids[idx], idx);
+		}
+	}
+}
+
+
+namespace libbio::vcf {
+
+	void bcf_variant_printer::prepare(reader const &vcf_reader)
+	{
+		m_reader = &vcf_reader;
+		m_dictionary.build(vcf_reader.metadata());
+		add_keys(m_string_keys, m_dictionary.strings());
+		add_keys(m_contig_keys, m_dictionary.contigs());
+		m_pass_key = string_key("PASS");
+
+		m_info_fields.clear();
+		for (auto const *field_ptr : vcf_reader.info_fields_in_headers())
+		{
+			auto const *meta(field_ptr->get_metadata());
+			libbio_assert(meta);
+			m_info_fields.emplace_back(field_ptr, string_key(meta->get_id()));
+		}
+
+		m_end_field = nullptr;
+		{
+			auto const &info_fields(vcf_reader.info_fields());
+			if (auto const it(info_fields.find("END")); info_fields.end() != it)
+				m_end_field = dynamic_cast <info_field_end const *>(it->second.get());
+		}
+	}
+
+
+	void bcf_variant_printer::output_header(byte_vector &dst) const
+	{
+		libbio_assert(m_reader);
+
+		// Output the header records in the order that was used for building the dictionaries.
+		// The relative order of FILTER, INFO and FORMAT needs to match bcf::dictionary::build().
+		auto const &metadata(m_reader->metadata());
+		metadata_ptr_vector header_records;
+		add_metadata(metadata.filter(), header_records);
+		add_metadata(metadata.info(), header_records);
+		add_metadata(metadata.format(), header_records);
+		add_metadata(metadata.alt(), header_records);
+		add_metadata(metadata.contig(), header_records);
+		for (auto const &assembly : metadata.assembly())
+			header_records.push_back(&assembly);
+
+		std::stable_sort(header_records.begin(), header_records.end(), [](auto const *lhs, auto const *rhs){
+			return lhs->get_header_index() < rhs->get_header_index();
+		});
+
+		std::stringstream stream;
+		stream << "##fileformat=VCFv4.3\n";
+		for (auto const *meta : header_records)
+			meta->output_vcf(stream);
+
+		stream << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO";
+		if (m_reader->sample_count())
+		{
+			stream << "\tFORMAT";
+			for (auto const &name : m_reader->sample_names_by_index())
+				stream << '\t' << name;
+		}
+		stream << '\n';
+
+		// BCF 2.2 § 6.2.
+		auto const text(stream.str());
+		for (auto const cc : std::string_view{"BCF\2\2"})
+			dst.push_back(std::byte(cc));
+		bcf::append_le(dst, std::uint32_t(1 + text.size()));
+		for (auto const cc : text)
+			dst.push_back(std::byte(cc));
+		dst.push_back(std::byte{});
+	}
+
+
+	std::int32_t bcf_variant_printer::string_key(std::string_view const id) const
+	{
+		auto const it(m_string_keys.find(id));
+		if (m_string_keys.end() == it)
+			throw std::runtime_error("Identifier not found in the BCF string dictionary");
+		return it->second;
+	}
+
+
+	std::int32_t bcf_variant_printer::contig_key(std::string_view const id) const
+	{
+		auto const it(m_contig_keys.find(id));
+		if (m_contig_keys.end() == it)
+			throw std::runtime_error("Contig not declared in the VCF header");
+		return it->second;
+	}
+
+
+	void bcf_variant_printer::reset_values(genotype_field_base const &field)
+	{
+		// GT is encoded as integers, BCF 2.2 § 6.3.3.
+		if (dynamic_cast <genotype_field_gt const *>(&field))
+		{
+			m_values.reset(bcf::value_type::INT32);
+			return;
+		}
+
+		switch (field.metadata_value_type())
+		{
+			case metadata_value_type::INTEGER:
+				m_values.reset(bcf::value_type::INT32);
+				break;
+			case metadata_value_type::FLOAT:
+				m_values.reset(bcf::value_type::FLOAT);
+				break;
+			case metadata_value_type::STRING:
+			case metadata_value_type::CHARACTER:
+				m_values.reset(bcf::value_type::CHAR);
+				break;
+			default:
+				throw std::runtime_error("Unexpected genotype field value type");
+		}
+	}
+}
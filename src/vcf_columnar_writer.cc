@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <bit>
+#include <libbio/assert.hh>
+#include <libbio/vcf/columnar_writer.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <string>
+
+
+namespace {
+
+	namespace arrow = libbio::arrow;
+	namespace bcf = libbio::bcf;
+
+	typedef arrow::primitive_builder <std::int32_t>	integer_builder;
+	typedef arrow::primitive_builder <float>		float_builder;
+
+
+	void append_integer(integer_builder &builder, std::int32_t const val)
+	{
+		if (bcf::INT32_MISSING == val)
+			builder.append_null();
+		else
+			builder.append(val);
+	}
+
+
+	void append_float(float_builder &builder, std::uint32_t const bits)
+	{
+		if (bcf::FLOAT_MISSING_BITS == bits)
+			builder.append_null();
+		else
+			builder.append(std::bit_cast <float>(bits));
+	}
+}
+
+
+namespace libbio::vcf {
+
+	template <typename t_fn>
+	void columnar_writer::visit_columns(t_fn &&fn)
+	{
+		fn("CHROM", m_chrom);
+		fn("POS", m_pos);
+		fn("ID", m_id);
+		fn("REF", m_ref);
+		fn("ALT", m_alt);
+		fn("QUAL", m_qual);
+		fn("FILTER", m_filter);
+
+		for (auto &column : m_info_columns)
+			fn("INFO/" + column.field->get_metadata()->get_id(), *column.builder);
+
+		if (m_gt_alleles)
+		{
+			fn("GT", *m_gt_alleles);
+			fn("GT_phased", *m_gt_phased);
+		}
+	}
+
+
+	void columnar_writer::prepare(reader const &vcf_reader)
+	{
+		// INFO
+		m_info_columns.clear();
+		for (auto const *field_ptr : vcf_reader.info_fields_in_headers())
+		{
+			auto const is_vector(field_ptr->value_type_is_vector());
+			info_column column{field_ptr};
+			switch (field_ptr->metadata_value_type())
+			{
+				case metadata_value_type::FLAG:
+					column.type = info_column_type::FLAG;
+					column.builder = std::make_unique <arrow::boolean_builder>();
+					break;
+
+				case metadata_value_type::INTEGER:
+					if (is_vector)
+					{
+						column.type = info_column_type::INTEGER_LIST;
+						column.builder = std::make_unique <arrow::list_builder <integer_builder>>();
+					}
+					else
+					{
+						column.type = info_column_type::INTEGER;
+						column.builder = std::make_unique <integer_builder>();
+					}
+					break;
+
+				case metadata_value_type::FLOAT:
+					if (is_vector)
+					{
+						column.type = info_column_type::FLOAT_LIST;
+						column.builder = std::make_unique <arrow::list_builder <float_builder>>();
+					}
+					else
+					{
+						column.type = info_column_type::FLOAT;
+						column.builder = std::make_unique <float_builder>();
+					}
+					break;
+
+				case metadata_value_type::CHARACTER:
+				case metadata_value_type::STRING:
+					// Vectors are stored as comma-separated values.
+					column.type = info_column_type::STRING;
+					column.builder = std::make_unique <arrow::utf8_builder>();
+					break;
+
+				default:
+					continue;
+			}
+
+			m_info_columns.emplace_back(std::move(column));
+		}
+
+		// GT
+		m_sample_count = vcf_reader.sample_count();
+		m_gt_alleles.reset();
+		m_gt_phased.reset();
+		m_format = nullptr;
+		m_gt_field = nullptr;
+		if (m_sample_count && vcf_reader.genotype_fields().contains("GT"))
+		{
+			auto const list_size(m_sample_count * m_ploidy);
+			libbio_always_assert_lte(list_size, INT32_MAX);
+			m_gt_alleles = std::make_unique <allele_builder>(list_size);
+			m_gt_phased = std::make_unique <phasing_builder>(list_size);
+		}
+
+		// Schema.
+		arrow::field_vector schema;
+		visit_columns([&schema](std::string name, arrow::array_builder const &builder){
+			auto &fd(schema.emplace_back());
+			fd.name = std::move(name);
+			builder.describe(fd);
+		});
+
+		// CHROM values are indices to the dictionary of chromosome names.
+		schema.front().type = arrow::type_id::UTF8;
+		schema.front().dictionary_id = 0;
+		schema.front().nullable = false;
+		schema[1].nullable = false; // POS
+
+		arrow::ipc_file_writer::key_value_vector metadata;
+		if (m_sample_count)
+		{
+			auto &[key, value](metadata.emplace_back("samples", std::string{}));
+			for (auto const &name : vcf_reader.sample_names_by_index())
+			{
+				if (!value.empty())
+					value += '\t';
+				value += name;
+			}
+		}
+
+		m_writer.write_schema(std::move(schema), std::move(metadata));
+	}
+
+
+	std::int32_t columnar_writer::chromosome_index(std::string_view const chrom_id)
+	{
+		auto it(m_chromosome_indices.find(chrom_id));
+		if (m_chromosome_indices.end() == it)
+		{
+			it = m_chromosome_indices.emplace(chrom_id, m_chromosome_names.length()).first;
+			m_chromosome_names.append(chrom_id);
+		}
+
+		return it->second;
+	}
+
+
+	void columnar_writer::add_info_value(info_column &column, bool const has_value)
+	{
+		if (info_column_type::FLAG == column.type)
+		{
+			static_cast <arrow::boolean_builder &>(*column.builder).append(has_value);
+			return;
+		}
+
+		if (!has_value)
+		{
+			column.builder->append_null();
+			return;
+		}
+
+		switch (column.type)
+		{
+			case info_column_type::INTEGER:
+				libbio_assert_eq(1, m_values.integers().size());
+				append_integer(static_cast <integer_builder &>(*column.builder), m_values.integers().front());
+				break;
+
+			case info_column_type::INTEGER_LIST:
+			{
+				auto &builder(static_cast <arrow::list_builder <integer_builder> &>(*column.builder));
+				for (auto const val : m_values.integers())
+					append_integer(builder.child(), val);
+				builder.finish_item();
+				break;
+			}
+
+			case info_column_type::FLOAT:
+				libbio_assert_eq(1, m_values.float_bits().size());
+				append_float(static_cast <float_builder &>(*column.builder), m_values.float_bits().front());
+				break;
+
+			case info_column_type::FLOAT_LIST:
+			{
+				auto &builder(static_cast <arrow::list_builder <float_builder> &>(*column.builder));
+				for (auto const bits : m_values.float_bits())
+					append_float(builder.child(), bits);
+				builder.finish_item();
+				break;
+			}
+
+			case info_column_type::STRING:
+				static_cast <arrow::utf8_builder &>(*column.builder).append(m_values.characters());
+				break;
+
+			case info_column_type::FLAG:
+				libbio_fail("Unexpected column type");
+		}
+	}
+
+
+	void columnar_writer::update_format(variant_format const &format)
+	{
+		if (&format == m_format)
+			return;
+
+		m_format = &format;
+		m_gt_field = nullptr;
+		auto const &fields(format.fields_by_identifier());
+		if (auto const it(fields.find("GT")); fields.end() != it)
+			m_gt_field = dynamic_cast <genotype_field_gt const *>(it->second.get());
+	}
+
+
+	void columnar_writer::add_genotype(std::vector <sample_genotype> const *gt)
+	{
+		// Missing and null alleles and haplotypes beyond the sample’s ploidy are stored as nulls.
+		libbio_always_assert(!gt || gt->size() <= m_ploidy, "Unexpected ploidy");
+		auto &alleles(m_gt_alleles->child());
+		auto &phased(m_gt_phased->child());
+		for (std::size_t chr_idx{}; chr_idx < m_ploidy; ++chr_idx)
+		{
+			if (!gt || gt->size() <= chr_idx || sample_genotype::NULL_ALLELE == (*gt)[chr_idx].alt)
+			{
+				alleles.append_null();
+				phased.append_null();
+				continue;
+			}
+
+			auto const &sample_gt((*gt)[chr_idx]);
+			alleles.append(sample_gt.alt);
+			phased.append(sample_gt.is_phased);
+		}
+	}
+
+
+	void columnar_writer::write_batch()
+	{
+		auto const length(m_pos.length());
+		if (!length)
+			return;
+
+		m_batch.clear();
+		m_batch.set_length(length);
+		visit_columns([this](std::string const &, arrow::array_builder &builder){
+			libbio_assert_eq(builder.length(), m_batch.length());
+			builder.output(m_batch);
+			builder.clear();
+		});
+		m_writer.write_record_batch(m_batch);
+	}
+
+
+	void columnar_writer::finish()
+	{
+		write_batch();
+
+		// The file format allows the dictionary to follow the record batches.
+		m_batch.clear();
+		m_batch.set_length(m_chromosome_names.length());
+		m_chromosome_names.output(m_batch);
+		m_writer.write_dictionary_batch(0, m_batch);
+		m_writer.finish();
+	}
+}
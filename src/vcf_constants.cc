@@ -4,6 +4,7 @@
  */
 
  #include <cstdint>
+#include <libbio/utility/output_integer.hh>
 #include <libbio/vcf/constants.hh>
 #include <ostream>
 
@@ -73,7 +74,7 @@ namespace libbio::vcf {
 				stream << 'G';
 				break;
 			default:
-				stream << value;
+				output_integer(stream, value);
 				break;
 		}
 	}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <libbio/vcf/contig_table.hh>
+#include <libbio/vcf/metadata.hh>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace libbio::vcf {
+
+	void contig_table::reset(class metadata const &meta)
+	{
+		m_names.clear();
+		m_indices.clear();
+		m_prev_index = INVALID_INDEX;
+
+		// The contig map is ordered by the identifier; use the header order instead.
+		// (The header indices are not consecutive, since the other header lines are counted as well.
+		// get_index() is not used, since it is only 16 bits wide.)
+		std::vector <std::pair <std::uint32_t, std::string const *>> contigs;
+		contigs.reserve(meta.contig().size());
+		for (auto const &[name, contig] : meta.contig())
+			contigs.emplace_back(contig.get_header_index(), &name);
+		std::sort(contigs.begin(), contigs.end());
+
+		m_names.reserve(contigs.size());
+		for (auto const &[header_idx, name] : contigs)
+		{
+			m_indices.emplace(*name, m_names.size());
+			m_names.emplace_back(*name);
+		}
+	}
+
+
+	auto contig_table::find_or_add_shared(std::string_view const name) -> contig_index_type
+	{
+		// Copy the contigs added by the other readers, too, to keep the indices dense.
+		libbio_assert(m_shared_contigs);
+		auto &shared(*m_shared_contigs);
+		std::lock_guard const lock(shared.m_mutex);
+		auto const retval(shared.m_contigs.find_or_add(name));
+		libbio_assert_lte(m_names.size(), shared.m_contigs.m_names.size());
+		for (auto idx(size()); idx < shared.m_contigs.size(); ++idx)
+			add(shared.m_contigs.m_names[idx]);
+		return retval;
+	}
+
+
+	void shared_contig_table::reset(contig_table const &contigs)
+	{
+		std::lock_guard const lock(m_mutex);
+		m_contigs = contigs;
+		m_contigs.m_shared_contigs = nullptr;
+		m_contigs.m_prev_index = contig_table::INVALID_INDEX;
+	}
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <libbio/vcf/frozen_variant.hh>
+#include <libbio/vcf/vcf_reader.hh>
+
+
+namespace libbio::vcf {
+
+	auto frozen_variant_buffer::copy_common(abstract_variant const &var, variant_format_ptr const &format) -> record *
+	{
+		// Keep the format available while the copy is valid. Consecutive variants usually share the format.
+		if (m_formats.empty() || m_formats.back() != format)
+			m_formats.push_back(format);
+
+		auto *rec(new (m_arena.allocate_array <record>(1)) record{});
+
+		auto const &filters(var.filters());
+		auto *filter_ptrs(m_arena.allocate_array <frozen_variant::filter_ptr>(filters.size()));
+		std::copy(filters.begin(), filters.end(), filter_ptrs);
+
+		rec->reader = var.reader();
+		rec->format = format.get();
+		rec->filters = std::span(filter_ptrs, filters.size());
+		rec->assigned_info_fields = copy_flags(var.m_assigned_info_fields);
+		rec->qual = var.qual();
+		rec->pos = var.pos();
+		rec->variant_index = var.variant_index();
+		rec->lineno = var.lineno();
+		rec->contig_index = var.contig_index();
+		return rec;
+	}
+
+
+	std::span <bool const> frozen_variant_buffer::copy_flags(std::vector <bool> const &flags)
+	{
+		auto *dst(m_arena.allocate_array <bool>(flags.size()));
+		std::copy(flags.begin(), flags.end(), dst);
+		return std::span(dst, flags.size());
+	}
+
+
+	std::byte *frozen_variant_buffer::allocate_buffer(aligned_buffer <std::byte, buffer_base::zero_tag> const &src)
+	{
+		// The frozen values are not larger than the original ones, so the field offsets can be reused.
+		if (!src.size())
+			return nullptr;
+
+		auto *retval(static_cast <std::byte *>(m_arena.allocate(src.size(), src.alignment())));
+		std::memset(retval, 0, src.size());
+		return retval;
+	}
+}
@@ -7,9 +7,13 @@
 #include <cstdint>
 #include <iostream>
 #include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/utility/output_integer.hh>
 #include <libbio/vcf/subfield.hh>
 #include <libbio/vcf/variant_printer.hh>
 #include <libbio/vcf/vcf_reader.hh>
+#include <span>
+#include <stdexcept>
 #include <string_view>
 #include <vector>
 
@@ -27,7 +31,7 @@ namespace lb	= libbio;
 namespace libbio::vcf {
 
 	// FIXME: move to some other translation unit.
-	void output_genotype(std::ostream &stream, std::vector <sample_genotype> const &genotype)
+	void output_genotype(std::ostream &stream, std::span <sample_genotype const> const genotype)
 	{
 		// The genotype should not be empty b.c. the missing value “.” cannot
 		// be distinguished from haploid genotype with a null allele.
@@ -42,7 +46,7 @@ namespace libbio::vcf {
 			if (sample_genotype::NULL_ALLELE == gt.alt)
 				stream << '.';
 			else
-				stream << gt.alt;
+				output_integer(stream, std::uint16_t(gt.alt));
 
 			is_first = false;
 		}
@@ -51,6 +55,21 @@ namespace libbio::vcf {
 
 	bool genotype_field_gt::parse_and_assign(std::string_view const &sv, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const
 	{
+		// Handle the common diploid case with single-digit alleles, e.g. 0|1, without the state machine.
+		if (3 == sv.size() && ('|' == sv[1] || '/' == sv[1]))
+		{
+			auto const first(detail::single_character_allele(sv[0]));
+			auto const second(detail::single_character_allele(sv[2]));
+			auto const alt_count(var.alts().size());
+			auto const is_valid([alt_count](std::uint16_t const idx){ return sample_genotype::NULL_ALLELE == idx || idx <= alt_count; });
+			if (is_valid(first) && is_valid(second))
+			{
+				value_access::add_value(mem + this->m_offset, sample_genotype(first, false));
+				value_access::add_value(mem + this->m_offset, sample_genotype(second, '|' == sv[1]));
+				return true;
+			}
+		}
+
 		// Mixed phasing is possible, e.g. in VCF 4.2 specification p. 26: 0/1|2: triploid with a single phased allele.
 		// (The specification says it is tetraploid but this is likely a bug.)
 		std::uint16_t idx{};
@@ -112,6 +131,41 @@ namespace libbio::vcf {
 
 		return true;
 	}
+
+
+	bool genotype_field_gt::assign_bcf_value(bcf::typed_value const &val, transient_variant const &var, transient_variant_sample &sample, std::byte *mem) const
+	{
+		// BCF 2.2 § 6.3.3: the values are (allele + 1) << 1 | phased, zero denotes a null allele.
+		if (0 == val.count || bcf::value_type::MISSING == val.type || val.is_missing_at(0))
+			return false;
+
+		if (!bcf::is_integer(val.type))
+			throw std::runtime_error("Unexpected value type for GT in BCF");
+
+		auto const count(val.value_count());
+		for (std::uint32_t i{}; i < count; ++i)
+		{
+			auto const value(val.is_missing_at(i) ? 0 : val.raw_integer_at(i));
+			bool const is_phased(i && (value & 0x1)); // As in the VCF parser, the first allele is not phased.
+			std::uint16_t idx(value >> 1);
+			if (0 == idx)
+				idx = sample_genotype::NULL_ALLELE;
+			else
+				--idx;
+
+			if (sample_genotype::NULL_ALLELE == idx || idx <= var.alts().size())
+				value_access::add_value(mem + this->m_offset, sample_genotype(idx, is_phased));
+			else
+			{
+				// FIXME: handle the error condition some other way.
+				std::cerr << "Found genotype value (" << idx << ") greater than ALT count (" << var.alts().size() << ") for line " << var.lineno() << "; substituting with zero. Variant:\n";
+				output_vcf(std::cerr, var);
+				value_access::add_value(mem + this->m_offset, sample_genotype(0, is_phased));
+			}
+		}
+
+		return true;
+	}
 }
 
 #pragma GCC diagnostic pop
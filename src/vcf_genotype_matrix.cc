@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <libbio/assert.hh>
+#include <libbio/bits.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/vcf/genotype_matrix.hh>
+#include <utility>
+
+
+namespace {
+
+	template <typename t_src, typename t_dst>
+	void copy_columns(t_src const &src, t_dst &dst, std::size_t const first_column)
+	{
+		// The destination is zero-filled, so only the non-zero values need to be copied.
+		auto const offset(first_column * dst.number_of_rows());
+		auto const &src_values(src.values());
+		auto &dst_values(dst.values());
+		for (std::size_t i{}; i < src_values.size(); ++i)
+		{
+			if (auto const val(src_values[i]); val)
+				dst_values[offset + i] |= val;
+		}
+	}
+}
+
+
+namespace libbio::vcf {
+
+	genotype_matrix_builder::genotype_matrix_builder(std::size_t const sample_count, std::uint16_t const ploidy)
+	{
+		libbio_always_assert_lt(0, sample_count);
+		libbio_always_assert_lt(0, ploidy);
+		auto const haplotype_count(sample_count * ploidy);
+		m_matrix.alleles = bit_matrix(haplotype_count, 0);
+		m_matrix.phased = bit_matrix(haplotype_count, 0);
+		m_matrix.missing = bit_matrix(haplotype_count, 0);
+		m_matrix.ploidy = ploidy;
+		m_column_buffer.resize(haplotype_count, 0);
+	}
+
+
+	void genotype_matrix_builder::add_variant(transient_variant const &var)
+	{
+		auto const &format(var.get_format());
+		if (&format != m_format)
+		{
+			m_format = &format;
+			m_gt_field = nullptr;
+			auto const &fields(format.fields_by_identifier());
+			if (auto const it(fields.find("GT")); fields.end() != it)
+				m_gt_field = dynamic_cast <genotype_field_gt const *>(it->second.get());
+		}
+
+		// Add a column.
+		auto const rows(m_matrix.alleles.number_of_rows());
+		auto const ploidy(m_matrix.ploidy);
+		auto const column(m_variant_count);
+		auto const column_start(column * rows);
+		++m_variant_count;
+		m_matrix.alleles.resize(rows * m_variant_count, 0);
+		m_matrix.phased.resize(rows * m_variant_count, 0);
+		m_matrix.missing.resize(rows * m_variant_count, 0);
+
+		// Collect the allele numbers first so that the storage can be chosen by the largest one.
+		std::fill(m_column_buffer.begin(), m_column_buffer.end(), 0);
+		std::uint16_t max_allele{};
+		auto const &samples(var.samples());
+		libbio_always_assert_eq(rows, samples.size() * ploidy, "Unexpected number of samples");
+		for (std::size_t sample_idx{}; sample_idx < samples.size(); ++sample_idx)
+		{
+			auto const &sample(samples[sample_idx]);
+			auto const first_row(sample_idx * ploidy);
+			if (! (m_gt_field && m_gt_field->has_value(sample)))
+			{
+				for (std::size_t chr_idx{}; chr_idx < ploidy; ++chr_idx)
+					m_matrix.missing.values()[column_start + first_row + chr_idx] |= 1;
+				continue;
+			}
+
+			auto const &gt((*m_gt_field)(sample));
+			libbio_always_assert_lte(gt.size(), ploidy, "Unexpected ploidy");
+			for (std::size_t chr_idx{}; chr_idx < ploidy; ++chr_idx)
+			{
+				auto const idx(column_start + first_row + chr_idx);
+				if (gt.size() <= chr_idx || sample_genotype::NULL_ALLELE == gt[chr_idx].alt)
+				{
+					m_matrix.missing.values()[idx] |= 1;
+					continue;
+				}
+
+				auto const &sample_gt(gt[chr_idx]);
+				if (sample_gt.is_phased)
+					m_matrix.phased.values()[idx] |= 1;
+
+				m_column_buffer[first_row + chr_idx] = sample_gt.alt;
+				max_allele = std::max(max_allele, sample_gt.alt);
+			}
+		}
+
+		if (max_allele <= 1)
+		{
+			for (std::size_t row{}; row < rows; ++row)
+			{
+				if (m_column_buffer[row])
+					m_matrix.alleles.values()[column_start + row] |= 1;
+			}
+		}
+		else
+		{
+			auto &dst(m_matrix.multiallelic_columns.emplace_back());
+			dst.variant_idx = column;
+			dst.alleles = int_vector <0>(rows, bits::highest_bit_set(max_allele));
+			for (std::size_t row{}; row < rows; ++row)
+			{
+				if (m_column_buffer[row])
+					dst.alleles[row] |= m_column_buffer[row];
+			}
+		}
+	}
+
+
+	genotype_matrix genotype_matrix_builder::finish()
+	{
+		m_format = nullptr;
+		m_gt_field = nullptr;
+		m_variant_count = 0;
+		return std::move(m_matrix);
+	}
+
+
+	genotype_matrix genotype_matrix_builder::concatenate(std::vector <genotype_matrix> const &matrices)
+	{
+		genotype_matrix retval;
+		if (matrices.empty())
+			return retval;
+
+		auto const rows(matrices.front().haplotype_count());
+		std::size_t columns{};
+		std::size_t multiallelic_count{};
+		for (auto const &matrix : matrices)
+		{
+			libbio_always_assert_eq(rows, matrix.haplotype_count());
+			columns += matrix.variant_count();
+			multiallelic_count += matrix.multiallelic_columns.size();
+		}
+
+		retval.alleles = bit_matrix(rows, columns);
+		retval.phased = bit_matrix(rows, columns);
+		retval.missing = bit_matrix(rows, columns);
+		retval.multiallelic_columns.reserve(multiallelic_count);
+		retval.ploidy = matrices.front().ploidy;
+
+		std::size_t first_column{};
+		for (auto const &matrix : matrices)
+		{
+			copy_columns(matrix.alleles, retval.alleles, first_column);
+			copy_columns(matrix.phased, retval.phased, first_column);
+			copy_columns(matrix.missing, retval.missing, first_column);
+			for (auto const &column : matrix.multiallelic_columns)
+				retval.multiallelic_columns.emplace_back(first_column + column.variant_idx, column.alleles);
+			first_column += matrix.variant_count();
+		}
+
+		return retval;
+	}
+
+
+	genotype_matrix build_genotype_matrix(parallel_reader &reader, std::uint16_t const ploidy, dispatch::parallel_queue &queue)
+	{
+		// The callback is called serially for the records of each chunk, so the builders need no locking.
+		auto const sample_count(reader.header_reader().sample_count());
+		std::vector <genotype_matrix_builder> builders;
+		reader.parse_unordered(
+			[&](std::size_t const chunk_count){
+				builders.resize(chunk_count, genotype_matrix_builder(sample_count, ploidy));
+			},
+			[&builders](std::size_t const chunk_idx, transient_variant const &var){
+				builders[chunk_idx].add_variant(var);
+				return true;
+			},
+			queue
+		);
+
+		std::vector <genotype_matrix> matrices;
+		matrices.reserve(builders.size());
+		for (auto &builder : builders)
+			matrices.emplace_back(builder.finish());
+
+		return genotype_matrix_builder::concatenate(matrices);
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <libbio/assert.hh>
+#include <libbio/vcf/indexed_region_parser.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_reader.hh>
+
+
+namespace {
+
+	namespace vcf = libbio::vcf;
+
+
+	// Restore the reader’s validator also in case of an exception.
+	class validator_guard
+	{
+	protected:
+		vcf::reader				*m_reader{};
+		vcf::variant_validator	*m_validator{};
+
+	public:
+		validator_guard(vcf::reader &reader, vcf::variant_validator &validator):
+			m_reader(&reader),
+			m_validator(&reader.variant_validator())
+		{
+			reader.set_variant_validator(validator);
+		}
+
+		~validator_guard() { m_reader->set_variant_validator(*m_validator); }
+	};
+}
+
+
+namespace libbio::vcf {
+
+	void indexed_region_parser::parse(reader::callback_cq_fn const &callback)
+	{
+		libbio_always_assert_lte(field::POS, m_reader->parsed_fields());
+		validator_guard const guard(*m_reader, *this);
+
+		bool should_stop(false);
+		auto const cb([&callback, &should_stop](transient_variant const &var){
+			if (callback(var))
+				return true;
+
+			should_stop = true;
+			return false;
+		});
+
+		for (auto const &chr : m_offset_index->chromosomes())
+		{
+			m_chr_intervals = m_intervals->find(chr.id);
+			if (!m_chr_intervals)
+				continue;
+
+			auto const pos(m_chr_intervals->next_contained_position(0));
+			if (chromosome_interval_index::NOT_FOUND == pos)
+				continue;
+
+			// validate() sets m_next_entry if the reader should be moved to the next region.
+			m_chr_id = chr.id;
+			m_contig_index = m_reader->contigs().find_or_add(chr.id);
+			m_next_entry = m_offset_index->find(chr.id, 1 + pos);
+			while (m_next_entry)
+			{
+				auto const &entry(*m_next_entry);
+				m_next_entry = nullptr;
+				m_reader->seek_to_variant(entry.offset, entry.lineno, entry.variant_index);
+				++m_seek_count;
+
+				m_reader->parse(cb);
+				if (should_stop)
+					return;
+			}
+		}
+	}
+
+
+	variant_validation_result indexed_region_parser::validate(transient_variant const &var)
+	{
+		// Stop at the next chromosome.
+		if (var.contig_index() != m_contig_index)
+			return variant_validation_result::STOP;
+
+		auto const pos(var.zero_based_pos());
+		if (m_chr_intervals->contains(pos))
+			return variant_validation_result::PASS;
+
+		auto const next_pos(m_chr_intervals->next_contained_position(pos));
+		if (chromosome_interval_index::NOT_FOUND == next_pos)
+			return variant_validation_result::STOP;
+
+		// Move the reader if there is an indexed record between the current one and the next region.
+		auto const *entry(m_offset_index->find(m_chr_id, 1 + next_pos));
+		if (entry && var.variant_index() < entry->variant_index)
+		{
+			m_next_entry = entry;
+			return variant_validation_result::STOP;
+		}
+
+		return variant_validation_result::SKIP;
+	}
+}
@@ -106,11 +106,32 @@ namespace libbio::vcf {
 
 	void mmap_input::fill_buffer(reader &vcf_reader)
 	{
-		auto const begin(m_handle.data());
-		auto const end(begin + m_handle.size());
+		auto const begin(m_handle.data() + m_offset);
+		auto const end(m_handle.data() + m_handle.size());
 
 		vcf_reader.set_buffer_start(begin);
 		vcf_reader.set_buffer_end(end);
 		vcf_reader.set_eof(end);
 	}
+
+
+	void chunk_input::fill_buffer(reader &vcf_reader)
+	{
+		// The header is served first without EOF s.t. the reader requests more input after parsing it.
+		if (!m_has_served_header)
+		{
+			m_has_served_header = true;
+			m_buffer_start = m_header.data();
+			vcf_reader.set_buffer_start(m_header.data());
+			vcf_reader.set_buffer_end(m_header.data() + m_header.size());
+			vcf_reader.set_eof(nullptr);
+			return;
+		}
+
+		auto const end(m_records.data() + m_records.size());
+		m_buffer_start = m_records.data();
+		vcf_reader.set_buffer_start(m_records.data());
+		vcf_reader.set_buffer_end(end);
+		vcf_reader.set_eof(end);
+	}
 }
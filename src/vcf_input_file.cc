@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <cstddef>
+#include <libbio/file_handling.hh>
+#include <libbio/vcf/bcf_input.hh>
+#include <libbio/vcf/input_file.hh>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+#	include <libbio/bgzf/block.hh>
+#	include <libbio/bgzf/deflate_decompressor.hh>
+#	include <libbio/bgzf/parser.hh>
+#	include <libbio/binary_parsing/range.hh>
+#	include <libbio/vcf/bgzf_bcf_input.hh>
+#	include <span>
+#	include <vector>
+#endif
+
+
+namespace {
+
+	// BCF 2.2 § 6.2; the minor version is not checked here.
+	constexpr std::string_view const bcf_magic{"BCF\x02", 4};
+	constexpr std::string_view const gzip_magic{"\x1f\x8b"};
+
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+	bool is_compressed_bcf(std::string_view const content)
+	{
+		// Check the BC extra subfield, which bgzip writes first, and decompress only the first block.
+		if (content.size() < 16 || !content.starts_with("\x1f\x8b\x08\x04") || 'B' != content[12] || 'C' != content[13])
+			return false;
+
+		libbio::binary_parsing::range range_(reinterpret_cast <std::byte const *>(content.data()), content.size());
+		libbio::bgzf::block bb;
+		libbio::bgzf::parser pp(range_, bb);
+		pp.parse();
+		if (bb.isize < bcf_magic.size())
+			return false;
+
+		std::vector <std::byte> buffer(bb.isize);
+		libbio::bgzf::detail::deflate_decompressor decompressor;
+		decompressor.prepare();
+		auto const res(decompressor.decompress({bb.compressed_data, bb.compressed_data_size}, buffer));
+		return std::string_view{reinterpret_cast <char const *>(res.data()), res.size()}.starts_with(bcf_magic);
+	}
+#endif
+}
+
+
+namespace libbio::vcf {
+
+	void input_file::open(std::string const &path)
+	{
+		m_bcf_input.reset();
+		m_format = format_type::vcf;
+
+		auto &handle(m_mmap_input.handle());
+		handle.open(path);
+		std::string_view const content{handle.data(), handle.size()};
+
+		if (content.starts_with(bcf_magic))
+		{
+			m_format = format_type::bcf;
+			m_bcf_input = std::make_unique <bcf_buffer_input>(bcf_buffer_input::byte_span{
+				reinterpret_cast <std::byte const *>(content.data()),
+				content.size()
+			});
+			return;
+		}
+
+		if (!content.starts_with(gzip_magic))
+			return;
+
+#if defined(LIBBIO_ENABLE_BGZF_DECOMPRESSOR) && LIBBIO_ENABLE_BGZF_DECOMPRESSOR
+		if (!is_compressed_bcf(content))
+			throw std::runtime_error("Compressed input is supported only for BGZF-compressed BCF");
+
+		handle.close();
+		m_format = format_type::bgzf_bcf;
+		m_bcf_input = std::make_unique <bgzf_bcf_input>(file_handle(open_file_for_reading(path)));
+#else
+		throw std::runtime_error("libbio was built without BGZF support");
+#endif
+	}
+}
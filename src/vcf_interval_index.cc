@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <libbio/assert.hh>
+#include <libbio/vcf/interval_index.hh>
+#include <string>
+
+
+namespace libbio::vcf {
+
+	void chromosome_interval_index::finish()
+	{
+		std::sort(ranges.begin(), ranges.end(), position_range_cmp());
+
+		max_ends.resize(ranges.size());
+		std::size_t max_end{};
+		for (std::size_t idx{}; idx < ranges.size(); ++idx)
+		{
+			max_end = std::max(max_end, ranges[idx].end);
+			max_ends[idx] = max_end;
+		}
+	}
+
+
+	bool chromosome_interval_index::contains(std::size_t const pos) const
+	{
+		// The intervals in [0, limit) start at or before pos; one of them contains pos iff. the maximum end is greater.
+		libbio_assert_eq(ranges.size(), max_ends.size());
+		auto const it(std::partition_point(ranges.begin(), ranges.end(), [pos](auto const &rr){ return rr.begin <= pos; }));
+		auto const limit(std::distance(ranges.begin(), it));
+		return 0 < limit && pos < max_ends[limit - 1];
+	}
+
+
+	std::size_t chromosome_interval_index::next_contained_position(std::size_t const pos) const
+	{
+		if (contains(pos))
+			return pos;
+
+		// Find the first non-empty interval that starts after pos.
+		auto it(std::partition_point(ranges.begin(), ranges.end(), [pos](auto const &rr){ return rr.begin <= pos; }));
+		it = std::find_if(it, ranges.end(), [](auto const &rr){ return rr.begin < rr.end; });
+		return (ranges.end() == it ? NOT_FOUND : it->begin);
+	}
+
+
+	void interval_index::add_interval(std::string_view const chr_id, std::size_t const begin, std::size_t const end)
+	{
+		auto it(m_chromosomes.find(chr_id));
+		if (m_chromosomes.end() == it)
+			it = m_chromosomes.try_emplace(std::string(chr_id)).first;
+
+		it->second.ranges.emplace_back(begin, end);
+	}
+
+
+	void interval_index::finish()
+	{
+		for (auto &[chr_id, chr] : m_chromosomes)
+			chr.finish();
+	}
+}
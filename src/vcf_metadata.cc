@@ -32,6 +32,13 @@ namespace libbio::vcf {
 	}
 
 
+	void metadata_base::output_idx(std::ostream &stream) const
+	{
+		if (has_idx())
+			stream << ",IDX=" << get_idx();
+	}
+
+
 	// FIXME: refine the output formats.
 
 	void metadata_info::output_vcf(std::ostream &stream) const
@@ -44,7 +51,9 @@ namespace libbio::vcf {
 			<< ",Description=\"" << get_description()
 			<< "\",Source=\"" << get_source()
 			<< "\",Version=\"" << get_version()
-			<< "\">\n";
+			<< '"';
+		output_idx(stream);
+		stream << ">\n";
 	}
 
 
@@ -54,13 +63,17 @@ namespace libbio::vcf {
 		output_vcf_value(stream, get_number());
 		stream << ",Type=";
 		output_vcf_value(stream, get_value_type());
-		stream << ",Description=\"" << get_description() << "\">\n";
+		stream << ",Description=\"" << get_description() << '"';
+		output_idx(stream);
+		stream << ">\n";
 	}
 
 
 	void metadata_filter::output_vcf(std::ostream &stream) const
 	{
-		stream << "##FILTER=<ID=" << get_id() << ",Description=\"" << get_description() << "\">\n";
+		stream << "##FILTER=<ID=" << get_id() << ",Description=\"" << get_description() << '"';
+		output_idx(stream);
+		stream << ">\n";
 	}
 
 
@@ -78,6 +91,8 @@ namespace libbio::vcf {
 
 	void metadata_contig::output_vcf(std::ostream &stream) const
 	{
-		stream << "##contig=<ID=" << get_id() << ",length=" << get_length() << ">\n";
+		stream << "##contig=<ID=" << get_id() << ",length=" << get_length();
+		output_idx(stream);
+		stream << ">\n";
 	}
 }
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <libbio/assert.hh>
+#include <libbio/vcf/offset_index.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <stdexcept>
+#include <string>
+
+
+namespace {
+
+	constexpr static std::string_view const HEADER_PREFIX{"#offset_index\t"};
+
+
+	std::size_t parse_number(std::string_view const sv)
+	{
+		std::size_t retval{};
+		auto const res(std::from_chars(sv.data(), sv.data() + sv.size(), retval));
+		if (std::errc{} != res.ec || sv.data() + sv.size() != res.ptr)
+			throw std::runtime_error("Unable to parse the offset index");
+		return retval;
+	}
+}
+
+
+namespace libbio::vcf {
+
+	void offset_index::add_variant(reader const &vcf_reader, transient_variant const &var)
+	{
+		// Add the first record of each chromosome and every m_interval-th record after it.
+		bool const is_new_chromosome(m_chromosomes.empty() || m_chromosomes.back().id != var.chrom_id());
+		if (is_new_chromosome)
+		{
+			auto &chr(m_chromosomes.emplace_back());
+			chr.id = var.chrom_id();
+			chr.first_entry = m_entries.size();
+			chr.entry_limit = m_entries.size();
+		}
+		else if (++m_records_since_last_entry < m_interval)
+		{
+			return;
+		}
+
+		m_records_since_last_entry = 0;
+		m_entries.emplace_back(m_chromosomes.size() - 1, var.pos(), vcf_reader.variant_offset(), var.lineno(), var.variant_index());
+		++m_chromosomes.back().entry_limit;
+	}
+
+
+	auto offset_index::find(std::string_view const chrom_id, std::size_t const pos) const -> entry const *
+	{
+		auto const chr_it(std::find_if(m_chromosomes.begin(), m_chromosomes.end(), [chrom_id](auto const &chr){ return chr.id == chrom_id; }));
+		if (m_chromosomes.end() == chr_it)
+			return nullptr;
+
+		// The first entry of the chromosome is its first record, so it may be used if all of the entries have pos ≥ pos.
+		auto const begin(m_entries.begin() + chr_it->first_entry);
+		auto const end(m_entries.begin() + chr_it->entry_limit);
+		libbio_assert_neq(begin, end);
+		auto const it(std::partition_point(begin, end, [pos](auto const &ee){ return ee.pos < pos; }));
+		return &*(begin == it ? it : it - 1);
+	}
+
+
+	bool offset_index::seek(reader &vcf_reader, std::string_view const chrom_id, std::size_t const pos) const
+	{
+		auto const *ee(find(chrom_id, pos));
+		if (!ee)
+			return false;
+
+		vcf_reader.seek_to_variant(ee->offset, ee->lineno, ee->variant_index);
+		return true;
+	}
+
+
+	void offset_index::output(std::ostream &os) const
+	{
+		os << HEADER_PREFIX << m_interval << '\n';
+		for (auto const &ee : m_entries)
+			os << m_chromosomes[ee.chrom_idx].id << '\t' << ee.pos << '\t' << ee.offset << '\t' << ee.lineno << '\t' << ee.variant_index << '\n';
+	}
+
+
+	void offset_index::read(std::istream &is)
+	{
+		m_entries.clear();
+		m_chromosomes.clear();
+		m_records_since_last_entry = 0;
+
+		std::string line;
+		if (!std::getline(is, line) || !line.starts_with(HEADER_PREFIX))
+			throw std::runtime_error("Unexpected offset index header");
+		m_interval = parse_number(std::string_view(line).substr(HEADER_PREFIX.size()));
+
+		while (std::getline(is, line))
+		{
+			std::string_view fields[5];
+			std::string_view rest(line);
+			for (std::size_t idx{}; idx < 5; ++idx)
+			{
+				auto const tab_pos(rest.find('\t'));
+				if ((std::string_view::npos == tab_pos) != (4 == idx))
+					throw std::runtime_error("Unexpected number of fields in the offset index");
+				fields[idx] = rest.substr(0, tab_pos);
+				if (std::string_view::npos != tab_pos)
+					rest.remove_prefix(1 + tab_pos);
+			}
+
+			if (m_chromosomes.empty() || m_chromosomes.back().id != fields[0])
+			{
+				auto &chr(m_chromosomes.emplace_back());
+				chr.id = fields[0];
+				chr.first_entry = m_entries.size();
+				chr.entry_limit = m_entries.size();
+			}
+
+			m_entries.emplace_back(m_chromosomes.size() - 1, parse_number(fields[1]), parse_number(fields[2]), parse_number(fields[3]), parse_number(fields[4]));
+			++m_chromosomes.back().entry_limit;
+		}
+	}
+}
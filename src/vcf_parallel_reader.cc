@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <libbio/assert.hh>
+#include <libbio/dispatch.hh>
+#include <libbio/vcf/parallel_reader.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_input.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+	typedef std::counting_semaphore <UINT16_MAX>	semaphore_type;
+
+
+	struct chunk
+	{
+		libbio::vcf::chunk_input			input;
+		libbio::vcf::reader					reader;
+		std::vector <libbio::vcf::variant>	variants;	// Destroyed before the reader.
+		std::size_t							index{};
+
+		chunk(std::string_view const header, std::string_view const records, std::size_t const index_):
+			input(header, records),
+			reader(input),
+			index(index_)
+		{
+		}
+
+		std::size_t record_count() const { return reader.lineno() - reader.last_header_lineno(); }
+	};
+
+	typedef std::unique_ptr <chunk>	chunk_ptr;
+
+
+	struct chunk_ptr_cmp
+	{
+		bool operator()(chunk_ptr const &lhs, chunk_ptr const &rhs) const { return lhs->index > rhs->index; }
+	};
+
+
+	struct parsing_status
+	{
+		std::exception_ptr	exception;
+		std::mutex			mutex;
+		std::atomic_bool	should_stop{};
+
+		bool is_stopped() const { return should_stop.load(std::memory_order_acquire); }
+		void stop() { should_stop.store(true, std::memory_order_release); }
+
+		void stop_with_current_exception()
+		{
+			{
+				std::lock_guard const lock(mutex);
+				if (!exception)
+					exception = std::current_exception();
+			}
+
+			stop();
+		}
+
+		void rethrow_if_needed()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+	};
+
+
+	std::ptrdiff_t pending_chunk_limit(std::size_t const count)
+	{
+		return std::min <std::ptrdiff_t>(count, semaphore_type::max());
+	}
+}
+
+
+namespace libbio::vcf {
+
+	void parallel_reader::read_header()
+	{
+		if (m_setup_fn)
+			m_setup_fn(m_reader);
+
+		m_reader.read_header();
+		m_contigs.reset(m_reader.contigs());
+
+		// The mmap_input passes the whole file at once, so the reader now points to the first record.
+		auto const *data(m_input->handle().data());
+		m_header = std::string_view(data, m_reader.buffer_start() - data);
+	}
+
+
+	auto parallel_reader::make_chunks() const -> chunk_vector
+	{
+		auto const &handle(m_input->handle());
+		libbio_assert_lte(m_header.size(), handle.size());
+		std::string_view const records(handle.data() + m_header.size(), handle.size() - m_header.size());
+
+		chunk_vector retval;
+		retval.reserve(1 + records.size() / m_chunk_size);
+		std::size_t pos{};
+		while (pos < records.size())
+		{
+			// Extend the chunk to the end of the line.
+			std::size_t end(pos + m_chunk_size);
+			if (records.size() <= end)
+				end = records.size();
+			else
+			{
+				auto const nl_pos(records.find('\n', end - 1));
+				end = (std::string_view::npos == nl_pos ? records.size() : 1 + nl_pos);
+			}
+
+			retval.emplace_back(records.substr(pos, end - pos));
+			pos = end;
+		}
+
+		return retval;
+	}
+
+
+	void parallel_reader::prepare_chunk_reader(reader &chunk_reader)
+	{
+		if (m_setup_fn)
+			m_setup_fn(chunk_reader);
+
+		chunk_reader.read_header();
+		libbio_assert_eq(chunk_reader.contigs().size(), m_reader.contigs().size());
+		chunk_reader.contigs().set_shared_contigs(m_contigs);
+		chunk_reader.set_parsed_fields(m_parsed_fields);
+		chunk_reader.set_parsed_samples(m_parsed_samples);
+	}
+
+
+	void parallel_reader::parse_unordered(chunk_count_fn const &chunk_count_callback, unordered_callback_fn const &callback, dispatch::parallel_queue &queue)
+	{
+		auto const chunks(make_chunks());
+		if (chunk_count_callback)
+			chunk_count_callback(chunks.size());
+
+		semaphore_type semaphore(pending_chunk_limit(m_max_pending_chunks));
+		dispatch::group group;
+		parsing_status status;
+
+		for (std::size_t idx{}; idx < chunks.size(); ++idx)
+		{
+			semaphore.acquire();
+			if (status.is_stopped())
+			{
+				semaphore.release();
+				break;
+			}
+
+			queue.group_async(group, [this, &callback, &semaphore, &status, records = chunks[idx], idx]{
+				try
+				{
+					chunk cc(m_header, records, idx);
+					prepare_chunk_reader(cc.reader);
+					cc.reader.parse([&callback, &status, idx](transient_variant const &var){
+						if (status.is_stopped())
+							return false;
+
+						if (!callback(idx, var))
+						{
+							status.stop();
+							return false;
+						}
+
+						return true;
+					});
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+
+				semaphore.release();
+			});
+		}
+
+		group.wait();
+		status.rethrow_if_needed();
+	}
+
+
+	void parallel_reader::parse_ordered(ordered_callback_fn const &callback, dispatch::parallel_queue &queue)
+	{
+		auto const chunks(make_chunks());
+		semaphore_type semaphore(pending_chunk_limit(m_max_pending_chunks));
+		dispatch::group group;
+		dispatch::serial_queue delivery_queue(queue);
+		parsing_status status;
+
+		// Accessed only from delivery_queue.
+		std::vector <chunk_ptr> pending_chunks;	// Min-heap by chunk index.
+		std::size_t next_chunk_index{};
+		std::size_t record_offset{};
+
+		auto const deliver([&](chunk &cc){
+			if (!status.is_stopped())
+			{
+				try
+				{
+					for (auto &var : cc.variants)
+					{
+						// Make the line numbers and the variant indices relative to the beginning of the file.
+						var.set_lineno(var.lineno() + record_offset);
+						var.set_variant_index(var.variant_index() + record_offset);
+						if (!callback(var))
+						{
+							status.stop();
+							break;
+						}
+					}
+
+					record_offset += cc.record_count();
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+			}
+
+			++next_chunk_index;
+			semaphore.release();
+		});
+
+		for (std::size_t idx{}; idx < chunks.size(); ++idx)
+		{
+			semaphore.acquire();
+			if (status.is_stopped())
+			{
+				semaphore.release();
+				break;
+			}
+
+			queue.group_async(group, [&, records = chunks[idx], idx]{
+				// Always pass the chunk to the delivery queue, even if parsing failed, s.t. the following chunks get released.
+				auto cc(std::make_unique <chunk>(m_header, records, idx));
+				try
+				{
+					prepare_chunk_reader(cc->reader);
+					cc->reader.parse([&status, &cc = *cc](transient_variant const &var){
+						if (status.is_stopped())
+							return false;
+
+						cc.variants.emplace_back(var);
+						return true;
+					});
+				}
+				catch (...)
+				{
+					status.stop_with_current_exception();
+				}
+
+				delivery_queue.group_async(group, [&, cc = std::move(cc)] mutable {
+					if (next_chunk_index != cc->index)
+					{
+						pending_chunks.emplace_back(std::move(cc));
+						std::push_heap(pending_chunks.begin(), pending_chunks.end(), chunk_ptr_cmp{});
+						return;
+					}
+
+					deliver(*cc);
+					cc.reset();
+
+					while (!pending_chunks.empty() && next_chunk_index == pending_chunks.front()->index)
+					{
+						std::pop_heap(pending_chunks.begin(), pending_chunks.end(), chunk_ptr_cmp{});
+						auto cc_(std::move(pending_chunks.back()));
+						pending_chunks.pop_back();
+						deliver(*cc_);
+					}
+				});
+			});
+		}
+
+		group.wait();
+		status.rethrow_if_needed();
+	}
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <exception>
+#include <libbio/assert.hh>
+#include <libbio/vcf/parallel_variant_printer.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <mutex>
+
+
+namespace {
+
+	struct task_cmp
+	{
+		template <typename t_task>
+		bool operator()(t_task const *lhs, t_task const *rhs) const { return lhs->batch_index > rhs->batch_index; }
+	};
+}
+
+
+namespace libbio::vcf::detail {
+
+	void parallel_variant_printer_task::run()
+	{
+		libbio_assert(printer);
+		buffer.clear();
+
+		std::exception_ptr exc;
+		try
+		{
+			auto const &variant_printer(*printer->m_printer);
+			for (std::size_t idx{}; idx < size; ++idx)
+				variant_printer.output_variant(stream, variants[idx]);
+		}
+		catch (...)
+		{
+			exc = std::current_exception();
+		}
+
+		printer->task_did_finish(*this, exc);
+	}
+}
+
+
+namespace libbio::vcf {
+
+	parallel_variant_printer::parallel_variant_printer(
+		output_fn output,
+		printer_type const &printer,
+		std::size_t const task_count,
+		std::size_t const batch_size,
+		dispatch::queue &queue
+	):
+		m_task_queue(task_count, task_queue_type::start_from_reading{true}),
+		m_output(std::move(output)),
+		m_printer(&printer),
+		m_queue(&queue),
+		m_batch_size(batch_size)
+	{
+		libbio_assert_lt(0, task_count);
+		libbio_always_assert_lt(0, batch_size);
+		for (auto &task : m_task_queue.values())
+		{
+			task.printer = this;
+			task.variants.reserve(batch_size);
+		}
+
+		m_finished_tasks.reserve(m_task_queue.size());
+	}
+
+
+	parallel_variant_printer::~parallel_variant_printer()
+	{
+		// Make sure that the worker threads do not access the tasks after destruction.
+		m_group.wait();
+	}
+
+
+	void parallel_variant_printer::rethrow_exception_if_needed()
+	{
+		std::lock_guard const lock(m_mutex);
+		if (m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+
+	void parallel_variant_printer::task_did_finish(task_type &task, std::exception_ptr exc)
+	{
+		// Called from worker threads.
+		std::lock_guard const lock(m_mutex);
+		if (exc && !m_exception)
+			m_exception = exc;
+
+		m_finished_tasks.push_back(&task);
+		std::push_heap(m_finished_tasks.begin(), m_finished_tasks.end(), task_cmp{});
+
+		while (!m_finished_tasks.empty() && m_finished_tasks.front()->batch_index == m_next_written_batch_index)
+		{
+			std::pop_heap(m_finished_tasks.begin(), m_finished_tasks.end(), task_cmp{});
+			auto *next_task(m_finished_tasks.back());
+			m_finished_tasks.pop_back();
+
+			if (!m_exception)
+			{
+				try
+				{
+					m_output(next_task->buffer.view());
+				}
+				catch (...)
+				{
+					m_exception = std::current_exception();
+				}
+			}
+
+			++m_next_written_batch_index;
+			m_task_queue.push(*next_task);
+			// Task no longer valid.
+		}
+	}
+
+
+	void parallel_variant_printer::add_variant(transient_variant const &var)
+	{
+		auto &task(current_task());
+		if (task.size == task.variants.size())
+		{
+			auto *reader(var.reader());
+			libbio_assert(reader);
+			task.variants.emplace_back(reader->make_empty_variant());
+		}
+
+		task.variants[task.size] = var;
+		++task.size;
+
+		if (m_batch_size == task.size)
+			flush_batch();
+	}
+
+
+	void parallel_variant_printer::add_variant(variant const &var)
+	{
+		auto &task(current_task());
+		if (task.size == task.variants.size())
+			task.variants.emplace_back(var);
+		else
+			task.variants[task.size] = var;
+		++task.size;
+
+		if (m_batch_size == task.size)
+			flush_batch();
+	}
+
+
+	void parallel_variant_printer::flush_batch()
+	{
+		if (!m_current_task)
+			return;
+
+		m_current_task->batch_index = m_next_batch_index++;
+		m_queue->group_async(m_group, m_current_task);
+		m_current_task = nullptr;
+	}
+
+
+	void parallel_variant_printer::finish()
+	{
+		flush_batch();
+		m_group.wait();
+		rethrow_exception_if_needed();
+		libbio_assert_eq(m_next_batch_index, m_next_written_batch_index);
+	}
+}
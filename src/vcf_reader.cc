@@ -3,13 +3,19 @@
  * This code is licensed under MIT license (see LICENSE for details).
  */
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <libbio/assert.hh>
 #include <libbio/utility.hh>
+#include <libbio/vcf/bcf_input.hh>
 #include <libbio/vcf/constants.hh>
 #include <libbio/vcf/metadata.hh>
+#include <libbio/vcf/parse_error.hh>
 #include <libbio/vcf/subfield.hh>
 #include <libbio/vcf/variant.hh>
 #include <libbio/vcf/vcf_reader.hh>
@@ -24,6 +30,63 @@
 #include <vector>
 
 
+namespace {
+
+	// Helpers for checking the bytes of a 64-bit word in parallel. The masks are made from byte arrays,
+	// so the checks do not depend on the byte order.
+	typedef std::uint64_t swar_word;
+
+	constexpr static inline swar_word const SWAR_LOW_BITS{0x7F7F'7F7F'7F7F'7F7FULL};
+	constexpr static inline swar_word const SWAR_HIGH_BITS{0x8080'8080'8080'8080ULL};
+
+	// Byte positions in two consecutive sample columns of the form [0-9.][|/][0-9.]\t.
+	constexpr static inline swar_word const DIPLOID_GT_ALLELE_MASK{std::bit_cast <swar_word>(std::array <std::uint8_t, 8>{0x80, 0, 0x80, 0, 0x80, 0, 0x80, 0})};
+	constexpr static inline swar_word const DIPLOID_GT_SEPARATOR_MASK{std::bit_cast <swar_word>(std::array <std::uint8_t, 8>{0, 0x80, 0, 0, 0, 0x80, 0, 0})};
+	constexpr static inline swar_word const DIPLOID_GT_TAB_MASK{std::bit_cast <swar_word>(std::array <std::uint8_t, 8>{0, 0, 0, 0x80, 0, 0, 0, 0x80})};
+
+
+	constexpr swar_word swar_repeat(std::uint8_t const cc) { return 0x0101'0101'0101'0101ULL * cc; }
+
+
+	// Set the high bit of each byte that is equal to cc.
+	constexpr swar_word swar_equal(swar_word const word, std::uint8_t const cc)
+	{
+		auto const xx(word ^ swar_repeat(cc));
+		return ~(((xx & SWAR_LOW_BITS) + SWAR_LOW_BITS) | xx | SWAR_LOW_BITS);
+	}
+
+
+	// Set the high bit of each byte that is greater than or equal to cc, 0 < cc ≤ 0x80.
+	// The high bits of the bytes of the word need to be clear.
+	constexpr swar_word swar_greater_equal(swar_word const word, std::uint8_t const cc)
+	{
+		return (word + swar_repeat(0x80 - cc)) & SWAR_HIGH_BITS;
+	}
+
+
+	// Check that the word consists of two GT-only sample columns with allele numbers not greater than max_digit.
+	constexpr bool is_diploid_gt_column_pair(swar_word const word, std::uint8_t const max_digit)
+	{
+		if (word & SWAR_HIGH_BITS)
+			return false;
+
+		auto const digits(swar_greater_equal(word, '0') & ~swar_greater_equal(word, '0' + max_digit + 1));
+		auto const alleles(digits | swar_equal(word, '.'));
+		auto const separators(swar_equal(word, '|') | swar_equal(word, '/'));
+		auto const tabs(swar_equal(word, '\t'));
+		return SWAR_HIGH_BITS == ((alleles & DIPLOID_GT_ALLELE_MASK) | (separators & DIPLOID_GT_SEPARATOR_MASK) | (tabs & DIPLOID_GT_TAB_MASK));
+	}
+
+	constexpr auto to_word(char const (&buffer)[9]) { std::array <char, 8> retval{}; std::copy_n(buffer, 8, retval.begin()); return std::bit_cast <swar_word>(retval); }
+	static_assert(is_diploid_gt_column_pair(to_word("0|1\t.|2\t"), 2));
+	static_assert(is_diploid_gt_column_pair(to_word("9/9\t0/0\t"), 9));
+	static_assert(!is_diploid_gt_column_pair(to_word("0|1\t.|2\t"), 1));
+	static_assert(!is_diploid_gt_column_pair(to_word("0|1\t0|1\n"), 1));
+	static_assert(!is_diploid_gt_column_pair(to_word("0|1\t0:11"), 1));
+	static_assert(!is_diploid_gt_column_pair(to_word("0|1\t0\t1\t"), 1));
+}
+
+
 namespace libbio::vcf::detail {
 
 	reader_default_delegate	g_vcf_reader_default_delegate;
@@ -214,23 +277,187 @@ namespace libbio::vcf {
 	}
 
 
-	// TODO: Implement seeking. Currently this is possible (to some extent) by using a MMAP data source and a separate reader.
-#if 0
-	// Seek to the beginning of the records.
-	void reader::reset()
+	char const *reader::skip_sample_columns(char const *column_start, std::size_t &sample_idx)
+	{
+		// Skip the consecutive samples that are not parsed and return the position of the separator
+		// after the last one. memchr() is vectorised in the common C libraries, so locate the next tab
+		// and check for a newline only within the column.
+		auto const sample_count(m_parsed_samples.size());
+		auto &samples(m_current_variant.m_samples);
+		while (true)
+		{
+			auto const *column_end(static_cast <char const *>(std::memchr(column_start, '\t', m_fsm.pe - column_start)));
+			if (!column_end)
+				column_end = m_fsm.pe;
+
+			// The records end in a newline, so the column cannot extend to the end of the input.
+			if (auto const *nl(static_cast <char const *>(std::memchr(column_start, '\n', column_end - column_start))); nl)
+				column_end = nl;
+			else if (column_end == m_fsm.pe)
+				throw parse_error("Unable to find the end of the sample column", std::string_view(column_start, column_end - column_start));
+
+			libbio_always_assert_lt(sample_idx, samples.size(), "Samples should be preallocated.");
+			m_sample_columns[sample_idx] = std::string_view(column_start, column_end - column_start);
+			samples[sample_idx].reset();
+			++sample_idx;
+
+			if ('\t' != *column_end || sample_idx == sample_count || m_parsed_samples[sample_idx])
+				return column_end;
+
+			column_start = column_end + 1;
+		}
+	}
+
+
+	char const *reader::parse_diploid_gt_columns(char const *column_start, std::size_t &sample_idx)
+	{
+		// Handle the consecutive GT-only columns of the form [0-9.][|/][0-9.] without the state machine.
+		// Returns the position of the separator after the last handled column or nullptr if the first
+		// column needs to be parsed in the generic way.
+		libbio_assert(m_gt_only_field);
+		auto const &gt_field(*m_gt_only_field);
+		auto &samples(m_current_variant.m_samples);
+		auto const alt_count(m_current_variant.m_alts.size());
+		auto const is_valid([alt_count](std::uint16_t const idx){ return sample_genotype::NULL_ALLELE == idx || idx <= alt_count; });
+
+		auto const assign([&](char const *column){
+			auto &sample(samples[sample_idx]);
+			sample.reset();
+			gt_field.prepare(sample);
+			gt_field.assign_diploid(
+				sample,
+				sample_genotype(detail::single_character_allele(column[0]), false),
+				sample_genotype(detail::single_character_allele(column[2]), '|' == column[1])
+			);
+			++sample_idx;
+		});
+
+		char const *retval{};
+		auto const *p(column_start);
+
+		// Check eight bytes, i.e. two columns followed by tabs, at a time.
+		auto const max_digit(std::min <std::size_t>(alt_count, 9));
+		while (8 <= m_fsm.pe - p && sample_idx + 2 <= samples.size())
+		{
+			swar_word word{};
+			std::memcpy(&word, p, sizeof(swar_word));
+			if (!is_diploid_gt_column_pair(word, max_digit))
+				break;
+
+			assign(p);
+			assign(p + 4);
+			retval = p + 7;
+			p += 8;
+		}
+
+		// Handle the remaining columns one at a time.
+		while (4 <= m_fsm.pe - p && sample_idx < samples.size())
+		{
+			auto const first(detail::single_character_allele(p[0]));
+			auto const second(detail::single_character_allele(p[2]));
+			auto const sep(p[1]);
+			auto const next(p[3]);
+			if (! (is_valid(first) && is_valid(second) && ('|' == sep || '/' == sep) && ('\t' == next || '\n' == next)))
+				break;
+
+			assign(p);
+			retval = p + 3;
+			if ('\n' == next)
+				break;
+
+			p += 4;
+		}
+
+		return retval;
+	}
+
+
+	void reader::set_parsed_samples(sample_number_vector const &sample_numbers)
+	{
+		m_parsed_samples.clear();
+		m_sample_columns.clear();
+		if (sample_numbers.empty())
+			return;
+
+		auto const count(sample_count());
+		m_parsed_samples.resize(count, false);
+		m_sample_columns.resize(count);
+		for (auto const sample_no : sample_numbers)
+		{
+			libbio_always_assert_lt(0, sample_no, "Sample numbers should be 1-based");
+			libbio_always_assert_lte(sample_no, count, "Unexpected sample number");
+			m_parsed_samples[sample_no - 1] = true;
+		}
+	}
+
+
+	void reader::parse_skipped_sample(std::size_t const sample_idx)
+	{
+		auto &samples(m_current_variant.m_samples);
+		libbio_assert_lt(sample_idx, samples.size());
+		auto &sample(samples[sample_idx]);
+		sample.reset();
+		for (auto const *field_ptr : m_current_format_vec)
+			field_ptr->prepare(sample);
+
+		if (auto const *bcf_input = m_input->as_bcf_input())
+		{
+			// The value ranges are retained until the next record is read.
+			libbio_assert_eq(m_current_format_vec.size(), bcf_input->m_format_entries.size());
+			for (std::size_t field_idx{}; field_idx < m_current_format_vec.size(); ++field_idx)
+			{
+				auto const &entry(bcf_input->m_format_entries[field_idx]);
+				m_current_format_vec[field_idx]->assign_bcf_value(entry.values.sample(sample_idx), m_current_variant, sample);
+			}
+			return;
+		}
+
+		auto const column(m_sample_columns[sample_idx]);
+		std::size_t field_idx{};
+		std::size_t start_pos{};
+		while (true)
+		{
+			if (! (field_idx < m_current_format_vec.size()))
+				throw parse_error("More fields in current sample than specified in FORMAT");
+
+			auto const end_pos(column.find(':', start_pos));
+			m_current_format_vec[field_idx]->parse_and_assign(column.substr(start_pos, end_pos - start_pos), m_current_variant, sample); // npos is valid for end_pos.
+			++field_idx;
+
+			if (std::string_view::npos == end_pos)
+				break;
+
+			start_pos = 1 + end_pos;
+		}
+
+		if (m_current_format_vec.size() != field_idx)
+			throw parse_error("Number of sample fields differs from FORMAT");
+	}
+
+
+	void reader::seek_to_variant(std::size_t const offset, std::size_t const lineno, std::size_t const variant_index)
 	{
 		libbio_assert(m_input);
-		m_input->reset_to_first_variant_offset();
-		m_lineno = m_input->last_header_lineno();
-		m_fsm.eof = nullptr;
+		auto *input(dynamic_cast <seekable_input_base *>(m_input));
+		if (!input)
+			throw std::runtime_error("Input is not seekable");
+
+		input->seek(offset);
+
+		// Make the reader request more input.
+		m_fsm = fsm{};
 		m_current_line_or_buffer_start = nullptr;
-		m_counter = 0;
-		m_variant_index = 0;
+		m_variant_offset = offset;
+		m_variant_index = variant_index;
+		set_lineno(lineno);
+	}
 
-		m_current_format->m_fields_by_identifier.clear();
-		m_current_format_vec.clear();
+
+	void reader::reset()
+	{
+		libbio_assert(m_input);
+		seek_to_variant(m_input->first_variant_offset(), m_input->first_variant_lineno(), 0);
 	}
-#endif
 
 
 	// Return the 1-based number of the given sample.
@@ -248,8 +475,12 @@ namespace libbio::vcf {
 		libbio_assert(m_input);
 		if (m_fsm.p == m_fsm.pe && (m_fsm.p != m_fsm.eof || m_fsm.p == nullptr))
 		{
+			// Count the remaining bytes of the current buffer.
+			if (m_current_line_or_buffer_start)
+				m_variant_offset += m_fsm.p - m_current_line_or_buffer_start;
+
 			m_input->fill_buffer(*this);
-			m_current_line_or_buffer_start = m_input->buffer_start();
+			m_current_line_or_buffer_start = m_fsm.p;
 		}
 	}
 
@@ -316,6 +547,28 @@ namespace libbio::vcf {
 	}
 
 
+	void reader::update_variant_format(std::string_view const &new_format, parser_state &state)
+	{
+		m_current_format->reader_will_update_format(*this);
+		m_current_variant.deinitialize_samples();
+
+		state.current_format = new_format;
+		parse_format(state.current_format);
+		auto const [size, alignment] = assign_format_field_indices_and_offsets();
+		auto const field_count(m_current_format->fields_by_identifier().size());
+		m_current_variant.reserve_memory_for_samples(size, alignment, field_count);
+
+		m_current_variant.initialize_samples();
+
+		m_gt_only_field = nullptr;
+		if (1 == m_current_format_vec.size())
+			m_gt_only_field = dynamic_cast <genotype_field_gt const *>(m_current_format_vec.front());
+
+		m_current_format->reader_did_update_format(*this);
+		m_delegate->vcf_reader_did_update_variant_format(*this);
+	}
+
+
 	std::pair <std::uint16_t, std::uint16_t> reader::assign_format_field_indices_and_offsets()
 	{
 		// Recalculate the offsets. This also has the effect of making variants copied earlier unreadable,
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <libbio/assert.hh>
+#include <libbio/bcf/typed_value.hh>
+#include <libbio/binary_parsing/range.hh>
+#include <libbio/binary_parsing/read_value.hh>
+#include <libbio/vcf/bcf_input.hh>
+#include <libbio/vcf/constants.hh>
+#include <libbio/vcf/parse_error.hh>
+#include <libbio/vcf/subfield.hh>
+#include <libbio/vcf/variant.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <string_view>
+
+namespace bcf	= libbio::bcf;
+namespace bp	= libbio::binary_parsing;
+namespace vcf	= libbio::vcf;
+
+
+namespace {
+
+	// Determine the structural variant type in the same way as the VCF parser.
+	vcf::sv_type symbolic_alt_type(std::string_view alt)
+	{
+		if ("." == alt)
+			return vcf::sv_type::UNKNOWN;
+
+		if (! (2 < alt.size() && '<' == alt.front() && '>' == alt.back()))
+			return vcf::sv_type::NONE;
+
+		alt = alt.substr(1, alt.size() - 2);
+		auto const has_prefix([alt](std::string_view const prefix){
+			return alt.starts_with(prefix) && (alt.size() == prefix.size() || ':' == alt[prefix.size()]);
+		});
+
+		if (has_prefix("DUP:TANDEM"))	return vcf::sv_type::DUP_TANDEM;
+		if (has_prefix("DEL:ME"))		return vcf::sv_type::DEL_ME;
+		if (has_prefix("INS:ME"))		return vcf::sv_type::INS_ME;
+		if (has_prefix("DEL"))			return vcf::sv_type::DEL;
+		if (has_prefix("INS"))			return vcf::sv_type::INS;
+		if (has_prefix("DUP"))			return vcf::sv_type::DUP;
+		if (has_prefix("INV"))			return vcf::sv_type::INV;
+		if (has_prefix("CNV"))			return vcf::sv_type::CNV;
+		return vcf::sv_type::UNKNOWN_SV;
+	}
+
+
+	std::string_view take_string(bp::range &rr)
+	{
+		auto const val(bcf::take_typed_value(rr));
+		if (val.is_missing())
+			return {};
+		return val.string();
+	}
+
+
+	template <typename t_type>
+	t_type *find_by_key(std::vector <t_type *> const &vec, std::int32_t const key)
+	{
+		if (0 <= key && std::size_t(key) < vec.size())
+			return vec[key];
+		return nullptr;
+	}
+}
+
+
+namespace libbio::vcf {
+
+	// Returns whether there is still data to be parsed, i.e. if EOF was not reached.
+	bool reader::parse_bcf(callback_fn const &cb, parser_state &state, bool const stop_after_record)
+	{
+		libbio_assert(m_input);
+		auto &input(*m_input->as_bcf_input());
+		input.prepare_for_parsing(*this);
+
+		auto const &dictionary(input.dictionary());
+		bcf_input_base::byte_span shared_span;
+		bcf_input_base::byte_span indiv_span;
+
+		// Report an error or skip the current record. Returns true if the record should be skipped.
+		auto const should_skip_invalid([this](char const *message, std::string_view const sv = {}){
+			if (!m_should_skip_invalid)
+				throw parse_error(message, sv);
+
+			// FIXME: Call the delegate.
+			std::cerr << "WARNING: " << message << " in record " << (1 + m_variant_index) << "; skipping.\n";
+			return true;
+		});
+
+		while (input.take_record(shared_span, indiv_span))
+		{
+			++m_lineno;
+			m_current_variant.reset();
+			m_current_variant.m_variant_index = m_variant_index++;
+			m_current_variant.m_lineno = m_lineno;
+			m_variant_offset = input.offset() - shared_span.size() - indiv_span.size();
+
+			// BCF 2.2 § 6.3.1.
+			auto shared(bp::to_range(shared_span));
+			auto const chrom_idx(bp::take <std::int32_t, bp::endian::little>(shared));
+			auto const pos(bp::take <std::int32_t, bp::endian::little>(shared));
+			bp::take <std::int32_t, bp::endian::little>(shared); // rlen
+			auto const qual_bits(bp::take <std::uint32_t, bp::endian::little>(shared));
+			auto const n_allele_info(bp::take <std::uint32_t, bp::endian::little>(shared));
+			auto const n_fmt_sample(bp::take <std::uint32_t, bp::endian::little>(shared));
+			std::uint32_t const n_allele(n_allele_info >> 16);
+			std::uint32_t const n_info(n_allele_info & 0xFFFF);
+			std::uint32_t const n_fmt(n_fmt_sample >> 24);
+			std::uint32_t const n_sample(n_fmt_sample & 0xFFFFFF);
+
+			bool should_skip(false);
+			auto const should_parse([this](field const ff){ return ff <= m_max_parsed_field; });
+
+			// CHROM
+			if (should_parse(field::CHROM))
+			{
+				auto const chrom_id(dictionary.contig(chrom_idx));
+				if (chrom_id.empty() && should_skip_invalid("Unknown contig index"))
+					continue;
+				m_current_variant.set_chrom_id(chrom_id);
+				m_current_variant.set_contig_index(m_contigs.find_or_add(chrom_id));
+			}
+
+			// POS
+			if (should_parse(field::POS))
+			{
+				m_current_variant.set_pos(1 + pos);
+
+				switch (m_chrom_pos_validator->validate(m_current_variant))
+				{
+					case variant_validation_result::PASS:
+						break;
+
+					case variant_validation_result::SKIP:
+						should_skip = true;
+						break;
+
+					case variant_validation_result::STOP:
+						return true;
+				}
+
+				if (should_skip)
+				{
+					if (stop_after_record)
+						return true;
+					continue;
+				}
+			}
+
+			// QUAL is stored before ID.
+			if (should_parse(field::QUAL))
+			{
+				if (bcf::FLOAT_MISSING_BITS == qual_bits)
+					m_current_variant.set_qual(variant_formatted_base::UNKNOWN_QUALITY);
+				else
+					m_current_variant.set_qual(std::bit_cast <float>(qual_bits));
+			}
+
+			// ID
+			{
+				auto const id(take_string(shared));
+				if (should_parse(field::ID))
+				{
+					if (id.empty())
+						m_current_variant.set_id(".", 0);
+					else
+					{
+						std::size_t idx{};
+						std::size_t start_pos{};
+						while (true)
+						{
+							auto const end_pos(id.find(';', start_pos));
+							m_current_variant.set_id(id.substr(start_pos, end_pos - start_pos), idx++);
+							if (std::string_view::npos == end_pos)
+								break;
+							start_pos = 1 + end_pos;
+						}
+					}
+				}
+			}
+
+			// REF and ALT
+			for (std::uint32_t i{}; i < n_allele; ++i)
+			{
+				auto const allele(take_string(shared));
+				if (0 == i)
+				{
+					if (should_parse(field::REF))
+						m_current_variant.set_ref(allele);
+				}
+				else if (should_parse(field::ALT))
+				{
+					auto &alt(m_current_variant.m_alts.emplace_back());
+					alt.set_alt(allele.empty() ? std::string_view{"."} : allele);
+					alt.alt_sv_type = symbolic_alt_type(alt.alt);
+				}
+			}
+
+			// FILTER
+			{
+				auto const filters(bcf::take_typed_value(shared));
+				if (should_parse(field::FILTER) && !filters.is_missing())
+				{
+					auto const count(filters.value_count());
+					for (std::uint32_t i{}; i < count; ++i)
+					{
+						auto const key(filters.integer_at(i));
+						if (key == input.m_pass_key)
+							continue;
+
+						auto const *filter(find_by_key(input.m_filters_by_key, key));
+						if (!filter)
+						{
+							should_skip = should_skip_invalid("Unknown FILTER key", dictionary.string(key));
+							break;
+						}
+
+						m_current_variant.m_filters.emplace_back(filter);
+					}
+
+					if (should_skip)
+						continue;
+				}
+			}
+
+			// INFO
+			if (should_parse(field::INFO))
+			{
+				m_current_record_info_fields.clear();
+				for (auto const *field_ptr : m_info_fields_in_headers)
+					field_ptr->prepare(m_current_variant);
+
+				for (std::uint32_t i{}; i < n_info; ++i)
+				{
+					auto const key(bcf::take_typed_integer(shared));
+					auto const val(bcf::take_typed_value(shared));
+					auto *info_field(find_by_key(input.m_info_fields_by_key, key));
+					if (!info_field)
+					{
+						should_skip = should_skip_invalid("Unknown INFO key", dictionary.string(key));
+						break;
+					}
+
+					m_current_record_info_fields.emplace_back(info_field);
+					if (metadata_value_type::FLAG == info_field->metadata_value_type())
+						info_field->assign_flag(m_current_variant);
+					else
+						info_field->assign_bcf_value(val, m_current_variant);
+				}
+
+				if (should_skip)
+					continue;
+			}
+
+			// FORMAT
+			if (n_fmt && should_parse(field::FORMAT))
+			{
+				// Read the keys and the value ranges, BCF 2.2 § 6.3.2.
+				auto indiv(bp::to_range(indiv_span));
+				input.m_format_entries.clear();
+				input.m_format_buffer.clear();
+				for (std::uint32_t i{}; i < n_fmt; ++i)
+				{
+					auto &entry(input.m_format_entries.emplace_back());
+					entry.key = bcf::take_typed_integer(indiv);
+					entry.values = bcf::take_type_descriptor(indiv);
+					entry.values.data = indiv.it;
+					indiv.seek(n_sample * entry.values.byte_size());
+
+					auto const key_sv(dictionary.string(entry.key));
+					if (key_sv.empty())
+					{
+						should_skip = should_skip_invalid("Unknown FORMAT key");
+						break;
+					}
+
+					if (i)
+						input.m_format_buffer += ':';
+					input.m_format_buffer += key_sv;
+				}
+
+				if (should_skip)
+					continue;
+
+				if (input.m_format_buffer != state.current_format)
+					update_variant_format(input.m_format_buffer, state);
+
+				// Samples
+				if (should_parse(field::ALL))
+				{
+					auto &samples(m_current_variant.m_samples);
+					if (samples.size() != n_sample && should_skip_invalid("Number of samples differs from VCF headers"))
+						continue;
+
+					libbio_assert_eq(m_current_format_vec.size(), input.m_format_entries.size());
+					for (std::size_t sample_idx{}; sample_idx < n_sample; ++sample_idx)
+					{
+						auto &sample(samples[sample_idx]);
+						sample.reset();
+						if (!is_parsed_sample(sample_idx))
+							continue;
+
+						for (auto const *field_ptr : m_current_format_vec)
+							field_ptr->prepare(sample);
+
+						for (std::size_t field_idx{}; field_idx < m_current_format_vec.size(); ++field_idx)
+						{
+							auto const *field_ptr(m_current_format_vec[field_idx]);
+							auto const &entry(input.m_format_entries[field_idx]);
+							field_ptr->assign_bcf_value(entry.values.sample(sample_idx), m_current_variant, sample);
+						}
+					}
+				}
+			}
+
+			auto const should_continue(cb(m_current_variant));
+			if (!should_continue)
+				return true;
+
+			++m_counter;
+
+			if (stop_after_record)
+				return true;
+		}
+
+		return false;
+	}
+}
@@ -58,10 +58,9 @@ namespace libbio::vcf {
 		metadata_record_var		current_metadata;
 		metadata_base			*current_metadata_ptr{};
 
-		char const				*buffer_start(nullptr);
 		char const				*start(nullptr);				// Current string start.
 		char const				*line_start(nullptr);			// Current line start.
-		std::uint16_t			counters[1 + HEADER_COUNT]{};
+		std::uint32_t			counters[1 + HEADER_COUNT]{};
 
 		std::size_t				sample_name_idx(1);
 		std::int64_t			integer(0);						// Currently read from the input.
@@ -172,6 +171,9 @@ namespace libbio::vcf {
 				>(start_string)
 				%{ HANDLE_STRING_END_METADATA(&meta_t::set_url); };
 
+			# IDX field, output by e.g. HTSlib for BCF headers.
+			meta_field_idx					= "IDX=" integer %{ HANDLE_INTEGER_END_METADATA(&meta_t::set_idx); };
+
 			# length field.
 			meta_field_length				= "length=" integer %{ HANDLE_INTEGER_END_METADATA(&meta_t::set_length); };
 
@@ -217,7 +219,8 @@ namespace libbio::vcf {
 												meta_field_type |
 												meta_field_description |
 												meta_field_source |
-												meta_field_version;
+												meta_field_version |
+												meta_field_idx;
 			meta_record_info				:=
 				(
 					"=<"
@@ -226,7 +229,7 @@ namespace libbio::vcf {
 				) >(meta_record_info) %(meta_record_info_end) header_sub_nl $err(error);
 
 			# FILTER record.
-			meta_record_filter_field		= meta_field_id | meta_field_description;
+			meta_record_filter_field		= meta_field_id | meta_field_description | meta_field_idx;
 			meta_record_filter				:=
 				(
 					"=<"
@@ -235,7 +238,7 @@ namespace libbio::vcf {
 				) >(meta_record_filter) %(meta_record_filter_end) header_sub_nl $err(error);
 
 			# FORMAT record.
-			meta_record_format_field		= meta_field_id | meta_field_number | meta_field_type | meta_field_description;
+			meta_record_format_field		= meta_field_id | meta_field_number | meta_field_type | meta_field_description | meta_field_idx;
 			meta_record_format				:=
 				(
 					"=<" (meta_record_format_field (',' meta_record_format_field)*)
@@ -278,6 +281,7 @@ namespace libbio::vcf {
 			meta_record_contig_field		=
 				meta_field_id |
 				meta_field_length |
+				meta_field_idx |
 				meta_field_generic;
 				#meta_field_assembly |
 				#meta_field_md5 |
@@ -321,20 +325,24 @@ namespace libbio::vcf {
 		{
 			fill_buffer();
 			should_continue = true;
-			buffer_start = m_fsm.p;
 			%% write exec;
-			m_variant_offset += m_fsm.p - buffer_start;
 		} while (should_continue);
 
+		// fill_buffer() counts the bytes in the previous buffers.
+		m_variant_offset += m_fsm.p - m_current_line_or_buffer_start;
+		m_current_line_or_buffer_start = m_fsm.p;
+
 		// Post-process the metadata descriptions.
 		m_delegate->vcf_reader_did_parse_metadata(*this);
 		associate_metadata_with_field_descriptions();
+		m_contigs.reset(m_metadata);
 		auto const [info_size, info_max_alignment] = assign_info_field_offsets();
 
 		// Assign the genotype offsets after reading FORMAT.
 
 		// stream now points to the first variant.
 		m_input->set_first_variant_lineno(1 + m_lineno);
+		m_input->set_first_variant_offset(m_variant_offset);
 
 		// Instantiate a variant.
 		transient_variant var(*this, sample_count(), info_size, info_max_alignment);
@@ -13,6 +13,7 @@
 #include <libbio/vcf/variant.hh>
 #include <libbio/vcf/vcf_reader.hh>
 #include <string_view>
+#include <type_traits>
 #include "vcf_reader_private.hh"
 
 #pragma GCC diagnostic push
@@ -83,6 +84,15 @@ namespace libbio::vcf {
 		typedef transient_variant				var_t;
 		typedef variant_alt <std::string_view>	alt_t;
 
+		if (m_input->as_bcf_input())
+		{
+			// Wrap the callback instead of copying it to a callback_fn.
+			if constexpr (std::is_same_v <t_cb, callback_fn>)
+				return parse_bcf(cb, state, stop_after_newline);
+			else
+				return parse_bcf([&cb](transient_variant &var){ return cb(var); }, state, stop_after_newline);
+		}
+
 		bool should_continue(true);
 		bool eof_reached(false);
 
@@ -93,6 +103,7 @@ namespace libbio::vcf {
 		std::int64_t			integer(0);					// Currently read from the input.
 		std::size_t				sample_idx(0);				// Current sample idx (1-based).
 		std::size_t				subfield_idx(0);			// Current index in multi-part fields.
+		std::size_t				handled_sample_limit(0);	// Non-zero if the current sample columns were handled outside the state machine.
 		int						cs(0);
 		bool					integer_is_negative(false);	// Re-initialized in HANDLE_INTEGER_END.
 		bool					gt_is_phased(false);		// Is the current GT phased.
@@ -261,72 +272,92 @@ namespace libbio::vcf {
 			action end_format {
 				std::string_view const new_format(start, fpc - start);
 				if (new_format != state.current_format)
-				{
-					m_current_format->reader_will_update_format(*this);
-					m_current_variant.deinitialize_samples();
-
-					state.current_format = new_format;
-					parse_format(state.current_format);
-					auto const [size, alignment] = assign_format_field_indices_and_offsets();
-					auto const field_count(m_current_format->fields_by_identifier().size());
-					m_current_variant.reserve_memory_for_samples(size, alignment, field_count);
-
-					m_current_variant.initialize_samples();
-					m_current_format->reader_did_update_format(*this);
-					m_delegate->vcf_reader_did_update_variant_format(*this);
-				}
+					update_variant_format(new_format, state);
 			}
 
 			action end_sample_field {
-				std::string_view const field_value(start, fpc - start);
-				if (! (subfield_idx < m_current_format_vec.size()))
+				// The fields of the samples handled outside the state machine are ignored.
+				if (!handled_sample_limit)
 				{
-					if (!m_should_skip_invalid)
-						throw parse_error("More fields in current sample than specified in FORMAT");
-					else
+					if (! (subfield_idx < m_current_format_vec.size()))
 					{
-						// FIXME: Call the delegate.
-						std::cerr << "WARNING: Unexpected number of genotype value fields on line " << (m_lineno + last_header_lineno()) << "; skipping.\n";
-						skip_to_next_nl();
-						fgoto main_nl;
+						if (!m_should_skip_invalid)
+							throw parse_error("More fields in current sample than specified in FORMAT");
+						else
+						{
+							// FIXME: Call the delegate.
+							std::cerr << "WARNING: Unexpected number of genotype value fields on line " << (m_lineno + last_header_lineno()) << "; skipping.\n";
+							skip_to_next_nl();
+							fgoto main_nl;
+						}
 					}
-				}
 
-				auto const &format_ptr(m_current_format_vec[subfield_idx]);
-				auto &samples(m_current_variant.m_samples);
-				libbio_always_assert_lt(sample_idx, samples.size(), "Samples should be preallocated.");
-				format_ptr->parse_and_assign(field_value, m_current_variant, samples[sample_idx]);
+					std::string_view const field_value(start, fpc - start);
+					auto const &format_ptr(m_current_format_vec[subfield_idx]);
+					auto &samples(m_current_variant.m_samples);
+					libbio_always_assert_lt(sample_idx, samples.size(), "Samples should be preallocated.");
+					format_ptr->parse_and_assign(field_value, m_current_variant, samples[sample_idx]);
 
-				++subfield_idx;
+					++subfield_idx;
+				}
 			}
 
 			action start_sample {
 				subfield_idx = 0;
+				auto &samples(m_current_variant.m_samples);
+				libbio_always_assert_lt(sample_idx, samples.size(), "Samples should be preallocated.");
+				if (!is_parsed_sample(sample_idx))
 				{
-					auto &samples(m_current_variant.m_samples);
-					libbio_always_assert_lt(sample_idx, samples.size(), "Samples should be preallocated.");
-					auto &current_sample(samples[sample_idx]);
-					current_sample.reset();
-					for (auto const *field_ptr : m_current_format_vec)
-						field_ptr->prepare(current_sample);
+					// Skip to the separator that follows the unparsed columns; handle_sample updates sample_idx.
+					handled_sample_limit = sample_idx;
+					fexec skip_sample_columns(fpc, handled_sample_limit);
+				}
+				else
+				{
+					// Try the fast path for diploid GT-only columns first.
+					char const *column_end{};
+					if (m_gt_only_field && m_parsed_samples.empty())
+					{
+						handled_sample_limit = sample_idx;
+						column_end = parse_diploid_gt_columns(fpc, handled_sample_limit);
+					}
+
+					if (column_end)
+						fexec column_end;
+					else
+					{
+						handled_sample_limit = 0;
+						auto &current_sample(samples[sample_idx]);
+						current_sample.reset();
+						for (auto const *field_ptr : m_current_format_vec)
+							field_ptr->prepare(current_sample);
+					}
 				}
 			}
 
 			action handle_sample {
-				if (m_current_format_vec.size() != subfield_idx)
+				if (handled_sample_limit)
 				{
-					if (!m_should_skip_invalid)
-						throw parse_error("Number of sample fields differs from FORMAT");
-					else
+					sample_idx = handled_sample_limit;
+					handled_sample_limit = 0;
+				}
+				else
+				{
+					if (m_current_format_vec.size() != subfield_idx)
 					{
-						// FIXME: Call the delegate.
-						std::cerr << "WARNING: Unexpected number of genotype value fields on line " << (m_lineno + last_header_lineno()) << "; skipping.\n";
-						skip_to_next_nl();
-						fgoto main_nl;
+						if (!m_should_skip_invalid)
+							throw parse_error("Number of sample fields differs from FORMAT");
+						else
+						{
+							// FIXME: Call the delegate.
+							std::cerr << "WARNING: Unexpected number of genotype value fields on line " << (m_lineno + last_header_lineno()) << "; skipping.\n";
+							skip_to_next_nl();
+							fgoto main_nl;
+						}
 					}
-				}
 
-				++sample_idx;
+					++sample_idx;
+				}
 			}
 
 			action handle_last_sample {
@@ -383,7 +414,10 @@ namespace libbio::vcf {
 
 			chrom_id	= (chr+)
 				>(start_string)
-				%{ HANDLE_STRING_END_VAR(&var_t::set_chrom_id); };
+				%{
+					HANDLE_STRING_END_VAR(&var_t::set_chrom_id);
+					m_current_variant.set_contig_index(m_contigs.find_or_add(m_current_variant.chrom_id()));
+				};
 
 			pos			= integer %{ HANDLE_INTEGER_END_VAR(&var_t::set_pos); };
 
@@ -597,6 +631,7 @@ namespace libbio::vcf {
 
 					subfield_idx = 0;
 					sample_idx = 0;
+					handled_sample_limit = 0;
 					alt_is_complex = false;
 					++m_lineno;
 					m_current_variant.reset();
@@ -16,9 +16,9 @@ namespace libbio::vcf {
 
 	variant_validation_result region_variant_validator::validate(transient_variant const &var)
 	{
-		auto const chr_id(var.chrom_id());
+		auto const contig_idx(var.contig_index());
 		auto const var_pos(var.zero_based_pos());
-		if (m_prev_chr_id == chr_id)
+		if (m_prev_contig_index == contig_idx)
 		{
 			if (var_pos < m_prev_var_pos)
 				return handle_unordered_variants(var);
@@ -64,9 +64,10 @@ namespace libbio::vcf {
 		}
 		else
 		{
-			m_prev_chr_id = chr_id;
+			m_prev_contig_index = contig_idx;
 			m_prev_var_pos = var_pos;
 
+			auto const chr_id(var.chrom_id());
 			auto const it(m_regions.find(chr_id));
 			if (m_regions.end() == it)
 			{
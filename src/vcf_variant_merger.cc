@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <cstdint>
+#include <libbio/assert.hh>
+#include <libbio/loser_tree.hh>
+#include <libbio/vcf/variant_merger.hh>
+#include <libbio/vcf/vcf_reader.hh>
+#include <utility>
+
+
+namespace {
+
+	// Position and the number of preceding records with the same position in the same input.
+	typedef std::pair <std::uint64_t, std::size_t>	merge_key;
+}
+
+
+namespace libbio::vcf {
+
+	void variant_merger::input_channel::run()
+	{
+		// Called from the parsing thread.
+		block *current(acquire_block());
+		if (!current)
+			return;
+
+		try
+		{
+			m_reader->parse([this, &current](transient_variant const &var){
+				auto &bb(*current);
+				bb.variants.push_back(bb.buffer.freeze(var));
+
+				if (bb.size() < m_block_size)
+					return true;
+
+				publish_block();
+				current = acquire_block();
+				return nullptr != current;
+			});
+		}
+		catch (...)
+		{
+			std::lock_guard const lock(m_mutex);
+			m_exception = std::current_exception();
+		}
+
+		// Mark the end of the input unless stopped.
+		if (current)
+		{
+			current->is_last = true;
+			publish_block();
+		}
+	}
+
+
+	auto variant_merger::input_channel::acquire_block() -> block *
+	{
+		std::unique_lock lock(m_mutex);
+		m_cv.wait(lock, [this]{ return m_should_stop || m_filled_count < m_blocks.size(); });
+		if (m_should_stop)
+			return nullptr;
+
+		// The merging thread does not access the unfilled blocks, so the block may be filled without locking.
+		auto &bb(m_blocks[(m_first_filled + m_filled_count) % m_blocks.size()]);
+		bb.buffer.release();
+		bb.variants.clear();
+		bb.is_last = false;
+		return &bb;
+	}
+
+
+	void variant_merger::input_channel::publish_block()
+	{
+		{
+			std::lock_guard const lock(m_mutex);
+			++m_filled_count;
+		}
+		m_cv.notify_all();
+	}
+
+
+	auto variant_merger::input_channel::filled_block(std::size_t const nth) -> block &
+	{
+		std::unique_lock lock(m_mutex);
+		libbio_assert_lt(nth, m_blocks.size());
+		m_cv.wait(lock, [this, nth]{ return nth < m_filled_count; });
+		return m_blocks[(m_first_filled + nth) % m_blocks.size()];
+	}
+
+
+	void variant_merger::input_channel::release_block()
+	{
+		{
+			std::lock_guard const lock(m_mutex);
+			libbio_assert_lt(0, m_filled_count);
+			m_first_filled = (1 + m_first_filled) % m_blocks.size();
+			--m_filled_count;
+		}
+		m_cv.notify_all();
+	}
+
+
+	void variant_merger::input_channel::rethrow_if_failed()
+	{
+		std::lock_guard const lock(m_mutex);
+		if (m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+
+	void variant_merger::input_channel::stop()
+	{
+		{
+			std::lock_guard const lock(m_mutex);
+			m_should_stop = true;
+		}
+		m_cv.notify_all();
+
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+
+	bool variant_merger::advance(std::size_t const input_idx, input_cursor &cursor)
+	{
+		// Move to the next record of the given input and return false if there are none.
+		auto &input(*m_inputs[input_idx]);
+		++cursor.index;
+		if (cursor.index < cursor.current_block->size())
+			return true;
+
+		if (cursor.current_block->is_last)
+		{
+			input.rethrow_if_failed();
+			return false;
+		}
+
+		// The current block is still used by the group.
+		libbio_assert(!cursor.should_release);
+		cursor.current_block = &input.filled_block(1);
+		cursor.index = 0;
+		cursor.should_release = true;
+		if (cursor.current_block->size())
+			return true;
+
+		libbio_assert(cursor.current_block->is_last);
+		input.rethrow_if_failed();
+		return false;
+	}
+
+
+	void variant_merger::stop()
+	{
+		for (auto &input : m_inputs)
+			input->stop();
+	}
+
+
+	void variant_merger::merge(callback_fn const &callback)
+	{
+		auto const count(m_inputs.size());
+		for (auto &input : m_inputs)
+			input->start();
+
+		try
+		{
+			// Determine the first records.
+			std::vector <input_cursor> cursors(count);
+			loser_tree <merge_key> tree(count);
+			for (std::size_t idx{}; idx < count; ++idx)
+			{
+				auto &input(*m_inputs[idx]);
+				auto const &bb(input.filled_block(0));
+				cursors[idx].current_block = &bb;
+				if (bb.size())
+					tree.set_key(idx, merge_key(bb.variants.front().pos(), 0));
+				else
+					input.rethrow_if_failed();
+			}
+			tree.build();
+
+			// Group the records by the key, which makes the groups contain at most one record from each input.
+			variant_group group;
+			while (!tree.empty())
+			{
+				group.clear();
+				auto const key(tree.winner_key());
+				while (!tree.empty() && key == tree.winner_key())
+				{
+					auto const idx(tree.winner());
+					auto &cursor(cursors[idx]);
+					auto const var(cursor.current_block->variants[cursor.index]);
+					group.emplace_back(var, idx);
+
+					auto const pos(var.pos());
+					if (advance(idx, cursor))
+					{
+						auto const next_pos(cursor.current_block->variants[cursor.index].pos());
+						tree.replace_winner(merge_key(next_pos, next_pos == pos ? 1 + key.second : 0));
+					}
+					else
+					{
+						tree.remove_winner();
+					}
+				}
+
+				auto const should_continue(callback(group));
+
+				// Let the parsing threads reuse the blocks that were passed.
+				for (auto const &sv : group)
+				{
+					auto &cursor(cursors[sv.input_index]);
+					if (cursor.should_release)
+					{
+						m_inputs[sv.input_index]->release_block();
+						cursor.should_release = false;
+					}
+				}
+
+				if (!should_continue)
+					break;
+			}
+		}
+		catch (...)
+		{
+			stop();
+			throw;
+		}
+
+		stop();
+	}
+}
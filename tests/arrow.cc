@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/arrow/array_builder.hh>
+#include <libbio/arrow/flatbuffer_builder.hh>
+#include <libbio/arrow/ipc_file_writer.hh>
+#include <libbio/arrow/record_batch.hh>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arrow	= libbio::arrow;
+
+
+namespace {
+
+	std::vector <std::byte> to_bytes(std::vector <std::uint8_t> const &values)
+	{
+		std::vector <std::byte> retval(values.size());
+		std::transform(values.begin(), values.end(), retval.begin(), [](auto const val){ return std::byte(val); });
+		return retval;
+	}
+
+
+	std::vector <std::byte> to_vector(std::span <std::byte const> const bytes)
+	{
+		return {bytes.begin(), bytes.end()};
+	}
+
+
+	template <typename t_type>
+	t_type read_le(std::span <std::byte const> const bytes, std::size_t const pos)
+	{
+		REQUIRE(pos + sizeof(t_type) <= bytes.size());
+		std::array <std::byte, sizeof(t_type)> buffer;
+		std::copy_n(bytes.begin() + pos, sizeof(t_type), buffer.begin());
+		if constexpr (std::endian::big == std::endian::native)
+			std::reverse(buffer.begin(), buffer.end());
+		return std::bit_cast <t_type>(buffer);
+	}
+
+
+	// Minimal FlatBuffers decoder for checking the written metadata.
+	struct table
+	{
+		std::span <std::byte const>	bytes;
+		std::size_t					pos{};
+
+		std::size_t vtable_pos() const { return pos - read_le <std::int32_t>(bytes, pos); }
+
+		// Position of the field or zero if the field is not present.
+		std::size_t field_pos(std::uint16_t const field_id) const
+		{
+			auto const vtable(vtable_pos());
+			auto const vtable_size(read_le <std::uint16_t>(bytes, vtable));
+			auto const entry_pos(sizeof(std::uint16_t) * (2 + field_id));
+			if (vtable_size <= entry_pos)
+				return 0;
+			auto const offset(read_le <std::uint16_t>(bytes, vtable + entry_pos));
+			return offset ? pos + offset : 0;
+		}
+
+		template <typename t_type>
+		t_type scalar(std::uint16_t const field_id, t_type const default_value = {}) const
+		{
+			auto const field(field_pos(field_id));
+			return field ? read_le <t_type>(bytes, field) : default_value;
+		}
+
+		std::size_t follow(std::uint16_t const field_id) const
+		{
+			auto const field(field_pos(field_id));
+			REQUIRE(field);
+			return field + read_le <std::uint32_t>(bytes, field);
+		}
+
+		table subtable(std::uint16_t const field_id) const { return {bytes, follow(field_id)}; }
+		std::uint32_t vector_size(std::uint16_t const field_id) const { return read_le <std::uint32_t>(bytes, follow(field_id)); }
+
+		// Position of the first element of a vector.
+		std::size_t vector_data(std::uint16_t const field_id) const { return follow(field_id) + sizeof(std::uint32_t); }
+
+		table vector_table(std::uint16_t const field_id, std::size_t const idx) const
+		{
+			auto const element_pos(vector_data(field_id) + idx * sizeof(std::uint32_t));
+			return {bytes, element_pos + read_le <std::uint32_t>(bytes, element_pos)};
+		}
+
+		std::string_view string(std::uint16_t const field_id) const
+		{
+			auto const string_pos(follow(field_id));
+			auto const length(read_le <std::uint32_t>(bytes, string_pos));
+			REQUIRE(string_pos + sizeof(std::uint32_t) + length < bytes.size());
+			CHECK(std::byte{} == bytes[string_pos + sizeof(std::uint32_t) + length]);
+			return {reinterpret_cast <char const *>(bytes.data() + string_pos + sizeof(std::uint32_t)), length};
+		}
+	};
+
+
+	table root_table(std::span <std::byte const> const bytes)
+	{
+		return {bytes, read_le <std::uint32_t>(bytes, 0)};
+	}
+
+
+	struct expected_buffer
+	{
+		std::int64_t	offset{};
+		std::int64_t	length{};
+	};
+}
+
+
+SCENARIO("flatbuffer_builder writes FlatBuffers data", "[arrow]")
+{
+	GIVEN("a string")
+	{
+		arrow::flatbuffer_builder builder;
+
+		WHEN("the string is added")
+		{
+			auto const pos(builder.create_string("ab"));
+
+			THEN("the length precedes the characters and the NUL terminator, and the length is aligned")
+			{
+				CHECK(8 == pos);
+				CHECK(to_bytes({2, 0, 0, 0, 'a', 'b', 0, 0}) == to_vector(builder.data()));
+			}
+		}
+
+		WHEN("the string is used as the root")
+		{
+			builder.finish(builder.create_string("abc"));
+
+			THEN("the root offset refers to the string")
+			{
+				CHECK(to_bytes({4, 0, 0, 0, 3, 0, 0, 0, 'a', 'b', 'c', 0}) == to_vector(builder.data()));
+			}
+		}
+	}
+
+	GIVEN("a table with scalar fields")
+	{
+		arrow::flatbuffer_builder builder;
+		builder.start_table();
+		builder.add_field(0, std::int32_t(7));
+		builder.add_field(1, std::uint8_t(1));
+		builder.finish(builder.end_table());
+
+		THEN("the vtable precedes the table and the fields are aligned")
+		{
+			CHECK(to_bytes({
+				12,	0,	0,	0,	// Root offset
+				8,	0,			// vtable size
+				12,	0,			// Table size
+				8,	0,			// Field 0 offset
+				7,	0,			// Field 1 offset
+				8,	0,	0,	0,	// vtable offset
+				0,	0,	0,		// Padding
+				1,				// Field 1
+				7,	0,	0,	0	// Field 0
+			}) == to_vector(builder.data()));
+		}
+	}
+
+	GIVEN("two tables with the same layout")
+	{
+		arrow::flatbuffer_builder builder;
+		builder.start_table();
+		builder.add_field(0, std::int32_t(1));
+		builder.add_field(1, std::int32_t(2));
+		auto const first(builder.end_table());
+
+		builder.start_table();
+		builder.add_field(0, std::int32_t(3));
+		builder.add_field(1, std::int32_t(4));
+		auto const second(builder.end_table());
+		builder.finish(second);
+
+		THEN("the vtable is shared")
+		{
+			CHECK(12 == first);
+			CHECK(32 == second);
+			CHECK(to_bytes({
+				4,	0,	0,	0,			// Root offset
+				0xF4, 0xFF, 0xFF, 0xFF,	// Second table’s vtable offset (-12)
+				4,	0,	0,	0,			// Second table’s field 1
+				3,	0,	0,	0,			// Second table’s field 0
+				8,	0,					// vtable size
+				12,	0,					// Table size
+				8,	0,					// Field 0 offset
+				4,	0,					// Field 1 offset
+				8,	0,	0,	0,			// First table’s vtable offset
+				2,	0,	0,	0,			// First table’s field 1
+				1,	0,	0,	0			// First table’s field 0
+			}) == to_vector(builder.data()));
+
+			auto const bytes(builder.data());
+			table const tt{bytes, 4};
+			CHECK(3 == tt.scalar <std::int32_t>(0));
+			CHECK(4 == tt.scalar <std::int32_t>(1));
+			CHECK(tt.vtable_pos() == table{bytes, 24}.vtable_pos());
+		}
+	}
+
+	GIVEN("a vector of structs")
+	{
+		arrow::flatbuffer_builder builder;
+		builder.start_vector(2, 2 * sizeof(std::int64_t), alignof(std::int64_t));
+		builder.push(std::int64_t(0));
+		builder.push(std::int64_t(7));
+		builder.push(std::int64_t(1));
+		builder.push(std::int64_t(5));
+		builder.finish(builder.end_vector(2));
+
+		THEN("the elements follow the length and are aligned to eight bytes")
+		{
+			CHECK(to_bytes({
+				4,	0,	0,	0,				// Root offset
+				2,	0,	0,	0,				// Length
+				5,	0,	0,	0,	0,	0,	0,	0,
+				1,	0,	0,	0,	0,	0,	0,	0,
+				7,	0,	0,	0,	0,	0,	0,	0,
+				0,	0,	0,	0,	0,	0,	0,	0
+			}) == to_vector(builder.data()));
+		}
+	}
+}
+
+
+SCENARIO("ipc_file_writer writes Arrow IPC files", "[arrow]")
+{
+	GIVEN("a record batch with an integer and a string column")
+	{
+		arrow::primitive_builder <std::int32_t> values;
+		values.append(5);
+		values.append_null();
+		values.append(-3);
+
+		arrow::utf8_builder names;
+		names.append("abc");
+		names.append("");
+		names.append("de");
+
+		arrow::field_vector schema(2);
+		schema[0].name = "value";
+		values.describe(schema[0]);
+		schema[1].name = "name";
+		names.describe(schema[1]);
+
+		arrow::record_batch batch;
+		batch.set_length(3);
+		values.output(batch);
+		names.output(batch);
+
+		std::stringstream stream;
+		arrow::ipc_file_writer writer(stream);
+		writer.write_schema(schema, {{"key", "value"}});
+		writer.write_record_batch(batch);
+		writer.finish();
+
+		WHEN("the file is decoded")
+		{
+			auto const contents(stream.str());
+			std::span const bytes(reinterpret_cast <std::byte const *>(contents.data()), contents.size());
+			REQUIRE(writer.bytes_written() == contents.size());
+
+			THEN("the file begins and ends with the magic string")
+			{
+				REQUIRE(18 < contents.size());
+				CHECK(std::string_view("ARROW1\0\0", 8) == std::string_view(contents).substr(0, 8));
+				CHECK("ARROW1" == std::string_view(contents).substr(contents.size() - 6));
+			}
+
+			THEN("the footer contains the schema and the record batch block")
+			{
+				auto const footer_length(read_le <std::int32_t>(bytes, bytes.size() - 10));
+				auto const footer(bytes.subspan(bytes.size() - 10 - footer_length, footer_length));
+				auto const footer_table(root_table(footer));
+				CHECK(4 == footer_table.scalar <std::int16_t>(0)); // V5
+
+				// Schema.
+				auto const schema_table(footer_table.subtable(1));
+				CHECK(0 == schema_table.scalar <std::int16_t>(0)); // Little endian
+				REQUIRE(2 == schema_table.vector_size(1));
+
+				{
+					auto const field(schema_table.vector_table(1, 0));
+					CHECK("value" == field.string(0));
+					CHECK(1 == field.scalar <std::uint8_t>(1));
+					CHECK(2 == field.scalar <std::uint8_t>(2)); // Int
+					auto const type(field.subtable(3));
+					CHECK(32 == type.scalar <std::int32_t>(0));
+					CHECK(1 == type.scalar <std::uint8_t>(1));
+					CHECK(0 == field.vector_size(5));
+				}
+
+				{
+					auto const field(schema_table.vector_table(1, 1));
+					CHECK("name" == field.string(0));
+					CHECK(5 == field.scalar <std::uint8_t>(2)); // Utf8
+					CHECK(0 == field.vector_size(5));
+				}
+
+				REQUIRE(1 == schema_table.vector_size(2));
+				{
+					auto const kv(schema_table.vector_table(2, 0));
+					CHECK("key" == kv.string(0));
+					CHECK("value" == kv.string(1));
+				}
+
+				// Blocks.
+				CHECK(0 == footer_table.vector_size(2));
+				REQUIRE(1 == footer_table.vector_size(3));
+				auto const block_pos(footer_table.vector_data(3));
+				auto const offset(read_le <std::int64_t>(footer, block_pos));
+				auto const metadata_length(read_le <std::int32_t>(footer, block_pos + 8));
+				auto const body_length(read_le <std::int64_t>(footer, block_pos + 16));
+				CHECK(0 == offset % 8);
+				CHECK(0 == metadata_length % 8);
+				CHECK(std::int64_t(batch.body().size()) == body_length);
+
+				AND_THEN("the record batch message has the expected field nodes and buffers")
+				{
+					REQUIRE(std::size_t(offset + metadata_length + body_length) <= bytes.size());
+					CHECK(0xFFFFFFFF == read_le <std::uint32_t>(bytes, offset));
+					CHECK(metadata_length - 8 == read_le <std::int32_t>(bytes, offset + 4));
+
+					auto const message(bytes.subspan(offset + 8, metadata_length - 8));
+					auto const message_table(root_table(message));
+					CHECK(4 == message_table.scalar <std::int16_t>(0)); // V5
+					CHECK(3 == message_table.scalar <std::uint8_t>(1)); // RecordBatch
+					CHECK(body_length == message_table.scalar <std::int64_t>(3));
+
+					auto const batch_table(message_table.subtable(2));
+					CHECK(3 == batch_table.scalar <std::int64_t>(0));
+
+					// Field nodes.
+					REQUIRE(2 == batch_table.vector_size(1));
+					auto const nodes_pos(batch_table.vector_data(1));
+					CHECK(0 == nodes_pos % 8);
+					CHECK(3 == read_le <std::int64_t>(message, nodes_pos));
+					CHECK(1 == read_le <std::int64_t>(message, nodes_pos + 8));
+					CHECK(3 == read_le <std::int64_t>(message, nodes_pos + 16));
+					CHECK(0 == read_le <std::int64_t>(message, nodes_pos + 24));
+
+					// Buffers: validity and values of the integers, validity (omitted), offsets and data of the strings.
+					expected_buffer const expected_buffers[]{{0, 1}, {8, 12}, {24, 0}, {24, 16}, {40, 5}};
+					REQUIRE(std::size(expected_buffers) == batch_table.vector_size(2));
+					auto const buffers_pos(batch_table.vector_data(2));
+					CHECK(0 == buffers_pos % 8);
+					for (std::size_t i{}; i < std::size(expected_buffers); ++i)
+					{
+						CHECK(expected_buffers[i].offset == read_le <std::int64_t>(message, buffers_pos + 16 * i));
+						CHECK(expected_buffers[i].length == read_le <std::int64_t>(message, buffers_pos + 16 * i + 8));
+					}
+					CHECK(48 == body_length);
+
+					// Body.
+					auto const body(bytes.subspan(offset + metadata_length, body_length));
+					CHECK(0b101 == read_le <std::uint8_t>(body, 0));
+					CHECK(5 == read_le <std::int32_t>(body, 8));
+					CHECK(-3 == read_le <std::int32_t>(body, 16));
+					CHECK(0 == read_le <std::int32_t>(body, 24));
+					CHECK(3 == read_le <std::int32_t>(body, 28));
+					CHECK(3 == read_le <std::int32_t>(body, 32));
+					CHECK(5 == read_le <std::int32_t>(body, 36));
+					CHECK("abcde" == std::string_view(reinterpret_cast <char const *>(body.data() + 40), 5));
+				}
+			}
+		}
+	}
+}
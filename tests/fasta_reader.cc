@@ -3,15 +3,24 @@
  * This code is licensed under MIT license (see LICENSE for details).
  */
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <iterator>
+#include <libbio/bgzf/gzi_index.hh>
 #include <libbio/fasta_reader.hh>
 #include <libbio/file_handle.hh>
 #include <libbio/file_handling.hh>
+#include <libbio/indexed_fasta.hh>
 #include <libbio/mmap_file_handle.hh>
+#include <libbio/sequence_batch_reader.hh>
+#include <libbio/utility/strip_newlines.hh>
 #include <span>
+#include <stdexcept>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace lb	= libbio;
 
@@ -47,6 +56,52 @@ namespace {
 			return true;
 		}
 	};
+
+
+	class newline_stripping_delegate final : public lb::fasta_reader_delegate
+	{
+	public:
+		std::vector <std::string>	identifiers;
+		std::vector <std::string>	sequences;
+		std::stringstream			index;	// In .fai format.
+		std::size_t					chunk_count{};
+		std::size_t					non_uniform_count{};
+
+		bool handle_identifier(lb::fasta_reader_base &reader, std::string_view identifier, std::span <std::string_view const> extra_fields) override
+		{
+			auto &dst(identifiers.emplace_back(identifier));
+			for (auto const &extra : extra_fields)
+			{
+				dst += '\t';
+				dst += extra;
+			}
+			sequences.emplace_back();
+			return true;
+		}
+
+		bool handle_sequence_chunk(lb::fasta_reader_base &reader, std::string_view sv, bool has_newline) override
+		{
+			REQUIRE(!has_newline);
+			if (sequences.empty())
+				sequences.emplace_back();
+			sequences.back() += sv;
+			++chunk_count;
+			return true;
+		}
+
+		bool handle_sequence_end(lb::fasta_reader_base &reader) override
+		{
+			if (!reader.has_uniform_line_lengths())
+			{
+				++non_uniform_count;
+				return true;
+			}
+
+			auto const &entry(reader.index_entry());
+			index << entry.name << '\t' << entry.length << '\t' << entry.offset << '\t' << entry.line_bases << '\t' << entry.line_width << '\n';
+			return true;
+		}
+	};
 }
 
 
@@ -183,3 +238,364 @@ SCENARIO("FASTA files can be parsed", "[fasta_reader]")
 		}
 	}
 }
+
+
+SCENARIO("FASTA files can be parsed without newlines", "[fasta_reader]")
+{
+	auto const blocksize(GENERATE(1, 2, 5, 64, 0));
+
+	GIVEN("A FASTA file with CRLF line endings and an empty sequence")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-indexed.fa"));
+
+		WHEN("the file is parsed")
+		{
+			lb::fasta_reader reader;
+			newline_stripping_delegate cb;
+			reader.set_strips_newlines(true);
+			REQUIRE(lb::fasta_reader::parsing_status::success == reader.parse(handle, cb, blocksize));
+
+			THEN("the sequences match the expected")
+			{
+				CHECK(cb.identifiers == std::vector <std::string>{"s1\tdesc", "s2", "empty", "s3"});
+				CHECK(cb.sequences == std::vector <std::string>{"ACGTACGTACGT", "AAAACC", "", "ACGTT"});
+				CHECK(0 == cb.non_uniform_count);
+				CHECK(12 == reader.line_number());
+			}
+
+			THEN("the index entries match the ones built by samtools faidx")
+			{
+				CHECK(cb.index.str() ==
+					"s1\t12\t9\t5\t6\n"
+					"s2\t6\t28\t4\t5\n"
+					"empty\t0\t43\t0\t0\n"
+					"s3\t5\t48\t3\t5\n"
+				);
+			}
+
+			THEN("the delegate is called once per sequence when the sequences fit into the buffer")
+			{
+				if (0 == blocksize)
+					CHECK(3 == cb.chunk_count);
+			}
+		}
+	}
+
+	GIVEN("A FASTA file with varying line lengths")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-line-lengths.fa"));
+
+		WHEN("the file is parsed")
+		{
+			lb::fasta_reader reader;
+			newline_stripping_delegate cb;
+			reader.set_strips_newlines(true);
+			REQUIRE(lb::fasta_reader::parsing_status::success == reader.parse(handle, cb, blocksize));
+
+			THEN("the line lengths are reported to vary in the first sequence")
+			{
+				CHECK(cb.sequences == std::vector <std::string>{"ACGAACG", "ACACA"});
+				CHECK(1 == cb.non_uniform_count);
+				CHECK(cb.index.str() == "y\t5\t16\t2\t3\n");
+			}
+		}
+	}
+
+	GIVEN("A sequence without a header and without a terminating newline")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-noeol-3.fa"));
+
+		WHEN("the file is parsed")
+		{
+			lb::fasta_reader reader;
+			newline_stripping_delegate cb;
+			reader.set_strips_newlines(true);
+			REQUIRE(lb::fasta_reader::parsing_status::success == reader.parse(handle, cb, blocksize));
+
+			THEN("the sequence matches the expected")
+			{
+				CHECK(cb.identifiers.empty());
+				CHECK(cb.sequences == std::vector <std::string>{"GATTACA"});
+				CHECK(cb.index.str() == "\t7\t0\t7\t7\n");
+			}
+		}
+	}
+
+	GIVEN("A FASTA file with extra header fields")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/extra-fields.fa"));
+
+		WHEN("the file is parsed")
+		{
+			lb::fasta_reader reader;
+			newline_stripping_delegate cb;
+			reader.set_strips_newlines(true);
+			REQUIRE(lb::fasta_reader::parsing_status::success == reader.parse(handle, cb, blocksize));
+
+			THEN("the extra fields are reported")
+			{
+				CHECK(cb.identifiers == std::vector <std::string>{"test1\taa\tbb\tcc", "test2\tdd\tee\tff"});
+				CHECK(cb.sequences == std::vector <std::string>{"GATTACA", "GGTTCC"});
+			}
+		}
+	}
+}
+
+
+SCENARIO("FASTA files can be indexed", "[fasta_reader]")
+{
+	GIVEN("A FASTA file with wrapped lines")
+	{
+		lb::indexed_fasta fasta;
+		fasta.open("test-files/test-indexed.fa");
+
+		WHEN("the index is written")
+		{
+			std::stringstream stream;
+			fasta.index().write(stream);
+
+			THEN("the index matches the one built by samtools faidx")
+			{
+				REQUIRE(stream.str() ==
+					"s1\t12\t9\t5\t6\n"
+					"s2\t6\t28\t4\t5\n"
+					"empty\t0\t43\t0\t0\n"
+					"s3\t5\t48\t3\t5\n"
+				);
+			}
+
+			AND_WHEN("the index is read")
+			{
+				lb::fasta_index index;
+				index.read(stream);
+
+				THEN("the entries match")
+				{
+					REQUIRE(4 == index.size());
+					auto const *entry(index.find("s3"));
+					REQUIRE(entry);
+					CHECK(5 == entry->length);
+					CHECK(48 == entry->offset);
+					CHECK(3 == entry->line_bases);
+					CHECK(5 == entry->line_width);
+				}
+			}
+		}
+
+		WHEN("subsequences are fetched")
+		{
+			std::string seq;
+
+			THEN("the bases are copied without the newlines")
+			{
+				REQUIRE(fasta.subsequence("s1", 0, 12, seq));
+				CHECK("ACGTACGTACGT" == seq);
+				REQUIRE(fasta.subsequence("s1", 3, 8, seq));
+				CHECK("TACGT" == seq);
+				REQUIRE(fasta.subsequence("s1", 10, 100, seq));
+				CHECK("GT" == seq);
+				REQUIRE(fasta.subsequence("s3", 0, 5, seq));
+				CHECK("ACGTT" == seq);
+				REQUIRE(fasta.subsequence("empty", 0, 5, seq));
+				CHECK(seq.empty());
+				CHECK(!fasta.subsequence("s4", 0, 5, seq));
+			}
+
+			THEN("ranges within one line can be accessed without copying")
+			{
+				auto const *entry(fasta.find("s1"));
+				REQUIRE(entry);
+				CHECK("CGTA" == fasta.subsequence_view(*entry, 5, 9));
+				CHECK(fasta.subsequence_view(*entry, 3, 8).empty());
+			}
+		}
+	}
+
+	GIVEN("A FASTA file with varying line lengths")
+	{
+		lb::fasta_index index;
+		THEN("building the index fails")
+		{
+			REQUIRE_THROWS_AS(index.build(">x\nACG\nA\nACG\n"), std::runtime_error);
+		}
+	}
+
+	GIVEN("A sequence without a header")
+	{
+		// Unlike fasta_reader, the index builder needs a name for every sequence.
+		lb::fasta_index index;
+		THEN("building the index fails")
+		{
+			REQUIRE_THROWS_AS(index.build("GATTACA\n>x\nACG\n"), std::runtime_error);
+		}
+	}
+}
+
+
+SCENARIO("Bgzipped FASTA files can be indexed", "[fasta_reader]")
+{
+	GIVEN("A bgzipped FASTA file with small BGZF blocks")
+	{
+		lb::indexed_fasta fasta;
+		fasta.open("test-files/test-indexed.fa.gz");
+		REQUIRE(fasta.is_compressed());
+
+		WHEN("the indices are written")
+		{
+			std::stringstream stream;
+			fasta.index().write(stream);
+
+			THEN("the FASTA index matches the one of the uncompressed file")
+			{
+				REQUIRE(stream.str() ==
+					"s1\t12\t9\t5\t6\n"
+					"s2\t6\t28\t4\t5\n"
+					"empty\t0\t43\t0\t0\n"
+					"s3\t5\t48\t3\t5\n"
+				);
+			}
+
+			AND_WHEN("the GZI index is written and read")
+			{
+				std::stringstream gzi_stream;
+				fasta.gzi_index().write(gzi_stream);
+				lb::bgzf::gzi_index gzi_index;
+				gzi_index.read(gzi_stream);
+
+				THEN("the entries match")
+				{
+					auto const &lhs(fasta.gzi_index().entries());
+					auto const &rhs(gzi_index.entries());
+					REQUIRE(lhs.size() == rhs.size());
+					for (std::size_t i{}; i < lhs.size(); ++i)
+					{
+						CHECK(lhs[i].compressed_offset == rhs[i].compressed_offset);
+						CHECK(lhs[i].uncompressed_offset == rhs[i].uncompressed_offset);
+					}
+				}
+			}
+		}
+
+		WHEN("subsequences are fetched")
+		{
+			std::string seq;
+
+			THEN("the bases are copied from the touched blocks")
+			{
+				REQUIRE(fasta.subsequence("s1", 0, 12, seq));
+				CHECK("ACGTACGTACGT" == seq);
+				REQUIRE(fasta.subsequence("s1", 3, 8, seq));
+				CHECK("TACGT" == seq);
+				REQUIRE(fasta.subsequence("s2", 2, 6, seq));
+				CHECK("AACC" == seq);
+				REQUIRE(fasta.subsequence("s3", 0, 5, seq));
+				CHECK("ACGTT" == seq);
+				REQUIRE(fasta.subsequence("empty", 0, 5, seq));
+				CHECK(seq.empty());
+			}
+
+			THEN("ranges within one line and one block can be accessed without copying")
+			{
+				// The blocks contain seven bytes each.
+				auto const *entry(fasta.find("s3"));
+				REQUIRE(entry);
+				CHECK("CG" == fasta.subsequence_view(*entry, 1, 3));
+				CHECK(fasta.subsequence_view(*entry, 0, 3).empty());
+			}
+		}
+	}
+}
+
+
+SCENARIO("FASTA files can be read in batches", "[fasta_reader]")
+{
+	GIVEN("A FASTA file with CRLF line endings and an empty sequence")
+	{
+		auto const blocksize(GENERATE(1, 2, 5, 64, 0));
+		auto const max_records(GENERATE(1, 3, 64));
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-indexed.fa"));
+
+		WHEN("the records are read in batches")
+		{
+			lb::fasta_batch_reader reader(handle, blocksize);
+			lb::sequence_record_batch batch;
+			std::vector <std::string> identifiers;
+			std::vector <std::string> sequences;
+			while (reader.read_batch(batch, max_records))
+			{
+				REQUIRE(batch.size() <= std::size_t(max_records));
+				for (std::size_t i{}; i < batch.size(); ++i)
+				{
+					CHECK(batch.quality(i).empty());
+					identifiers.emplace_back(batch.identifier(i));
+					sequences.emplace_back(batch.sequence(i));
+				}
+			}
+
+			THEN("the newlines have been removed")
+			{
+				CHECK(identifiers == std::vector <std::string>{"s1 desc", "s2", "empty", "s3"});
+				CHECK(sequences == std::vector <std::string>{"ACGTACGTACGT", "AAAACC", "", "ACGTT"});
+			}
+		}
+	}
+
+	GIVEN("Input without a header")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-parallel.fastq"));
+		lb::fasta_batch_reader reader(handle);
+		lb::sequence_record_batch batch;
+
+		THEN("reading fails")
+		{
+			REQUIRE_THROWS_AS(reader.read_batch(batch), std::runtime_error);
+		}
+	}
+
+	GIVEN("A sequence with long lines")
+	{
+		std::string text;
+		std::string expected;
+		for (std::size_t i{}; i < 100; ++i)
+		{
+			auto const length((i * 37) % 131);
+			for (std::size_t j{}; j < length; ++j)
+			{
+				text += "ACGT"[(i + j) % 4];
+				expected += "ACGT"[(i + j) % 4];
+			}
+			text += (i % 3 ? "\n" : "\r\n");
+		}
+
+		THEN("strip_newlines removes the line endings")
+		{
+			std::string actual;
+			lb::append_without_newlines(text, actual);
+			CHECK(expected == actual);
+		}
+	}
+
+	GIVEN("Inputs of different lengths")
+	{
+		// Covers the boundaries of the vector loop when built with --enable-highway.
+		auto const line_length(GENERATE(1, 2, 7, 15, 16, 17, 31, 32, 33, 64, 65));
+		std::string text;
+		for (std::size_t i{}; i < 300; ++i)
+			text += ((i + 1) % (line_length + 1) ? "ACGTN"[i % 5] : (i % 2 ? '\n' : '\r'));
+
+		THEN("strip_newlines removes the line endings from each prefix")
+		{
+			std::string actual;
+			for (std::size_t length{}; length <= text.size(); ++length)
+			{
+				auto const src(std::string_view(text).substr(0, length));
+				std::string expected;
+				std::copy_if(src.begin(), src.end(), std::back_inserter(expected), [](char const cc){ return '\n' != cc && '\r' != cc; });
+
+				actual.clear();
+				lb::append_without_newlines(src, actual);
+				REQUIRE(expected == actual);
+			}
+		}
+	}
+}
@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <cmath>
+#include <cstddef>
+#include <libbio/bgzf/in_order_reader.hh>
+#include <libbio/decompressing_reading_handle.hh>
+#include <libbio/fastq_qc.hh>
+#include <libbio/fastq_writer.hh>
+#include <libbio/memfd_handle.hh>
+#include <libbio/mmap_file_handle.hh>
+#include <libbio/paired_fastq_reader.hh>
+#include <libbio/parallel_fastq_reader.hh>
+#include <libbio/sequence_batch_reader.hh>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace lb	= libbio;
+
+
+namespace {
+
+	struct record
+	{
+		std::string identifier;
+		std::string sequence;
+		std::string quality;
+
+		record(lb::fastq_record_view const &rec):
+			identifier(rec.identifier),
+			sequence(rec.sequence),
+			quality(rec.quality)
+		{
+		}
+
+		bool operator==(record const &) const = default;
+	};
+
+
+	std::vector <record> parse_sequentially(std::string_view const content)
+	{
+		std::vector <lb::fastq_record_view> records;
+		lb::parallel_fastq_reader::parse_chunk(content, records);
+		return std::vector <record>(records.begin(), records.end());
+	}
+
+
+	std::vector <record> parse_file(char const *path)
+	{
+		lb::mmap_file_handle <char> handle;
+		handle.open(path);
+		return parse_sequentially(handle.to_string_view());
+	}
+
+
+	// Write the contents of the file to a pipe from a separate thread and return the reading end.
+	lb::file_handle open_pipe(char const *path, std::jthread &writer)
+	{
+		int fds[2]{};
+		REQUIRE(0 == ::pipe(fds));
+		writer = std::jthread([path, dst = lb::file_handle(fds[1])] mutable {
+			lb::mmap_file_handle <char> src;
+			src.open(path);
+			auto const sv(src.to_string_view());
+			std::size_t pos{};
+			while (pos < sv.size())
+				pos += dst.write(sv.data() + pos, sv.size() - pos);
+		});
+		return lb::file_handle(fds[0]);
+	}
+
+
+	typedef std::pair <std::vector <record>, std::vector <record>>	record_vector_pair;
+
+
+	record_vector_pair read_pairs(lb::paired_fastq_reader &reader)
+	{
+		record_vector_pair retval;
+		lb::paired_fastq_batch batch;
+		while (reader.next_batch(batch))
+		{
+			REQUIRE(retval.first.size() == batch.first_record_index);
+			REQUIRE(batch.first.records.size() == batch.second.records.size());
+			retval.first.insert(retval.first.end(), batch.first.records.begin(), batch.first.records.end());
+			retval.second.insert(retval.second.end(), batch.second.records.begin(), batch.second.records.end());
+		}
+		return retval;
+	}
+}
+
+
+SCENARIO("FASTQ files can be parsed in parallel", "[fastq_reader]")
+{
+	GIVEN("A FASTQ file with quality lines that begin with @ and +")
+	{
+		lb::mmap_file_handle <char> handle;
+		handle.open("test-files/test-parallel.fastq");
+		auto const content(handle.to_string_view());
+		auto const expected(parse_sequentially(content));
+
+		REQUIRE(5 == expected.size());
+		CHECK("r1 first" == expected[0].identifier);
+		CHECK("ACGTACGT" == expected[0].sequence);
+		CHECK("@@@@IIII" == expected[0].quality);
+		CHECK("+@!I" == expected[1].quality);
+		CHECK("@" == expected[2].quality);
+
+		auto const chunk_size(GENERATE(range(1, 80)));
+
+		WHEN("the file is split into chunks")
+		{
+			lb::parallel_fastq_reader reader(content);
+			reader.set_chunk_size(chunk_size);
+			auto const chunks(reader.make_chunks());
+
+			THEN("each chunk begins with a record")
+			{
+				std::size_t total_size{};
+				std::vector <lb::fastq_record_view> records;
+				for (auto const chunk : chunks)
+				{
+					REQUIRE(chunk.starts_with('@'));
+					REQUIRE_NOTHROW(lb::parallel_fastq_reader::parse_chunk(chunk, records));
+					total_size += chunk.size();
+				}
+				CHECK(content.size() == total_size);
+			}
+		}
+
+		WHEN("the records are parsed in order")
+		{
+			lb::parallel_fastq_reader reader(content);
+			reader.set_chunk_size(chunk_size);
+			reader.set_max_pending_chunks(3);
+
+			std::vector <record> actual;
+			std::size_t expected_chunk_index{};
+			reader.parse_ordered([&](lb::fastq_record_batch const &batch){
+				REQUIRE(expected_chunk_index == batch.chunk_index);
+				REQUIRE(actual.size() == batch.first_record_index);
+				++expected_chunk_index;
+				actual.insert(actual.end(), batch.records.begin(), batch.records.end());
+				return true;
+			});
+
+			THEN("the records match")
+			{
+				CHECK(expected == actual);
+			}
+		}
+
+		WHEN("the records are parsed in arbitrary order")
+		{
+			lb::parallel_fastq_reader reader(content);
+			reader.set_chunk_size(chunk_size);
+
+			std::mutex mutex;
+			std::vector <std::vector <record>> batches(reader.make_chunks().size());
+			reader.parse_unordered([&](lb::fastq_record_batch const &batch){
+				std::lock_guard const lock(mutex);
+				batches.at(batch.chunk_index).assign(batch.records.begin(), batch.records.end());
+				return true;
+			});
+
+			THEN("the records match")
+			{
+				std::vector <record> actual;
+				for (auto const &batch : batches)
+					actual.insert(actual.end(), batch.begin(), batch.end());
+				CHECK(expected == actual);
+			}
+		}
+	}
+
+	GIVEN("A FASTQ record with a length mismatch")
+	{
+		lb::parallel_fastq_reader reader("@r1\nACGT\n+\nIII\n");
+		THEN("parsing fails")
+		{
+			REQUIRE_THROWS_AS(reader.parse_ordered([](auto const &){ return true; }), std::runtime_error);
+		}
+	}
+
+	GIVEN("A FASTQ record with a length mismatch after the first chunk")
+	{
+		lb::parallel_fastq_reader reader("@r1\nACGT\n+\nIIII\n@r2\nACGT\n+\nIIII\n@r3\nACGT\n+\nIII\n");
+		reader.set_chunk_size(1);
+		REQUIRE(2 == reader.make_chunks().size());
+
+		THEN("the line number is counted from the beginning of the content")
+		{
+			REQUIRE_THROWS_WITH(reader.parse_ordered([](auto const &){ return true; }), "Sequence length mismatch at line 9");
+			REQUIRE_THROWS_WITH(reader.parse_unordered([](auto const &){ return true; }), "Sequence length mismatch at line 9");
+		}
+	}
+}
+
+
+SCENARIO("Paired FASTQ files can be read in lockstep", "[fastq_reader]")
+{
+	auto const expected_first(parse_file("test-files/test-paired-1.fastq"));
+	auto const expected_second(parse_file("test-files/test-paired-2.fastq"));
+	REQUIRE(10 == expected_first.size());
+	REQUIRE(10 == expected_second.size());
+
+	auto const batch_size(GENERATE(1, 3, 10, 64));
+
+	GIVEN("Uncompressed inputs")
+	{
+		lb::decompressing_reading_handle first("test-files/test-paired-1.fastq");
+		lb::decompressing_reading_handle second("test-files/test-paired-2.fastq");
+		REQUIRE(lb::decompressing_reading_handle::compression_type::none == first.compression());
+
+		WHEN("the pairs are read")
+		{
+			lb::paired_fastq_reader reader(first, second, batch_size, 2);
+			auto const actual(read_pairs(reader));
+
+			THEN("the records match")
+			{
+				CHECK(expected_first == actual.first);
+				CHECK(expected_second == actual.second);
+			}
+		}
+	}
+
+	GIVEN("BGZF and gzip compressed inputs")
+	{
+		lb::decompressing_reading_handle first("test-files/test-paired-1.fastq.gz");
+		lb::decompressing_reading_handle second("test-files/test-paired-2.fastq.gz");
+		REQUIRE(lb::decompressing_reading_handle::compression_type::bgzf == first.compression());
+		REQUIRE(lb::decompressing_reading_handle::compression_type::gzip == second.compression());
+
+		WHEN("the pairs are read")
+		{
+			lb::paired_fastq_reader reader(first, second, batch_size, 2);
+			auto const actual(read_pairs(reader));
+
+			THEN("the records match")
+			{
+				CHECK(expected_first == actual.first);
+				CHECK(expected_second == actual.second);
+			}
+		}
+	}
+
+	GIVEN("BGZF and gzip compressed inputs from pipes")
+	{
+		std::jthread first_writer;
+		std::jthread second_writer;
+		lb::decompressing_reading_handle first;
+		lb::decompressing_reading_handle second;
+		first.open(open_pipe("test-files/test-paired-1.fastq.gz", first_writer));
+		second.open(open_pipe("test-files/test-paired-2.fastq.gz", second_writer));
+		REQUIRE(lb::decompressing_reading_handle::compression_type::bgzf == first.compression());
+		REQUIRE(lb::decompressing_reading_handle::compression_type::gzip == second.compression());
+
+		WHEN("the pairs are read")
+		{
+			lb::paired_fastq_reader reader(first, second, batch_size, 2);
+			auto const actual(read_pairs(reader));
+
+			THEN("the records match")
+			{
+				CHECK(expected_first == actual.first);
+				CHECK(expected_second == actual.second);
+			}
+		}
+	}
+
+	GIVEN("Inputs with mismatched identifiers")
+	{
+		lb::decompressing_reading_handle first("test-files/test-paired-1.fastq");
+		lb::decompressing_reading_handle second("test-files/test-paired-mismatch.fastq");
+		lb::paired_fastq_reader reader(first, second, batch_size, 2);
+
+		THEN("reading fails")
+		{
+			REQUIRE_THROWS_AS(read_pairs(reader), std::runtime_error);
+		}
+	}
+
+	GIVEN("An input with an invalid record after the first batches")
+	{
+		lb::decompressing_reading_handle first("test-files/test-paired-1.fastq");
+		lb::decompressing_reading_handle second("test-files/test-paired-invalid.fastq");
+		lb::paired_fastq_reader reader(first, second, batch_size, 2);
+
+		THEN("the line number is counted from the beginning of the input")
+		{
+			REQUIRE_THROWS_WITH(read_pairs(reader), "Sequence length mismatch at line 29");
+		}
+	}
+
+	GIVEN("Inputs with different numbers of records")
+	{
+		lb::decompressing_reading_handle first("test-files/test-paired-1.fastq");
+		lb::decompressing_reading_handle second("test-files/test-parallel.fastq");
+		lb::paired_fastq_reader reader(first, second, batch_size, 2);
+		reader.set_validates_identifiers(false);
+
+		THEN("reading fails")
+		{
+			REQUIRE_THROWS_AS(read_pairs(reader), std::runtime_error);
+		}
+	}
+}
+
+
+SCENARIO("FASTQ files can be read in batches", "[fastq_reader]")
+{
+	GIVEN("A FASTQ file")
+	{
+		auto const expected(parse_file("test-files/test-parallel.fastq"));
+		auto const blocksize(GENERATE(1, 7, 64, 0));
+		auto const max_records(GENERATE(1, 2, 64));
+
+		WHEN("the records are read in batches")
+		{
+			lb::decompressing_reading_handle handle("test-files/test-parallel.fastq");
+			lb::fastq_batch_reader reader(handle, blocksize);
+			lb::sequence_record_batch batch;
+			std::vector <record> actual;
+			while (reader.read_batch(batch, max_records))
+			{
+				REQUIRE(batch.size() <= std::size_t(max_records));
+				for (std::size_t i{}; i < batch.size(); ++i)
+					actual.emplace_back(lb::fastq_record_view{batch.identifier(i), batch.sequence(i), batch.quality(i)});
+			}
+
+			THEN("the records match")
+			{
+				CHECK(expected == actual);
+				CHECK(expected.size() == reader.record_count());
+			}
+		}
+	}
+}
+
+
+SCENARIO("FASTQ files can be written with BGZF compression", "[fastq_reader]")
+{
+	GIVEN("FASTQ records")
+	{
+		auto const expected(parse_file("test-files/test-paired-1.fastq"));
+		auto const buffer_size(GENERATE(1, 64, 0));
+
+		WHEN("the records are written")
+		{
+			auto const memfd(lb::open_anonymous_memory_file());
+			lb::file_handle handle(memfd.fd, false);
+
+			{
+				lb::fastq_writer writer(handle, 2);
+				if (buffer_size)
+					writer.set_buffer_size(buffer_size);
+
+				for (auto const &rec : expected)
+					writer.write(rec.identifier, rec.sequence, rec.quality);
+
+				REQUIRE_THROWS_AS(writer.write("r", "ACGT", "III"), std::runtime_error);
+				writer.finish();
+			}
+
+			THEN("the records can be read")
+			{
+				handle.seek(0);
+				lb::bgzf::in_order_reader bgzf_reader(handle);
+				lb::fastq_batch_reader reader(bgzf_reader);
+				lb::sequence_record_batch batch;
+				std::vector <record> actual;
+				while (reader.read_batch(batch))
+				{
+					for (std::size_t i{}; i < batch.size(); ++i)
+						actual.emplace_back(lb::fastq_record_view{batch.identifier(i), batch.sequence(i), batch.quality(i)});
+				}
+
+				CHECK(expected == actual);
+			}
+		}
+	}
+}
+
+
+SCENARIO("FASTQ quality statistics can be collected", "[fastq_reader]")
+{
+	GIVEN("A FASTQ file")
+	{
+		lb::mmap_file_handle <char> handle;
+		handle.open("test-files/test-parallel.fastq");
+		auto const content(handle.to_string_view());
+		auto const records(parse_sequentially(content));
+
+		WHEN("the statistics are collected serially")
+		{
+			lb::fastq_qc_statistics stats;
+			for (auto const &rec : records)
+				stats.update(rec.sequence, rec.quality);
+
+			THEN("the statistics match the expected")
+			{
+				CHECK(5 == stats.read_count());
+				CHECK(27 == stats.base_count());
+				CHECK(10 == stats.gc_count());
+				CHECK(2 == stats.n_count());
+				REQUIRE(8 == stats.max_length());
+
+				auto const length_counts(stats.length_counts());
+				REQUIRE(9 == length_counts.size());
+				CHECK(1 == length_counts[1]);
+				CHECK(1 == length_counts[4]);
+				CHECK(1 == length_counts[6]);
+				CHECK(2 == length_counts[8]);
+
+				auto const first_qualities(stats.position_quality_counts(0));
+				CHECK(3 == first_qualities[31]);
+				CHECK(1 == first_qualities[10]);
+				CHECK(1 == first_qualities[40]);
+
+				auto const n_counts(stats.position_n_counts());
+				CHECK(1 == n_counts[0]);
+				CHECK(1 == n_counts[1]);
+				CHECK(0 == n_counts[2]);
+
+				auto const mean_quality_counts(stats.mean_quality_counts());
+				CHECK(2 == mean_quality_counts[20]);
+				CHECK(1 == mean_quality_counts[31]);
+				CHECK(1 == mean_quality_counts[35]);
+				CHECK(1 == mean_quality_counts[40]);
+				CHECK(std::abs((35.5 + 20.25 + 31.0 + 40.0 + 20.5) / 5 - stats.mean_quality()) < 1e-9);
+
+				auto const gc_counts(stats.gc_percentage_counts());
+				CHECK(2 == gc_counts[0]);
+				CHECK(1 == gc_counts[33]);
+				CHECK(1 == gc_counts[50]);
+				CHECK(1 == gc_counts[100]);
+			}
+
+			AND_WHEN("the statistics are collected in parallel")
+			{
+				auto const chunk_size(GENERATE(1, 16, 1024));
+				lb::parallel_fastq_reader reader(content);
+				reader.set_chunk_size(chunk_size);
+				auto const parallel_stats(lb::collect_fastq_qc_statistics(reader));
+
+				THEN("the statistics match")
+				{
+					CHECK(stats.read_count() == parallel_stats.read_count());
+					CHECK(stats.base_count() == parallel_stats.base_count());
+					CHECK(stats.gc_count() == parallel_stats.gc_count());
+					CHECK(stats.n_count() == parallel_stats.n_count());
+					REQUIRE(stats.max_length() == parallel_stats.max_length());
+					for (std::size_t i{}; i < stats.max_length(); ++i)
+						CHECK(std::ranges::equal(stats.position_quality_counts(i), parallel_stats.position_quality_counts(i)));
+					CHECK(std::ranges::equal(stats.position_n_counts(), parallel_stats.position_n_counts()));
+					CHECK(std::ranges::equal(stats.length_counts(), parallel_stats.length_counts()));
+					CHECK(std::ranges::equal(stats.mean_quality_counts(), parallel_stats.mean_quality_counts()));
+					CHECK(std::ranges::equal(stats.gc_percentage_counts(), parallel_stats.gc_percentage_counts()));
+					CHECK(std::abs(stats.mean_quality() - parallel_stats.mean_quality()) < 1e-9);
+				}
+			}
+		}
+	}
+
+	GIVEN("A record with an invalid quality value")
+	{
+		lb::fastq_qc_statistics stats;
+		THEN("updating fails")
+		{
+			REQUIRE_THROWS_AS(stats.update("ACGT", "II I"), std::runtime_error);
+			REQUIRE_THROWS_AS(stats.update("ACGT", "III"), std::runtime_error);
+		}
+
+		WHEN("the invalid value is at the end of a long record")
+		{
+			stats.update("ACGT", "IIII");
+			std::string const sequence(100, 'A');
+			std::string quality(100, 'I');
+			quality.back() = '\x7f';
+			REQUIRE_THROWS_AS(stats.update(sequence, quality), std::runtime_error);
+
+			THEN("the statistics are not changed")
+			{
+				CHECK(1 == stats.read_count());
+				CHECK(4 == stats.base_count());
+				CHECK(4 == stats.max_length());
+				CHECK(5 == stats.length_counts().size());
+				CHECK(1 == stats.position_quality_counts(0)['I' - lb::fastq_qc_statistics::DEFAULT_QUALITY_OFFSET]);
+			}
+		}
+	}
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <libbio/hash_counter.hh>
+#include <libbio/minimizer.hh>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lb	= libbio;
+
+
+namespace {
+
+	typedef std::pair <std::uint64_t, std::uint64_t>	position_value_pair;
+	typedef std::vector <position_value_pair>			position_value_vector;
+
+
+	std::string random_sequence(std::mt19937 &rng, std::size_t const length)
+	{
+		std::string_view const characters("ACGTACGTACGTacgtN");
+		std::uniform_int_distribution <std::size_t> dist(0, characters.size() - 1);
+		std::string retval(length, 0);
+		for (auto &cc : retval)
+			cc = characters[dist(rng)];
+		return retval;
+	}
+
+
+	position_value_vector kmers_naive(std::string_view const seq, std::size_t const k)
+	{
+		position_value_vector retval;
+		for (std::size_t i{}; i + k <= seq.size(); ++i)
+		{
+			std::uint64_t forward{};
+			std::uint64_t reverse{};
+			bool is_valid{true};
+			for (std::size_t j{}; j < k; ++j)
+			{
+				auto const code(lb::detail::DNA_CODES[std::uint8_t(seq[i + j])]);
+				auto const rc_code(lb::detail::DNA_CODES[std::uint8_t(seq[i + k - j - 1])]);
+				if (lb::detail::DNA_CODE_INVALID == code)
+				{
+					is_valid = false;
+					break;
+				}
+				forward = (forward << 2) | code;
+				reverse = (reverse << 2) | (3 - rc_code);
+			}
+
+			if (is_valid)
+				retval.emplace_back(i, std::min(forward, reverse));
+		}
+		return retval;
+	}
+
+
+	position_value_vector minimizers_naive(std::string_view const seq, std::size_t const w, std::size_t const k)
+	{
+		auto const mask(k == 32 ? UINT64_MAX : (std::uint64_t(1) << (2 * k)) - 1);
+		auto kmers(kmers_naive(seq, k));
+		for (auto &kmer : kmers)
+			kmer.second = lb::kmer_hash(kmer.second, mask);
+
+		// Windows of w consecutive k-mers.
+		position_value_vector retval;
+		for (std::size_t i{}; i + w <= kmers.size(); ++i)
+		{
+			if (kmers[i].first + w - 1 != kmers[i + w - 1].first)
+				continue;
+
+			auto const it(std::min_element(kmers.begin() + i, kmers.begin() + i + w, [](auto const &lhs, auto const &rhs){
+				return lhs.second < rhs.second;
+			}));
+			if (retval.empty() || retval.back().first != it->first)
+				retval.emplace_back(*it);
+		}
+		return retval;
+	}
+
+
+	template <typename t_extractor>
+	position_value_vector extract_in_chunks(t_extractor &extractor, std::string_view seq, std::size_t const chunk_size)
+	{
+		position_value_vector retval;
+		extractor.reset();
+		while (!seq.empty())
+		{
+			auto const chunk(seq.substr(0, chunk_size));
+			extractor.update(chunk, [&](std::uint64_t const pos, std::uint64_t const value){ retval.emplace_back(pos, value); });
+			seq.remove_prefix(chunk.size());
+		}
+		return retval;
+	}
+}
+
+
+SCENARIO("Canonical k-mers can be extracted", "[minimizer]")
+{
+	GIVEN("A random sequence")
+	{
+		std::mt19937 rng(1);
+		auto const seq(random_sequence(rng, 500));
+		auto const k(GENERATE(1, 2, 5, 16, 31, 32));
+		auto const chunk_size(GENERATE(1, 7, 1000));
+
+		WHEN("the k-mers are extracted in chunks")
+		{
+			lb::kmer_extractor extractor(k);
+			auto const actual(extract_in_chunks(extractor, seq, chunk_size));
+
+			THEN("the k-mers match")
+			{
+				CHECK(kmers_naive(seq, k) == actual);
+			}
+		}
+	}
+
+	GIVEN("A sequence and its reverse complement")
+	{
+		lb::kmer_extractor extractor(5);
+		position_value_vector lhs, rhs;
+		extractor.extract("AACGTTTGCA", [&](auto const pos, auto const kmer){ lhs.emplace_back(pos, kmer); });
+		extractor.extract("TGCAAACGTT", [&](auto const pos, auto const kmer){ rhs.emplace_back(pos, kmer); });
+
+		THEN("the canonical k-mers match in reverse order")
+		{
+			REQUIRE(lhs.size() == rhs.size());
+			for (std::size_t i{}; i < lhs.size(); ++i)
+				CHECK(lhs[i].second == rhs[rhs.size() - i - 1].second);
+		}
+	}
+}
+
+
+SCENARIO("Minimizers can be extracted", "[minimizer]")
+{
+	GIVEN("A random sequence")
+	{
+		std::mt19937 rng(2);
+		auto const seq(random_sequence(rng, 2000));
+		auto const wk(GENERATE(
+			std::make_pair(1, 3),
+			std::make_pair(4, 5),
+			std::make_pair(5, 3),
+			std::make_pair(10, 15),
+			std::make_pair(16, 21),
+			std::make_pair(3, 32)
+		));
+		auto const chunk_size(GENERATE(1, 13, 5000));
+
+		WHEN("the minimizers are extracted in chunks")
+		{
+			lb::minimizer_extractor extractor(wk.first, wk.second);
+			auto const actual(extract_in_chunks(extractor, seq, chunk_size));
+
+			THEN("the minimizers match")
+			{
+				CHECK(minimizers_naive(seq, wk.first, wk.second) == actual);
+			}
+		}
+	}
+}
+
+
+SCENARIO("Hashes can be counted in parallel", "[minimizer]")
+{
+	GIVEN("K-mers extracted in multiple threads")
+	{
+		constexpr std::size_t const thread_count{4};
+		constexpr std::uint8_t const k{6};
+		auto const partition_bits(GENERATE(1, 4, 12));
+		auto const buffer_capacity(GENERATE(1, 100, 100000));
+
+		std::vector <std::string> sequences;
+		std::map <std::uint64_t, std::uint64_t> expected;
+		{
+			std::mt19937 rng(3);
+			for (std::size_t i{}; i < thread_count; ++i)
+			{
+				auto const &seq(sequences.emplace_back(random_sequence(rng, 5000)));
+				for (auto const &kmer : kmers_naive(seq, k))
+					++expected[kmer.second];
+			}
+		}
+
+		WHEN("the k-mers are counted")
+		{
+			lb::hash_counter counter(2 * k, partition_bits);
+			std::vector <std::thread> threads;
+			for (auto const &seq : sequences)
+			{
+				threads.emplace_back([&counter, &seq, buffer_capacity]{
+					lb::hash_buffer buffer(counter, buffer_capacity);
+					lb::kmer_extractor extractor(k);
+					extractor.extract(seq, [&](auto const, auto const kmer){ buffer.push_back(kmer); });
+					buffer.flush();
+				});
+			}
+
+			for (auto &thread : threads)
+				thread.join();
+
+			auto const actual(counter.count());
+
+			THEN("the counts match and are sorted by the hash value")
+			{
+				std::vector <lb::hash_count> expected_(expected.size());
+				std::transform(expected.begin(), expected.end(), expected_.begin(), [](auto const &kv){ return lb::hash_count{kv.first, kv.second}; });
+				CHECK(expected_ == actual);
+			}
+
+			AND_THEN("the counter is empty afterwards")
+			{
+				CHECK(counter.count().empty());
+			}
+		}
+	}
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cereal/archives/binary.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libbio/file_handle.hh>
+#include <libbio/file_handling.hh>
+#include <libbio/packed_sequence_store.hh>
+#include <libbio/packed_sequence_store/cereal_serialization.hh>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lb	= libbio;
+
+
+namespace {
+
+	struct expected_contig
+	{
+		std::string_view	name;
+		std::string_view	sequence;
+	};
+
+
+	constexpr expected_contig const EXPECTED_CONTIGS[]{
+		{"chr1", "ACGTNNNNacgtnnRYacgtACGTACGTACGTACGTACGTACGTACGTACGTACGTAC"},
+		{"chr2", "nnnnACGTAC"},
+		{"chr3", "TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTgcatgcatMKWS*-ACGT"}
+	};
+
+
+	std::string to_upper(std::string_view const sv)
+	{
+		std::string retval(sv);
+		std::transform(retval.begin(), retval.end(), retval.begin(), [](char const cc){ return ('a' <= cc && cc <= 'z') ? cc & ~0x20 : cc; });
+		return retval;
+	}
+
+
+	void check_view(lb::packed_sequence_view const &view)
+	{
+		REQUIRE(std::size(EXPECTED_CONTIGS) == view.contig_count());
+		for (std::size_t i{}; i < view.contig_count(); ++i)
+		{
+			auto const &expected(EXPECTED_CONTIGS[i]);
+			auto const *contig(view.find(expected.name));
+			REQUIRE(contig);
+			CHECK(expected.name == view.name(*contig));
+			REQUIRE(expected.sequence.size() == contig->length);
+
+			// Check all the subranges.
+			std::string seq;
+			for (std::size_t start{}; start <= contig->length; ++start)
+			{
+				for (auto end(start); end <= contig->length; ++end)
+				{
+					auto const expected_seq(expected.sequence.substr(start, end - start));
+					view.extract(*contig, start, end, seq);
+					REQUIRE(expected_seq == seq);
+					view.extract(*contig, start, end, seq, false);
+					REQUIRE(to_upper(expected_seq) == seq);
+				}
+			}
+		}
+	}
+}
+
+
+SCENARIO("Packed sequence store can be loaded from FASTA", "[packed_sequence_store]")
+{
+	GIVEN("A FASTA file with ambiguous and soft-masked characters")
+	{
+		lb::file_handle handle(lb::open_file_for_reading("test-files/test-packed.fa"));
+		lb::packed_sequence_store store;
+		store.load_fasta(handle);
+
+		THEN("the bases are stored with two bits each")
+		{
+			CHECK(2 == store.bases().element_bits());
+		}
+
+		THEN("the sequences can be extracted")
+		{
+			check_view(store.view());
+		}
+
+		THEN("the sequences can be compared to REF strings")
+		{
+			auto const view(store.view());
+			auto const *contig(view.find("chr1"));
+			REQUIRE(contig);
+			CHECK(view.compare(*contig, 0, "ACGTNN"));
+			CHECK(view.compare(*contig, 8, "ACGTNNRY"));
+			CHECK(view.compare(*contig, 8, "acgtnnry"));
+			CHECK(!view.compare(*contig, 8, "ACGTNNRR"));
+			CHECK(!view.compare(*contig, 4, "A"));
+			CHECK(view.compare(*contig, contig->length, ""));
+			CHECK(!view.compare(*contig, contig->length - 1, "CA"));
+			CHECK(!view.compare(*contig, contig->length + 1, ""));
+
+			std::string long_ref(300, 'T');
+			auto const *chr3(view.find("chr3"));
+			REQUIRE(chr3);
+			CHECK(view.compare(*chr3, 0, std::string_view(long_ref).substr(0, 43)));
+			CHECK(!view.compare(*chr3, 0, long_ref));
+		}
+
+		WHEN("the store is written in the mappable format")
+		{
+			std::stringstream stream;
+			store.write_mappable(stream);
+			auto const str(stream.str());
+
+			// Align the buffer as mmap would.
+			std::vector <std::uint64_t> buffer((str.size() + 7) / 8);
+			std::memcpy(buffer.data(), str.data(), str.size());
+			std::span const bytes(reinterpret_cast <std::byte const *>(buffer.data()), str.size());
+
+			THEN("the sequences can be extracted from the buffer")
+			{
+				check_view(lb::packed_sequence_view::from_mappable(bytes));
+			}
+
+			THEN("truncated buffers are rejected")
+			{
+				REQUIRE_THROWS_AS(lb::packed_sequence_view::from_mappable(bytes.first(bytes.size() - 8)), std::runtime_error);
+				REQUIRE_THROWS_AS(lb::packed_sequence_view::from_mappable(bytes.first(16)), std::runtime_error);
+			}
+
+			THEN("buffers with a different byte order or version are rejected")
+			{
+				// The byte order mark and the version follow the eight-byte magic string.
+				auto const check_modified([&](std::size_t const offset){
+					auto modified(buffer);
+					auto *modified_bytes(reinterpret_cast <std::byte *>(modified.data()));
+					std::reverse(modified_bytes + offset, modified_bytes + offset + 4);
+					std::span const modified_span(modified_bytes, str.size());
+					REQUIRE_THROWS_AS(lb::packed_sequence_view::from_mappable(modified_span), std::runtime_error);
+				});
+
+				check_modified(8);
+				check_modified(12);
+			}
+		}
+
+		WHEN("the store is serialized with cereal")
+		{
+			std::stringstream stream;
+			{
+				cereal::BinaryOutputArchive archive(stream);
+				archive(store);
+			}
+
+			THEN("the loaded store matches the original")
+			{
+				lb::packed_sequence_store loaded;
+				{
+					cereal::BinaryInputArchive archive(stream);
+					archive(loaded);
+				}
+
+				CHECK(loaded.bases() == store.bases());
+				check_view(loaded.view());
+
+				auto const expected_view(store.view());
+				auto const actual_view(loaded.view());
+				REQUIRE(expected_view.contig_count() == actual_view.contig_count());
+				for (std::size_t i{}; i < actual_view.contig_count(); ++i)
+				{
+					auto const &expected(expected_view.contig(i));
+					auto const &actual(actual_view.contig(i));
+					CHECK(0 == std::memcmp(&expected, &actual, sizeof(lb::packed_sequence_contig)));
+				}
+			}
+
+			THEN("archives with a different version are rejected")
+			{
+				// The binary archive writes the class version before the first instance.
+				auto str(stream.str());
+				std::uint32_t version{};
+				REQUIRE(sizeof(version) <= str.size());
+				std::memcpy(&version, str.data(), sizeof(version));
+				CHECK(lb::packed_sequence_store::SERIALIZATION_VERSION == version);
+
+				++version;
+				std::memcpy(str.data(), &version, sizeof(version));
+				std::istringstream modified(str);
+				cereal::BinaryInputArchive archive(modified);
+				lb::packed_sequence_store loaded;
+				REQUIRE_THROWS_AS(archive(loaded), std::runtime_error);
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <libbio/sam/cigar.hh>
+#include <libbio/sam/literals.hh>
+#include <vector>
+
+namespace sam	= libbio::sam;
+
+using sam::operator ""_cigar_operation;
+
+
+SCENARIO("sam::alignment_geometry can be calculated from CIGAR runs", "[sam_alignment_geometry]")
+{
+	GIVEN("a CIGAR with clipping and indels")
+	{
+		// 2H3S10M2I5M3D4M1N6=1X4S
+		std::vector <sam::cigar_run> const runs{
+			{'H'_cigar_operation, 2},
+			{'S'_cigar_operation, 3},
+			{'M'_cigar_operation, 10},
+			{'I'_cigar_operation, 2},
+			{'M'_cigar_operation, 5},
+			{'D'_cigar_operation, 3},
+			{'M'_cigar_operation, 4},
+			{'N'_cigar_operation, 1},
+			{'='_cigar_operation, 6},
+			{'X'_cigar_operation, 1},
+			{'S'_cigar_operation, 4}
+		};
+
+		WHEN("the geometry is calculated")
+		{
+			sam::alignment_geometry geometry;
+			geometry.assign(runs);
+
+			THEN("the lengths and counts are correct")
+			{
+				CHECK(30 == geometry.reference_length);
+				CHECK(35 == geometry.query_length);
+				CHECK(28 == geometry.aligned_query_length());
+				CHECK(3 == geometry.leading_soft_clip_length);
+				CHECK(4 == geometry.trailing_soft_clip_length);
+				CHECK(2 == geometry.leading_hard_clip_length);
+				CHECK(0 == geometry.trailing_hard_clip_length);
+				CHECK(1 == geometry.insertion_count);
+				CHECK(2 == geometry.inserted_bases);
+				CHECK(1 == geometry.deletion_count);
+				CHECK(3 == geometry.deleted_bases);
+			}
+		}
+	}
+}
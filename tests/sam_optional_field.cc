@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Tuukka Norri
+ * This code is licensed under MIT license (see LICENSE for details).
+ */
+
+#if !(defined(LIBBIO_NO_SAM_READER) && LIBBIO_NO_SAM_READER)
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <libbio/sam.hh>
+#include <string>
+#include <utility>
+
+namespace lb	= libbio;
+namespace sam	= libbio::sam;
+
+using sam::operator ""_tag;
+
+
+namespace {
+
+	sam::optional_field make_optional_field()
+	{
+		// Note that the tags are not in sorted order.
+		sam::optional_field::value_tuple_type values;
+		std::get <sam::optional_field::container_of_t <std::int32_t>>(values) = {5, 12};
+		std::get <sam::optional_field::container_of_t <std::string>>(values).emplace_back("10A5^AC6");
+		std::get <sam::optional_field::container_of_t <char>>(values) = {'x'};
+
+		constexpr auto const int32_idx{lb::tuples::first_index_of_v <sam::optional_field::value_tuple_type, sam::optional_field::container_of_t <std::int32_t>>};
+		constexpr auto const string_idx{lb::tuples::first_index_of_v <sam::optional_field::value_tuple_type, sam::optional_field::container_of_t <std::string>>};
+		constexpr auto const char_idx{lb::tuples::first_index_of_v <sam::optional_field::value_tuple_type, sam::optional_field::container_of_t <char>>};
+
+		sam::optional_field::tag_rank_vector tag_ranks{
+			{"NM"_tag, int32_idx, 0},
+			{"MD"_tag, string_idx, 0},
+			{"AS"_tag, int32_idx, 1},
+			{"XA"_tag, char_idx, 0}
+		};
+
+		return sam::optional_field(std::move(tag_ranks), std::move(values));
+	}
+}
+
+
+SCENARIO("sam::optional_field can look up values by tag", "[sam_optional_field]")
+{
+	GIVEN("an optional_field with some values")
+	{
+		auto const of(make_optional_field());
+
+		WHEN("the values are retrieved one by one")
+		{
+			THEN("the correct values are found")
+			{
+				auto const nm(of.get <std::int32_t>("NM"_tag));
+				REQUIRE(nm);
+				CHECK(5 == nm->get());
+
+				auto const as(of.get <"AS"_tag>());
+				REQUIRE(as);
+				CHECK(12 == as->get());
+
+				auto const md(of.get <std::string>("MD"_tag));
+				REQUIRE(md);
+				CHECK("10A5^AC6" == md->get());
+
+				CHECK(of.contains("XA"_tag));
+				CHECK(!of.contains("OA"_tag));
+			}
+
+			THEN("missing values and type mismatches are reported")
+			{
+				auto const oa(of.get <std::string>("OA"_tag));
+				REQUIRE(!oa);
+				CHECK(sam::optional_field::get_value_error::not_found == oa.error());
+
+				auto const md(of.get <std::int32_t>("MD"_tag));
+				REQUIRE(!md);
+				CHECK(sam::optional_field::get_value_error::type_mismatch == md.error());
+			}
+		}
+
+		WHEN("a set of values is retrieved at once")
+		{
+			auto const [nm, md, oa] = of.get_all <std::int32_t, std::string, std::string>({"NM"_tag, "MD"_tag, "OA"_tag});
+
+			THEN("the correct values are found")
+			{
+				REQUIRE(nm);
+				CHECK(5 == nm->get());
+				REQUIRE(md);
+				CHECK("10A5^AC6" == md->get());
+				CHECK(!oa);
+			}
+		}
+	}
+
+	GIVEN("an optional_field that is modified")
+	{
+		auto of(make_optional_field());
+
+		WHEN("values are added and removed")
+		{
+			of.obtain <std::int32_t>("XB"_tag) = 7;
+			of.erase_if([](auto const &tr){ return "NM"_tag == tr.tag_id; });
+
+			THEN("the lookups reflect the changes")
+			{
+				auto const [as, nm, as_] = of.get_all <"AS"_tag, "NM"_tag, "AS"_tag>();
+				REQUIRE(as);
+				CHECK(12 == as->get());
+				CHECK(!nm);
+				CHECK(as_);
+
+				auto const xb_(of.get <std::int32_t>("XB"_tag));
+				REQUIRE(xb_);
+				CHECK(7 == xb_->get());
+			}
+		}
+	}
+
+	GIVEN("an empty optional_field")
+	{
+		sam::optional_field of;
+
+		THEN("the lookups fail")
+		{
+			CHECK(!of.contains("NM"_tag));
+			of.clear();
+			CHECK(!of.contains("NM"_tag));
+			CHECK(!of.get <std::int32_t>("NM"_tag));
+		}
+	}
+}
+
+#endif
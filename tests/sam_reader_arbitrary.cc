@@ -643,6 +643,14 @@ TEST_CASE(
 					auto const &[input_rec, parsed_rec] = tup;
 					if (!sam::is_equal_(input.header, parsed_header, input_rec, parsed_rec))
 						non_matching.emplace_back(idx);
+					else
+					{
+						// The parser should have calculated the alignment geometry.
+						sam::alignment_geometry expected_geometry;
+						expected_geometry.assign(input_rec.cigar);
+						if (expected_geometry != parsed_rec.geometry)
+							non_matching.emplace_back(idx);
+					}
 				}
 
 				if (!non_matching.empty())
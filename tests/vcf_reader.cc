@@ -8,9 +8,23 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/generators/catch_generators_range.hpp>
+#include <libbio/dispatch.hh>
+#include <libbio/vcf/bcf_input.hh>
+#include <libbio/vcf/bcf_variant_printer.hh>
+#include <libbio/vcf/columnar_writer.hh>
+#include <libbio/vcf/frozen_variant.hh>
+#include <libbio/vcf/genotype_matrix.hh>
+#include <libbio/vcf/indexed_region_parser.hh>
+#include <libbio/vcf/input_file.hh>
+#include <libbio/vcf/offset_index.hh>
+#include <libbio/vcf/parallel_reader.hh>
+#include <libbio/vcf/parallel_variant_printer.hh>
+#include <libbio/vcf/parse_error.hh>
+#include <libbio/vcf/variant_merger.hh>
 #include <libbio/vcf/variant_printer.hh>
 #include <libbio/vcf/vcf_reader.hh>
 #include <map>
+#include <mutex>
 #include <range/v3/all.hpp>
 #include <set>
 #include <string>
@@ -1279,3 +1293,1019 @@ SCENARIO("Copying persistent variants works even if the format has changed", "[v
 		}
 	}
 }
+
+
+SCENARIO("The VCF reader can skip unselected samples", "[vcf_reader]")
+{
+	GIVEN("a VCF file with multiple samples")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-samples.vcf");
+		vcf::reader reader(input);
+		vcf::add_reserved_info_keys(reader.info_fields());
+		vcf::add_reserved_genotype_keys(reader.genotype_fields());
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("only the second sample is parsed")
+		{
+			reader.set_parsed_samples({2});
+			
+			std::vector <std::uint16_t> parsed_alts;
+			std::vector <std::string> skipped_columns;
+			std::vector <std::uint16_t> lazily_parsed_alts;
+			reader.parse([&reader, &parsed_alts, &skipped_columns, &lazily_parsed_alts](vcf::transient_variant const &var){
+				auto const &gt_field(dynamic_cast <vcf::genotype_field_gt const &>(*reader.genotype_fields().find("GT")->second));
+				auto const &samples(var.samples());
+				REQUIRE(samples.size() == 4);
+				
+				CHECK(!reader.is_parsed_sample(0));
+				CHECK(reader.is_parsed_sample(1));
+				CHECK(!gt_field.has_value(samples[0]));
+				CHECK(!gt_field.has_value(samples[2]));
+				CHECK(!gt_field.has_value(samples[3]));
+				
+				REQUIRE(gt_field.has_value(samples[1]));
+				for (auto const &gt : gt_field(samples[1]))
+					parsed_alts.push_back(gt.alt);
+				
+				for (auto const idx : {0, 2, 3})
+					skipped_columns.emplace_back(reader.skipped_sample_column(idx));
+				
+				reader.parse_skipped_sample(3);
+				REQUIRE(gt_field.has_value(samples[3]));
+				for (auto const &gt : gt_field(samples[3]))
+					lazily_parsed_alts.push_back(gt.alt);
+				
+				return true;
+			});
+			
+			THEN("the selected sample was parsed")
+			{
+				CHECK(parsed_alts == std::vector <std::uint16_t>{1, 1, 0, 1});
+			}
+			
+			THEN("the other sample columns are available")
+			{
+				CHECK(skipped_columns == std::vector <std::string>{"0|1:5", "0|0:7", "1|0:8", "1|0:9", "1|1:11", "0|0:12"});
+			}
+			
+			THEN("the skipped samples can be parsed on demand")
+			{
+				CHECK(lazily_parsed_alts == std::vector <std::uint16_t>{1, 0, 0, 0});
+			}
+		}
+	}
+
+	GIVEN("a VCF file that ends in the middle of a skipped sample column")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-samples-truncated.vcf");
+		vcf::reader reader(input);
+		vcf::add_reserved_info_keys(reader.info_fields());
+		vcf::add_reserved_genotype_keys(reader.genotype_fields());
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		reader.set_parsed_samples({2});
+
+		THEN("parsing fails with a parse error")
+		{
+			REQUIRE_THROWS_AS(reader.parse([](vcf::transient_variant const &){ return true; }), vcf::parse_error);
+		}
+	}
+}
+
+
+SCENARIO("The VCF reader can assign contig indices to records", "[vcf_reader]")
+{
+	GIVEN("a VCF file with ##contig lines")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-contigs.vcf");
+		vcf::reader reader(input);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		THEN("the declared contigs are indexed in header order")
+		{
+			auto const &contigs(reader.contigs());
+			CHECK(contigs.names() == std::vector <std::string>{"chrB", "chrA"});
+			CHECK(0 == contigs.find("chrB"));
+			CHECK(1 == contigs.find("chrA"));
+			CHECK(vcf::contig_table::INVALID_INDEX == contigs.find("chrC"));
+		}
+		
+		WHEN("the records are parsed")
+		{
+			std::vector <vcf::contig_table::contig_index_type> indices;
+			reader.parse([&indices](vcf::transient_variant const &var){
+				indices.push_back(var.contig_index());
+				vcf::variant const copy(var);
+				CHECK(copy.contig_index() == var.contig_index());
+				return true;
+			});
+			
+			THEN("the records have the contig indices and the undeclared contig was added")
+			{
+				CHECK(indices == std::vector <vcf::contig_table::contig_index_type>{0, 0, 1, 2});
+				CHECK(reader.contigs().names() == std::vector <std::string>{"chrB", "chrA", "chrC"});
+				CHECK("chrC" == reader.contigs().name(2));
+			}
+		}
+	}
+}
+
+
+SCENARIO("Genotypes can be collected into a matrix", "[vcf_reader]")
+{
+	GIVEN("a VCF file with multiple samples")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-samples.vcf");
+		
+		// Haplotypes in rows, variants in columns.
+		std::vector <std::vector <std::uint16_t>> const expected_alleles{
+			{0, 1, 1, 1, 0, 0, 1, 0},
+			{1, 0, 0, 1, 1, 1, 0, 0}
+		};
+		
+		auto const check_matrix([&expected_alleles](vcf::genotype_matrix const &matrix){
+			REQUIRE(matrix.variant_count() == expected_alleles.size());
+			REQUIRE(matrix.haplotype_count() == 8);
+			for (std::size_t var_idx{}; var_idx < expected_alleles.size(); ++var_idx)
+			{
+				for (std::size_t hap_idx{}; hap_idx < 8; ++hap_idx)
+				{
+					CHECK(matrix.allele(var_idx, hap_idx) == expected_alleles[var_idx][hap_idx]);
+					CHECK(!matrix.is_missing(var_idx, hap_idx));
+					CHECK(matrix.is_phased(var_idx, hap_idx) == (1 == hap_idx % 2));
+				}
+			}
+		});
+		
+		WHEN("the records are parsed serially")
+		{
+			vcf::reader reader(input);
+			vcf::add_reserved_info_keys(reader.info_fields());
+			vcf::add_reserved_genotype_keys(reader.genotype_fields());
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+			
+			vcf::genotype_matrix_builder builder(reader.sample_count());
+			reader.parse([&builder](vcf::transient_variant const &var){
+				builder.add_variant(var);
+				return true;
+			});
+			
+			THEN("the matrix contains the genotypes")
+			{
+				check_matrix(builder.finish());
+			}
+		}
+		
+		WHEN("the records are parsed in parallel")
+		{
+			lb::dispatch::thread_pool thread_pool;
+			lb::dispatch::parallel_queue queue(thread_pool);
+			
+			vcf::parallel_reader reader(input, [](vcf::reader &chunk_reader){
+				vcf::add_reserved_info_keys(chunk_reader.info_fields());
+				vcf::add_reserved_genotype_keys(chunk_reader.genotype_fields());
+			});
+			reader.set_chunk_size(1);
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+			
+			auto const matrix(vcf::build_genotype_matrix(reader, 2, queue));
+			
+			THEN("the matrix contains the genotypes in file order")
+			{
+				check_matrix(matrix);
+			}
+		}
+	}
+	
+	GIVEN("a VCF file with a multiallelic variant")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-gt-only.vcf");
+		
+		lb::dispatch::thread_pool thread_pool;
+		lb::dispatch::parallel_queue queue(thread_pool);
+		
+		vcf::parallel_reader reader(input, [](vcf::reader &chunk_reader){
+			vcf::add_reserved_info_keys(chunk_reader.info_fields());
+			vcf::add_reserved_genotype_keys(chunk_reader.genotype_fields());
+		});
+		reader.set_chunk_size(1);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the matrix is built")
+		{
+			auto const matrix(vcf::build_genotype_matrix(reader, 2, queue));
+			
+			THEN("only the multiallelic variant is stored with a wider type")
+			{
+				std::vector <std::vector <std::uint16_t>> const expected_alleles{
+					{0, 1, 1, 0, 0, 0, 1, 1},
+					{2, 0, 1, 0, 0, 2, 0, 1},
+					{1, 0, 0, 0, 0, 1, 1, 0}
+				};
+				std::vector <std::vector <bool>> const expected_missing{
+					{false, false, false, false, true, true, false, false},
+					{false, false, false, true, false, false, true, false},
+					{false, false, false, false, false, false, false, true}
+				};
+				
+				REQUIRE(matrix.variant_count() == 3);
+				REQUIRE(matrix.haplotype_count() == 8);
+				REQUIRE(matrix.multiallelic_columns.size() == 1);
+				CHECK(matrix.multiallelic_columns.front().variant_idx == 1);
+				CHECK(matrix.multiallelic_columns.front().alleles.element_bits() == 2);
+				CHECK(nullptr == matrix.find_multiallelic_column(0));
+				CHECK(nullptr == matrix.find_multiallelic_column(2));
+				
+				for (std::size_t var_idx{}; var_idx < 3; ++var_idx)
+				{
+					for (std::size_t hap_idx{}; hap_idx < 8; ++hap_idx)
+					{
+						CHECK(matrix.allele(var_idx, hap_idx) == expected_alleles[var_idx][hap_idx]);
+						CHECK(matrix.is_missing(var_idx, hap_idx) == expected_missing[var_idx][hap_idx]);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+SCENARIO("The VCF reader can parse GT-only sample columns", "[vcf_reader]")
+{
+	GIVEN("a VCF file with GT as the only genotype field")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-gt-only.vcf");
+		vcf::reader reader(input);
+		vcf::add_reserved_info_keys(reader.info_fields());
+		vcf::add_reserved_genotype_keys(reader.genotype_fields());
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the records are parsed")
+		{
+			// Diploid columns with single-character alleles use the fast path, the others the generic parser.
+			std::vector <std::string> genotypes;
+			reader.parse([&reader, &genotypes](vcf::transient_variant const &var){
+				auto const &gt_field(dynamic_cast <vcf::genotype_field_gt const &>(*reader.genotype_fields().find("GT")->second));
+				for (auto const &sample : var.samples())
+				{
+					REQUIRE(gt_field.has_value(sample));
+					std::string gt_str;
+					for (auto const &gt : gt_field(sample))
+					{
+						if (!gt_str.empty())
+							gt_str += (gt.is_phased ? '|' : '/');
+						if (vcf::sample_genotype::NULL_ALLELE == gt.alt)
+							gt_str += '.';
+						else
+							gt_str += std::to_string(gt.alt);
+					}
+					genotypes.emplace_back(std::move(gt_str));
+				}
+				return true;
+			});
+			
+			THEN("the genotypes match the sample columns")
+			{
+				CHECK(genotypes == std::vector <std::string>{
+					"0|1", "1/0", "./.", "1|1",
+					"2|0", "1", "0/2", ".|1",
+					"1|0", "0|0", "0/1", "1"
+				});
+			}
+		}
+	}
+}
+
+
+SCENARIO("Variants can be copied to an arena", "[vcf_reader]")
+{
+	GIVEN("a VCF file with multiple samples")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-samples.vcf");
+		vcf::reader reader(input);
+		vcf::add_reserved_info_keys(reader.info_fields());
+		vcf::add_reserved_genotype_keys(reader.genotype_fields());
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the records are frozen")
+		{
+			vcf::frozen_variant_buffer buffer(64); // Small blocks to test allocating more.
+			std::vector <vcf::frozen_variant> frozen_variants;
+			std::vector <vcf::variant> variants;
+			std::vector <std::string> expected_records;
+			reader.parse([&reader, &buffer, &frozen_variants, &variants, &expected_records](vcf::transient_variant const &var){
+				frozen_variants.push_back(buffer.freeze(var));
+				variants.emplace_back(reader.make_empty_variant()) = var;
+				
+				std::stringstream stream;
+				vcf::output_vcf(stream, var);
+				expected_records.emplace_back(stream.str());
+				return true;
+			});
+			
+			THEN("the copies match the original records")
+			{
+				REQUIRE(frozen_variants.size() == 2);
+				REQUIRE(1 < buffer.memory().block_count());
+				
+				for (auto const &[frozen_var, expected] : rsv::zip(frozen_variants, expected_records))
+				{
+					std::stringstream stream;
+					frozen_var.output_vcf(stream);
+					CHECK(stream.str() == expected);
+				}
+				
+				auto const &var(frozen_variants.front());
+				CHECK(var.chrom_id() == "chr1");
+				CHECK(var.pos() == 10);
+				CHECK(var.ref() == "A");
+				CHECK(var.id().size() == 1);
+				CHECK(var.id()[0] == "v1");
+				CHECK(var.alts().size() == 1);
+				CHECK(var.alts()[0].alt == "C");
+				REQUIRE(var.samples().size() == 4);
+				
+				auto const &fields(var.get_format().fields_by_identifier());
+				auto const &gt_field(dynamic_cast <vcf::genotype_field_gt const &>(*fields.find("GT")->second));
+				auto const &dp_field(dynamic_cast <vcf::genotype_field_dp const &>(*fields.find("DP")->second));
+				auto const &first_sample(var.samples()[0]);
+				REQUIRE(gt_field.has_value(first_sample));
+				auto const gt(gt_field(first_sample));
+				REQUIRE(gt.size() == 2);
+				CHECK(gt[0].alt == 0);
+				CHECK(gt[1].alt == 1);
+				CHECK(gt[1].is_phased);
+				CHECK(dp_field(first_sample) == 5);
+				CHECK(dp_field(var.samples()[3]) == 8);
+			}
+			
+			AND_WHEN("the arena is released")
+			{
+				auto const block_count(buffer.memory().block_count());
+				buffer.release();
+				CHECK(0 == buffer.memory().bytes_used());
+				
+				THEN("the blocks are reused for copies of non-transient variants")
+				{
+					for (auto const &[var, expected] : rsv::zip(variants, expected_records))
+					{
+						std::stringstream stream;
+						buffer.freeze(var).output_vcf(stream);
+						CHECK(stream.str() == expected);
+					}
+					CHECK(buffer.memory().block_count() == block_count);
+				}
+			}
+		}
+	}
+}
+
+
+SCENARIO("Variants can be converted to an Arrow IPC file", "[vcf_reader]")
+{
+	GIVEN("a VCF file with genotypes")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-gt-only.vcf");
+		vcf::reader reader(input);
+		vcf::add_reserved_info_keys(reader.info_fields());
+		vcf::add_reserved_genotype_keys(reader.genotype_fields());
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the records are written in batches of two")
+		{
+			std::stringstream stream;
+			vcf::columnar_writer writer(stream, 2, 2);
+			writer.prepare(reader);
+			reader.parse([&writer](vcf::transient_variant const &var){
+				writer.add_variant(var);
+				return true;
+			});
+			writer.finish();
+			
+			auto const contents(stream.str());
+			std::string_view const contents_(contents);
+			
+			THEN("the file has the Arrow IPC magic strings and a footer")
+			{
+				using namespace std::literals::string_view_literals;
+				REQUIRE(contents_.size() == writer.bytes_written());
+				REQUIRE(contents_.starts_with("ARROW1\0\0"sv));
+				REQUIRE(contents_.ends_with("ARROW1"sv));
+				
+				std::uint32_t footer_length{};
+				for (std::size_t i{}; i < 4; ++i)
+					footer_length |= std::uint32_t(std::uint8_t(contents_[contents_.size() - 10 + i])) << (8 * i);
+				CHECK(8 + 10 + footer_length < contents_.size());
+			}
+			
+			THEN("the schema contains the columns and the sample names")
+			{
+				CHECK(std::string_view::npos != contents_.find("CHROM"));
+				CHECK(std::string_view::npos != contents_.find("GT_phased"));
+				CHECK(std::string_view::npos != contents_.find("SAMPLE1\tSAMPLE2\tSAMPLE3\tSAMPLE4"));
+			}
+		}
+	}
+}
+
+
+SCENARIO("The VCF reader can be positioned with an offset index", "[vcf_reader]")
+{
+	auto const should_use_stream_input = GENERATE(false, true);
+	
+	GIVEN("a VCF file with two chromosomes")
+	{
+		vcf::mmap_input mmap_input;
+		vcf::seekable_stream_input <lb::file_istream> stream_input{128}; // Small buffer to test refilling.
+		vcf::input_base *input{};
+		if (should_use_stream_input)
+		{
+			lb::open_file_for_reading("test-files/test-index.vcf", stream_input.stream());
+			input = &stream_input;
+		}
+		else
+		{
+			mmap_input.handle().open("test-files/test-index.vcf");
+			input = &mmap_input;
+		}
+		
+		vcf::reader reader(*input);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		struct record
+		{
+			std::string	id;
+			std::size_t	lineno{};
+			std::size_t	variant_index{};
+			
+			bool operator==(record const &) const = default;
+		};
+		
+		std::vector <record> records;
+		vcf::offset_index index(2);
+		reader.parse([&reader, &records, &index](vcf::transient_variant const &var){
+			records.emplace_back(std::string(var.id().front()), var.lineno(), var.variant_index());
+			index.add_variant(reader, var);
+			return true;
+		});
+		
+		WHEN("the index is built")
+		{
+			THEN("the entries point to the records")
+			{
+				vcf::mmap_input::handle_type handle;
+				handle.open("test-files/test-index.vcf");
+				std::string_view const contents(handle.data(), handle.size());
+				
+				REQUIRE(index.chromosomes().size() == 2);
+				REQUIRE(index.entries().size() == 5); // chr1: 1, 3, 5; chr2: 10, 30.
+				for (auto const &entry : index.entries())
+				{
+					auto const &chr(index.chromosomes()[entry.chrom_idx]);
+					auto const expected_prefix(chr.id + '\t' + std::to_string(entry.pos) + '\t');
+					CHECK(contents.substr(entry.offset).starts_with(expected_prefix));
+					CHECK(records[entry.variant_index].lineno == entry.lineno);
+				}
+			}
+			
+			THEN("the index may be written and read")
+			{
+				std::stringstream stream;
+				index.output(stream);
+				
+				vcf::offset_index index_;
+				index_.read(stream);
+				CHECK(index_.interval() == 2);
+				REQUIRE(index_.entries().size() == index.entries().size());
+				for (auto const &[lhs, rhs] : rsv::zip(index.entries(), index_.entries()))
+				{
+					CHECK(lhs.chrom_idx == rhs.chrom_idx);
+					CHECK(lhs.pos == rhs.pos);
+					CHECK(lhs.offset == rhs.offset);
+					CHECK(lhs.lineno == rhs.lineno);
+					CHECK(lhs.variant_index == rhs.variant_index);
+				}
+			}
+		}
+		
+		WHEN("the reader is positioned at a locus")
+		{
+			REQUIRE(index.seek(reader, "chr2", 25));
+			
+			std::vector <record> parsed_records;
+			reader.parse([&parsed_records](vcf::transient_variant const &var){
+				parsed_records.emplace_back(std::string(var.id().front()), var.lineno(), var.variant_index());
+				return true;
+			});
+			
+			THEN("parsing continues from the preceding indexed record")
+			{
+				CHECK(parsed_records == std::vector <record>(records.begin() + 5, records.end()));
+			}
+		}
+		
+		WHEN("the chromosome is not in the index")
+		{
+			THEN("the reader is not positioned")
+			{
+				CHECK(!index.seek(reader, "chr3", 1));
+			}
+		}
+		
+		WHEN("the reader is reset")
+		{
+			reader.reset();
+			
+			std::vector <record> parsed_records;
+			reader.parse([&parsed_records](vcf::transient_variant const &var){
+				parsed_records.emplace_back(std::string(var.id().front()), var.lineno(), var.variant_index());
+				return true;
+			});
+			
+			THEN("the records are parsed again")
+			{
+				CHECK(parsed_records == records);
+			}
+		}
+	}
+}
+
+
+SCENARIO("The VCF reader can parse records in regions with an interval index", "[vcf_reader]")
+{
+	GIVEN("a VCF file, an offset index and an interval index")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-index.vcf");
+		
+		vcf::reader reader(input);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		vcf::offset_index offsets(2);
+		reader.parse([&reader, &offsets](vcf::transient_variant const &var){
+			offsets.add_variant(reader, var);
+			return true;
+		});
+		
+		// Zero-based, half-open intervals.
+		vcf::interval_index intervals;
+		intervals.add_interval("chr2", 25, 35);
+		intervals.add_interval("chr1", 1, 3);
+		intervals.add_interval("chr1", 2, 2);
+		intervals.add_interval("chr3", 0, 100);
+		intervals.finish();
+		
+		WHEN("the interval index is queried")
+		{
+			auto const *chr1(intervals.find("chr1"));
+			REQUIRE(chr1);
+			
+			THEN("the positions are found")
+			{
+				CHECK(!chr1->contains(0));
+				CHECK(chr1->contains(1));
+				CHECK(chr1->contains(2));
+				CHECK(!chr1->contains(3));
+				CHECK(chr1->next_contained_position(0) == 1);
+				CHECK(chr1->next_contained_position(2) == 2);
+				CHECK(chr1->next_contained_position(3) == vcf::chromosome_interval_index::NOT_FOUND);
+				CHECK(intervals.contains("chr2", 29));
+				CHECK(!intervals.contains("chr4", 29));
+			}
+		}
+		
+		WHEN("the records in the regions are parsed")
+		{
+			std::vector <std::string> ids;
+			vcf::indexed_region_parser parser(reader, offsets, intervals);
+			parser.parse([&ids](vcf::transient_variant const &var){
+				ids.emplace_back(var.id().front());
+				return true;
+			});
+			
+			THEN("only the records in the regions are reported")
+			{
+				CHECK(ids == std::vector <std::string>{"v1_2", "v1_3", "v2_30"});
+				CHECK(parser.seek_count() == 2);
+			}
+		}
+	}
+}
+
+
+SCENARIO("Records of multiple VCF files can be merged by position", "[vcf_reader]")
+{
+	auto const block_size = GENERATE(as <std::size_t>{}, 1, 2, vcf::variant_merger::DEFAULT_BLOCK_SIZE);
+	
+	GIVEN("two VCF files")
+	{
+		vcf::mmap_input inputs[2];
+		inputs[0].handle().open("test-files/test-merge-1.vcf");
+		inputs[1].handle().open("test-files/test-merge-2.vcf");
+		vcf::reader readers[2]{vcf::reader(inputs[0]), vcf::reader(inputs[1])};
+		
+		vcf::variant_merger merger;
+		merger.set_block_size(block_size);
+		merger.set_block_count(2);
+		for (auto &reader : readers)
+		{
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+			merger.add_input(reader);
+		}
+		
+		WHEN("the records are merged")
+		{
+			std::vector <std::vector <std::string>> groups;
+			merger.merge([&groups](vcf::variant_merger::variant_group const &group){
+				auto &ids(groups.emplace_back());
+				for (auto const &[var, input_idx] : group)
+					ids.push_back(std::to_string(input_idx) + ':' + std::string(var.id().front()));
+				return true;
+			});
+			
+			THEN("the records are grouped by position")
+			{
+				CHECK(groups == std::vector <std::vector <std::string>>{
+					{"0:a1"},
+					{"1:b2"},
+					{"0:a3", "1:b3"},
+					{"0:a3_2"},
+					{"0:a5"},
+					{"1:b6"}
+				});
+			}
+		}
+		
+		WHEN("the callback returns false")
+		{
+			std::size_t group_count{};
+			merger.merge([&group_count](vcf::variant_merger::variant_group const &){
+				++group_count;
+				return group_count < 2;
+			});
+			
+			THEN("merging stops")
+			{
+				CHECK(group_count == 2);
+			}
+		}
+	}
+}
+
+
+SCENARIO("Variants can be formatted in parallel", "[vcf_reader]")
+{
+	auto const batch_size = GENERATE(as <std::size_t>{}, 1, 2, vcf::parallel_variant_printer::DEFAULT_BATCH_SIZE);
+	
+	GIVEN("a VCF file")
+	{
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-data-types.vcf");
+		vcf::reader reader(input);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the records are formatted with the parallel printer")
+		{
+			vcf::variant_printer <vcf::variant> printer;
+			std::stringstream expected;
+			std::string output;
+			
+			{
+				vcf::parallel_variant_printer parallel_printer(
+					[&output](std::string_view const sv){ output += sv; },
+					printer,
+					2,
+					batch_size
+				);
+				
+				reader.parse([&](vcf::transient_variant const &var){
+					vcf::variant const copy(var);
+					printer.output_variant(expected, copy);
+					parallel_printer.add_variant(var);
+					return true;
+				});
+				parallel_printer.finish();
+			}
+			
+			THEN("the output matches that of the serial printer")
+			{
+				CHECK(!output.empty());
+				CHECK(output == expected.str());
+			}
+		}
+	}
+}
+
+
+SCENARIO("The parallel VCF reader can parse VCF records in chunks", "[vcf_reader]")
+{
+	auto const chunk_size = GENERATE(as <std::size_t>{}, 1, 64, vcf::parallel_reader::DEFAULT_CHUNK_SIZE);
+	
+	GIVEN("a VCF file")
+	{
+		lb::dispatch::thread_pool thread_pool;
+		lb::dispatch::parallel_queue queue(thread_pool);
+		
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-data-types.vcf");
+		vcf::parallel_reader reader(input, [](vcf::reader &chunk_reader){
+			vcf::add_reserved_info_keys(chunk_reader.info_fields());
+			vcf::add_reserved_genotype_keys(chunk_reader.genotype_fields());
+		});
+		reader.set_chunk_size(chunk_size);
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		auto const expected_records(prepare_expected_records_for_test_data_types_vcf());
+		
+		WHEN("the records are parsed in order")
+		{
+			struct actual_record
+			{
+				std::size_t	lineno{};
+				std::size_t	pos{};
+				std::size_t	variant_index{};
+				std::string	id;
+				std::string	ref;
+				std::size_t	alt_count{};
+			};
+			
+			std::vector <actual_record> actual_records;
+			reader.parse_ordered([&actual_records](vcf::variant const &var){
+				// The callback is called serially.
+				actual_records.emplace_back(var.lineno(), var.pos(), var.variant_index(), var.id().front(), var.ref(), var.alts().size());
+				return true;
+			}, queue);
+			
+			THEN("the records are reported in file order")
+			{
+				REQUIRE(actual_records.size() == expected_records.size());
+				for (auto const &[idx, actual, expected] : rsv::zip(rsv::iota(std::size_t(0)), actual_records, expected_records))
+				{
+					CHECK(actual.lineno == expected.lineno);
+					CHECK(actual.pos == expected.pos);
+					CHECK(actual.variant_index == idx);
+					CHECK(actual.id == expected.id);
+					CHECK(actual.ref == expected.ref);
+					CHECK(actual.alt_count == expected.alts.size());
+				}
+			}
+		}
+		
+		WHEN("the records are parsed in arbitrary order")
+		{
+			std::mutex mutex;
+			std::vector <std::pair <std::size_t, std::size_t>> chunks_and_positions;
+			reader.parse_unordered([&mutex, &chunks_and_positions](std::size_t const chunk_idx, vcf::transient_variant const &var){
+				std::lock_guard const lock(mutex);
+				chunks_and_positions.emplace_back(chunk_idx, var.pos());
+				return true;
+			}, queue);
+			
+			THEN("each record is reported once")
+			{
+				std::sort(chunks_and_positions.begin(), chunks_and_positions.end());
+				REQUIRE(chunks_and_positions.size() == expected_records.size());
+				for (auto const &[actual, expected] : rsv::zip(chunks_and_positions, expected_records))
+					CHECK(actual.second == expected.pos);
+			}
+		}
+	}
+}
+
+
+SCENARIO("The parallel VCF reader assigns the same index to an undeclared contig in every chunk", "[vcf_reader]")
+{
+	GIVEN("a VCF file with contigs not listed in the header")
+	{
+		lb::dispatch::thread_pool thread_pool;
+		lb::dispatch::parallel_queue queue(thread_pool);
+		
+		vcf::mmap_input input;
+		input.handle().open("test-files/test-contigs-undeclared.vcf");
+		vcf::parallel_reader reader(input);
+		reader.set_chunk_size(1); // One record per chunk.
+		reader.read_header();
+		reader.set_parsed_fields(vcf::field::ALL);
+		
+		WHEN("the records are parsed in arbitrary order")
+		{
+			std::mutex mutex;
+			std::map <std::string, std::set <vcf::contig_table::contig_index_type>> indices_by_contig;
+			reader.parse_unordered([&mutex, &indices_by_contig](std::size_t const chunk_idx, vcf::transient_variant const &var){
+				std::lock_guard const lock(mutex);
+				indices_by_contig[std::string(var.chrom_id())].insert(var.contig_index());
+				return true;
+			}, queue);
+			
+			THEN("each contig has one index, and the declared contigs are indexed in header order")
+			{
+				auto const &contigs(reader.contigs());
+				REQUIRE(indices_by_contig.size() == 6);
+				REQUIRE(contigs.size() == 6);
+				for (auto const &[name, indices] : indices_by_contig)
+				{
+					REQUIRE(indices.size() == 1);
+					CHECK(contigs.name(*indices.begin()) == name);
+				}
+				
+				CHECK(indices_by_contig["chrB"] == std::set <vcf::contig_table::contig_index_type>{0});
+				CHECK(indices_by_contig["chrA"] == std::set <vcf::contig_table::contig_index_type>{1});
+			}
+		}
+	}
+}
+
+
+SCENARIO("The VCF reader can parse BCF records", "[vcf_reader]")
+{
+	GIVEN("an uncompressed BCF file")
+	{
+		std::vector <std::byte> buffer;
+		auto const append([&buffer](std::initializer_list <std::uint8_t> const bytes){
+			for (auto const bb : bytes)
+				buffer.push_back(std::byte{bb});
+		});
+		auto const append_uint32([&buffer](std::uint32_t const val){
+			for (std::size_t i{}; i < 4; ++i)
+				buffer.push_back(std::byte((val >> (8 * i)) & 0xFF));
+		});
+		
+		std::string const header_text(
+			"##fileformat=VCFv4.3\n"
+			"##contig=<ID=chr1>\n"
+			"##INFO=<ID=DP,Number=1,Type=Integer,Description=\"Depth\">\n"
+			"##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">\n"
+			"#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tSAMPLE1\n"
+		);
+		
+		append({'B', 'C', 'F', 2, 2});
+		append_uint32(1 + header_text.size());
+		for (auto const cc : header_text)
+			buffer.push_back(std::byte(cc));
+		buffer.push_back(std::byte{});
+		
+		// The string dictionary is PASS, DP, GT.
+		std::vector <std::uint8_t> const shared{
+			0, 0, 0, 0,					// CHROM
+			9, 0, 0, 0,					// POS
+			1, 0, 0, 0,					// rlen
+			0x00, 0x00, 0xF0, 0x41,		// QUAL = 30.0
+			1, 0, 2, 0,					// n_info, n_allele
+			1, 0, 0, 1,					// n_sample, n_fmt
+			0x37, 'r', 's', '1',		// ID
+			0x17, 'A',					// REF
+			0x17, 'T',					// ALT
+			0x11, 0,					// FILTER = PASS
+			0x11, 1, 0x11, 14			// DP = 14
+		};
+		std::vector <std::uint8_t> const indiv{
+			0x11, 2, 0x21, 2, 5			// GT = 0|1
+		};
+		append_uint32(shared.size());
+		append_uint32(indiv.size());
+		for (auto const bb : shared)
+			buffer.push_back(std::byte{bb});
+		for (auto const bb : indiv)
+			buffer.push_back(std::byte{bb});
+		
+		WHEN("the file is parsed")
+		{
+			vcf::bcf_buffer_input input(vcf::bcf_buffer_input::byte_span{buffer.data(), buffer.size()});
+			vcf::reader reader(input);
+			vcf::add_reserved_info_keys(reader.info_fields());
+			vcf::add_reserved_genotype_keys(reader.genotype_fields());
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+			
+			std::size_t count{};
+			reader.parse([&reader, &count](vcf::transient_variant const &var){
+				++count;
+				
+				CHECK(var.chrom_id() == "chr1");
+				CHECK(var.pos() == 10);
+				REQUIRE(var.id().size() == 1);
+				CHECK(var.id().front() == "rs1");
+				CHECK(var.ref() == "A");
+				REQUIRE(var.alts().size() == 1);
+				CHECK(var.alts().front().alt == "T");
+				CHECK(var.qual() == 30.0);
+				CHECK(var.filters().empty());
+				
+				auto const &dp_field(dynamic_cast <vcf::info_field_base::typed_field_type <vcf::metadata_value_type::INTEGER, false> const &>(*reader.info_fields().find("DP")->second));
+				REQUIRE(dp_field.has_value(var));
+				CHECK(dp_field(var) == 14);
+				
+				auto const &gt_field(dynamic_cast <vcf::genotype_field_gt const &>(*reader.genotype_fields().find("GT")->second));
+				auto const &sample(var.samples().front());
+				REQUIRE(gt_field.has_value(sample));
+				auto const &gt(gt_field(sample));
+				REQUIRE(gt.size() == 2);
+				CHECK(gt[0].alt == 0);
+				CHECK(gt[1].alt == 1);
+				CHECK(gt[1].is_phased);
+				
+				return true;
+			});
+			
+			THEN("each record was parsed")
+			{
+				CHECK(count == 1);
+			}
+		}
+
+		WHEN("the records are output with bcf_variant_printer")
+		{
+			vcf::bcf_buffer_input input(vcf::bcf_buffer_input::byte_span{buffer.data(), buffer.size()});
+			vcf::reader reader(input);
+			vcf::add_reserved_info_keys(reader.info_fields());
+			vcf::add_reserved_genotype_keys(reader.genotype_fields());
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+			
+			vcf::bcf_variant_printer printer;
+			printer.prepare(reader);
+			vcf::bcf_variant_printer::byte_vector output;
+			reader.parse([&printer, &output](vcf::transient_variant const &var){
+				printer.output_variant(output, var);
+				return true;
+			});
+			
+			THEN("the output matches the input records")
+			{
+				auto const record_start(5 + 4 + 1 + header_text.size());
+				REQUIRE(output.size() == buffer.size() - record_start);
+				CHECK(std::equal(output.begin(), output.end(), buffer.begin() + record_start));
+			}
+		}
+	}
+
+	GIVEN("a BGZF-compressed BCF file with records that span multiple blocks")
+	{
+		vcf::input_file input;
+		input.open("test-files/test-simple.bcf");
+
+		WHEN("the file is parsed")
+		{
+			REQUIRE(vcf::input_file::format_type::bgzf_bcf == input.format());
+
+			vcf::reader reader(input.input());
+			vcf::add_reserved_info_keys(reader.info_fields());
+			vcf::add_reserved_genotype_keys(reader.genotype_fields());
+			reader.read_header();
+			reader.set_parsed_fields(vcf::field::ALL);
+
+			auto const &dp_field(dynamic_cast <vcf::info_field_base::typed_field_type <vcf::metadata_value_type::INTEGER, false> const &>(*reader.info_fields().find("DP")->second));
+			auto const &gt_field(dynamic_cast <vcf::genotype_field_gt const &>(*reader.genotype_fields().find("GT")->second));
+
+			std::vector <std::size_t> positions;
+			std::vector <std::string> ids;
+			std::vector <std::int32_t> depths;
+			std::vector <std::string> genotypes;
+			reader.parse([&](vcf::transient_variant const &var){
+				positions.push_back(var.pos());
+				REQUIRE(var.id().size() == 1);
+				ids.emplace_back(var.id().front());
+				REQUIRE(dp_field.has_value(var));
+				depths.push_back(dp_field(var));
+
+				auto const &gt(gt_field(var.samples().front()));
+				REQUIRE(gt.size() == 2);
+				std::string gt_str;
+				gt_str += std::to_string(gt[0].alt);
+				gt_str += (gt[1].is_phased ? '|' : '/');
+				gt_str += std::to_string(gt[1].alt);
+				genotypes.emplace_back(std::move(gt_str));
+				return true;
+			});
+
+			THEN("the records match the expected")
+			{
+				CHECK(positions == std::vector <std::size_t>{10, 20, 30});
+				CHECK(ids == std::vector <std::string>{"rs1", "rs2", "rs3"});
+				CHECK(depths == std::vector <std::int32_t>{14, 15, 16});
+				CHECK(genotypes == std::vector <std::string>{"0|1", "1|1", "0/0"});
+			}
+		}
+	}
+}
@@ -5,8 +5,10 @@
 
 #include <libbio/assert.hh>
 #include <libbio/file_handling.hh>
+#include <libbio/indexed_fasta.hh>
 #include <libbio/vcf/variant.hh>
 #include <libbio/vcf/vcf_reader.hh>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -61,6 +63,76 @@ namespace {
 	}
 	
 	
+	void check_ref_indexed(vcf::reader &reader, lb::indexed_fasta const &reference, char const *expected_chr_id)
+	{
+		std::size_t matches{};
+		std::size_t mismatches{};
+		std::size_t missing{};
+		std::vector <std::optional <lb::fasta_index_entry const *>> entries_by_contig;	// By contig index; nullptr if not in the index.
+		std::string buffer;
+		reader.parse(
+			[
+				&reference,
+				expected_chr_id,	// Pointer
+				&matches,
+				&mismatches,
+				&missing,
+				&entries_by_contig,
+				&buffer
+			](vcf::transient_variant const &var){
+				
+				if (expected_chr_id && var.chrom_id() != expected_chr_id)
+				{
+					++mismatches;
+					return true;
+				}
+				
+				// Look up each contig once.
+				auto const contig_idx(var.contig_index());
+				if (entries_by_contig.size() <= contig_idx)
+					entries_by_contig.resize(1 + contig_idx);
+				auto &cached_entry(entries_by_contig[contig_idx]);
+				if (!cached_entry)
+					cached_entry = reference.find(var.chrom_id());
+				
+				auto const *entry(*cached_entry);
+				if (!entry)
+				{
+					++missing;
+					return true;
+				}
+				
+				++matches;
+				auto const pos(var.zero_based_pos());
+				auto const &ref(var.ref());
+				auto expected_ref(reference.subsequence_view(*entry, pos, pos + ref.size()));
+				if (expected_ref.empty())
+				{
+					// The range spans multiple lines.
+					reference.subsequence(*entry, pos, pos + ref.size(), buffer);
+					expected_ref = buffer;
+				}
+				
+				if (ref != expected_ref)
+				{
+					std::cerr
+						<< "WARNING: Variant on line "
+						<< var.lineno()
+						<< " has REF column value “"
+						<< ref
+						<< "” but the reference contains “"
+						<< expected_ref
+						<< "”.\n";
+				}
+				
+				return true;
+			}
+		);
+		
+		lb::log_time(std::cerr) << "Done. Chromosome ID matches: " << matches << " mismatches: " << mismatches << " not in reference: " << missing << ".\n";
+	}
+	
+	
 	void read_reference(char const *path, std::vector <char> &dst)
 	{
 		// FIXME: Handle FASTA in addition to text without terminating newline.
@@ -116,9 +188,6 @@ int main(int argc, char **argv)
 	vcf::mmap_input vcf_input;
 	vcf_input.handle().open(args_info.variants_arg);
 	
-	std::vector <char> reference;
-	read_reference(args_info.reference_arg, reference);
-	
 	// Instantiate the parser and add the fields listed in the specification to the metadata.
 	vcf::reader reader;
 	vcf::add_reserved_info_keys(reader.info_fields());
@@ -129,7 +198,18 @@ int main(int argc, char **argv)
 	reader.read_header();
 	reader.set_parsed_fields(vcf::field::REF);
 	
-	check_ref(reader, reference, args_info.chromosome_arg);
+	if (args_info.indexed_fasta_flag)
+	{
+		lb::indexed_fasta reference;
+		reference.open(args_info.reference_arg);
+		check_ref_indexed(reader, reference, args_info.chromosome_arg);
+	}
+	else
+	{
+		std::vector <char> reference;
+		read_reference(args_info.reference_arg, reference);
+		check_ref(reader, reference, args_info.chromosome_arg);
+	}
 	
 	return EXIT_SUCCESS;
 }
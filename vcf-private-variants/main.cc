@@ -3,14 +3,13 @@
  * This code is licensed under MIT license (see LICENSE for details).
  */
 
+#include <algorithm>
 #include <libbio/vcf/vcf_reader.hh>
-#include <range/v3/view/generate_n.hpp>
 #include <set>
 #include <vector>
 #include "cmdline.h"
 
 namespace lb	= libbio;
-namespace rsv	= ranges::view;
 namespace vcf	= libbio::vcf;
 
 
@@ -87,12 +86,17 @@ int main(int argc, char **argv)
 	// Should be checked by gengetopt, hence no libbio_always_assert.
 	libbio_assert(!private_set.empty());
 	
+	// Parse only the given samples; the others are parsed on demand.
+	reader.set_parsed_samples(private_set);
+	for (auto &idx : private_set)
+		--idx; // Sample numbers are 1-based.
+	
 	// Parse the variants.
 	std::set <std::uint16_t> private_alts;
 	std::set <std::uint16_t> found_alts;
 	std::size_t total_count(0);
 	reader.set_parsed_fields(vcf::field::ALL);
-	reader.parse([&private_set, &private_alts, &found_alts, &total_count](vcf::transient_variant const &var){
+	reader.parse([&reader, &private_set, &private_alts, &found_alts, &total_count](vcf::transient_variant const &var){
 		auto const &gt_field(*get_variant_format(var).gt_field);
 		auto const &samples(var.samples());
 		
@@ -119,27 +123,13 @@ int main(int argc, char **argv)
 		if (1 < private_alts.size())
 			private_alts.erase(0);
 		
-		// Determine the indices not in the private set.
-		auto const sample_count(samples.size());
-		auto rng(rsv::generate_n(
-			[it = private_set.begin(), curr_idx = std::size_t(0)]() mutable {
-				while (*it <= curr_idx)
-				{
-					++it;
-					++curr_idx;
-				}
-				
-				auto const retval(curr_idx);
-				++curr_idx;
-				return retval;
-			},
-			sample_count - private_set.size()
-		));
-		
 		// Handle the complement of private_set.
-		for (auto const sample_idx : rng)
+		for (std::size_t sample_idx{}; sample_idx < samples.size(); ++sample_idx)
 		{
-			libbio_assert_lt(sample_idx, samples.size());
+			if (std::binary_search(private_set.begin(), private_set.end(), sample_idx))
+				continue;
+			
+			reader.parse_skipped_sample(sample_idx);
 			auto const &sample(samples[sample_idx]);
 			auto const &gt(gt_field(sample)); // vector of sample_genotype
 			for (auto const &sample_gt : gt)
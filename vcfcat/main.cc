@@ -6,6 +6,7 @@
 #include <boost/format.hpp>
 #include <libbio/assert.hh>
 #include <libbio/file_handling.hh>
+#include <libbio/vcf/input_file.hh>
 #include <libbio/vcf/parse_error.hh>
 #include <libbio/vcf/subfield.hh>
 #include <libbio/vcf/variant.hh>
@@ -620,6 +621,18 @@ namespace {
 		output_header(reader, stream, sample_names, exclude_samples);
 		printer.prepare(reader);
 
+		if (!exclude_samples)
+		{
+			// Parse only the samples that are output.
+			vcf::reader::sample_number_vector sample_numbers;
+			for (auto const &name : sample_names)
+			{
+				if (auto const sample_no(reader.sample_no(name)); sample_no)
+					sample_numbers.push_back(sample_no);
+			}
+			reader.set_parsed_samples(sample_numbers);
+		}
+
 		std::string var_id_buffer;
 		std::size_t missing_id_idx{};
 		
@@ -797,11 +810,11 @@ int main(int argc, char **argv)
 	}
 	
 	// Open the variant file.
-	// FIXME: use stream input, handle compressed input.
-	vcf::mmap_input vcf_input;
+	// FIXME: use stream input.
+	vcf::input_file vcf_input;
 	lb::file_ostream output_stream;
 	
-	vcf_input.handle().open(args_info.input_arg);
+	vcf_input.open(args_info.input_arg);
 	if (args_info.output_given)
 		lb::open_file_for_writing(args_info.output_arg, output_stream, lb::writing_open_mode::CREATE);
 	
@@ -828,7 +841,7 @@ int main(int argc, char **argv)
 	// Parse.
 	reader.set_should_skip_invalid_records(args_info.skip_invalid_flag);
 	reader.set_variant_format(new variant_format());
-	reader.set_input(vcf_input);
+	reader.set_input(vcf_input.input());
 	reader.read_header();
 	reader.set_parsed_fields(vcf::field::ALL);
 
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <libbio/vcf/variant_merger.hh>
 #include <range/v3/all.hpp>
 #include <set>
 #include <vector>
@@ -12,7 +13,6 @@
 #include "metadata_checker.hh"
 #include "variant_printer.hh"
 #include "vcf_input.hh"
-#include "vcf_record_generator.hh"
 
 
 namespace fs	= std::filesystem;
@@ -27,28 +27,6 @@ namespace {
 	typedef std::vector <merge::vcf_input>	vcf_input_vector;
 	
 	
-	struct sourced_variant
-	{
-		vcf::variant	variant;
-		std::size_t		input_index{};
-		
-		sourced_variant() = default;
-		
-		sourced_variant(vcf::variant &&variant_, std::size_t const input_index_):
-			variant(std::move(variant_)),
-			input_index(input_index_)
-		{
-		}
-	};
-	
-	typedef std::multiset <sourced_variant>	variant_set;
-	
-	bool operator<(sourced_variant const &lhs, sourced_variant const &rhs)
-	{
-		return lhs.variant.pos() < rhs.variant.pos();
-	}
-	
-	
 	void read_inputs(vcf_input_vector &inputs, char **names, std::size_t const count)
 	{
 		inputs.resize(count);
@@ -98,8 +76,8 @@ namespace {
 		
 		virtual ~merge_strategy() {}
 		virtual void make_sample_names(vcf_input_vector const &inputs, sample_name_vector &sample_names) const = 0;
-		virtual void prepare_variants(variant_set &variants, vcf_input_vector &inputs) = 0;
-		virtual void output_variant(std::size_t const input_idx, vcf::variant const &variant) = 0;
+		virtual void prepare_inputs(vcf_input_vector &inputs, vcf::variant_merger &merger) = 0;
+		virtual void output_variant(std::size_t const merger_input_idx, vcf::frozen_variant const &variant) = 0;
 		
 		void output_column_header(vcf_input_vector const &inputs) const
 		{
@@ -114,32 +92,18 @@ namespace {
 			std::cout << '\n';
 		}
 		
-		void output_variants(variant_set &variants, vcf_input_vector &inputs)
-		{
-			while (!variants.empty())
-			{
-				// Get the next variant.
-				auto node(variants.extract(variants.begin()));
-				auto &sourced_var(node.value());
-				auto const idx(sourced_var.input_index);
-				libbio_assert_lt(idx, inputs.size());
-				auto &input(inputs[idx]);
-				
-				output_variant(idx, sourced_var.variant);
-				
-				if (input.record_generator.get_next_variant(sourced_var.variant))
-					variants.insert(sourced_var);
-			}
-		}
-		
 		virtual void process_variants(vcf_input_vector &inputs)
 		{
-			// Output the records in order.
-			// Use a multiset in order to reuse the variants’ buffers and prepare it with the first variant from each input.
-			variant_set variants;
+			// Output the records in order. The inputs are parsed in separate threads
+			// and the records with the same position are passed to the printer together.
+			vcf::variant_merger merger;
 			output_column_header(inputs);
-			prepare_variants(variants, inputs);
-			output_variants(variants, inputs);
+			prepare_inputs(inputs, merger);
+			merger.merge([this](vcf::variant_merger::variant_group const &group){
+				for (auto const &[var, idx] : group)
+					output_variant(idx, var);
+				return true;
+			});
 		}
 	};
 	
@@ -147,7 +111,7 @@ namespace {
 	class merge_gs_strategy final : public merge_strategy
 	{
 	protected:
-		merge::variant_printer_gs <vcf::variant>	m_printer;
+		merge::variant_printer_gs <vcf::frozen_variant>	m_printer;
 		
 	public:
 		merge_gs_strategy(std::size_t const input_count, std::size_t const sample_ploidy, bool const samples_are_phased):
@@ -165,19 +129,16 @@ namespace {
 			}
 		}
 		
-		void prepare_variants(variant_set &variants, vcf_input_vector &inputs) override
+		void prepare_inputs(vcf_input_vector &inputs, vcf::variant_merger &merger) override
 		{
-			for (auto const &[idx, input] : rsv::enumerate(inputs))
+			for (auto &input : inputs)
 			{
 				input.reader.set_parsed_fields(vcf::field::INFO);
-
-				auto var(input.reader.make_empty_variant());
-				if (input.record_generator.get_next_variant(var))
-					variants.emplace(std::move(var), idx);
+				merger.add_input(input.reader);
 			}
 		}
 		
-		void output_variant(std::size_t const input_idx, vcf::variant const &variant) override
+		void output_variant(std::size_t const input_idx, vcf::frozen_variant const &variant) override
 		{
 			m_printer.set_active_sample_index(input_idx);
 			m_printer.output_variant(std::cout, variant);
@@ -188,9 +149,10 @@ namespace {
 	class merge_ms_strategy final : public merge_strategy
 	{
 	protected:
-		merge::variant_printer_ms <vcf::variant>	m_printer;
-		std::vector <std::size_t>					m_sample_count_csum;
-		bool										m_should_merge_sample_names{};
+		merge::variant_printer_ms <vcf::frozen_variant>	m_printer;
+		std::vector <std::size_t>						m_sample_count_csum;
+		std::vector <std::size_t>						m_input_indices;		// By merger input index.
+		bool											m_should_merge_sample_names{};
 		
 	public:
 		merge_ms_strategy(
@@ -261,7 +223,7 @@ namespace {
 			}
 		}
 		
-		void prepare_variants(variant_set &variants, vcf_input_vector &inputs) override
+		void prepare_inputs(vcf_input_vector &inputs, vcf::variant_merger &merger) override
 		{
 			// Prepare a cumulative sum of the sample counts.
 			std::size_t sample_count_csum(0);
@@ -271,11 +233,8 @@ namespace {
 				if (sample_count)
 				{
 					input.reader.set_parsed_fields(vcf::field::ALL);
-					
-					auto var(input.reader.make_empty_variant());
-					if (input.record_generator.get_next_variant(var))
-						variants.emplace(std::move(var), sample_count_csum);
-					
+					merger.add_input(input.reader);
+					m_input_indices.push_back(idx);
 					sample_count_csum += sample_count;
 				}
 				
@@ -288,8 +247,10 @@ namespace {
 			m_printer.set_total_samples(sample_count_csum);
 		}
 		
-		void output_variant(std::size_t const input_idx, vcf::variant const &variant) override
+		void output_variant(std::size_t const merger_input_idx, vcf::frozen_variant const &variant) override
 		{
+			libbio_assert_lt(merger_input_idx, m_input_indices.size());
+			auto const input_idx(m_input_indices[merger_input_idx]);
 			libbio_assert_lt(1 + input_idx, m_sample_count_csum.size());
 			auto const lb(m_sample_count_csum[input_idx]);
 			auto const rb(m_sample_count_csum[1 + input_idx]);
@@ -116,7 +116,7 @@ namespace libbio::vcfmerge {
 			// Get the GT field.
 			auto const &fields(var.get_format().fields_by_identifier());
 			auto const it(fields.find("GT"));
-			libbio_always_assert_neq_msg(it, fields.end(), "Expected variant to have a GT field");
+			libbio_always_assert_neq(it, fields.end(), "Expected variant to have a GT field");
 			auto const &gt_field(*it->second);
 			
 			// Output the samples.
@@ -9,7 +9,6 @@
 #include <libbio/vcf/vcf_input.hh>
 #include <libbio/vcf/vcf_reader.hh>
 #include <string>
-#include "vcf_record_generator.hh"
 
 
 namespace libbio::vcfmerge {
@@ -18,12 +17,10 @@ namespace libbio::vcfmerge {
 	{
 		libbio::vcf::mmap_input		input;
 		libbio::vcf::reader			reader;
-		vcf_record_generator		record_generator;
 		std::string					source_path;
 		
 		vcf_input():
-			reader(input),
-			record_generator(reader)
+			reader(input)
 		{
 		}
 		
@@ -3,6 +3,7 @@
  * This code is licensed under MIT license (see LICENSE for details).
  */
 
+#include <libbio/vcf/input_file.hh>
 #include <libbio/vcf/variant.hh>
 #include <libbio/vcf/vcf_reader.hh>
 #include <range/v3/view/enumerate.hpp>
@@ -18,8 +19,9 @@ namespace {
 	class variant_validator final : public vcf::variant_validator
 	{
 	protected:
-		std::string m_chr_id;
-		std::size_t	m_prev_pos{};
+		std::string							m_chr_id;
+		vcf::contig_table::contig_index_type	m_contig_index{vcf::contig_table::INVALID_INDEX};
+		std::size_t							m_prev_pos{};
 
 	public:
 		variant_validator(char const *chr_id):
@@ -27,9 +29,12 @@ namespace {
 		{
 		}
 
+		// Call after reading the header.
+		void prepare(vcf::reader &reader) { m_contig_index = reader.contigs().find_or_add(m_chr_id); }
+
 		vcf::variant_validation_result validate(vcf::transient_variant const &var) override
 		{
-			if (m_chr_id != var.chrom_id())
+			if (m_contig_index != var.contig_index())
 				return vcf::variant_validation_result::SKIP;
 
 			auto const pos(var.zero_based_pos());
@@ -240,9 +245,9 @@ int main(int argc, char **argv)
 	std::cin.tie(nullptr);					// We don't require any input from the user.
 
 	// Open the variant file.
-	// FIXME: use stream input, handle compressed input.
-	vcf::mmap_input vcf_input;
-	vcf_input.handle().open(args_info.input_arg);
+	// FIXME: use stream input.
+	vcf::input_file vcf_input;
+	vcf_input.open(args_info.input_arg);
 	
 	// Instantiate the parser and add the fields listed in the specification to the metadata.
 	vcf::reader reader;
@@ -252,8 +257,9 @@ int main(int argc, char **argv)
 	variant_validator validator(args_info.chr_arg);
 	reader.set_variant_validator(validator);
 	
-	reader.set_input(vcf_input);
+	reader.set_input(vcf_input.input());
 	reader.read_header();
+	validator.prepare(reader);
 
 	if (args_info.variant_distances_given)
 		output_variant_distances(reader);